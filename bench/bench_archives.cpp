@@ -0,0 +1,116 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "src/common/memwritestream.h"
+
+#include "src/awe/binarchive.h"
+#include "src/awe/rmdparchive.h"
+
+#include "src/datagen/rmdparchivewriter.h"
+
+#include "bench/benchdata.h"
+
+struct RMDPData {
+	std::vector<byte> bin, rmdp;
+	std::vector<std::string> paths;
+};
+
+static const RMDPData &getRMDPData(unsigned int version) {
+	static std::map<unsigned int, RMDPData> archives;
+
+	auto iter = archives.find(version);
+	if (iter != archives.end())
+		return iter->second;
+
+	const auto &resources = getResources(version == 7 ? DataGen::Generator::kNightmare : DataGen::Generator::kAlanWake);
+
+	RMDPData data;
+	DataGen::RMDPArchiveWriter writer(version);
+	for (const auto &resource : resources) {
+		writer.addResource(resource.first, resource.second);
+		data.paths.emplace_back(resource.first);
+	}
+
+	Common::DynamicMemoryWriteStream bin(true), rmdp(true);
+	writer.write(bin, rmdp);
+	data.bin.assign(bin.getData(), bin.getData() + bin.getLength());
+	data.rmdp.assign(rmdp.getData(), rmdp.getData() + rmdp.getLength());
+
+	return archives.emplace(version, std::move(data)).first->second;
+}
+
+static void BM_RMDPArchiveLoad(benchmark::State &state) {
+	const RMDPData &data = getRMDPData(state.range(0));
+
+	for (auto _ : state) {
+		AWE::RMDPArchive archive(createStream(data.bin), createStream(data.rmdp));
+		benchmark::DoNotOptimize(archive.getNumResources());
+	}
+
+	state.SetItemsProcessed(state.iterations() * data.paths.size());
+	state.SetBytesProcessed(state.iterations() * data.bin.size());
+}
+BENCHMARK(BM_RMDPArchiveLoad)->Arg(2)->Arg(7);
+
+static void BM_RMDPArchiveHasResource(benchmark::State &state) {
+	const RMDPData &data = getRMDPData(state.range(0));
+	AWE::RMDPArchive archive(createStream(data.bin), createStream(data.rmdp));
+
+	size_t index = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(archive.hasResource(data.paths[index]));
+		index = (index + 1) % data.paths.size();
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RMDPArchiveHasResource)->Arg(2)->Arg(7);
+
+static void BM_RMDPArchiveGetResource(benchmark::State &state) {
+	const RMDPData &data = getRMDPData(state.range(0));
+	AWE::RMDPArchive archive(createStream(data.bin), createStream(data.rmdp));
+
+	size_t index = 0;
+	for (auto _ : state) {
+		std::unique_ptr<Common::ReadStream> resource(archive.getResource(data.paths[index]));
+		benchmark::DoNotOptimize(resource.get());
+		index = (index + 1) % data.paths.size();
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RMDPArchiveGetResource)->Arg(2)->Arg(7);
+
+static void BM_BINArchiveLoad(benchmark::State &state) {
+	const auto &bin = getResources(DataGen::Generator::kAlanWake).at("objects/cell_000.bin");
+
+	for (auto _ : state) {
+		std::unique_ptr<Common::ReadStream> stream(createStream(bin));
+		AWE::BINArchive archive(*stream);
+		benchmark::DoNotOptimize(archive.getNumResources());
+	}
+
+	state.SetBytesProcessed(state.iterations() * bin.size());
+}
+BENCHMARK(BM_BINArchiveLoad);
@@ -0,0 +1,380 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "src/common/aabbtree.h"
+#include "src/common/bvh.h"
+#include "src/common/convexshape.h"
+#include "src/common/frustum.h"
+#include "src/common/threadpool.h"
+#include "src/common/timerwheel.h"
+
+static void BM_ConvexShapeIntersect(benchmark::State &state) {
+	const unsigned int numPoints = state.range(0);
+
+	std::vector<glm::vec2> points;
+	for (unsigned int i = 0; i < numPoints; ++i) {
+		const float angle = 2.0f * static_cast<float>(M_PI) * static_cast<float>(i) / static_cast<float>(numPoints);
+		points.emplace_back(std::cos(angle) * 10.0f, std::sin(angle) * 10.0f);
+	}
+	const Common::ConvexShape shape(points);
+
+	// Query points inside and outside of the shape
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> coordinate(-15.0f, 15.0f);
+	std::vector<glm::vec2> positions(1024);
+	for (auto &position : positions) {
+		position.x = coordinate(random);
+		position.y = coordinate(random);
+	}
+
+	size_t index = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(shape.intersect(positions[index]));
+		index = (index + 1) % positions.size();
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConvexShapeIntersect)->Arg(4)->Arg(16)->Arg(64);
+
+static void BM_ThreadPoolLatency(benchmark::State &state) {
+	// Measure the time from adding a task until it finished on a worker thread
+	for (auto _ : state) {
+		std::promise<void> finished;
+		std::future<void> result = finished.get_future();
+
+		Threads.add([&finished]() {
+			finished.set_value();
+		});
+
+		result.wait();
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ThreadPoolLatency)->UseRealTime();
+
+static void BM_ThreadPoolThroughput(benchmark::State &state) {
+	const unsigned int numTasks = state.range(0);
+
+	for (auto _ : state) {
+		std::atomic_uint remaining = numTasks;
+		std::promise<void> finished;
+		std::future<void> result = finished.get_future();
+
+		for (unsigned int i = 0; i < numTasks; ++i) {
+			Threads.add([&remaining, &finished]() {
+				if (--remaining == 0)
+					finished.set_value();
+			});
+		}
+
+		result.wait();
+	}
+
+	state.SetItemsProcessed(state.iterations() * numTasks);
+}
+BENCHMARK(BM_ThreadPoolThroughput)->Arg(64)->Arg(1024)->UseRealTime();
+
+static void BM_TimerWheelTick(benchmark::State &state) {
+	const unsigned int numTimers = state.range(0);
+
+	// Deadlines spread over a minute in milliseconds, expired by advancing one 60 fps frame at a time
+	std::mt19937 random(1);
+	std::uniform_int_distribution<uint64_t> delay(1, 60000);
+	std::vector<uint64_t> delays(numTimers);
+	for (auto &d : delays) {
+		d = delay(random);
+	}
+
+	size_t expired = 0;
+	for (auto _ : state) {
+		Common::TimerWheel wheel;
+		for (const auto d : delays) {
+			wheel.schedule(d, [&expired](){ expired++; });
+		}
+
+		while (wheel.size() > 0) {
+			wheel.advance(wheel.getTime() + 16);
+		}
+	}
+
+	benchmark::DoNotOptimize(expired);
+	state.SetItemsProcessed(state.iterations() * numTimers);
+}
+BENCHMARK(BM_TimerWheelTick)->Arg(1000)->Arg(100000);
+
+static void BM_TimerWheelScheduleCancel(benchmark::State &state) {
+	const unsigned int numTimers = state.range(0);
+
+	// Keep a number of timers pending, while scheduling and cancelling another one
+	Common::TimerWheel wheel;
+	std::mt19937 random(1);
+	std::uniform_int_distribution<uint64_t> delay(1, 60000);
+	for (unsigned int i = 0; i < numTimers; ++i) {
+		wheel.schedule(delay(random), [](){});
+	}
+
+	for (auto _ : state) {
+		const auto id = wheel.schedule(delay(random), [](){});
+		benchmark::DoNotOptimize(wheel.cancel(id));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimerWheelScheduleCancel)->Arg(100000);
+
+static Common::BoundSpheres generateBoundSpheres(unsigned int numSpheres) {
+	// Spheres scattered around the camera, roughly a fifth of them inside the frustum
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+	std::uniform_real_distribution<float> radius(0.5f, 20.0f);
+
+	Common::BoundSpheres spheres;
+	spheres.reserve(numSpheres);
+	for (unsigned int i = 0; i < numSpheres; ++i) {
+		spheres.add({glm::vec3(position(random), position(random), position(random)), radius(random)});
+	}
+
+	return spheres;
+}
+
+static glm::mat4 getBenchViewProjection() {
+	return glm::perspectiveFov(glm::radians(45.0f), 1920.0f, 1080.0f, 1.0f, 10000.0f) *
+		glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+static void BM_FrustumCull(benchmark::State &state) {
+	const unsigned int numSpheres = state.range(0);
+	const auto spheres = generateBoundSpheres(numSpheres);
+	const Common::Frustum frustum(getBenchViewProjection());
+
+	std::vector<byte> visibility;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(frustum.cull(spheres, visibility));
+	}
+
+	state.SetItemsProcessed(state.iterations() * numSpheres);
+}
+BENCHMARK(BM_FrustumCull)->Arg(1000)->Arg(100000);
+
+static void BM_FrustumIntersects(benchmark::State &state) {
+	const unsigned int numSpheres = state.range(0);
+	const auto spheres = generateBoundSpheres(numSpheres);
+	const Common::Frustum frustum(getBenchViewProjection());
+
+	// Test every sphere on its own for comparison with the batched culling
+	for (auto _ : state) {
+		size_t visible = 0;
+		for (size_t i = 0; i < spheres.size(); ++i) {
+			const Common::BoundSphere sphere{
+				glm::vec3(spheres.getX()[i], spheres.getY()[i], spheres.getZ()[i]), spheres.getRadius()[i]
+			};
+			visible += frustum.intersects(sphere);
+		}
+		benchmark::DoNotOptimize(visible);
+	}
+
+	state.SetItemsProcessed(state.iterations() * numSpheres);
+}
+BENCHMARK(BM_FrustumIntersects)->Arg(1000)->Arg(100000);
+
+static std::vector<Common::BVH::Object> generateWorldObjects(unsigned int numObjects) {
+	// Objects spread over a level of 4x4 km with a height of 100 m, between 1 and 8 m in size
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> position(-2048.0f, 2048.0f);
+	std::uniform_real_distribution<float> height(0.0f, 100.0f);
+	std::uniform_real_distribution<float> size(1.0f, 8.0f);
+
+	std::vector<Common::BVH::Object> objects;
+	objects.reserve(numObjects);
+	for (unsigned int i = 0; i < numObjects; ++i) {
+		const glm::vec3 min(position(random), height(random), position(random));
+		const glm::vec3 max = min + glm::vec3(size(random), size(random), size(random));
+		objects.emplace_back(Common::BoundBox{min.x, min.y, min.z, max.x, max.y, max.z}, i);
+	}
+
+	return objects;
+}
+
+static std::vector<Common::BoundSphere> generateQuerySpheres() {
+	std::mt19937 random(2);
+	std::uniform_real_distribution<float> position(-2048.0f, 2048.0f);
+
+	std::vector<Common::BoundSphere> spheres(1024);
+	for (auto &sphere : spheres) {
+		sphere = {glm::vec3(position(random), 50.0f, position(random)), 30.0f};
+	}
+
+	return spheres;
+}
+
+static Common::Frustum getWorldFrustum() {
+	return Common::Frustum(
+		glm::perspectiveFov(glm::radians(45.0f), 1920.0f, 1080.0f, 1.0f, 500.0f) *
+		glm::lookAt(glm::vec3(0.0f, 50.0f, 0.0f), glm::vec3(0.0f, 50.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f))
+	);
+}
+
+static void BM_BVHBuild(benchmark::State &state) {
+	const auto objects = generateWorldObjects(state.range(0));
+
+	for (auto _ : state) {
+		Common::BVH bvh(objects);
+		benchmark::DoNotOptimize(bvh.size());
+	}
+
+	state.SetItemsProcessed(state.iterations() * objects.size());
+}
+BENCHMARK(BM_BVHBuild)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_BVHQuerySphere(benchmark::State &state) {
+	const Common::BVH bvh(generateWorldObjects(state.range(0)));
+	const auto spheres = generateQuerySpheres();
+
+	std::vector<uint32_t> values;
+	size_t query = 0;
+	for (auto _ : state) {
+		values.clear();
+		bvh.query(spheres[query++ % spheres.size()], values);
+		benchmark::DoNotOptimize(values.data());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BVHQuerySphere)->Arg(100000)->Arg(1000000);
+
+static void BM_BVHQueryFrustum(benchmark::State &state) {
+	const Common::BVH bvh(generateWorldObjects(state.range(0)));
+	const Common::Frustum frustum = getWorldFrustum();
+
+	std::vector<uint32_t> values;
+	for (auto _ : state) {
+		values.clear();
+		bvh.query(frustum, values);
+		benchmark::DoNotOptimize(values.data());
+	}
+
+	state.counters["found"] = values.size();
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BVHQueryFrustum)->Arg(100000);
+
+static void BM_BVHRaycast(benchmark::State &state) {
+	const Common::BVH bvh(generateWorldObjects(state.range(0)));
+	const auto spheres = generateQuerySpheres();
+
+	// Horizontal rays of 200 m from the centers of the query spheres
+	std::vector<uint32_t> values;
+	size_t query = 0;
+	for (auto _ : state) {
+		values.clear();
+		bvh.raycast(spheres[query++ % spheres.size()].position, glm::vec3(0.6f, 0.0f, 0.8f), 200.0f, values);
+		benchmark::DoNotOptimize(values.data());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BVHRaycast)->Arg(100000);
+
+static void BM_LinearQuerySphere(benchmark::State &state) {
+	// Testing every object, as iterating over a registry view does
+	const auto objects = generateWorldObjects(state.range(0));
+	const auto spheres = generateQuerySpheres();
+
+	std::vector<uint32_t> values;
+	size_t query = 0;
+	for (auto _ : state) {
+		values.clear();
+		const Common::BoundSphere &sphere = spheres[query++ % spheres.size()];
+		for (const auto &[box, value] : objects) {
+			if (box.intersect(sphere.position, sphere.radius))
+				values.emplace_back(value);
+		}
+		benchmark::DoNotOptimize(values.data());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LinearQuerySphere)->Arg(100000);
+
+static void BM_AABBTreeQuerySphere(benchmark::State &state) {
+	Common::AABBTree tree;
+	for (const auto &[box, value] : generateWorldObjects(state.range(0))) {
+		tree.insert(box, value);
+	}
+	const auto spheres = generateQuerySpheres();
+
+	std::vector<uint32_t> values;
+	size_t query = 0;
+	for (auto _ : state) {
+		values.clear();
+		tree.query(spheres[query++ % spheres.size()], values);
+		benchmark::DoNotOptimize(values.data());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AABBTreeQuerySphere)->Arg(100000);
+
+static void BM_AABBTreeMove(benchmark::State &state) {
+	// Every object moves by up to 2 m per update, so that some of them leave their enlarged box
+	const auto objects = generateWorldObjects(state.range(0));
+	Common::AABBTree tree;
+	std::vector<Common::AABBTree::Proxy> proxies;
+	for (const auto &[box, value] : objects) {
+		proxies.emplace_back(tree.insert(box, value));
+	}
+
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> step(-2.0f, 2.0f);
+	std::vector<glm::vec3> offsets(objects.size());
+	for (auto &offset : offsets) {
+		offset = glm::vec3(step(random), 0.0f, step(random));
+	}
+
+	size_t moved = 0;
+	float direction = 1.0f;
+	for (auto _ : state) {
+		for (size_t i = 0; i < objects.size(); ++i) {
+			const glm::vec3 offset = offsets[i] * direction;
+			const Common::BoundBox &box = objects[i].first;
+			moved += tree.move(proxies[i], Common::BoundBox{
+				box.xmin + offset.x, box.ymin + offset.y, box.zmin + offset.z,
+				box.xmax + offset.x, box.ymax + offset.y, box.zmax + offset.z
+			});
+		}
+		direction = -direction;
+	}
+
+	state.counters["moved"] = benchmark::Counter(moved, benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(state.iterations() * objects.size());
+}
+BENCHMARK(BM_AABBTreeMove)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,197 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "src/common/log.h"
+#include "src/common/memwritestream.h"
+
+#include "src/awe/cidfile.h"
+#include "src/awe/dpfile.h"
+#include "src/awe/gidregistryfile.h"
+
+#include "src/datagen/dpfilewriter.h"
+#include "src/datagen/resources.h"
+
+#include "bench/benchdata.h"
+
+static void BM_CIDFile(
+		benchmark::State &state,
+		DataGen::Generator::Game game,
+		ObjectType type,
+		const std::string &path
+) {
+	const auto &resources = getResources(game);
+	const auto &cid = resources.at(path);
+	const auto dp = std::make_shared<DPFile>(createStream(resources.at("objects/cell_000/objects.dp")));
+
+	size_t numObjects = 0;
+	for (auto _ : state) {
+		std::unique_ptr<Common::ReadStream> stream(createStream(cid));
+		AWE::CIDFile file(*stream, type, dp);
+		numObjects = file.getContainers().size();
+	}
+
+	state.SetItemsProcessed(state.iterations() * numObjects);
+	state.SetBytesProcessed(state.iterations() * cid.size());
+}
+BENCHMARK_CAPTURE(BM_CIDFile, staticObjectsAlanWake, DataGen::Generator::kAlanWake, kStaticObject, "objects/cell_000/staticobjects.cid");
+BENCHMARK_CAPTURE(BM_CIDFile, dynamicObjectsAlanWake, DataGen::Generator::kAlanWake, kDynamicObject, "objects/cell_000/dynamicobjects.cid");
+BENCHMARK_CAPTURE(BM_CIDFile, charactersAlanWake, DataGen::Generator::kAlanWake, kCharacter, "objects/cell_000/characters.cid");
+BENCHMARK_CAPTURE(BM_CIDFile, triggersAlanWake, DataGen::Generator::kAlanWake, kTrigger, "objects/cell_000/triggers.cid");
+BENCHMARK_CAPTURE(BM_CIDFile, scriptsAlanWake, DataGen::Generator::kAlanWake, kScript, "scripts/scripts.cid");
+BENCHMARK_CAPTURE(BM_CIDFile, dynamicObjectsNightmare, DataGen::Generator::kNightmare, kDynamicObject, "objects/cell_000/dynamicobjects.cid");
+BENCHMARK_CAPTURE(BM_CIDFile, charactersNightmare, DataGen::Generator::kNightmare, kCharacter, "objects/cell_000/characters.cid");
+BENCHMARK_CAPTURE(BM_CIDFile, triggersNightmare, DataGen::Generator::kNightmare, kTrigger, "objects/cell_000/triggers.cid");
+BENCHMARK_CAPTURE(BM_CIDFile, scriptsNightmare, DataGen::Generator::kNightmare, kScript, "scripts/scripts.cid");
+
+struct DPData {
+	std::vector<byte> dp;
+	std::vector<uint32_t> offsets;
+};
+
+static DPData createDPData(unsigned int numStrings) {
+	DPData data;
+	DataGen::DPFileWriter writer;
+	for (unsigned int i = 0; i < numStrings; ++i) {
+		data.offsets.emplace_back(writer.addString(fmt::format("cell_{:03}_dynamicobject_{}", i % 64, i)));
+	}
+
+	Common::DynamicMemoryWriteStream stream(true);
+	writer.write(stream, true);
+	data.dp.assign(stream.getData(), stream.getData() + stream.getLength());
+
+	return data;
+}
+
+static void BM_DPFileLoad(benchmark::State &state) {
+	const DPData data = createDPData(state.range(0));
+
+	for (auto _ : state) {
+		DPFile dp(createStream(data.dp));
+		benchmark::DoNotOptimize(dp.hasString(data.offsets[0]));
+	}
+
+	state.SetBytesProcessed(state.iterations() * data.dp.size());
+}
+BENCHMARK(BM_DPFileLoad)->Arg(256)->Arg(4096);
+
+static void BM_DPFileGetString(benchmark::State &state) {
+	const DPData data = createDPData(state.range(0));
+	DPFile dp(createStream(data.dp));
+
+	size_t index = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(dp.getString(data.offsets[index]));
+		index = (index + 1) % data.offsets.size();
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DPFileGetString)->Arg(256)->Arg(4096);
+
+static void BM_DPFileGetAtom(benchmark::State &state) {
+	const DPData data = createDPData(state.range(0));
+	DPFile dp(createStream(data.dp));
+
+	size_t index = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(dp.getAtom(data.offsets[index]));
+		index = (index + 1) % data.offsets.size();
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DPFileGetAtom)->Arg(256)->Arg(4096);
+
+static std::vector<std::pair<GID, std::string>> createGIDs(unsigned int numGIDs) {
+	std::vector<std::pair<GID, std::string>> gids;
+	for (unsigned int i = 0; i < numGIDs; ++i) {
+		gids.emplace_back(GID{1 + i % 4, i + 1}, fmt::format("cell_{:03}_object_{}", i % 64, i));
+	}
+
+	return gids;
+}
+
+static void BM_GIDRegistryFileParse(benchmark::State &state) {
+	const std::vector<byte> registry = DataGen::writeGIDRegistry(createGIDs(state.range(0)));
+
+	for (auto _ : state) {
+		std::unique_ptr<Common::ReadStream> stream(createStream(registry));
+		AWE::GIDRegistryFile file(*stream);
+		benchmark::DoNotOptimize(&file);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * registry.size());
+}
+BENCHMARK(BM_GIDRegistryFileParse)->Arg(1024)->Arg(16384);
+
+static void BM_GIDRegistryFileGetString(benchmark::State &state) {
+	const auto gids = createGIDs(state.range(0));
+	const std::vector<byte> registry = DataGen::writeGIDRegistry(gids);
+
+	std::unique_ptr<Common::ReadStream> stream(createStream(registry));
+	AWE::GIDRegistryFile file(*stream);
+
+	size_t index = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(file.getString(gids[index].first));
+		index = (index + 1) % gids.size();
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GIDRegistryFileGetString)->Arg(1024)->Arg(16384);
+
+/*!
+ * Log the name of a gid with debug output disabled, like loading an object does. The gated variant uses the LOG_DEBUG
+ * macro, which skips the gid lookup, the ungated one calls spdlog directly, which evaluates it before checking the
+ * level. Builds with a minimum log level above debug remove the gated call completely.
+ */
+static void BM_GIDRegistryFileLog(benchmark::State &state, bool gated) {
+	const auto gids = createGIDs(1024);
+	const std::vector<byte> registry = DataGen::writeGIDRegistry(gids);
+
+	std::unique_ptr<Common::ReadStream> stream(createStream(registry));
+	AWE::GIDRegistryFile file(*stream);
+
+	const spdlog::level::level_enum level = spdlog::get_level();
+	spdlog::set_level(spdlog::level::info);
+
+	size_t index = 0;
+	for (auto _ : state) {
+		if (gated)
+			LOG_DEBUG("Loading dynamic object {}", file.getString(gids[index].first));
+		else
+			spdlog::debug("Loading dynamic object {}", file.getString(gids[index].first));
+		index = (index + 1) % gids.size();
+	}
+
+	spdlog::set_level(level);
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_GIDRegistryFileLog, gated, true);
+BENCHMARK_CAPTURE(BM_GIDRegistryFileLog, ungated, false);
@@ -0,0 +1,94 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <memory>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "src/graphics/gfxman.h"
+#include "src/graphics/mesh_binmsh.h"
+#include "src/graphics/images/dds.h"
+#include "src/graphics/images/tex.h"
+
+#include "src/datagen/resources.h"
+
+#include "bench/benchdata.h"
+
+static unsigned int getNumMipmaps(unsigned int size) {
+	return static_cast<unsigned int>(std::log2(std::max(size, 4u) / 4)) + 1;
+}
+
+static void BM_BINMSHMesh(benchmark::State &state) {
+	// The null renderer accepts the converted vertices without uploading them anywhere
+	static bool initialized = false;
+	if (!initialized) {
+		GfxMan.initNull();
+		initialized = true;
+	}
+
+	const unsigned int resolution = state.range(0);
+	const std::vector<byte> binmsh = DataGen::writeBINMSH(21, resolution, 32.0f);
+
+	for (auto _ : state) {
+		std::unique_ptr<Common::ReadStream> stream(createStream(binmsh));
+		Graphics::BINMSHMesh mesh(stream.get());
+		benchmark::DoNotOptimize(&mesh);
+	}
+
+	state.SetItemsProcessed(state.iterations() * resolution * resolution);
+	state.SetBytesProcessed(state.iterations() * binmsh.size());
+}
+BENCHMARK(BM_BINMSHMesh)->Arg(16)->Arg(64)->Arg(256);
+
+static void BM_TEX(benchmark::State &state) {
+	std::mt19937 random(1);
+	const unsigned int size = state.range(1);
+	const std::vector<byte> tex = DataGen::writeTEX(state.range(0), size, getNumMipmaps(size), random);
+
+	for (auto _ : state) {
+		std::unique_ptr<Common::ReadStream> stream(createStream(tex));
+		Graphics::TEX texture(*stream);
+		benchmark::DoNotOptimize(&texture);
+	}
+
+	state.SetBytesProcessed(state.iterations() * tex.size());
+}
+BENCHMARK(BM_TEX)
+		->ArgNames({"format", "size"})
+		->Args({6, 256})->Args({6, 1024})
+		->Args({5, 256})->Args({5, 1024})
+		->Args({9, 256})->Args({9, 1024});
+
+static void BM_DDS(benchmark::State &state) {
+	std::mt19937 random(1);
+	const unsigned int size = state.range(0);
+	const std::vector<byte> dds = DataGen::writeDDS(size, getNumMipmaps(size), random);
+
+	for (auto _ : state) {
+		std::unique_ptr<Common::ReadStream> stream(createStream(dds));
+		Graphics::DDS texture(stream.get());
+		benchmark::DoNotOptimize(&texture);
+	}
+
+	state.SetBytesProcessed(state.iterations() * dds.size());
+}
+BENCHMARK(BM_DDS)->Arg(256)->Arg(1024);
@@ -0,0 +1,62 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "src/awe/havokfile.h"
+
+#include "src/datagen/resources.h"
+
+#include "bench/benchdata.h"
+
+static void BM_HavokFile(benchmark::State &state) {
+	std::mt19937 random(1);
+	const std::vector<byte> binhkx = DataGen::writeHavokAnimation(state.range(0), state.range(1), random);
+
+	for (auto _ : state) {
+		std::unique_ptr<Common::ReadStream> stream(createStream(binhkx));
+		AWE::HavokFile havok(*stream);
+		benchmark::DoNotOptimize(havok.getAnimationContainer().animations.size());
+	}
+
+	state.SetBytesProcessed(state.iterations() * binhkx.size());
+}
+BENCHMARK(BM_HavokFile)->ArgNames({"bones", "frames"})->Args({16, 64})->Args({64, 512});
+
+static void BM_HavokFileGetAnimation(benchmark::State &state) {
+	std::mt19937 random(1);
+	const std::vector<byte> binhkx = DataGen::writeHavokAnimation(state.range(0), state.range(1), random);
+
+	std::unique_ptr<Common::ReadStream> stream(createStream(binhkx));
+	AWE::HavokFile havok(*stream);
+	const uint32_t skeleton = havok.getAnimationContainer().skeletons[0];
+	const uint32_t animation = havok.getAnimationContainer().animations[0];
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(havok.getSkeleton(skeleton));
+		benchmark::DoNotOptimize(havok.getAnimation(animation));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HavokFileGetAnimation)->ArgNames({"bones", "frames"})->Args({16, 64})->Args({64, 512});
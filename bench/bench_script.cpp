@@ -0,0 +1,178 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "src/common/memwritestream.h"
+
+#include "src/awe/cidfile.h"
+#include "src/awe/script/collection.h"
+#include "src/awe/script/context.h"
+#include "src/awe/script/functions.h"
+
+#include "src/datagen/dpfilewriter.h"
+#include "src/datagen/resources.h"
+
+#include "bench/benchdata.h"
+
+static std::atomic<uint64_t> numAllocations(0);
+
+// Count every allocation of the benchmarks, so that allocations on the hot path of scripts can be reported
+void *operator new(size_t size) {
+	numAllocations.fetch_add(1, std::memory_order_relaxed);
+	if (void *ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+struct ScriptData {
+	std::vector<byte> bytecode, parameters;
+	std::vector<AWE::Templates::ScriptVariables> scripts;
+};
+
+static std::vector<byte> getDPData(const DataGen::DPFileWriter &dp) {
+	Common::DynamicMemoryWriteStream stream(true);
+	dp.write(stream, false);
+	return std::vector<byte>(stream.getData(), stream.getData() + stream.getLength());
+}
+
+/*!
+ * Create a single synthetic script with one handler of the given number of blocks
+ */
+static ScriptData createSyntheticScript(unsigned int numBlocks) {
+	std::mt19937 random(1);
+	DataGen::DPFileWriter bytecode, parameters;
+
+	ScriptData data;
+	data.scripts.emplace_back(DataGen::writeBytecode(bytecode, parameters, {"OnInit"}, numBlocks, random));
+	data.bytecode = getDPData(bytecode);
+	data.parameters = getDPData(parameters);
+
+	return data;
+}
+
+/*!
+ * Get the scripts of the generated data of a game
+ */
+static ScriptData getGeneratedScripts(DataGen::Generator::Game game) {
+	const auto &resources = getResources(game);
+
+	ScriptData data;
+	data.bytecode = resources.at("scripts/bytecode.dp");
+	data.parameters = resources.at("scripts/bytecodeparameters.dp");
+
+	std::unique_ptr<Common::ReadStream> stream(createStream(resources.at("scripts/scripts.cid")));
+	AWE::CIDFile scripts(*stream, kScript, std::make_shared<DPFile>(createStream(resources.at("objects/cell_000/objects.dp"))));
+	for (const auto &container : scripts.getContainers()) {
+		data.scripts.emplace_back(std::any_cast<AWE::Templates::Script>(container).script);
+	}
+
+	return data;
+}
+
+static void runScripts(benchmark::State &state, const ScriptData &data, const std::string &entryPoint) {
+	AWE::Script::Collection collection(createStream(data.bytecode), createStream(data.parameters));
+
+	std::vector<std::unique_ptr<AWE::Script::Bytecode>> bytecodes;
+	for (const auto &script : data.scripts) {
+		bytecodes.emplace_back(collection.createScript(script));
+	}
+
+	entt::registry registry;
+	AWE::Script::Functions functions(registry);
+	AWE::Script::Context context(registry, functions);
+
+	// Run every script once before measuring, so that all call sites are bound
+	for (const auto &bytecode : bytecodes) {
+		bytecode->run(context, entryPoint, entt::null);
+	}
+
+	uint64_t executedInstructions = 0;
+	for (const auto &bytecode : bytecodes) {
+		executedInstructions -= bytecode->getNumExecutedInstructions();
+	}
+
+	const uint64_t allocationsBefore = numAllocations.load();
+	for (auto _ : state) {
+		for (const auto &bytecode : bytecodes) {
+			bytecode->run(context, entryPoint, entt::null);
+		}
+	}
+	const uint64_t allocations = numAllocations.load() - allocationsBefore;
+
+	for (const auto &bytecode : bytecodes) {
+		executedInstructions += bytecode->getNumExecutedInstructions();
+	}
+
+	state.SetItemsProcessed(state.iterations() * bytecodes.size());
+	state.counters["instructions"] = benchmark::Counter(executedInstructions, benchmark::Counter::kIsRate);
+	state.counters["allocations"] = benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+}
+
+static void BM_ScriptRunSynthetic(benchmark::State &state) {
+	runScripts(state, createSyntheticScript(state.range(0)), "OnInit");
+}
+BENCHMARK(BM_ScriptRunSynthetic)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_ScriptRunGenerated(benchmark::State &state, DataGen::Generator::Game game) {
+	runScripts(state, getGeneratedScripts(game), "OnUpdate");
+}
+BENCHMARK_CAPTURE(BM_ScriptRunGenerated, alanWake, DataGen::Generator::kAlanWake);
+BENCHMARK_CAPTURE(BM_ScriptRunGenerated, nightmare, DataGen::Generator::kNightmare);
+
+static void BM_ScriptDecode(benchmark::State &state) {
+	const ScriptData data = createSyntheticScript(state.range(0));
+
+	size_t numInstructions = 0;
+	for (auto _ : state) {
+		// Collections cache their programs, so every iteration needs a new one to decode the script again
+		state.PauseTiming();
+		auto collection = std::make_unique<AWE::Script::Collection>(createStream(data.bytecode), createStream(data.parameters));
+		state.ResumeTiming();
+
+		std::unique_ptr<AWE::Script::Bytecode> bytecode(collection->createScript(data.scripts[0]));
+		numInstructions = bytecode->getNumInstructions();
+
+		state.PauseTiming();
+		bytecode.reset();
+		collection.reset();
+		state.ResumeTiming();
+	}
+
+	state.counters["instructions"] = benchmark::Counter(
+			state.iterations() * numInstructions,
+			benchmark::Counter::kIsRate
+	);
+}
+BENCHMARK(BM_ScriptDecode)->Arg(256)->Arg(4096);
@@ -0,0 +1,54 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/video/codecs/theora.h"
+
+static void BM_TheoraDecodeYUV420(benchmark::State &state) {
+	const unsigned int width = state.range(0);
+	const unsigned int height = state.range(1);
+
+	std::mt19937 random(1);
+	std::vector<byte> y(width * height), cb(width * height / 4), cr(width * height / 4);
+	for (auto *plane : {&y, &cb, &cr}) {
+		for (auto &value : *plane) {
+			value = random() & 0xFFu;
+		}
+	}
+
+	th_ycbcr_buffer ycbcr;
+	ycbcr[0] = {static_cast<int>(width), static_cast<int>(height), static_cast<int>(width), y.data()};
+	ycbcr[1] = {static_cast<int>(width / 2), static_cast<int>(height / 2), static_cast<int>(width / 2), cb.data()};
+	ycbcr[2] = {static_cast<int>(width / 2), static_cast<int>(height / 2), static_cast<int>(width / 2), cr.data()};
+
+	std::vector<byte> rgb(width * height * 3);
+	for (auto _ : state) {
+		Video::Theora::decodeYUV420(ycbcr, 0, 0, width, height, rgb.data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * width * height);
+	state.SetBytesProcessed(state.iterations() * rgb.size());
+}
+BENCHMARK(BM_TheoraDecodeYUV420)->ArgNames({"width", "height"})->Args({640, 360})->Args({1280, 720});
@@ -0,0 +1,63 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_BENCH_BENCHDATA_H
+#define OPENAWE_BENCH_BENCHDATA_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "src/common/memreadstream.h"
+
+#include "src/datagen/generator.h"
+
+/*!
+ * Get the synthetic data of a game, which is generated with the small scale
+ * on first use and shared by all benchmarks
+ *
+ * \param game the game whose formats the data should use
+ * \return the generated files by their path
+ */
+inline const DataGen::Generator::Resources &getResources(DataGen::Generator::Game game) {
+	static std::map<DataGen::Generator::Game, DataGen::Generator::Resources> resources;
+
+	auto iter = resources.find(game);
+	if (iter == resources.end()) {
+		DataGen::Scale scale{};
+		DataGen::Generator::getScale("small", scale);
+
+		DataGen::Generator generator(scale, 1);
+		iter = resources.emplace(game, generator.generateResources(game)).first;
+	}
+
+	return iter->second;
+}
+
+/*!
+ * Create a stream over data without taking ownership of it
+ * \param data the data to read from
+ * \return the newly created stream
+ */
+inline Common::ReadStream *createStream(const std::vector<byte> &data) {
+	return new Common::MemoryReadStream(const_cast<byte *>(data.data()), data.size(), false);
+}
+
+#endif //OPENAWE_BENCH_BENCHDATA_H
@@ -29,13 +29,17 @@ int main(int argc, char** argv) {
 	if (!game.parseArguments(argc, argv))
 		return EXIT_SUCCESS;
 
+	int result = EXIT_SUCCESS;
 	try {
 		game.init();
 		game.start();
 	} catch (const std::exception &e) {
 		spdlog::critical(e.what());
-		return EXIT_FAILURE;
+		result = EXIT_FAILURE;
 	}
 
-	return EXIT_SUCCESS;
+	// Flush the log messages, which might still be queued in the asynchronous logger
+	spdlog::shutdown();
+
+	return result;
 }
@@ -18,4 +18,31 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <memory>
+#include <vector>
+
+#include <zlib.h>
+
 #include "archive.h"
+
+namespace AWE {
+
+bool Archive::getResourceHash(const std::string &rid, uint32_t &hash) const {
+	std::unique_ptr<Common::ReadStream> resource(getResource(rid));
+	if (!resource)
+		return false;
+
+	hash = crc32(0L, Z_NULL, 0);
+
+	std::vector<byte> buffer(65536);
+	while (!resource->eos()) {
+		const size_t length = resource->read(buffer.data(), buffer.size());
+		if (length == 0)
+			break;
+		hash = crc32(hash, buffer.data(), length);
+	}
+
+	return true;
+}
+
+} // End of namespace AWE
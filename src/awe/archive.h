@@ -58,6 +58,17 @@ public:
 	 * \return if the resource specified by rid exists
 	 */
 	virtual bool hasResource(const std::string &rid) const = 0;
+
+	/*!
+	 * Get a hash of the contents of a resource, which changes whenever
+	 * the resource changes. The default implementation reads the whole
+	 * resource and calculates its crc32.
+	 *
+	 * \param rid the path to the resource
+	 * \param hash the variable in which the hash is stored
+	 * \return if the resource specified by rid exists
+	 */
+	virtual bool getResourceHash(const std::string &rid, uint32_t &hash) const;
 };
 
 } // End of namespace AWE
@@ -23,17 +23,18 @@
 #include <src/common/memreadstream.h>
 #include "src/common/zlib.h"
 #include "src/common/readstream.h"
+#include "src/common/profiler.h"
 
 #include "binarchive.h"
 #include "resman.h"
 
 namespace AWE {
 
-BINArchive::BINArchive(Common::ReadStream &bin) {
+BINArchive::BINArchive(Common::ReadStream &bin) : _memory(Common::kMemoryArchives) {
 	load(bin);
 }
 
-BINArchive::BINArchive(const std::string &resource) {
+BINArchive::BINArchive(const std::string &resource) : _memory(Common::kMemoryArchives) {
 	std::unique_ptr<Common::ReadStream> bin(ResMan.getResource(resource));
 
 	load(*bin);
@@ -59,6 +60,7 @@ Common::ReadStream *BINArchive::getResource(const std::string &rid) const {
 }
 
 void BINArchive::load(Common::ReadStream &bin) {
+	PROFILE_ZONE("BINArchive::load");
 	bin.seek(0, Common::ReadStream::END);
 	unsigned int fileSize = bin.pos();
 	bin.seek(0);
@@ -89,6 +91,8 @@ void BINArchive::load(Common::ReadStream &bin) {
 			compressedSize,
 			decompressedSize
 	));
+
+	_memory.resize(decompressedSize + _fileEntries.size() * sizeof(FileEntry));
 }
 
 bool BINArchive::hasResource(const std::string &rid) const {
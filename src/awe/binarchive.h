@@ -26,6 +26,7 @@
 
 #include "archive.h"
 
+#include "src/common/memorytracker.h"
 #include "src/common/readstream.h"
 
 namespace AWE {
@@ -67,6 +68,8 @@ private:
 	std::vector<FileEntry> _fileEntries;
 
 	std::unique_ptr<Common::ReadStream> _data;
+
+	Common::TrackedMemory _memory;
 };
 
 } // End of namespace AWE
@@ -25,13 +25,16 @@
 #include "src/common/strutil.h"
 
 #include "src/awe/cidfile.h"
+#include "src/common/profiler.h"
 
 static const uint32_t kDeadBeef   = 0xDEADBEEF;
 static const uint32_t kDeadBeefV2 = 0xD34DB33F;
 
 namespace AWE {
 
-CIDFile::CIDFile(Common::ReadStream &cid, ObjectType type, std::shared_ptr<DPFile> dp) : _dp(dp) {
+CIDFile::CIDFile(Common::ReadStream &cid, ObjectType type, std::shared_ptr<DPFile> dp) : _dp(dp), _memory(Common::kMemoryContainers) {
+	PROFILE_ZONE("CIDFile::CIDFile");
+	const size_t start = cid.pos();
 	uint32_t version = cid.readUint32LE();
 	uint32_t contentType = cid.readUint32LE(); // ?
 	uint32_t numElements = cid.readUint32LE();
@@ -49,6 +52,9 @@ CIDFile::CIDFile(Common::ReadStream &cid, ObjectType type, std::shared_ptr<DPFil
 	for (auto &container : _containers) {
 		container = _objectStream->readObject(type, version);
 	}
+
+	// The decoded containers are roughly as large as their serialized data
+	_memory.resize(cid.pos() - start + _containers.size() * sizeof(Object));
 }
 
 const std::vector<Object> &CIDFile::getContainers() const {
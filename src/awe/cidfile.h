@@ -28,6 +28,7 @@
 #include <glm/vec3.hpp>
 #include <glm/detail/type_quat.hpp>
 
+#include "src/common/memorytracker.h"
 #include "src/common/readstream.h"
 
 #include "src/awe/dpfile.h"
@@ -67,6 +68,8 @@ private:
 
 	std::shared_ptr<DPFile> _dp;
 	std::vector<Object> _containers;
+
+	Common::TrackedMemory _memory;
 };
 
 } // End of namespace AWE
@@ -20,6 +20,10 @@
 
 #include <iostream>
 #include <algorithm>
+#include <cstring>
+
+#include "src/common/memreadstream.h"
+
 #include "dpfile.h"
 
 DPFile::DPFile(Common::ReadStream *dp) : _dp(dp) {
@@ -58,41 +62,45 @@ DPFile::DPFile(Common::ReadStream *dp) : _dp(dp) {
 		offset = _dp->readUint32LE();
 	}
 
-	for (const auto &item : _stringOffsets) {
-		bool overlap = (item & 0x80u) != 0;
-
-		int32_t offset = item >> 8u;
+	// Sort the offsets, so that they can be looked up with a binary search
+	std::sort(_valueOffsets.begin(), _valueOffsets.end());
+	std::sort(_stringOffsets.begin(), _stringOffsets.end());
 
-		_dp->seek(-static_cast<int>(_dataSize) + offset * 8, Common::ReadStream::END);
-		if (overlap)
-			_dp->skip(4);
+	// Keep the data section in memory, strings are directly referenced from it
+	_data.resize(_dataSize);
+	_dp->seek(-static_cast<int>(_dataSize), Common::ReadStream::END);
+	_dp->read(_data.data(), _dataSize);
 
-		std::string s = _dp->readNullTerminatedString();
-	}
+	// Every further access only needs the data section, so replace the original stream with a view of it
+	_dp = std::make_unique<Common::MemoryReadStream>(_data.data(), _data.size(), false);
 }
 
-bool DPFile::hasString(uint32_t offset) {
-	return std::find(_stringOffsets.begin(), _stringOffsets.end(), offset) != _stringOffsets.end();
+bool DPFile::hasString(uint32_t offset) const {
+	return std::binary_search(_stringOffsets.begin(), _stringOffsets.end(), offset);
 }
 
-std::string DPFile::getString(uint32_t offset) {
+std::string_view DPFile::getString(uint32_t offset) const {
 	if ((offset & 0x000000FFu) == 0)
-		return "";
+		return {};
 
-	if (std::find(std::begin(_stringOffsets), std::end(_stringOffsets), offset) == _stringOffsets.end())
-		return "";
+	if (!hasString(offset))
+		return {};
 
 	bool overlap = (offset & 0x80u) != 0;
 
-	int32_t relativeOffset = offset >> 8u;
-
-	_dp->seek(-static_cast<int>(_dataSize) + relativeOffset * 8, Common::ReadStream::END);
+	size_t relativeOffset = (offset >> 8u) * 8;
 	if (overlap)
-		_dp->skip(4);
+		relativeOffset += 4;
 
-	std::string string = _dp->readNullTerminatedString();
+	if (relativeOffset >= _data.size())
+		return {};
+
+	const char *string = reinterpret_cast<const char *>(_data.data() + relativeOffset);
+	return {string, strnlen(string, _data.size() - relativeOffset)};
+}
 
-	return string;
+Common::Atom DPFile::getAtom(uint32_t offset) const {
+	return Atoms.intern(getString(offset));
 }
 
 std::vector<uint32_t> DPFile::getValues(uint32_t offset, unsigned int count) {
@@ -103,7 +111,7 @@ std::vector<uint32_t> DPFile::getValues(uint32_t offset, unsigned int count) {
 	if (overlap)
 		relativeOffset += 4;
 
-	if (std::find(std::begin(_valueOffsets), std::end(_valueOffsets), relativeOffset) == _valueOffsets.end())
+	if (!std::binary_search(_valueOffsets.begin(), _valueOffsets.end(), static_cast<uint32_t>(relativeOffset)))
 		return values;
 
 	_dp->seek(-static_cast<int>(_dataSize) + relativeOffset, Common::ReadStream::END);
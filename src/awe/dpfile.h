@@ -22,8 +22,10 @@
 #define AWE_DPFILE_H
 
 #include <memory>
+#include <string_view>
 #include <vector>
 
+#include "src/common/atomtable.h"
 #include "src/common/readstream.h"
 
 #include "src/awe/types.h"
@@ -64,8 +66,31 @@ public:
 	 */
 	explicit DPFile(Common::ReadStream *dp);
 
-	bool hasString(uint32_t offset);
-	std::string getString(uint32_t offset);
+	/*!
+	 * Check if the offset points to a string in the dp file
+	 * \param offset the offset to check
+	 * \return if a string exists at the offset
+	 */
+	bool hasString(uint32_t offset) const;
+
+	/*!
+	 * Get a string from the dp file. The returned view points directly into
+	 * the data of the dp file and is only valid as long as the dp file exists
+	 *
+	 * \param offset the offset of the string
+	 * \return a view of the string or an empty view if there is no string at the offset
+	 */
+	std::string_view getString(uint32_t offset) const;
+
+	/*!
+	 * Get an interned string from the dp file. In contrast to getString, the
+	 * resulting atom stays valid after the dp file is destroyed
+	 *
+	 * \param offset the offset of the string
+	 * \return the atom of the string or the empty atom if there is no string at the offset
+	 */
+	Common::Atom getAtom(uint32_t offset) const;
+
 	std::vector<uint32_t> getValues(uint32_t offset, unsigned int count);
 	std::vector<glm::vec2> getPositions2D(uint32_t offset, unsigned int count);
 	std::vector<ScriptMetadata> getScriptMetadata(uint32_t offset, unsigned int count);
@@ -90,6 +115,7 @@ private:
 
 	uint32_t _dataSize;
 
+	std::vector<byte> _data;
 	std::vector<uint32_t> _bytecodeOffsets;
 	std::vector<uint32_t> _valueOffsets;
 	std::vector<uint32_t> _stringOffsets;
@@ -18,40 +18,103 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <regex>
+#include <algorithm>
 
-#include "src/common/strutil.h"
 #include "src/common/endianness.h"
 
 #include "gidregistryfile.h"
 
 namespace AWE {
 
+static bool parseDecimal(const char *&pos, const char *end, uint32_t &value) {
+	const char *start = pos;
+
+	value = 0;
+	while (pos < end && *pos >= '0' && *pos <= '9') {
+		value = value * 10 + (*pos - '0');
+		++pos;
+	}
+
+	return pos != start;
+}
+
+static bool parseHexadecimal(const char *&pos, const char *end, uint32_t &value) {
+	const char *start = pos;
+
+	value = 0;
+	while (pos < end) {
+		const char c = *pos;
+		if (c >= '0' && c <= '9')
+			value = (value << 4) | (c - '0');
+		else if (c >= 'a' && c <= 'f')
+			value = (value << 4) | (c - 'a' + 10);
+		else if (c >= 'A' && c <= 'F')
+			value = (value << 4) | (c - 'A' + 10);
+		else
+			break;
+		++pos;
+	}
+
+	return pos != start;
+}
+
 GIDRegistryFile::GIDRegistryFile(Common::ReadStream &gid) {
-	const std::regex comma(",");
+	gid.seek(0, Common::ReadStream::END);
+	_data.resize(gid.pos());
+	gid.seek(0);
+	gid.read(_data.data(), _data.size());
+
+	parse();
+}
+
+void GIDRegistryFile::parse() {
+	const char *begin = _data.data();
+	const char *end = begin + _data.size();
+	const char *pos = begin;
+
+	while (pos < end) {
+		const char *lineEnd = std::find(pos, end, '\n');
 
-	while (!gid.eos()) {
-		std::string line = gid.readLine();
+		Entry entry{};
+		bool valid = parseDecimal(pos, lineEnd, entry.gid.type);
+		valid = valid && pos < lineEnd && *pos++ == ',';
+		valid = valid && parseHexadecimal(pos, lineEnd, entry.gid.id);
+		valid = valid && pos < lineEnd && *pos++ == ',';
 
-		std::vector<std::string> split = Common::split(line, comma);
-		GID newGid;
-		newGid.type = std::stoi(split[0]);
-		newGid.id = std::stoul(Common::toLower(split[1]), nullptr, 16);
-		newGid.id = Common::swapBytes(newGid.id);
+		if (valid) {
+			const char *nameEnd = std::find(pos, lineEnd, ',');
+			if (nameEnd > pos && *(nameEnd - 1) == '\r')
+				--nameEnd;
 
-		_strings[newGid] = split[2];
+			entry.gid.id = Common::swapBytes(entry.gid.id);
+			entry.offset = pos - begin;
+			entry.length = nameEnd - pos;
+
+			_entries.emplace_back(entry);
+		}
+
+		pos = lineEnd + 1;
 	}
+
+	// Sort stable, so that of duplicate gids the last one in the file is found last
+	std::stable_sort(_entries.begin(), _entries.end(), [](const Entry &a, const Entry &b) {
+		return a.gid < b.gid;
+	});
 }
 
 std::string GIDRegistryFile::getString(GID gid) const {
 	if (gid.type == 0 && gid.id == 0)
 		return "";
 
-	auto string = _strings.find(gid);
-	if (string == _strings.end())
+	const auto entry = std::upper_bound(_entries.begin(), _entries.end(), gid, [](const GID &gid, const Entry &entry) {
+		return gid < entry.gid;
+	});
+
+	// Take the last entry with the given gid, like a later line would have overwritten an earlier one
+	if (entry == _entries.begin() || std::prev(entry)->gid != gid)
 		return "";
 
-	return string->second;
+	return _data.substr(std::prev(entry)->offset, std::prev(entry)->length);
 }
 
 }
@@ -21,7 +21,8 @@
 #ifndef AWE_GIDREGISTRYFILE_H
 #define AWE_GIDREGISTRYFILE_H
 
-#include <map>
+#include <string>
+#include <vector>
 
 #include "src/common/readstream.h"
 
@@ -29,14 +30,36 @@
 
 namespace AWE {
 
+/*!
+ * \brief Reader for GIDRegistry.txt files
+ *
+ * GIDRegistry.txt files map gids to human readable names. Each line consists
+ * of the decimal gid type, the hexadecimal gid id and the name, separated by
+ * commas. Since the names are only needed for debugging, the file is kept as
+ * a raw buffer and only the positions of the names are indexed. Names are
+ * materialized when they are actually requested.
+ */
 class GIDRegistryFile {
 public:
 	GIDRegistryFile(Common::ReadStream &gid);
 
+	/*!
+	 * Get the name of a gid
+	 * \param gid the gid to get the name for
+	 * \return the name of the gid or an empty string if the gid is not registered
+	 */
 	std::string getString(GID gid) const;
 
 private:
-	std::map<GID, std::string> _strings;
+	struct Entry {
+		GID gid;
+		uint32_t offset, length;
+	};
+
+	void parse();
+
+	std::string _data;
+	std::vector<Entry> _entries;
 };
 
 }
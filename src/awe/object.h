@@ -5,12 +5,14 @@
 #ifndef OPENAWE_OBJECT_H
 #define OPENAWE_OBJECT_H
 
+#include "src/common/atomtable.h"
+
 #include "src/awe/types.h"
 
 namespace AWE::Templates {
 
 struct Skeleton {
-	std::string name;
+	Common::Atom name;
 	uint32_t id;
 	rid_t rid;
 	GID gid;
@@ -18,7 +20,7 @@ struct Skeleton {
 
 struct SkeletonSetup {
 	GID rootBoneGid;
-	std::string identifier;
+	Common::Atom identifier;
 };
 
 struct CellInfo {
@@ -48,10 +50,10 @@ struct AnimationParameters {
 
 struct CharacterClass {
 	GID gid;
-	std::string name;
-	std::vector<std::string> baseClasses;
+	Common::Atom name;
+	std::vector<Common::Atom> baseClasses;
 	GID skeletonGid;
-	std::string parentName;
+	Common::Atom parentName;
 	float capsuleHeight;
 	float capsuleRadius;
 	float lethalDoseOfHitEnergy;
@@ -83,8 +85,8 @@ struct DynamicObject {
 	glm::mat3 rotation;
 	rid_t meshResource;
 	rid_t physicsResource;
-	std::string resourcePath;
-	std::string identifier;
+	Common::Atom resourcePath;
+	Common::Atom identifier;
 };
 
 struct ScriptVariables {
@@ -108,7 +110,7 @@ struct DynamicObjectScript {
 
 struct NotebookPage {
 	GID gid;
-	std::string name;
+	Common::Atom name;
 	uint32_t episodeNumber;
 	uint32_t id;
 	bool onlyInNightmare;
@@ -124,12 +126,12 @@ struct Animation {
 	GID skeletonGid;
 	uint32_t id;
 	rid_t rid;
-	std::string name;
+	Common::Atom name;
 };
 
 struct AreaTrigger {
 	GID gid;
-	std::string identifier;
+	Common::Atom identifier;
 	std::vector<glm::vec2> positions;
 };
 
@@ -206,7 +208,7 @@ struct PointLight {
 
 struct Trigger {
 	GID gid, gid2;
-	std::string localeString, identifier;
+	Common::Atom localeString, identifier;
 };
 
 struct FloatingScript {
@@ -224,8 +226,8 @@ struct Waypoint {
 
 struct TaskDefinition {
 	GID gid;
-	std::string name;
-	std::string cinematic;
+	Common::Atom name;
+	Common::Atom cinematic;
 	glm::mat3 rotation;
 	glm::vec3 position;
 	glm::mat3 rotationPlayer;
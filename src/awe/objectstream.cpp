@@ -110,9 +110,9 @@ Templates::DynamicObject ObjectBinaryReadStream::readDynamicObject(unsigned int
 	dynamicObject.position = readPosition();
 
 	dynamicObject.physicsResource = std::any_cast<rid_t>(readObject(kRID));
-	dynamicObject.resourcePath = _dp->getString(_stream.readUint32LE());
+	dynamicObject.resourcePath = _dp->getAtom(_stream.readUint32LE());
 	dynamicObject.meshResource = std::any_cast<rid_t>(readObject(kRID));
-	dynamicObject.identifier = _dp->getString(_stream.readUint32LE());
+	dynamicObject.identifier = _dp->getAtom(_stream.readUint32LE());
 
 	unsigned int unknown1 = _stream.readUint32LE();
 	unsigned int unknown2 = _stream.readUint32LE();
@@ -172,7 +172,7 @@ Templates::Animation ObjectBinaryReadStream::readAnimation(unsigned int version)
 	if (version == 17)
 		_stream.skip(1);
 
-	animation.name = _dp->getString(_stream.readUint32LE());
+	animation.name = _dp->getAtom(_stream.readUint32LE());
 
 	_stream.skip(15);
 
@@ -183,7 +183,7 @@ Templates::Skeleton ObjectBinaryReadStream::readSkeleton() {
 	Templates::Skeleton skeleton{};
 
 	skeleton.gid = readGID();
-	skeleton.name = _dp->getString(_stream.readUint32LE());
+	skeleton.name = _dp->getAtom(_stream.readUint32LE());
 
 	skeleton.rid = std::any_cast<rid_t>(readObject(kRID));
 
@@ -196,7 +196,7 @@ Templates::SkeletonSetup ObjectBinaryReadStream::readSkeletonSetup() {
 	Templates::SkeletonSetup skeletonSetup{};
 
 	skeletonSetup.rootBoneGid = readGID();
-	skeletonSetup.identifier = _dp->getString(_stream.readUint32LE());
+	skeletonSetup.identifier = _dp->getAtom(_stream.readUint32LE());
 
 	_stream.skip(7);
 
@@ -208,7 +208,7 @@ Templates::NotebookPage ObjectBinaryReadStream::readNotebookPage() {
 
 	notebookPage.gid = readGID();
 
-	notebookPage.name = _dp->getString(_stream.readUint32LE());
+	notebookPage.name = _dp->getAtom(_stream.readUint32LE());
 
 	// Probably GID?
 	_stream.skip(8);
@@ -323,21 +323,21 @@ Templates::CharacterClass ObjectBinaryReadStream::readCharacterClass(unsigned in
 	Templates::CharacterClass characterClass{};
 
 	characterClass.gid = readGID();
-	characterClass.name = _dp->getString(_stream.readUint32LE());
+	characterClass.name = _dp->getAtom(_stream.readUint32LE());
 
 	uint32_t numBaseClasses = 4;
 	if (version == 42)
 		numBaseClasses = _stream.readUint32LE();
 
 	for (int i = 0; i < numBaseClasses; ++i) {
-		const auto baseClass = _dp->getString(_stream.readUint32LE());
-		if (!baseClass.empty())
+		const auto baseClass = _dp->getAtom(_stream.readUint32LE());
+		if (baseClass != Common::kEmptyAtom)
 			characterClass.baseClasses.emplace_back(baseClass);
 	}
 
 	characterClass.skeletonGid = readGID();
 	if (version == 42) {
-		characterClass.parentName = _dp->getString(_stream.readUint32LE());
+		characterClass.parentName = _dp->getAtom(_stream.readUint32LE());
 		characterClass.capsuleHeight = _stream.readIEEEFloatLE();
 		characterClass.capsuleRadius = _stream.readIEEEFloatLE();
 		characterClass.lethalDoseOfHitEnergy = _stream.readIEEEFloatLE();
@@ -373,7 +373,7 @@ Templates::TaskDefinition ObjectBinaryReadStream::readTaskDefinition(unsigned in
 	 */
 	Templates::TaskDefinition taskDefinition{};
 
-	taskDefinition.name = _dp->getString(_stream.readUint32LE());
+	taskDefinition.name = _dp->getAtom(_stream.readUint32LE());
 
 	unsigned int count = _stream.readUint32LE();
 	uint32_t offset = _stream.readUint32LE();
@@ -407,7 +407,7 @@ Templates::TaskDefinition ObjectBinaryReadStream::readTaskDefinition(unsigned in
 		taskDefinition.playerCharacter.resize(3);
 		taskDefinition.playerCharacter[0] = readGID();
 		_stream.skip(8);
-		taskDefinition.cinematic = _dp->getString(_stream.readUint32LE());
+		taskDefinition.cinematic = _dp->getAtom(_stream.readUint32LE());
 		taskDefinition.playerCharacter[1] = readGID();
 		taskDefinition.playerCharacter[2] = readGID();
 	} else {
@@ -518,11 +518,11 @@ Templates::Trigger ObjectBinaryReadStream::readTrigger(unsigned int version) {
 
 	_stream.skip(4); // Priority?
 
-	trigger.identifier = _dp->getString(_stream.readUint32LE());
+	trigger.identifier = _dp->getAtom(_stream.readUint32LE());
 
 	_stream.skip(4);
 
-	trigger.localeString = _dp->getString(_stream.readUint32LE());
+	trigger.localeString = _dp->getAtom(_stream.readUint32LE());
 
 	_stream.skip(12);
 	unsigned int count = _stream.readUint32LE();
@@ -543,7 +543,7 @@ Templates::AreaTrigger ObjectBinaryReadStream::readAreaTrigger() {
 
 	uint32_t value1 = _stream.readUint32LE();
 
-	areaTrigger.identifier = _dp->getString(_stream.readUint32LE());
+	areaTrigger.identifier = _dp->getAtom(_stream.readUint32LE());
 
 	uint32_t numPositions = _stream.readUint32LE();
 	areaTrigger.positions = _dp->getPositions2D(_stream.readUint32LE(), numPositions);
@@ -557,7 +557,7 @@ Templates::TaskContent ObjectBinaryReadStream::readTaskContent() {
 	Templates::TaskContent taskContent{};
 
 	unsigned int value1 = _stream.readUint32LE();
-	std::string str1 = _dp->getString(_stream.readUint32LE());
+	std::string_view str1 = _dp->getString(_stream.readUint32LE());
 	unsigned int value2 = _stream.readUint32LE();
 
 	// List of rids
@@ -567,7 +567,7 @@ Templates::TaskContent ObjectBinaryReadStream::readTaskContent() {
 
 	// List of gids + 8byte padding
 	unsigned int value4 = _stream.readUint32LE();
-	std::string str3 = _dp->getString(_stream.readUint32LE());
+	std::string_view str3 = _dp->getString(_stream.readUint32LE());
 
 	// Unknown container
 	readObject(kAttachmentResources);
@@ -622,9 +622,9 @@ Templates::KeyFramedObject ObjectBinaryReadStream::readKeyFramedObject() {
 	keyFramedObject.position = readPosition();
 
 	keyFramedObject.physicsResource = std::any_cast<rid_t>(readObject(kRID));
-	std::string source = _dp->getString(_stream.readUint32LE());
+	std::string_view source = _dp->getString(_stream.readUint32LE());
 	keyFramedObject.meshResource = std::any_cast<rid_t>(readObject(kRID));
-	std::string name = _dp->getString(_stream.readUint32LE());
+	std::string_view name = _dp->getString(_stream.readUint32LE());
 	_stream.skip(8);
 	const uint32_t numRids = _stream.readUint32LE();
 	std::vector<rid_t> rids = _dp->getValues(_stream.readUint32LE(), numRids);
@@ -21,6 +21,9 @@
 #include <memory>
 #include <iostream>
 #include <filesystem>
+#include <fstream>
+
+#include <zlib.h>
 
 #include "src/common/readfile.h"
 
@@ -91,4 +94,25 @@ Common::ReadStream *RessourceManager::getResource(rid_t rid) {
 	return nullptr;
 }
 
+bool RessourceManager::getResourceHash(const std::string &path, uint32_t &hash) {
+	if (std::filesystem::is_regular_file(path)) {
+		std::ifstream file(path, std::ios::binary);
+
+		hash = crc32(0L, Z_NULL, 0);
+
+		std::vector<char> buffer(65536);
+		while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0)
+			hash = crc32(hash, reinterpret_cast<const Bytef *>(buffer.data()), file.gcount());
+
+		return true;
+	}
+
+	for (const auto &archive : _archives) {
+		if (archive->getResourceHash(path, hash))
+			return true;
+	}
+
+	return false;
+}
+
 } // End of namespace AWE
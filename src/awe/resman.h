@@ -54,6 +54,17 @@ public:
 
 	Common::ReadStream *getResource(rid_t rid);
 
+	/*!
+	 * Get a hash of the contents of the resource given by path. The hash
+	 * changes whenever the contents of the resource change, which allows
+	 * to detect outdated caches derived from the resource.
+	 *
+	 * \param path the path of the resource
+	 * \param hash the variable in which the hash is stored
+	 * \return if the resource exists
+	 */
+	bool getResourceHash(const std::string &path, uint32_t &hash);
+
 private:
 	std::vector<std::unique_ptr<RIDProvider>> _meta;
 	std::vector<std::unique_ptr<Archive>> _archives;
@@ -30,7 +30,7 @@
 
 namespace AWE {
 
-RMDPArchive::RMDPArchive(Common::ReadStream *bin, Common::ReadStream *rmdp) : _rmdp(rmdp) {
+RMDPArchive::RMDPArchive(Common::ReadStream *bin, Common::ReadStream *rmdp) : _rmdp(rmdp), _memory(Common::kMemoryArchives) {
 	_littleEndian = bin->readByte() == 0;
 
 	uint32_t version;
@@ -53,6 +53,8 @@ RMDPArchive::RMDPArchive(Common::ReadStream *bin, Common::ReadStream *rmdp) : _r
 			throw std::runtime_error(fmt::format("Unknown RMDP Archive version {}", version));
 	}
 
+	_memory.resize(_folderEntries.size() * sizeof(FolderEntry) + _fileEntries.size() * sizeof(FileEntry));
+
 	delete bin;
 }
 
@@ -61,55 +63,37 @@ size_t RMDPArchive::getNumResources() {
 }
 
 Common::ReadStream *RMDPArchive::getResource(const std::string &rid) const {
-	std::stringstream path(
-			std::regex_replace(
-					(_pathPrefix ? "d:/data/" : "") + rid,
-					std::regex("\\\\"),
-					"/"
-			)
-	);
-	std::string item;
-
-	FolderEntry folder = _folderEntries.front();
-
-	uint32_t nameHash = 0;
-
-	while (std::getline(path, item, '/')) {
-		nameHash = Common::crc32(Common::toLower(item));
-
-		if (path.eof())
-			break;
-
-		folder = _folderEntries[folder.nextLowerFolder];
+	const FileEntry *file = findFile(rid);
+	if (!file)
+		return nullptr;
 
-		while (nameHash != folder.nameHash) {
-			if (folder.nextNeighbourFolder == 0xFFFFFFFF)
-				return nullptr;
-			folder = _folderEntries[folder.nextNeighbourFolder];
-		}
+	byte *data = new byte[file->size];
+	{
+		// Resources can be requested from several threads, which share the rmdp stream
+		std::lock_guard<std::mutex> lock(_rmdpAccess);
+		_rmdp->seek(file->offset);
+		_rmdp->read(data, file->size);
 	}
 
-	if (folder.nextFile == 0xFFFFFFFF)
-		return nullptr;
-
-	FileEntry file = _fileEntries[folder.nextFile];
+	assert(crc32(0L, data, file->size) == file->fileDataHash);
 
-	while (file.nameHash != nameHash) {
-		if (file.nextFile == 0xFFFFFFFF)
-			return nullptr;
-		file = _fileEntries[file.nextFile];
-	}
+	return new Common::MemoryReadStream(data, file->size, true);
+}
 
-	byte *data = new byte[file.size];
-	_rmdp->seek(file.offset);
-	_rmdp->read(data, file.size);
+bool RMDPArchive::hasResource(const std::string &rid) const {
+	return findFile(rid) != nullptr;
+}
 
-	assert(crc32(0L, data, file.size) == file.fileDataHash);
+bool RMDPArchive::getResourceHash(const std::string &rid, uint32_t &hash) const {
+	const FileEntry *file = findFile(rid);
+	if (!file)
+		return false;
 
-	return new Common::MemoryReadStream(data, file.size, true);
+	hash = file->fileDataHash;
+	return true;
 }
 
-bool RMDPArchive::hasResource(const std::string &rid) const {
+const RMDPArchive::FileEntry *RMDPArchive::findFile(const std::string &rid) const {
 	std::stringstream path(
 			std::regex_replace(
 					(_pathPrefix ? "d:/data/" : "") + rid,
@@ -119,9 +103,9 @@ bool RMDPArchive::hasResource(const std::string &rid) const {
 	);
 	std::string item;
 
-	FolderEntry folder = _folderEntries.front();
+	const FolderEntry *folder = &_folderEntries.front();
 
-	uint32_t nameHash;
+	uint32_t nameHash = 0;
 
 	while (std::getline(path, item, '/')) {
 		nameHash = Common::crc32(Common::toLower(item));
@@ -129,27 +113,27 @@ bool RMDPArchive::hasResource(const std::string &rid) const {
 		if (path.eof())
 			break;
 
-		folder = _folderEntries[folder.nextLowerFolder];
+		folder = &_folderEntries[folder->nextLowerFolder];
 
-		while (nameHash != folder.nameHash) {
-			if (folder.nextNeighbourFolder == 0xFFFFFFFF)
-				return false;
-			folder = _folderEntries[folder.nextNeighbourFolder];
+		while (nameHash != folder->nameHash) {
+			if (folder->nextNeighbourFolder == 0xFFFFFFFF)
+				return nullptr;
+			folder = &_folderEntries[folder->nextNeighbourFolder];
 		}
 	}
 
-	if (folder.nextFile == 0xFFFFFFFF)
-		return false;
+	if (folder->nextFile == 0xFFFFFFFF)
+		return nullptr;
 
-	FileEntry file = _fileEntries[folder.nextFile];
+	const FileEntry *file = &_fileEntries[folder->nextFile];
 
-	while (file.nameHash != nameHash) {
-		if (file.nextFile == 0xFFFFFFFF)
-			return false;
-		file = _fileEntries[file.nextFile];
+	while (file->nameHash != nameHash) {
+		if (file->nextFile == 0xFFFFFFFF)
+			return nullptr;
+		file = &_fileEntries[file->nextFile];
 	}
 
-	return true;
+	return file;
 }
 
 void RMDPArchive::loadHeaderV2(Common::ReadStream *bin) {
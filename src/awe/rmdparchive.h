@@ -23,9 +23,12 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include "archive.h"
 
+#include "src/common/memorytracker.h"
+
 namespace AWE {
 
 /*!
@@ -80,6 +83,16 @@ public:
 	 */
 	[[nodiscard]] bool hasResource(const std::string &rid) const override;
 
+	/*!
+	 * Get the hash of the resource data, which is already stored in
+	 * the file entry and therefore doesn't need to read the resource
+	 *
+	 * \param rid the file to get the hash for
+	 * \param hash the variable in which the hash is stored
+	 * \return if the file given by rid exists inside this archive
+	 */
+	bool getResourceHash(const std::string &rid, uint32_t &hash) const override;
+
 private:
 	/*!
 	 * Load header version 2 used by Alan Wake
@@ -132,13 +145,25 @@ private:
 		uint64_t offset, size;
 	};
 
+	/*!
+	 * Find the file entry of a resource by following the folder
+	 * and file entries of the tree
+	 *
+	 * \param rid the virtual path to the resource
+	 * \return the file entry or nullptr if the resource doesn't exist
+	 */
+	const FileEntry *findFile(const std::string &rid) const;
+
 	bool _pathPrefix;
 	bool _littleEndian;
 
 	std::vector<FolderEntry> _folderEntries;
 	std::vector<FileEntry> _fileEntries;
 
+	mutable std::mutex _rmdpAccess;
 	std::unique_ptr<Common::ReadStream> _rmdp;
+
+	Common::TrackedMemory _memory;
 };
 
 } // End of namespace AWE
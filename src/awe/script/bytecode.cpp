@@ -18,277 +18,508 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <limits>
 #include <stdexcept>
 
 #include <spdlog/spdlog.h>
 #include <fmt/format.h>
 #include <src/awe/types.h>
+#include <src/common/log.h>
 
 #include "bytecode.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "tracer.h"
 
-enum Opcode {
-	kPush       = 0x01,
-	kPushGID    = 0x02,
-	kCallGlobal = 0x03,
-	kCallObject = 0x04,
-	kRet        = 0x0D,
-	kIntToFloat = 0x0E,
-	kSetMember  = 0x0F,
-	kGetMember  = 0x10,
-	kCmp        = 0x13,
-	kJmp        = 0x15,
-	kJmpIf      = 0x1A,
-	kLogAnd     = 0x1C,
-	kLogOr      = 0x1D,
-	kLogNot     = 0x1E,
-	kNeq        = 0x24,
-	kEq         = 0x25,
-};
+/*!
+ * The number of different targets for which a call instruction keeps a bound call site
+ */
+static const size_t kMaxBindingsPerCallSite = 4;
+
+// Dispatch through a table of labels with the gcc and clang extension for computed gotos or fall back to a switch
+#if defined(__GNUC__) || defined(__clang__)
+#	define VM_COMPUTED_GOTO
+#	define VM_DISPATCH() goto *kDispatchTable[ip->handler];
+#	define VM_CONTINUE() goto *kDispatchTable[ip->handler]
+#	define VM_CASE(handler) label_##handler:
+#else
+#	define VM_DISPATCH() switch (ip->handler)
+#	define VM_CONTINUE() continue
+#	define VM_CASE(handler) case handler:
+#endif
+
+#define VM_JUMP(target) { ip = (target); ++executed; VM_CONTINUE(); }
+#define VM_NEXT() VM_JUMP(ip + 1)
 
 namespace AWE::Script {
 
+Bytecode::Bytecode(ProgramPtr program) :
+	_program(std::move(program)),
+	_instructions(_program->getInstructions().data()),
+	_linked(false),
+	_executedInstructions(0) {
+	init();
+}
+
 Bytecode::Bytecode(Common::ReadStream *bytecode, const EntryPoints &entryPoints, std::shared_ptr<DPFile> parameters,
 				   const DebugEntries &debugEntries) :
-	_bytecode(bytecode),
-	_entryPoints(entryPoints),
-	_debugEntries(debugEntries),
-	_parameters(parameters) {
+	Bytecode([&]() {
+		std::unique_ptr<Common::ReadStream> stream(bytecode);
+		return std::make_shared<const Program>(*stream, entryPoints, *parameters, debugEntries);
+	}()) {
+}
+
+void Bytecode::init() {
+	const size_t numCallSites = _program->getCallSites().size();
+	_boundCallSites = std::make_unique<std::atomic<const CallSite *>[]>(numCallSites);
+	for (size_t i = 0; i < numCallSites; ++i) {
+		_boundCallSites[i].store(nullptr);
+	}
+	_callSiteBindings.resize(numCallSites);
+}
+
+const ProgramPtr &Bytecode::getProgram() const {
+	return _program;
 }
 
 bool Bytecode::hasEntryPoint(const std::string &entryPoint) {
-	return _entryPoints.find(entryPoint) != _entryPoints.end();
+	const EntryPoints &entryPoints = _program->getEntryPoints();
+	return entryPoints.find(entryPoint) != entryPoints.end();
+}
+
+void Bytecode::link(Context &context) {
+	const std::vector<GID> &gids = _program->getGIDs();
+	_linkedGIDs.resize(gids.size());
+	for (size_t i = 0; i < gids.size(); ++i) {
+		_linkedGIDs[i] = context.getEntityByGID(gids[i]);
+	}
+
+	// The bytecode isn't running while being linked, so the call sites bound so far can be dropped
+	const std::vector<Program::CallSite> &callSites = _program->getCallSites();
+	for (size_t i = 0; i < callSites.size(); ++i) {
+		_boundCallSites[i].store(nullptr);
+		_callSiteBindings[i].clear();
+	}
+	_bindings.clear();
+
+	for (size_t i = 0; i < callSites.size(); ++i) {
+		CallSite unbound;
+		if (callSites[i].method.atom != Common::kEmptyAtom)
+			bind(i, context.getFunctions(), callSites[i].object, callSites[i].method, unbound);
+	}
+
+	_linked = true;
+}
+
+void Bytecode::unlink() {
+	_linkedGIDs.clear();
+	_linked = false;
+}
+
+bool Bytecode::isLinked() const {
+	return _linked;
+}
+
+size_t Bytecode::getNumInstructions() const {
+	return _program->getNumInstructions();
+}
+
+uint64_t Bytecode::getNumExecutedInstructions() const {
+	return _executedInstructions.load(std::memory_order_relaxed);
 }
 
-void Bytecode::run(Context &context, const std::string &entryPoint, const entt::entity &caller) {
-	spdlog::debug("Starting script entry point {}", entryPoint);
-	auto entryPointIter = _entryPoints.find(entryPoint);
-	if (entryPointIter == _entryPoints.end()) {
+void Bytecode::run(Context &context, const std::string &entryPoint, const entt::entity &caller, CommandBuffer *commands,
+				   Common::Span<const Variable> arguments) {
+	LOG_DEBUG("Starting script entry point {}", entryPoint);
+	const EntryPoints &entryPoints = _program->getEntryPoints();
+	auto entryPointIter = entryPoints.find(entryPoint);
+	if (entryPointIter == entryPoints.end()) {
 		//spdlog::warn("Entry point {} not found", entryPoint);
 		return;
 	}
 
-	_bytecode->seek((*entryPointIter).second * 4);
-
-	_eq = false;
-	_gt = false;
-	_lt = false;
-
-	_stop = false;
-	while (!_stop) {
-		byte param1, param2, param3;
-
-		param1 = _bytecode->readByte();
-		param2 = _bytecode->readByte();
-		param3 = _bytecode->readByte();
-
-		auto opcode = Opcode(_bytecode->readByte());
-
-		switch (opcode) {
-			case kPush:       push(); break;
-			case kPushGID:    pushGID(context); break;
-			case kCallGlobal: callGlobal(context, caller, param1, param2); break;
-			case kCallObject: callObject(context, param1, param2); break;
-			case kRet:        ret(); break;
-			case kIntToFloat: intToFloat(); break;
-			case kSetMember:  setMember(param1); break;
-			case kGetMember:  getMember(param1); break;
-			case kCmp:        cmp(); break;
-			case kJmp:        jmp(); break;
-			case kJmpIf:      jmpIf(); break;
-			case kLogAnd:     logAnd(); break;
-			case kLogOr:      logOr(); break;
-			case kLogNot:     logNot(); break;
-			case kEq:         eq(); break;
-			case kNeq:        neq(); break;
-			default:
-				throw std::runtime_error(fmt::format("Unknown opcode {:x}", opcode));
-		}
+	Frame frame(context, caller, &entryPointIter->first, commands);
+	for (const auto &argument : arguments) {
+		frame.push(argument);
 	}
 
-	spdlog::trace("Finishing script");
+	execute(frame, _instructions + entryPointIter->second);
 }
 
-void Bytecode::push() {
-	uint32_t data = _bytecode->readUint32LE();
+void Bytecode::resume(Context &context, const Continuation &continuation, CommandBuffer *commands) {
+	if (continuation.program != _program)
+		throw std::runtime_error("Continuation was not suspended in the program of this bytecode");
+	if (continuation.instruction >= _program->getInstructions().size())
+		throw std::runtime_error(fmt::format("Invalid continuation instruction {}", continuation.instruction));
+
+	LOG_DEBUG("Resuming script at instruction {}", continuation.instruction);
 
-	if (_parameters->hasString(data)) {
-		_stack.push(_parameters->getString(data));
-		spdlog::trace("push \"{}\"", _parameters->getString(data));
-	} else {
-		_stack.push(data);
-		spdlog::trace("push {}", data);
+	Frame frame(context, continuation.caller, continuation.entryPoint, commands);
+	frame.gt = continuation.gt;
+	frame.lt = continuation.lt;
+	frame.eq = continuation.eq;
+	for (const auto &value : continuation.stack) {
+		frame.push(value);
 	}
+
+	execute(frame, _instructions + continuation.instruction);
 }
 
-void Bytecode::pushGID(Context &ctx) {
-	GID gid;
-	gid.type = _bytecode->readUint32LE();
-	gid.id = _bytecode->readUint32BE();
+void Bytecode::execute(Frame &frame, const Instruction *ip) {
+#ifdef VM_COMPUTED_GOTO
+	static const void *const kDispatchTable[] = {
+		&&label_kHandlerPush,
+		&&label_kHandlerPushString,
+		&&label_kHandlerPushGID,
+		&&label_kHandlerCallGlobal,
+		&&label_kHandlerCallObject,
+		&&label_kHandlerRet,
+		&&label_kHandlerIntToFloat,
+		&&label_kHandlerSetMember,
+		&&label_kHandlerGetMember,
+		&&label_kHandlerCmp,
+		&&label_kHandlerJmp,
+		&&label_kHandlerJmpIf,
+		&&label_kHandlerLogAnd,
+		&&label_kHandlerLogOr,
+		&&label_kHandlerLogNot,
+		&&label_kHandlerNeq,
+		&&label_kHandlerEq,
+		&&label_kHandlerInvalid,
+	};
+#endif
+
+	Profiler::ScriptZone zone(frame.context.getProfiler(), _program, frame.entryPoint, frame.caller);
+	uint64_t executed = 1;
+
+	while (true) {
+		VM_DISPATCH() {
+			VM_CASE(kHandlerPush)
+				push(frame, ip->operand);
+				VM_NEXT()
+
+			VM_CASE(kHandlerPushString)
+				pushString(frame, ip->operand);
+				VM_NEXT()
+
+			VM_CASE(kHandlerPushGID)
+				pushGID(frame, ip->operand);
+				VM_NEXT()
+
+			VM_CASE(kHandlerCallGlobal)
+				callGlobal(frame, ip->operand, ip->param1, ip->param2);
+				if (frame.suspension && suspend(frame, ip))
+					goto finish;
+				VM_NEXT()
+
+			VM_CASE(kHandlerCallObject)
+				callObject(frame, ip->operand, ip->param1, ip->param2);
+				if (frame.suspension && suspend(frame, ip))
+					goto finish;
+				VM_NEXT()
+
+			VM_CASE(kHandlerRet)
+				LOG_TRACE("ret");
+				goto finish;
+
+			VM_CASE(kHandlerIntToFloat)
+				intToFloat(frame);
+				VM_NEXT()
+
+			VM_CASE(kHandlerSetMember)
+				setMember(ip->param1);
+				VM_NEXT()
+
+			VM_CASE(kHandlerGetMember)
+				getMember(ip->param1);
+				VM_NEXT()
+
+			VM_CASE(kHandlerCmp)
+				cmp(frame);
+				VM_NEXT()
+
+			VM_CASE(kHandlerJmp)
+				LOG_TRACE("jmp {}", ip->operand);
+				VM_JUMP(_instructions + ip->operand)
+
+			VM_CASE(kHandlerJmpIf)
+				LOG_TRACE("jmp_if {}", ip->operand);
+				if (frame.eq)
+					VM_JUMP(_instructions + ip->operand)
+				VM_NEXT()
+
+			VM_CASE(kHandlerLogAnd)
+				logAnd(frame);
+				VM_NEXT()
+
+			VM_CASE(kHandlerLogOr)
+				logOr(frame);
+				VM_NEXT()
+
+			VM_CASE(kHandlerLogNot)
+				logNot(frame);
+				VM_NEXT()
+
+			VM_CASE(kHandlerNeq)
+				neq(frame);
+				VM_NEXT()
+
+			VM_CASE(kHandlerEq)
+				eq(frame);
+				VM_NEXT()
+
+			VM_CASE(kHandlerInvalid)
+				_executedInstructions.fetch_add(executed, std::memory_order_relaxed);
+				zone.setInstructions(executed);
+				throw std::runtime_error(fmt::format("Unknown opcode {:x}", ip->operand));
+		}
+	}
 
-	spdlog::trace("push_gid {} {:x}", gid.type, gid.id);
+finish:
+	_executedInstructions.fetch_add(executed, std::memory_order_relaxed);
+	zone.setInstructions(executed);
 
-	_stack.push(ctx.getEntityByGID(gid));
+	LOG_TRACE("Finishing script");
 }
 
-void Bytecode::callGlobal(Context &ctx, const entt::entity &caller, byte numArgs, byte retType) {
-	std::string object = std::get<std::string>(_stack.top());
-	_stack.pop();
-	std::string method = std::get<std::string>(_stack.top());
-	_stack.pop();
+bool Bytecode::suspend(Frame &frame, const Instruction *ip) {
+	const std::chrono::milliseconds delay = *frame.suspension;
+	frame.suspension.reset();
 
-	std::vector<Variable> arguments(numArgs);
-	for (auto &argument : arguments) {
-		if (_stack.empty())
-			break;
-
-		argument = _stack.top();
-		_stack.pop();
+	// The script can only be resumed through the entity it belongs to
+	Scheduler *scheduler = frame.context.getScheduler();
+	if (!scheduler || frame.caller == entt::null) {
+		spdlog::warn("Script can not be suspended for {}ms, continuing", delay.count());
+		return false;
 	}
 
-	std::optional<Variable> ret;
-	// Call caller object when "this" is used
-	if (object == "this")
-		ret = ctx.getFunctions().callObject(caller, method, arguments);
-	// If not call global object
+	auto continuation = std::make_shared<Continuation>(Continuation{
+		_program,
+		frame.caller,
+		frame.entryPoint,
+		static_cast<uint32_t>(ip - _instructions) + 1,
+		frame.gt, frame.lt, frame.eq,
+		std::vector<Variable>(frame.stack, frame.stack + frame.stackSize)
+	});
+
+	LOG_TRACE("Suspending script for {}ms", delay.count());
+
+	// Suspending modifies the scheduler, so it has to be deferred like every other modification
+	if (frame.commands)
+		frame.commands->add([scheduler, continuation, delay](){ scheduler->suspend(continuation, delay); });
 	else
-		ret = ctx.getFunctions().callGlobal(object, method, arguments);
+		scheduler->suspend(continuation, delay);
 
-	// Return variable if there is any
-	if (ret)
-		_stack.push(*ret);
+	return true;
+}
+
+void Bytecode::push(Frame &frame, uint32_t value) {
+	frame.push(value);
+	LOG_TRACE("push {}", value);
+}
 
-	spdlog::trace("call_global {} {}", numArgs, retType);
+void Bytecode::pushString(Frame &frame, Common::Atom atom) {
+	frame.push(String{atom});
+	LOG_TRACE("push \"{}\"", Atoms.getString(atom));
 }
 
-void Bytecode::callObject(Context &ctx, byte numArgs, byte retType) {
-	entt::entity entity = std::get<entt::entity>(_stack.top());
-	_stack.pop();
-	std::string method = std::get<std::string>(_stack.top());
-	_stack.pop();
-
-	std::vector<Variable> arguments(numArgs);
-	for (auto &argument : arguments) {
-		if (_stack.empty())
-			break;
-		argument = _stack.top();
-		_stack.pop();
+void Bytecode::pushGID(Frame &frame, uint32_t index) {
+	// If the bytecode is linked, take the entity from the side table as long as it is still alive
+	if (_linked) {
+		const entt::entity entity = _linkedGIDs[index];
+		if (frame.context.getRegistry().valid(entity)) {
+			LOG_TRACE("push_gid {}", static_cast<uint32_t>(entity));
+			frame.push(entity);
+			return;
+		}
 	}
 
-	auto ret = ctx.getFunctions().callObject(entity, method, arguments);
-	if (ret)
-		_stack.push(*ret);
+	const GID &gid = _program->getGIDs()[index];
 
-	spdlog::trace("call_object {} {}", numArgs, retType);
+	LOG_TRACE("push_gid {} {:x}", gid.type, gid.id);
+
+	// Stale entries in the side table are not refreshed here, since other frames may read it concurrently
+	frame.push(frame.context.getEntityByGID(gid));
 }
 
-void Bytecode::ret() {
-	_stop = true;
-	
-	spdlog::trace("ret");
+const Bytecode::CallSite *Bytecode::bind(uint32_t index, Functions &functions, String object, String method, CallSite &unbound) {
+	std::lock_guard<std::mutex> lock(_bindingAccess);
+
+	// Call instructions alternating between a few targets find their previous bindings again
+	std::vector<const CallSite *> &bindings = _callSiteBindings[index];
+	for (const CallSite *bound : bindings) {
+		if (bound->functions == &functions && bound->object == object && bound->method == method) {
+			_boundCallSites[index].store(bound, std::memory_order_release);
+			return bound;
+		}
+	}
+
+	CallSite site{};
+	site.global = _program->getCallSites()[index].global;
+	site.object = object;
+	site.method = method;
+	site.functions = &functions;
+
+	// Call the caller object when "this" is used and if not the global object
+	site.self = site.global && object.str() == "this";
+	if (site.global && !site.self)
+		site.function = functions.resolveGlobal(object.str(), method.str());
+	else
+		site.function = functions.resolveObject(method.str());
+
+	// Instructions with more targets are resolved on every call instead of growing without bound
+	if (bindings.size() >= kMaxBindingsPerCallSite) {
+		unbound = site;
+		return &unbound;
+	}
+
+	// Other frames may still use the previous call site, so it is kept alive until the bytecode is linked again
+	const CallSite *bound = &_bindings.emplace_back(site);
+	bindings.emplace_back(bound);
+	_boundCallSites[index].store(bound, std::memory_order_release);
+
+	return bound;
 }
 
-void Bytecode::intToFloat() {
-	uint32_t value = std::get<uint32_t>(_stack.top());
-	_stack.pop();
+void Bytecode::callGlobal(Frame &frame, uint32_t index, byte numArgs, byte retType) {
+	const String object = frame.pop().getString();
+	const String method = frame.pop().getString();
+
+	// Missing arguments are passed as 0
+	Variable arguments[std::numeric_limits<byte>::max()];
+	for (size_t i = 0; i < numArgs; ++i) {
+		arguments[i] = frame.empty() ? Variable() : frame.pop();
+	}
 
-	auto fValue = static_cast<float>(value);
-	std::memcpy(&value, &fValue, 4);
-	_stack.push(value);
+	Functions &functions = frame.context.getFunctions();
+	CallSite unbound;
+	const CallSite *site = _boundCallSites[index].load(std::memory_order_acquire);
+	if (!site || site->functions != &functions || site->object != object || site->method != method)
+		site = bind(index, functions, object, method, unbound);
 
-	spdlog::trace("int_to_float");
+	// Return variable if there is any
+	std::optional<Variable> ret;
+	if (site->function) {
+		Profiler::NativeZone zone(frame.context.getProfiler(), site->self ? Common::kEmptyAtom : object.atom, method.atom);
+		ret = functions.call(site->function, site->self ? frame.caller : entt::null, Common::Span<const Variable>(arguments, numArgs), frame.commands, &frame.suspension, &frame.context);
+		if (ret)
+			frame.push(*ret);
+	}
+
+	if (Tracer *tracer = frame.context.getTracer())
+		tracer->record(frame.caller, site->self ? frame.caller : entt::null, object, method, Common::Span<const Variable>(arguments, numArgs), site->function != nullptr, ret);
+
+	LOG_TRACE("call_global {} {}", numArgs, retType);
 }
 
-void Bytecode::setMember(byte id) {
-	const auto memberName = _debugEntries.find(id);
+void Bytecode::callObject(Frame &frame, uint32_t index, byte numArgs, byte retType) {
+	const entt::entity entity = frame.pop().getEntity();
+	const String method = frame.pop().getString();
 
-	// TODO
+	// Missing arguments are passed as 0
+	Variable arguments[std::numeric_limits<byte>::max()];
+	for (size_t i = 0; i < numArgs; ++i) {
+		arguments[i] = frame.empty() ? Variable() : frame.pop();
+	}
 
-	if (memberName != _debugEntries.end())
-		spdlog::trace("set_member {} {}", id, memberName->second);
-	else
-		spdlog::trace("set_member {}", id);
+	Functions &functions = frame.context.getFunctions();
+	CallSite unbound;
+	const CallSite *site = _boundCallSites[index].load(std::memory_order_acquire);
+	if (!site || site->functions != &functions || site->method != method)
+		site = bind(index, functions, String{Common::kEmptyAtom}, method, unbound);
+
+	std::optional<Variable> ret;
+	if (site->function) {
+		Profiler::NativeZone zone(frame.context.getProfiler(), Common::kEmptyAtom, method.atom);
+		ret = functions.call(site->function, entity, Common::Span<const Variable>(arguments, numArgs), frame.commands, &frame.suspension, &frame.context);
+		if (ret)
+			frame.push(*ret);
+	}
+
+	if (Tracer *tracer = frame.context.getTracer())
+		tracer->record(frame.caller, entity, String{Common::kEmptyAtom}, method, Common::Span<const Variable>(arguments, numArgs), site->function != nullptr, ret);
+
+	LOG_TRACE("call_object {} {}", numArgs, retType);
 }
 
-void Bytecode::getMember(byte id) {
-	const auto memberName = _debugEntries.find(id);
+void Bytecode::intToFloat(Frame &frame) {
+	const uint32_t value = frame.pop().getInt();
+	frame.push(static_cast<float>(value));
+
+	LOG_TRACE("int_to_float");
+}
+
+void Bytecode::setMember(byte id) {
+	const DebugEntries &debugEntries = _program->getDebugEntries();
+	const auto memberName = debugEntries.find(id);
 
 	// TODO
 
-	if (memberName != _debugEntries.end())
-		spdlog::trace("get_member {} {}", id, memberName->second);
+	if (memberName != debugEntries.end())
+		LOG_TRACE("set_member {} {}", id, memberName->second);
 	else
-		spdlog::trace("get_member {}", id);
+		LOG_TRACE("set_member {}", id);
 }
 
-void Bytecode::cmp() {
-	uint32_t value1 = std::get<uint32_t>(_stack.top());
-	_stack.pop();
-	uint32_t value2 = std::get<uint32_t>(_stack.top());
-	_stack.pop();
+void Bytecode::getMember(byte id) {
+	const DebugEntries &debugEntries = _program->getDebugEntries();
+	const auto memberName = debugEntries.find(id);
 
-	_eq = value1 == value2;
-	_gt = value1 > value2;
-	_lt = value1 < value2;
+	// TODO
 
-	spdlog::trace("cmp");
+	if (memberName != debugEntries.end())
+		LOG_TRACE("get_member {} {}", id, memberName->second);
+	else
+		LOG_TRACE("get_member {}", id);
 }
 
-void Bytecode::jmp() {
-	uint32_t offset = _bytecode->readUint32LE();
-	_bytecode->skip(offset * 4);
-
-	spdlog::trace("jmp {}", offset);
-}
+void Bytecode::cmp(Frame &frame) {
+	const uint32_t value1 = frame.pop().getInt();
+	const uint32_t value2 = frame.pop().getInt();
 
-void Bytecode::jmpIf() {
-	uint32_t offset = _bytecode->readUint32LE();
-	if (_eq)
-		_bytecode->skip(offset * 4);
+	frame.eq = value1 == value2;
+	frame.gt = value1 > value2;
+	frame.lt = value1 < value2;
 
-	spdlog::trace("jmp_if {}", offset);
+	LOG_TRACE("cmp");
 }
 
-void Bytecode::logAnd() {
-	bool value1 = std::get<uint32_t>(_stack.top()) != 0;
-	_stack.pop();
-	bool value2 = std::get<uint32_t>(_stack.top()) != 0;
-	_stack.pop();
+void Bytecode::logAnd(Frame &frame) {
+	const bool value1 = frame.pop().getInt() != 0;
+	const bool value2 = frame.pop().getInt() != 0;
 
-	_stack.push((value1 && value2) ? 1u : 0u);
+	frame.push((value1 && value2) ? 1u : 0u);
 
-	spdlog::trace("and");
+	LOG_TRACE("and");
 }
 
-void Bytecode::logOr() {
-	bool value1 = std::get<uint32_t>(_stack.top()) != 0;
-	_stack.pop();
-	bool value2 = std::get<uint32_t>(_stack.top()) != 0;
-	_stack.pop();
+void Bytecode::logOr(Frame &frame) {
+	const bool value1 = frame.pop().getInt() != 0;
+	const bool value2 = frame.pop().getInt() != 0;
 
-	_stack.push((value1 || value2) ? 1u : 0u);
+	frame.push((value1 || value2) ? 1u : 0u);
 
-	spdlog::trace("or");
+	LOG_TRACE("or");
 }
 
-void Bytecode::logNot() {
-	bool value = std::get<uint32_t>(_stack.top()) != 0;
-	_stack.pop();
+void Bytecode::logNot(Frame &frame) {
+	const bool value = frame.pop().getInt() != 0;
 
-	_stack.push(!value ? 1u : 0u);
+	frame.push(!value ? 1u : 0u);
 
-	spdlog::trace("not");
+	LOG_TRACE("not");
 }
 
-void Bytecode::neq() {
-	_stack.push(!_eq);
+void Bytecode::neq(Frame &frame) {
+	frame.push(!frame.eq);
 
-	spdlog::trace("neq");
+	LOG_TRACE("neq");
 }
 
-void Bytecode::eq() {
-	_stack.push(_eq);
+void Bytecode::eq(Frame &frame) {
+	frame.push(frame.eq);
 
-	spdlog::trace("eq");
+	LOG_TRACE("eq");
 }
 
 }
@@ -21,65 +21,261 @@
 #ifndef AWE_BYTECODE_H
 #define AWE_BYTECODE_H
 
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <map>
 #include <string>
 #include <memory>
-#include <stack>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <variant>
+#include <vector>
 
 #include "src/common/readstream.h"
+#include "src/common/span.h"
 
 #include "src/awe/dpfile.h"
 #include "src/awe/script/types.h"
 #include "src/awe/script/context.h"
+#include "src/awe/script/commandbuffer.h"
+#include "src/awe/script/program.h"
 
 namespace AWE::Script {
 
 class Bytecode;
 
 typedef std::shared_ptr<Bytecode> BytecodePtr;
-typedef std::map<std::string, uint32_t> EntryPoints;
-typedef std::map<uint32_t, std::string> DebugEntries;
 
+/*!
+ * \brief Interpreter for the bytecode of a script
+ *
+ * The bytecode runs the decoded program of a script, which can be shared
+ * with every other script using the same code. Executing a script only
+ * walks the instructions of the program and dispatches every instruction
+ * through a jump table, using computed gotos where the compiler supports
+ * them. Every call instruction has an inline cache holding the native
+ * function it was last bound to, which is only resolved by name again if
+ * the called names or the functions of the context change.
+ *
+ * The decoded bytecode is immutable while running, the state of every
+ * execution lives in its own frame. The same bytecode can therefore be run
+ * recursively, for example by custom events, and from multiple threads at
+ * once, as long as the native functions defer their modifications into a
+ * command buffer.
+ *
+ * A native function can ask to suspend the calling script for some time. The
+ * frame is then saved into a continuation, which is handed to the scheduler
+ * of the context and resumed at the instruction after the call once the time
+ * passed.
+ */
 class Bytecode : Common::Noncopyable {
 public:
+	/*!
+	 * \brief The saved frame of a suspended script
+	 */
+	struct Continuation {
+		ProgramPtr program; // Keeps the program and with it the entry point alive while suspended
+		entt::entity caller;
+		const std::string *entryPoint; // The entry point the script was started with, owned by the program
+		uint32_t instruction; // The index of the instruction to resume at
+		bool gt, lt, eq;
+		std::vector<Variable> stack;
+	};
+
+	/*!
+	 * Create a bytecode running a decoded program
+	 * \param program the program to run
+	 */
+	explicit Bytecode(ProgramPtr program);
+
+	/*!
+	 * Decode the bytecode of a script into a program of its own
+	 *
+	 * \param bytecode the stream containing the code, which is only used during construction
+	 * \param entryPoints the entry points of the script as offsets in 4 byte words
+	 * \param parameters the dp file containing the string constants
+	 * \param debugEntries the names of members
+	 */
 	Bytecode(Common::ReadStream *bytecode, const EntryPoints &entryPoints, std::shared_ptr<DPFile> parameters,
 			 const DebugEntries &debugEntries);
 
+	/*!
+	 * Get the decoded program run by this bytecode
+	 * \return the program of the bytecode
+	 */
+	const ProgramPtr &getProgram() const;
+
 	/*!
 	 * Check if a specific entry point is available
 	 * \param entryPoint the entry point to check for
 	 * \return if this entry point exists in this byte code
 	 */
 	bool hasEntryPoint(const std::string &entryPoint);
-	void run(Context &context, const std::string &entryPoint, const entt::entity &caller);
+
+	/*!
+	 * Run an entry point of the bytecode
+	 *
+	 * \param context the context to run the bytecode in
+	 * \param entryPoint the name of the entry point to run
+	 * \param caller the entity the script belongs to
+	 * \param commands the buffer native functions defer their modifications to or nullptr to apply them directly
+	 * \param arguments the values pushed onto the stack in the given order before running the entry point
+	 */
+	void run(
+			Context &context,
+			const std::string &entryPoint,
+			const entt::entity &caller,
+			CommandBuffer *commands = nullptr,
+			Common::Span<const Variable> arguments = {}
+	);
+
+	/*!
+	 * Resume a suspended script with its saved frame
+	 *
+	 * \param context the context to run the bytecode in
+	 * \param continuation the saved frame of the script, which must have been suspended in a bytecode of the same program
+	 * \param commands the buffer native functions defer their modifications to or nullptr to apply them directly
+	 */
+	void resume(Context &context, const Continuation &continuation, CommandBuffer *commands = nullptr);
+
+	/*!
+	 * Resolve every gid referenced by push_gid instructions once and store the resulting entities in a side table,
+	 * so that executing the instruction only needs a table lookup. Entities which are destroyed afterwards are
+	 * detected on execution and resolved again. Call sites whose names are pushed as constants directly before the
+	 * call are bound to their native functions as well. This must not be called while the bytecode is running
+	 *
+	 * \param context the context used to resolve the gids
+	 */
+	void link(Context &context);
+
+	/*!
+	 * Drop the side table of resolved gids, falling back to resolving them on every execution
+	 */
+	void unlink();
+
+	/*!
+	 * Check if the gid references of this bytecode are currently resolved
+	 * \return if the bytecode is linked
+	 */
+	bool isLinked() const;
+
+	/*!
+	 * Get the number of decoded instructions
+	 * \return the number of instructions of this bytecode
+	 */
+	size_t getNumInstructions() const;
+
+	/*!
+	 * Get the number of instructions executed by all runs of this bytecode so far
+	 * \return the number of executed instructions
+	 */
+	uint64_t getNumExecutedInstructions() const;
 
 private:
-	void push();
-	void pushGID(Context &ctx);
-	void callGlobal(Context &ctx, const entt::entity &caller, byte numArgs, byte retType);
-	void callObject(Context &ctx, byte numArgs, byte retType);
-	void ret();
-	void intToFloat();
+	typedef Program::Instruction Instruction;
+
+	/*!
+	 * \brief The native function a call instruction is bound to
+	 *
+	 * A call site is valid as long as the call is done with the same object
+	 * and method names and with the same functions it was bound for. The
+	 * object name is only used by call_global. Bound call sites are never
+	 * modified, since other frames may still use them. Every call instruction
+	 * keeps one for each of its last few targets until the bytecode is linked
+	 * again, further targets are resolved on every call.
+	 */
+	struct CallSite {
+		bool global;
+		bool self;
+		String object;
+		String method;
+		Functions *functions;
+		Functions::NativeFunction function;
+	};
+
+	/*!
+	 * \brief The state of a single execution of the bytecode
+	 *
+	 * The operand stack is stored inline with a fixed capacity, so running a
+	 * script doesn't allocate.
+	 */
+	struct Frame {
+		static constexpr size_t kStackSize = 64;
+
+		Frame(Context &context, entt::entity caller, const std::string *entryPoint, CommandBuffer *commands) :
+			context(context), caller(caller), entryPoint(entryPoint), commands(commands), gt(false), lt(false),
+			eq(false), stackSize(0) {
+		}
+
+		void push(Variable value) {
+			if (stackSize == kStackSize)
+				throw std::runtime_error("Script stack overflow");
+			stack[stackSize++] = value;
+		}
+
+		Variable pop() {
+			if (stackSize == 0)
+				throw std::runtime_error("Script stack underflow");
+			return stack[--stackSize];
+		}
+
+		bool empty() const {
+			return stackSize == 0;
+		}
+
+		Context &context;
+		const entt::entity caller;
+		const std::string *entryPoint;
+		CommandBuffer *commands;
+		bool gt, lt, eq;
+		size_t stackSize;
+		Variable stack[kStackSize];
+		std::optional<std::chrono::milliseconds> suspension;
+	};
+
+	void init();
+
+	void execute(Frame &frame, const Instruction *ip);
+	bool suspend(Frame &frame, const Instruction *ip);
+
+	/*!
+	 * Bind a call instruction to the native function of an object and method name
+	 * \param index the index of the call site
+	 * \param functions the native functions to bind to
+	 * \param object the name of the object, only used by call_global
+	 * \param method the name of the method
+	 * \param unbound storage for the call site, if the instruction already has too many bound targets
+	 * \return the bound call site or unbound
+	 */
+	const CallSite *bind(uint32_t index, Functions &functions, String object, String method, CallSite &unbound);
+
+	void push(Frame &frame, uint32_t value);
+	void pushString(Frame &frame, Common::Atom atom);
+	void pushGID(Frame &frame, uint32_t index);
+	void callGlobal(Frame &frame, uint32_t index, byte numArgs, byte retType);
+	void callObject(Frame &frame, uint32_t index, byte numArgs, byte retType);
+	void intToFloat(Frame &frame);
 	void setMember(byte id);
 	void getMember(byte id);
-	void cmp();
-	void jmp();
-	void jmpIf();
-	void logAnd();
-	void logOr();
-	void logNot();
-	void neq();
-	void eq();
-
-	bool _gt, _lt, _eq;
-
-	bool _stop;
-	std::unique_ptr<Common::ReadStream> _bytecode;
-	std::shared_ptr<DPFile> _parameters;
-	std::stack<Variable> _stack;
-	const EntryPoints _entryPoints;
-	const DebugEntries _debugEntries;
+	void cmp(Frame &frame);
+	void logAnd(Frame &frame);
+	void logOr(Frame &frame);
+	void logNot(Frame &frame);
+	void neq(Frame &frame);
+	void eq(Frame &frame);
+
+	const ProgramPtr _program;
+	const Instruction *const _instructions;
+
+	bool _linked;
+	std::vector<entt::entity> _linkedGIDs;
+	std::unique_ptr<std::atomic<const CallSite *>[]> _boundCallSites;
+	std::deque<CallSite> _bindings;
+	std::vector<std::vector<const CallSite *>> _callSiteBindings;
+	std::mutex _bindingAccess;
+	std::atomic<uint64_t> _executedInstructions;
 };
 
 } // End of namespace
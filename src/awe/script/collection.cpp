@@ -20,6 +20,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include "src/common/log.h"
 #include "src/awe/types.h"
 #include "src/awe/script/collection.h"
 
@@ -31,6 +32,15 @@ Collection::Collection(Common::ReadStream *bytecode, Common::ReadStream *bytecod
 }
 
 Bytecode *Collection::createScript(const AWE::Templates::ScriptVariables &script) {
+	return new Bytecode(getProgram(script));
+}
+
+ProgramPtr Collection::getProgram(const AWE::Templates::ScriptVariables &script) {
+	const ProgramKey key = getProgramKey(script);
+	const auto cached = _programs.find(key);
+	if (cached != _programs.end())
+		return cached->second;
+
 	std::vector<DPFile::ScriptDebugEntry> variableMappings = _bytecode->getScriptDebugEntries(script.offsetDebugEntries,
 																					   script.numDebugEntries);
 	std::vector<DPFile::ScriptMetadata> metadata = _bytecode->getScriptMetadata(script.offsetHandlers, script.numHandlers);
@@ -38,8 +48,8 @@ Bytecode *Collection::createScript(const AWE::Templates::ScriptVariables &script
 
 	EntryPoints entryPoints;
 	for (const auto &item : metadata) {
-		std::string handler = _bytecodeParameters->getString(item.name);
-		spdlog::debug("Add script entry point {}", handler);
+		std::string handler(_bytecodeParameters->getString(item.name));
+		LOG_DEBUG("Add script entry point {}", handler);
 
 		assert(item.offset <= script.codeSize);
 
@@ -47,23 +57,60 @@ Bytecode *Collection::createScript(const AWE::Templates::ScriptVariables &script
 	}
 
 	for (const auto &signal : signals) {
-		spdlog::debug("Add script signal {}", _bytecodeParameters->getString(signal.nameOffset));
+		LOG_DEBUG("Add script signal {}", _bytecodeParameters->getString(signal.nameOffset));
 	}
 
 	DebugEntries debugEntries;
 	for (const auto &debugEntry : variableMappings) {
-		std::string memberName = _bytecodeParameters->getString(debugEntry.nameOffset);
+		std::string memberName(_bytecodeParameters->getString(debugEntry.nameOffset));
 		debugEntries[debugEntry.id] = memberName;
 
-		spdlog::debug("Add debug entry {} for entry {}", _bytecodeParameters->getString(debugEntry.nameOffset), debugEntry.id);
+		LOG_DEBUG("Add debug entry {} for entry {}", _bytecodeParameters->getString(debugEntry.nameOffset), debugEntry.id);
 	}
 
 	assert(_bytecodeParameters);
 
-	return new Bytecode(
-	_bytecode->getStream(script.offsetCode, script.codeSize),
-	entryPoints,
-	_bytecodeParameters, debugEntries);
+	std::unique_ptr<Common::ReadStream> code(_bytecode->getStream(script.offsetCode, script.codeSize));
+	auto program = std::make_shared<const Program>(*code, entryPoints, *_bytecodeParameters, debugEntries);
+	_programs.emplace(key, program);
+
+	return program;
+}
+
+size_t Collection::getNumPrograms() const {
+	return _programs.size();
+}
+
+void Collection::save(Common::WriteStream &stream) const {
+	stream.writeUint32LE(_programs.size());
+	for (const auto &[key, program] : _programs) {
+		std::apply([&](auto... values) {
+			(stream.writeUint32LE(values), ...);
+		}, key);
+		program->save(stream);
+	}
+}
+
+void Collection::restore(Common::ReadStream &stream) {
+	const uint32_t numPrograms = stream.readUint32LE();
+	for (uint32_t i = 0; i < numPrograms; ++i) {
+		ProgramKey key;
+		std::apply([&](auto &... values) {
+			((values = stream.readUint32LE()), ...);
+		}, key);
+		_programs[key] = std::make_shared<const Program>(stream);
+	}
+}
+
+Collection::ProgramKey Collection::getProgramKey(const AWE::Templates::ScriptVariables &script) {
+	return ProgramKey(
+		script.offsetCode,
+		script.codeSize,
+		script.offsetHandlers,
+		script.numHandlers,
+		script.offsetDebugEntries,
+		script.numDebugEntries
+	);
 }
 
 }
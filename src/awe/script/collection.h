@@ -21,12 +21,15 @@
 #ifndef AWE_COLLECTION_H
 #define AWE_COLLECTION_H
 
+#include <map>
 #include <memory>
+#include <tuple>
 
 #include "src/awe/cidfile.h"
 #include "src/awe/dpfile.h"
 #include "src/awe/object.h"
 #include "src/awe/script/bytecode.h"
+#include "src/awe/script/program.h"
 
 namespace AWE::Script {
 
@@ -34,7 +37,10 @@ namespace AWE::Script {
  * \brief A collection of scripts
  *
  * A collection of scripts associated with an episode,
- * a level, a global world scope or the global scope
+ * a level, a global world scope or the global scope.
+ * The code of every script is decoded only once into a program, which is
+ * shared by all scripts referencing the same code and can be cached in
+ * snapshots.
  */
 class Collection {
 public:
@@ -42,9 +48,40 @@ public:
 
 	Bytecode *createScript(const AWE::Templates::ScriptVariables &script);
 
+	/*!
+	 * Get the decoded program of a script, decoding it if it is not cached yet
+	 * \param script the script variables referencing the code of the script
+	 * \return the program of the script
+	 */
+	ProgramPtr getProgram(const AWE::Templates::ScriptVariables &script);
+
+	/*!
+	 * Get the number of decoded programs
+	 * \return the number of programs in the cache
+	 */
+	size_t getNumPrograms() const;
+
+	/*!
+	 * Write all decoded programs, so that they don't have to be decoded again when restoring
+	 * \param stream the stream to write the programs to
+	 */
+	void save(Common::WriteStream &stream) const;
+
+	/*!
+	 * Add programs written with save to the cache
+	 * \param stream the stream to read the programs from
+	 */
+	void restore(Common::ReadStream &stream);
+
 private:
+	// The code, entry points and debug entries referenced by script variables
+	typedef std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t> ProgramKey;
+
+	static ProgramKey getProgramKey(const AWE::Templates::ScriptVariables &script);
+
 	std::unique_ptr<DPFile> _bytecode;
 	std::shared_ptr<DPFile> _bytecodeParameters;
+	std::map<ProgramKey, ProgramPtr> _programs;
 };
 
 }
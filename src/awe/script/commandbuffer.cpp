@@ -0,0 +1,43 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/awe/script/commandbuffer.h"
+
+namespace AWE::Script {
+
+void CommandBuffer::add(Command command) {
+	_commands.emplace_back(std::move(command));
+}
+
+void CommandBuffer::execute() {
+	// Commands may add new commands while being executed, which are executed afterwards
+	for (size_t i = 0; i < _commands.size(); ++i) {
+		Command command = std::move(_commands[i]);
+		command();
+	}
+
+	_commands.clear();
+}
+
+size_t CommandBuffer::size() const {
+	return _commands.size();
+}
+
+} // End of namespace AWE::Script
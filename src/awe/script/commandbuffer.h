@@ -0,0 +1,64 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_AWE_SCRIPT_COMMANDBUFFER_H
+#define OPENAWE_AWE_SCRIPT_COMMANDBUFFER_H
+
+#include <functional>
+#include <vector>
+
+namespace AWE::Script {
+
+typedef std::function<void()> Command;
+
+/*!
+ * \brief Buffer of deferred modifications of the game state
+ *
+ * Scripts running in parallel must not modify the registry or any other
+ * shared state. Native functions called by them record their modifications
+ * as commands instead, which are executed on a single thread after all
+ * scripts have finished.
+ */
+class CommandBuffer {
+public:
+	/*!
+	 * Add a command to the end of the buffer
+	 * \param command the command to defer
+	 */
+	void add(Command command);
+
+	/*!
+	 * Execute all commands in the order they were added and clear the buffer
+	 */
+	void execute();
+
+	/*!
+	 * Get the number of commands waiting to be executed
+	 * \return the number of commands in the buffer
+	 */
+	size_t size() const;
+
+private:
+	std::vector<Command> _commands;
+};
+
+} // End of namespace AWE::Script
+
+#endif // OPENAWE_AWE_SCRIPT_COMMANDBUFFER_H
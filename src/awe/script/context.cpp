@@ -20,22 +20,32 @@
 
 #include <spdlog/spdlog.h>
 
+#include "src/common/log.h"
+#include "src/awe/script/bytecode.h"
+
 #include "context.h"
 
 namespace AWE::Script {
 
-AWE::Script::Context::Context(entt::registry &registry, Functions &functions) : _registry(registry), _functions(functions) {
+AWE::Script::Context::Context(entt::registry &registry, Functions &functions) : _registry(registry), _functions(functions), _scheduler(nullptr), _profiler(nullptr), _tracer(nullptr) {
 }
 
 entt::entity AWE::Script::Context::getEntityByGID(const GID &gid) {
 	entt::entity result = entt::null;
-	auto gidView = _registry.view<GID>();
 
-	for (const auto &entity : gidView) {
-		GID gid2 = _registry.get<GID>(entity);
-		if (gid2 == gid) {
-			result = entity;
-			break;
+	if (!_gidIndex.empty()) {
+		const auto iter = _gidIndex.find(gid);
+		if (iter != _gidIndex.end())
+			result = iter->second;
+	} else {
+		auto gidView = _registry.view<GID>();
+
+		for (const auto &entity : gidView) {
+			GID gid2 = _registry.get<GID>(entity);
+			if (gid2 == gid) {
+				result = entity;
+				break;
+			}
 		}
 	}
 
@@ -45,8 +55,45 @@ entt::entity AWE::Script::Context::getEntityByGID(const GID &gid) {
 	return result;
 }
 
+void Context::linkScripts() {
+	// Build a temporary index of all gids, so that linking does not need to iterate all entities per reference
+	auto gidView = _registry.view<GID>();
+	for (const auto &entity : gidView) {
+		_gidIndex.emplace(_registry.get<GID>(entity), entity);
+	}
+
+	auto bytecodeView = _registry.view<BytecodePtr>();
+	for (const auto &entity : bytecodeView) {
+		_registry.get<BytecodePtr>(entity)->link(*this);
+	}
+
+	LOG_DEBUG("Linked {} scripts against {} gids", bytecodeView.size(), _gidIndex.size());
+
+	_gidIndex.clear();
+}
+
+entt::registry &Context::getRegistry() {
+	return _registry;
+}
+
 Functions &Context::getFunctions() {
 	return _functions;
 }
 
+void Context::setScheduler(Scheduler *scheduler) {
+	_scheduler = scheduler;
+}
+
+Scheduler *Context::getScheduler() {
+	return _scheduler;
+}
+
+void Context::setProfiler(Profiler *profiler) {
+	_profiler = profiler;
+}
+
+void Context::setTracer(Tracer *tracer) {
+	_tracer = tracer;
+}
+
 }
@@ -28,17 +28,72 @@
 
 namespace AWE::Script {
 
+class Profiler;
+class Scheduler;
+class Tracer;
+
 class Context {
 public:
 	Context(entt::registry &registry, Functions &functions);
 
 	entt::entity getEntityByGID(const GID &gid);
 
+	/*!
+	 * Link all scripts currently in the registry, resolving their gid references to entities. This should be called
+	 * every time objects got loaded or unloaded
+	 */
+	void linkScripts();
+
+	entt::registry &getRegistry();
 	Functions &getFunctions();
 
+	/*!
+	 * Set the scheduler which resumes suspended scripts
+	 * \param scheduler the scheduler or nullptr if scripts can not be suspended
+	 */
+	void setScheduler(Scheduler *scheduler);
+
+	/*!
+	 * Get the scheduler which resumes suspended scripts
+	 * \return the scheduler or nullptr if scripts can not be suspended
+	 */
+	Scheduler *getScheduler();
+
+	/*!
+	 * Set the profiler measuring scripts and native functions
+	 * \param profiler the profiler or nullptr to disable profiling
+	 */
+	void setProfiler(Profiler *profiler);
+
+	/*!
+	 * Get the profiler measuring scripts and native functions
+	 * \return the profiler or nullptr if profiling is disabled
+	 */
+	Profiler *getProfiler() {
+		return _profiler;
+	}
+
+	/*!
+	 * Set the tracer recording the native functions called by scripts
+	 * \param tracer the tracer or nullptr to disable tracing
+	 */
+	void setTracer(Tracer *tracer);
+
+	/*!
+	 * Get the tracer recording the native functions called by scripts
+	 * \return the tracer or nullptr if tracing is disabled
+	 */
+	Tracer *getTracer() {
+		return _tracer;
+	}
+
 private:
 	Functions &_functions;
+	Scheduler *_scheduler;
+	Profiler *_profiler;
+	Tracer *_tracer;
 	entt::registry &_registry;
+	std::map<GID, entt::entity> _gidIndex;
 	std::map<std::string, Functions> _globalObjects;
 };
 
@@ -0,0 +1,140 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#include "src/common/profiler.h"
+#include "src/common/threadpool.h"
+
+#include "src/awe/script/bytecode.h"
+#include "src/awe/script/commandbuffer.h"
+#include "src/awe/script/dispatcher.h"
+
+namespace AWE::Script {
+
+static const size_t kBatchSize = 32;
+
+namespace {
+
+/*!
+ * The state of a single dispatch, which is shared with the worker threads.
+ * Workers only picking up their task after all batches are done still
+ * access this state, so they keep it alive instead of the dispatcher.
+ */
+struct Dispatch {
+	std::string entryPoint;
+	std::vector<std::pair<entt::entity, BytecodePtr>> scripts;
+	std::vector<CommandBuffer> commands;
+	std::vector<std::exception_ptr> errors;
+
+	std::atomic<size_t> nextBatch{0};
+	size_t finishedBatches{0};
+	std::mutex finishedAccess;
+	std::condition_variable finished;
+};
+
+}
+
+static void runBatches(Dispatch &dispatch, Context &context) {
+	const size_t numBatches = dispatch.commands.size();
+
+	size_t batch;
+	while ((batch = dispatch.nextBatch.fetch_add(1)) < numBatches) {
+		PROFILE_ZONE("Dispatcher::runBatch");
+
+		const size_t begin = batch * kBatchSize;
+		const size_t end = std::min(begin + kBatchSize, dispatch.scripts.size());
+
+		try {
+			for (size_t i = begin; i < end; ++i) {
+				const auto &script = dispatch.scripts[i];
+				script.second->run(context, dispatch.entryPoint, script.first, &dispatch.commands[batch]);
+			}
+		} catch (...) {
+			dispatch.errors[batch] = std::current_exception();
+		}
+
+		std::lock_guard<std::mutex> lock(dispatch.finishedAccess);
+		if (++dispatch.finishedBatches == numBatches)
+			dispatch.finished.notify_all();
+	}
+}
+
+Dispatcher::Dispatcher(Context &context) : _context(context) {
+}
+
+void Dispatcher::run(const std::string &entryPoint) {
+	auto bytecodeView = _context.getRegistry().view<BytecodePtr>();
+	run(std::vector<entt::entity>(bytecodeView.begin(), bytecodeView.end()), entryPoint);
+}
+
+void Dispatcher::run(const std::vector<entt::entity> &entities, const std::string &entryPoint) {
+	PROFILE_ZONE("Dispatcher::run");
+
+	auto dispatch = std::make_shared<Dispatch>();
+	dispatch->entryPoint = entryPoint;
+
+	// Collect the scripts up front, so that the workers don't need to access the registry for it
+	entt::registry &registry = _context.getRegistry();
+	for (const auto &entity : entities) {
+		const auto *bytecode = registry.try_get<BytecodePtr>(entity);
+		if (bytecode && (*bytecode)->hasEntryPoint(entryPoint))
+			dispatch->scripts.emplace_back(entity, *bytecode);
+	}
+
+	const size_t numBatches = (dispatch->scripts.size() + kBatchSize - 1) / kBatchSize;
+	if (numBatches == 0)
+		return;
+
+	dispatch->commands.resize(numBatches);
+	dispatch->errors.resize(numBatches);
+
+	// The calling thread works on the batches as well, so only start as many workers as there are remaining batches
+	const size_t numWorkers = std::min(Threads.getNumThreads(), numBatches - 1);
+	Context &context = _context;
+	for (size_t i = 0; i < numWorkers; ++i) {
+		Threads.add([dispatch, &context]() {
+			runBatches(*dispatch, context);
+		});
+	}
+
+	runBatches(*dispatch, _context);
+
+	std::unique_lock<std::mutex> lock(dispatch->finishedAccess);
+	dispatch->finished.wait(lock, [&]() {
+		return dispatch->finishedBatches == numBatches;
+	});
+	lock.unlock();
+
+	// Apply the modifications in the order of the scripts, stopping at the first batch which failed
+	for (size_t i = 0; i < numBatches; ++i) {
+		dispatch->commands[i].execute();
+
+		if (dispatch->errors[i])
+			std::rethrow_exception(dispatch->errors[i]);
+	}
+}
+
+} // End of namespace AWE::Script
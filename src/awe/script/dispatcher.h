@@ -0,0 +1,67 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_AWE_SCRIPT_DISPATCHER_H
+#define OPENAWE_AWE_SCRIPT_DISPATCHER_H
+
+#include <string>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "src/awe/script/context.h"
+
+namespace AWE::Script {
+
+/*!
+ * \brief Runs an entry point of many scripts in parallel
+ *
+ * The scripts are split into batches which are executed on the thread pool
+ * and the calling thread. Every batch defers the modifications of its
+ * scripts into its own command buffer. After all batches have finished, the
+ * command buffers are executed in the order of the batches, so the result
+ * does not depend on how the batches were scheduled.
+ */
+class Dispatcher {
+public:
+	Dispatcher(Context &context);
+
+	/*!
+	 * Run an entry point on every entity with a script which has this entry point
+	 *
+	 * \param entryPoint the name of the entry point to run
+	 */
+	void run(const std::string &entryPoint);
+
+	/*!
+	 * Run an entry point on the scripts of the given entities. Entities without the entry point are skipped
+	 *
+	 * \param entities the entities to run the scripts of
+	 * \param entryPoint the name of the entry point to run
+	 */
+	void run(const std::vector<entt::entity> &entities, const std::string &entryPoint);
+
+private:
+	Context &_context;
+};
+
+} // End of namespace AWE::Script
+
+#endif // OPENAWE_AWE_SCRIPT_DISPATCHER_H
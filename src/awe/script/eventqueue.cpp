@@ -0,0 +1,143 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "src/common/profiler.h"
+
+#include "src/awe/script/eventqueue.h"
+
+namespace AWE::Script {
+
+EventQueue::EventQueue(Context &context) : _context(context), _budget(0), _nextSequence(0) {
+}
+
+bool EventQueue::post(entt::entity entity, const std::string &entryPoint, std::vector<Variable> arguments) {
+	const auto *bytecode = _context.getRegistry().try_get<BytecodePtr>(entity);
+	if (!bytecode || !(*bytecode)->hasEntryPoint(entryPoint))
+		return false;
+
+	const ProgramPtr &program = (*bytecode)->getProgram();
+	const BatchKey key(program.get(), entryPoint);
+	auto batch = _batchIndex.find(key);
+	if (batch == _batchIndex.end()) {
+		_batches.emplace_back(Batch{program, entryPoint, {}});
+		batch = _batchIndex.emplace(key, std::prev(_batches.end())).first;
+	}
+
+	batch->second->events.emplace_back(Event{
+		_nextSequence++,
+		entity,
+		*bytecode,
+		std::move(arguments),
+		std::chrono::steady_clock::now()
+	});
+
+	_metrics.depth++;
+	_metrics.peakDepth = std::max(_metrics.peakDepth, _metrics.depth);
+	PROFILE_COUNTER("EventQueue::depth", _metrics.depth);
+
+	return true;
+}
+
+size_t EventQueue::update() {
+	PROFILE_ZONE("EventQueue::update");
+
+	const auto start = std::chrono::steady_clock::now();
+
+	// Events posted by the events of this update wait for the next one
+	const uint64_t lastSequence = _nextSequence;
+
+	size_t processed = 0;
+	std::chrono::steady_clock::duration totalLatency(0), maxLatency(0);
+	bool outOfTime = false;
+
+	auto batch = _batches.begin();
+	while (batch != _batches.end() && !outOfTime) {
+		while (!batch->events.empty() && batch->events.front().sequence < lastSequence) {
+			// Take the event out first, running it may post new events into the same batch
+			const Event event = std::move(batch->events.front());
+			batch->events.pop_front();
+			_metrics.depth--;
+
+			const auto now = std::chrono::steady_clock::now();
+			totalLatency += now - event.posted;
+			maxLatency = std::max(maxLatency, now - event.posted);
+
+			// The entity might have been destroyed since the event was posted
+			if (_context.getRegistry().valid(event.entity)) {
+				try {
+					event.bytecode->run(_context, batch->entryPoint, event.entity, nullptr, event.arguments);
+				} catch (std::exception &e) {
+					spdlog::error("Error while running {}: {}", batch->entryPoint, e.what());
+				}
+			}
+
+			processed++;
+
+			if (_budget.count() > 0 && std::chrono::steady_clock::now() - start >= _budget) {
+				outOfTime = true;
+				break;
+			}
+		}
+
+		if (batch->events.empty()) {
+			_batchIndex.erase(BatchKey(batch->program.get(), batch->entryPoint));
+			batch = _batches.erase(batch);
+		} else if (!outOfTime) {
+			++batch;
+		}
+	}
+
+	_metrics.processed = processed;
+	_metrics.totalProcessed += processed;
+	_metrics.time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	_metrics.averageLatency = std::chrono::duration_cast<std::chrono::microseconds>(
+			totalLatency / std::max<int64_t>(processed, 1)
+	);
+	_metrics.maxLatency = std::chrono::duration_cast<std::chrono::microseconds>(maxLatency);
+	PROFILE_COUNTER("EventQueue::depth", _metrics.depth);
+
+	return processed;
+}
+
+void EventQueue::setTimeBudget(std::chrono::microseconds budget) {
+	_budget = budget;
+}
+
+std::chrono::microseconds EventQueue::getTimeBudget() const {
+	return _budget;
+}
+
+size_t EventQueue::size() const {
+	return _metrics.depth;
+}
+
+bool EventQueue::empty() const {
+	return _metrics.depth == 0;
+}
+
+const EventQueue::Metrics &EventQueue::getMetrics() const {
+	return _metrics;
+}
+
+} // End of namespace AWE::Script
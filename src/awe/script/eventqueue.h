@@ -0,0 +1,153 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_AWE_SCRIPT_EVENTQUEUE_H
+#define OPENAWE_AWE_SCRIPT_EVENTQUEUE_H
+
+#include <chrono>
+#include <deque>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "src/awe/script/bytecode.h"
+#include "src/awe/script/context.h"
+#include "src/awe/script/types.h"
+
+namespace AWE::Script {
+
+/*!
+ * \brief Queue of script events executed within a time budget per frame
+ *
+ * Events are entry points to run on the script of an entity. They are
+ * batched by the program of their script and their entry point, so that the
+ * events of entities sharing the same code run one after another, each one
+ * with the bytecode of its own entity. Batches run in the order their first event was
+ * posted and the events of a batch in the order they were posted. Every
+ * update runs events until the time budget is used up, the remaining events
+ * are carried over to the next update. Events posted while updating are
+ * only run by the next update.
+ */
+class EventQueue {
+public:
+	/*!
+	 * \brief Statistics about the queue
+	 */
+	struct Metrics {
+		// The number of waiting events and the highest number so far
+		size_t depth{0};
+		size_t peakDepth{0};
+
+		// The number of events run by the last update and so far
+		size_t processed{0};
+		uint64_t totalProcessed{0};
+
+		// The time spent in the last update
+		std::chrono::microseconds time{0};
+
+		// The average and longest time the events run by the last update waited in the queue
+		std::chrono::microseconds averageLatency{0};
+		std::chrono::microseconds maxLatency{0};
+	};
+
+	EventQueue(Context &context);
+
+	/*!
+	 * Post an event for the script of an entity. This is not thread safe, scripts running in parallel have to post
+	 * their events through their command buffer
+	 *
+	 * \param entity the entity whose script should run the event
+	 * \param entryPoint the entry point to run
+	 * \param arguments the values pushed onto the stack before running the entry point
+	 * \return if the entity has a script with this entry point, otherwise the event is dropped
+	 */
+	bool post(entt::entity entity, const std::string &entryPoint, std::vector<Variable> arguments = {});
+
+	/*!
+	 * Run waiting events until the queue is empty or the time budget is used up. At least one event is run per
+	 * update, so that the queue always makes progress
+	 *
+	 * \return the number of events run
+	 */
+	size_t update();
+
+	/*!
+	 * Set the time events may run per update
+	 * \param budget the time budget, zero runs all waiting events on every update
+	 */
+	void setTimeBudget(std::chrono::microseconds budget);
+
+	/*!
+	 * Get the time events may run per update
+	 * \return the time budget, zero if unlimited
+	 */
+	std::chrono::microseconds getTimeBudget() const;
+
+	/*!
+	 * Get the number of waiting events
+	 * \return the number of events in the queue
+	 */
+	size_t size() const;
+
+	/*!
+	 * Check if events are waiting to be run
+	 * \return if the queue is empty
+	 */
+	bool empty() const;
+
+	/*!
+	 * Get the statistics of the queue
+	 * \return the metrics of the queue
+	 */
+	const Metrics &getMetrics() const;
+
+private:
+	struct Event {
+		uint64_t sequence;
+		entt::entity entity;
+		BytecodePtr bytecode;
+		std::vector<Variable> arguments;
+		std::chrono::steady_clock::time_point posted;
+	};
+
+	struct Batch {
+		ProgramPtr program;
+		std::string entryPoint;
+		std::deque<Event> events;
+	};
+
+	typedef std::pair<const Program *, std::string> BatchKey;
+
+	Context &_context;
+	std::chrono::microseconds _budget;
+
+	uint64_t _nextSequence;
+	std::list<Batch> _batches;
+	std::map<BatchKey, std::list<Batch>::iterator> _batchIndex;
+
+	Metrics _metrics;
+};
+
+} // End of namespace AWE::Script
+
+#endif // OPENAWE_AWE_SCRIPT_EVENTQUEUE_H
@@ -18,6 +18,8 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
+
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 
@@ -27,43 +29,79 @@
 
 namespace AWE::Script {
 
-Functions::Functions(entt::registry &registry) : _registry(registry) {
+Functions::Functions(entt::registry &registry) :
+	_registry(registry),
+	_eventQueue(nullptr),
+	_random(std::chrono::system_clock::now().time_since_epoch().count()) {
 
 }
 
-std::optional<Variable> Functions::callObject(entt::entity object, const std::string &functionName, std::vector<Variable> parameters) {
-	Context ctx{
-		object,
-		*this,
-		parameters
-	};
+void Functions::setSeed(uint32_t seed) {
+	std::lock_guard<std::mutex> lock(_randomAccess);
+	_random.seed(seed);
+}
+
+std::optional<Variable> Functions::callObject(entt::entity object, const std::string &functionName, Common::Span<const Variable> parameters) {
+	auto fun = resolveObject(functionName);
+	if (!fun)
+		return {};
 
-	auto fun = getFunction(functionName);
-	if (fun)
-		fun(ctx);
-	else
+	return call(fun, object, parameters);
+}
+
+std::optional<Variable> Functions::callGlobal(const std::string &name,const std::string &functionName, Common::Span<const Variable> parameters) {
+	auto fun = resolveGlobal(name, functionName);
+	if (!fun)
+		return {};
+
+	return call(fun, entt::null, parameters);
+}
+
+Functions::NativeFunction Functions::resolveObject(std::string_view functionName) {
+	auto fun = getFunction(std::string(functionName));
+	if (!fun)
 		spdlog::warn("TODO: Implement object script functions {}", functionName);
 
-	return ctx.ret;
+	return fun;
 }
 
-std::optional<Variable> Functions::callGlobal(const std::string &name,const std::string &functionName, std::vector<Variable> parameters) {
+Functions::NativeFunction Functions::resolveGlobal(std::string_view className, std::string_view functionName) {
+	const std::string globalFunctionName = fmt::format("{}.{}", Common::toUpper(std::string(className)), functionName);
+	auto fun = getFunction(globalFunctionName);
+	if (!fun)
+		spdlog::warn("TODO: Implement global script functions {}", globalFunctionName);
+
+	return fun;
+}
+
+std::optional<Variable> Functions::call(NativeFunction function, entt::entity object, Common::Span<const Variable> parameters, CommandBuffer *commands,
+								 std::optional<std::chrono::milliseconds> *suspension, AWE::Script::Context *script) {
 	Context ctx{
-			entt::null,
-			*this,
-			parameters
+		object,
+		*this,
+		commands,
+		parameters,
+		std::nullopt,
+		std::nullopt,
+		script
 	};
 
-	const std::string globalFunctionName = fmt::format("{}.{}", Common::toUpper(name), functionName);
-	auto fun = getFunction(globalFunctionName);
-	if (fun)
-		fun(ctx);
-	else
-		spdlog::warn("TODO: Implement global script functions {}", globalFunctionName);
+	function(ctx);
+
+	if (suspension)
+		*suspension = ctx.suspension;
 
 	return ctx.ret;
 }
 
+void Functions::setEventQueue(EventQueue *eventQueue) {
+	_eventQueue = eventQueue;
+}
+
+EventQueue *Functions::getEventQueue() {
+	return _eventQueue;
+}
+
 Functions::NativeFunction Functions::getFunction(const std::string &name) {
 	auto func = _functions.find(name);
 	if (func == _functions.end())
@@ -21,19 +21,90 @@
 #ifndef OPENAWE_FUNCTIONS_H
 #define OPENAWE_FUNCTIONS_H
 
-#include <functional>
+#include <chrono>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <random>
+#include <string_view>
+
+#include "src/common/span.h"
 
 #include "types.h"
+#include "commandbuffer.h"
 
 namespace AWE::Script {
 
+class Context;
+class EventQueue;
+
 class Functions {
+protected:
+	struct Context;
+
 public:
+	typedef void (*NativeFunction)(Context &);
+
 	Functions(entt::registry &registry);
 
+	/*!
+	 * Resolve the native function implementing an object method, taking
+	 * engine specific functions into account. This is meant to be done once
+	 * per call site, the returned function can then be called with call
+	 *
+	 * \param functionName the name of the method
+	 * \return the native function or nullptr if it is not implemented
+	 */
+	NativeFunction resolveObject(std::string_view functionName);
+
+	/*!
+	 * Resolve the native function implementing a global object method,
+	 * taking engine specific functions into account
+	 *
+	 * \param className the name of the global object
+	 * \param functionName the name of the method
+	 * \return the native function or nullptr if it is not implemented
+	 */
+	NativeFunction resolveGlobal(std::string_view className, std::string_view functionName);
+
+	/*!
+	 * Seed the random number generator used by the random functions of scripts, so that runs can be reproduced
+	 * \param seed the seed of the random number generator
+	 */
+	void setSeed(uint32_t seed);
+
+	/*!
+	 * Set the queue into which events sent by scripts are posted
+	 * \param eventQueue the event queue or nullptr to run events directly
+	 */
+	void setEventQueue(EventQueue *eventQueue);
+
+	/*!
+	 * Get the queue into which events sent by scripts are posted
+	 * \return the event queue or nullptr if events are run directly
+	 */
+	EventQueue *getEventQueue();
+
+	/*!
+	 * Call a previously resolved native function
+	 *
+	 * \param function the function to call, which must not be nullptr
+	 * \param object the object to call the function for or entt::null for global functions
+	 * \param parameters
+	 * \param commands the buffer to defer modifications to or nullptr to apply them directly
+	 * \param suspension receives the time the function asked to suspend the calling script for, if not nullptr
+	 * \param script the context of the calling script or nullptr if not called by a script
+	 * \return the return value of the function if any
+	 */
+	std::optional<Variable> call(
+			NativeFunction function,
+			entt::entity object,
+			Common::Span<const Variable> parameters,
+			CommandBuffer *commands = nullptr,
+			std::optional<std::chrono::milliseconds> *suspension = nullptr,
+			AWE::Script::Context *script = nullptr
+	);
+
 	/*!
 	 * Call an object with a certain function and optionally return a value
 	 *
@@ -45,7 +116,7 @@ public:
 	std::optional<Variable> callObject(
 			entt::entity object,
 			const std::string &functionName,
-			std::vector<Variable> parameters
+			Common::Span<const Variable> parameters
 	);
 
 	/*!
@@ -59,30 +130,52 @@ public:
 	std::optional<Variable> callGlobal(
 			const std::string &className,
 			const std::string &functionName,
-			std::vector<Variable> parameters
+			Common::Span<const Variable> parameters
 	);
 
 protected:
 	struct Context {
 		entt::entity thisEntity;
 		Functions &functions;
-		std::vector<Variable> parameters;
+		CommandBuffer *commands;
+		Common::Span<const Variable> parameters;
 		std::optional<Variable> ret;
+		std::optional<std::chrono::milliseconds> suspension;
+		AWE::Script::Context *script;
+
+		/*!
+		 * Execute a modification of the registry or other shared state, or defer it if the script runs in parallel
+		 * to others. Native functions have to modify the game state only through this
+		 */
+		void defer(Command command) {
+			if (commands)
+				commands->add(std::move(command));
+			else
+				command();
+		}
+
+		/*!
+		 * Suspend the calling script after this function returned and resume it once the delay passed. If the
+		 * script can not be suspended, it continues right away
+		 */
+		void suspend(std::chrono::milliseconds delay) {
+			suspension = delay;
+		}
 
 		float getFloat(size_t index) {
-			return reinterpret_cast<float&>(std::get<uint32_t>(parameters[index]));
+			return parameters.at(index).getFloat();
 		}
 
 		int getInt(size_t index) {
-			return reinterpret_cast<int32_t&>(std::get<uint32_t>(parameters[index]));
+			return static_cast<int32_t>(parameters.at(index).getInt());
 		}
 
 		entt::entity getEntity(size_t index) {
-			return std::get<entt::entity>(parameters[index]);
+			return parameters.at(index).getEntity();
 		}
 
-		std::string getString(size_t index) {
-			return std::get<std::string>(parameters[index]);
+		std::string_view getString(size_t index) {
+			return parameters.at(index).getString().str();
 		}
 
 		template<typename T> T& getFunctions() {
@@ -90,11 +183,14 @@ protected:
 		}
 	};
 
-	typedef std::function<void(Context &)> NativeFunction;
-
 	virtual NativeFunction getFunction(const std::string &name);
 
 	entt::registry &_registry;
+	EventQueue *_eventQueue;
+
+	// Shared by all scripts, which can run in parallel
+	std::mt19937 _random;
+	std::mutex _randomAccess;
 
 private:
 	// functions_object.cpp
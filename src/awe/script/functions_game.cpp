@@ -18,9 +18,7 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <cstring>
-
-#include <chrono>
+#include <mutex>
 #include <random>
 
 #include "src/awe/script/functions.h"
@@ -29,12 +27,8 @@ namespace AWE::Script {
 
 void Functions::getRand01(Functions::Context &ctx) {
     std::uniform_real_distribution<float> distribution(0.0, 1.0);
-    std::mt19937 generator(std::chrono::system_clock::now().time_since_epoch().count());
-
-    uint32_t value;
-    float fValue = distribution(generator);
-    std::memcpy(&fValue, &value, 4);
-    ctx.ret = value;
+    std::lock_guard<std::mutex> lock(ctx.functions._randomAccess);
+    ctx.ret = distribution(ctx.functions._random);
 }
 
 void Functions::getRand(Functions::Context &ctx) {
@@ -42,13 +36,8 @@ void Functions::getRand(Functions::Context &ctx) {
     float lowerBound = ctx.getFloat(1);
 
     std::uniform_real_distribution<float> distribution(lowerBound, upperBound);
-    std::mt19937 generator(std::chrono::system_clock::now().time_since_epoch().count());
-
-    uint32_t value;
-    float fValue = distribution(generator);
-    std::memcpy(&fValue, &value, 4);
-
-    ctx.ret = value;
+    std::lock_guard<std::mutex> lock(ctx.functions._randomAccess);
+    ctx.ret = distribution(ctx.functions._random);
 }
 
 void Functions::getRandInt(Functions::Context &ctx) {
@@ -56,9 +45,8 @@ void Functions::getRandInt(Functions::Context &ctx) {
     uint32_t lowerBound = ctx.getInt(1);
 
     std::uniform_int_distribution<uint32_t> distribution(lowerBound, upperBound);
-    std::mt19937 generator(std::chrono::system_clock::now().time_since_epoch().count());
-
-    ctx.ret = distribution(generator);
+    std::lock_guard<std::mutex> lock(ctx.functions._randomAccess);
+    ctx.ret = distribution(ctx.functions._random);
 }
 
 }
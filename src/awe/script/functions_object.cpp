@@ -22,12 +22,13 @@
 
 #include "src/awe/script/functions.h"
 #include "src/awe/script/bytecode.h"
+#include "src/awe/script/eventqueue.h"
 
 namespace AWE::Script {
 
 void Functions::sendCustomEvent(Context &ctx) {
 	const entt::entity caller = ctx.thisEntity;
-	const std::string eventName = ctx.getString(0);
+	const std::string eventName(ctx.getString(0));
 
 	if (caller == entt::null) {
 		spdlog::warn("Cannot call custom event without entity, skipping");
@@ -40,8 +41,23 @@ void Functions::sendCustomEvent(Context &ctx) {
 		return;
 	}
 
+	// Post the event if there is a queue for it, otherwise run it right away
+	EventQueue *eventQueue = ctx.functions.getEventQueue();
+	if (eventQueue) {
+		ctx.defer([eventQueue, caller, eventName]() {
+			eventQueue->post(caller, eventName);
+		});
+		return;
+	}
+
+	// Run the event in the context of the calling script to keep its scheduler and profiler
+	if (ctx.script) {
+		bytecode->run(*ctx.script, eventName, caller, ctx.commands);
+		return;
+	}
+
 	AWE::Script::Context newContext(ctx.functions._registry, ctx.functions);
-	bytecode->run(newContext, eventName, caller);
+	bytecode->run(newContext, eventName, caller, ctx.commands);
 }
 
 }
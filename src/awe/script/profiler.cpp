@@ -0,0 +1,197 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include "src/common/profiler.h"
+#include "src/common/strutil.h"
+
+#include "src/awe/types.h"
+#include "src/awe/script/profiler.h"
+
+namespace AWE::Script {
+
+// The innermost zone of the current thread
+static thread_local Profiler::Zone *currentZone = nullptr;
+
+/*!
+ * Copy the measurements of a map sorted by descending exclusive time
+ */
+template<typename Key>
+static std::vector<Profiler::Stats> getSortedStats(const std::map<Key, Profiler::Stats> &stats) {
+	std::vector<Profiler::Stats> sorted;
+	sorted.reserve(stats.size());
+	for (const auto &item : stats) {
+		if (item.second.calls > 0)
+			sorted.emplace_back(item.second);
+	}
+
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Profiler::Stats &a, const Profiler::Stats &b) {
+		return a.exclusive > b.exclusive;
+	});
+
+	return sorted;
+}
+
+void Profiler::Zone::enter() {
+	_parent = currentZone;
+	currentZone = this;
+	_start = Profile.getTime();
+}
+
+void Profiler::Zone::leave(uint64_t &inclusive, uint64_t &exclusive) {
+	inclusive = Profile.getTime() - _start;
+	exclusive = inclusive - std::min(_children, inclusive);
+
+	if (_parent)
+		_parent->_children += inclusive;
+	currentZone = _parent;
+}
+
+Profiler::ScriptZone::~ScriptZone() {
+	if (!_profiler)
+		return;
+
+	uint64_t inclusive, exclusive;
+	leave(inclusive, exclusive);
+	_profiler->addEntryPoint(_program, _entryPoint, _caller, _instructions, _start, inclusive, exclusive);
+}
+
+Profiler::NativeZone::~NativeZone() {
+	if (!_profiler)
+		return;
+
+	uint64_t inclusive, exclusive;
+	leave(inclusive, exclusive);
+	_profiler->addNative(_object, _method, _start, inclusive, exclusive);
+}
+
+Profiler::Profiler(const entt::registry &registry, const GIDRegistryFile *gidRegistry) :
+	_registry(registry),
+	_gidRegistry(gidRegistry) {
+}
+
+std::vector<Profiler::Stats> Profiler::getEntryPoints() const {
+	std::lock_guard<std::mutex> lock(_access);
+	return getSortedStats(_entryPoints);
+}
+
+std::vector<Profiler::Stats> Profiler::getNatives() const {
+	std::lock_guard<std::mutex> lock(_access);
+	return getSortedStats(_natives);
+}
+
+void Profiler::reset() {
+	std::lock_guard<std::mutex> lock(_access);
+	// The names stay untouched, since trace events still reference them
+	const auto resetStats = [](Stats &stats) {
+		stats.calls = 0;
+		stats.instructions = 0;
+		stats.inclusive = std::chrono::nanoseconds(0);
+		stats.exclusive = std::chrono::nanoseconds(0);
+	};
+
+	for (auto &item : _entryPoints) {
+		resetStats(item.second);
+	}
+	for (auto &item : _natives) {
+		resetStats(item.second);
+	}
+}
+
+void Profiler::save(Common::WriteStream &stream) const {
+	const auto writeTable = [&](const std::string &title, const std::vector<Stats> &stats) {
+		stream.writeString(fmt::format("{}\n", title));
+		stream.writeString(fmt::format(
+			"{:>14} {:>14} {:>10} {:>14}  {}\n", "exclusive ms", "inclusive ms", "calls", "instructions", "name"
+		));
+		for (const auto &item : stats) {
+			stream.writeString(fmt::format(
+				"{:>14.3f} {:>14.3f} {:>10} {:>14}  {}\n",
+				std::chrono::duration<double, std::milli>(item.exclusive).count(),
+				std::chrono::duration<double, std::milli>(item.inclusive).count(),
+				item.calls,
+				item.instructions,
+				item.name
+			));
+		}
+	};
+
+	writeTable("Script entry points", getEntryPoints());
+	stream.writeString("\n");
+	writeTable("Native functions", getNatives());
+}
+
+void Profiler::addEntryPoint(const ProgramPtr &program, const std::string *entryPoint, entt::entity caller,
+							 uint64_t instructions, uint64_t start, uint64_t inclusive, uint64_t exclusive) {
+	std::lock_guard<std::mutex> lock(_access);
+
+	Stats &stats = _entryPoints[EntryPointKey(program, entryPoint)];
+	if (stats.name.empty())
+		stats.name = fmt::format("{} ({})", entryPoint ? *entryPoint : "", formatCaller(program.get(), caller));
+
+	stats.instructions += instructions;
+	add(stats, start, inclusive, exclusive);
+}
+
+void Profiler::addNative(Common::Atom object, Common::Atom method, uint64_t start, uint64_t inclusive,
+						 uint64_t exclusive) {
+	std::lock_guard<std::mutex> lock(_access);
+
+	Stats &stats = _natives[NativeKey(object, method)];
+	if (stats.name.empty()) {
+		if (object == Common::kEmptyAtom)
+			stats.name = std::string(Atoms.getString(method));
+		else
+			stats.name = fmt::format("{}.{}", Common::toUpper(std::string(Atoms.getString(object))), Atoms.getString(method));
+	}
+
+	add(stats, start, inclusive, exclusive);
+}
+
+std::string Profiler::formatCaller(const Program *program, entt::entity caller) {
+	const GID *gid = caller != entt::null ? _registry.try_get<GID>(caller) : nullptr;
+	if (gid) {
+		if (_gidRegistry) {
+			const std::string name = _gidRegistry->getString(*gid);
+			if (!name.empty())
+				return name;
+		}
+
+		return fmt::format("{}:{:x}", gid->type, gid->id);
+	}
+
+	// Without a gid the programs are numbered in the order they were first run
+	const auto iter = _programs.emplace(program, _programs.size()).first;
+	return fmt::format("program {}", iter->second);
+}
+
+void Profiler::add(Stats &stats, uint64_t start, uint64_t inclusive, uint64_t exclusive) {
+	stats.calls++;
+	stats.inclusive += std::chrono::nanoseconds(inclusive);
+	stats.exclusive += std::chrono::nanoseconds(exclusive);
+
+	if (Profile.isRecording())
+		Profile.addZone(stats.name.c_str(), start, start + inclusive);
+}
+
+} // End of namespace AWE::Script
@@ -0,0 +1,190 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_AWE_SCRIPT_PROFILER_H
+#define OPENAWE_AWE_SCRIPT_PROFILER_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "src/common/atomtable.h"
+#include "src/common/types.h"
+#include "src/common/writestream.h"
+
+#include "src/awe/gidregistryfile.h"
+#include "src/awe/script/program.h"
+
+namespace AWE::Script {
+
+/*!
+ * \brief Profiler of script entry points and native functions
+ *
+ * Records how often every entry point of every program and every native
+ * function is run, how long it took in total and without the time spent in
+ * the native functions or scripts it called, and for entry points how many
+ * instructions were executed. Scripts are only profiled while a profiler is
+ * set in their context, otherwise profiling costs one pointer check per run
+ * and native call. If the common profiler is recording, every measured run
+ * and call is added to the trace as well. Entry points are named after the
+ * gid of the first entity running them, so that the rows of programs shared
+ * by several scripts are the same in every run.
+ */
+class Profiler : Common::Noncopyable {
+public:
+	/*!
+	 * \brief Accumulated measurements of an entry point or native function
+	 */
+	struct Stats {
+		std::string name;
+		uint64_t calls{0};
+		uint64_t instructions{0};
+
+		// The time including and excluding the called native functions and scripts
+		std::chrono::nanoseconds inclusive{0};
+		std::chrono::nanoseconds exclusive{0};
+	};
+
+	/*!
+	 * \brief Base of the measurements of a run or call
+	 *
+	 * The zones of a thread form a stack through their parents, so that the
+	 * time of every zone can be excluded from the zone which it was started in.
+	 */
+	class Zone : Common::Noncopyable {
+	protected:
+		explicit Zone(Profiler *profiler) : _profiler(profiler) {
+			if (_profiler)
+				enter();
+		}
+
+		void enter();
+		void leave(uint64_t &inclusive, uint64_t &exclusive);
+
+		Profiler *const _profiler;
+		uint64_t _start{0};
+		uint64_t _children{0};
+		Zone *_parent{nullptr};
+	};
+
+	/*!
+	 * \brief Measures the run of an entry point between its construction and destruction
+	 */
+	class ScriptZone : Zone {
+	public:
+		ScriptZone(Profiler *profiler, const ProgramPtr &program, const std::string *entryPoint, entt::entity caller) :
+			Zone(profiler), _program(program), _entryPoint(entryPoint), _caller(caller) {
+		}
+
+		~ScriptZone();
+
+		void setInstructions(uint64_t instructions) {
+			_instructions = instructions;
+		}
+
+	private:
+		const ProgramPtr &_program;
+		const std::string *_entryPoint;
+		entt::entity _caller;
+		uint64_t _instructions{0};
+	};
+
+	/*!
+	 * \brief Measures the call of a native function between its construction and destruction
+	 */
+	class NativeZone : Zone {
+	public:
+		NativeZone(Profiler *profiler, Common::Atom object, Common::Atom method) :
+			Zone(profiler), _object(object), _method(method) {
+		}
+
+		~NativeZone();
+
+	private:
+		Common::Atom _object;
+		Common::Atom _method;
+	};
+
+	/*!
+	 * Create a profiler naming entry points after the gids of the entities running them
+	 *
+	 * \param registry the registry containing the gids of the entities
+	 * \param gidRegistry the names of the gids, if they are available
+	 */
+	explicit Profiler(const entt::registry &registry, const GIDRegistryFile *gidRegistry = nullptr);
+
+	/*!
+	 * Get the measurements of all entry points
+	 * \return the measurements sorted by descending exclusive time
+	 */
+	std::vector<Stats> getEntryPoints() const;
+
+	/*!
+	 * Get the measurements of all native functions
+	 * \return the measurements sorted by descending exclusive time
+	 */
+	std::vector<Stats> getNatives() const;
+
+	/*!
+	 * Reset all measurements, the names of the entry points and native functions are kept
+	 */
+	void reset();
+
+	/*!
+	 * Write a report of all measurements as text table
+	 * \param stream the stream to write the report to
+	 */
+	void save(Common::WriteStream &stream) const;
+
+private:
+	// The entry point names are owned by the program, which is kept alive by the key
+	typedef std::pair<ProgramPtr, const std::string *> EntryPointKey;
+	typedef std::pair<Common::Atom, Common::Atom> NativeKey;
+
+	void addEntryPoint(const ProgramPtr &program, const std::string *entryPoint, entt::entity caller,
+					   uint64_t instructions, uint64_t start, uint64_t inclusive, uint64_t exclusive);
+	void addNative(Common::Atom object, Common::Atom method, uint64_t start, uint64_t inclusive, uint64_t exclusive);
+
+	std::string formatCaller(const Program *program, entt::entity caller);
+
+	static void add(Stats &stats, uint64_t start, uint64_t inclusive, uint64_t exclusive);
+
+	const entt::registry &_registry;
+	const GIDRegistryFile *_gidRegistry;
+
+	mutable std::mutex _access;
+
+	// The numbers of the programs whose entry points were run by entities without gid
+	std::map<const Program *, size_t> _programs;
+
+	// The names of the measurements are referenced by trace events, so they are never removed
+	std::map<EntryPointKey, Stats> _entryPoints;
+	std::map<NativeKey, Stats> _natives;
+};
+
+} // End of namespace AWE::Script
+
+#endif // OPENAWE_AWE_SCRIPT_PROFILER_H
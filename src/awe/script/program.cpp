@@ -0,0 +1,525 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <limits>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "src/common/memreadstream.h"
+#include "src/common/memwritestream.h"
+
+#include "src/awe/script/program.h"
+
+enum Opcode {
+	kPush       = 0x01,
+	kPushGID    = 0x02,
+	kCallGlobal = 0x03,
+	kCallObject = 0x04,
+	kRet        = 0x0D,
+	kIntToFloat = 0x0E,
+	kSetMember  = 0x0F,
+	kGetMember  = 0x10,
+	kCmp        = 0x13,
+	kJmp        = 0x15,
+	kJmpIf      = 0x1A,
+	kLogAnd     = 0x1C,
+	kLogOr      = 0x1D,
+	kLogNot     = 0x1E,
+	kNeq        = 0x24,
+	kEq         = 0x25,
+};
+
+static const uint32_t kNoString = std::numeric_limits<uint32_t>::max();
+
+/*!
+ * Get the size of the operand following an instruction in bytes
+ */
+static size_t getOperandSize(Opcode opcode) {
+	switch (opcode) {
+		case kPush:
+		case kJmp:
+		case kJmpIf:
+			return 4;
+		case kPushGID:
+			return 8;
+		default:
+			return 0;
+	}
+}
+
+/*!
+ * Get the handler of an opcode, or kHandlerInvalid if the opcode is unknown
+ */
+static AWE::Script::Handler getHandler(Opcode opcode) {
+	using namespace AWE::Script;
+
+	switch (opcode) {
+		case kPush:       return kHandlerPush;
+		case kPushGID:    return kHandlerPushGID;
+		case kCallGlobal: return kHandlerCallGlobal;
+		case kCallObject: return kHandlerCallObject;
+		case kRet:        return kHandlerRet;
+		case kIntToFloat: return kHandlerIntToFloat;
+		case kSetMember:  return kHandlerSetMember;
+		case kGetMember:  return kHandlerGetMember;
+		case kCmp:        return kHandlerCmp;
+		case kJmp:        return kHandlerJmp;
+		case kJmpIf:      return kHandlerJmpIf;
+		case kLogAnd:     return kHandlerLogAnd;
+		case kLogOr:      return kHandlerLogOr;
+		case kLogNot:     return kHandlerLogNot;
+		case kNeq:        return kHandlerNeq;
+		case kEq:         return kHandlerEq;
+		default:          return kHandlerInvalid;
+	}
+}
+
+/*!
+ * Get the mnemonic of a handler for the disassembly
+ */
+static const char *getMnemonic(byte handler) {
+	using namespace AWE::Script;
+
+	switch (handler) {
+		case kHandlerPush:
+		case kHandlerPushString: return "push";
+		case kHandlerPushGID:    return "push_gid";
+		case kHandlerCallGlobal: return "call_global";
+		case kHandlerCallObject: return "call_object";
+		case kHandlerRet:        return "ret";
+		case kHandlerIntToFloat: return "int_to_float";
+		case kHandlerSetMember:  return "set_member";
+		case kHandlerGetMember:  return "get_member";
+		case kHandlerCmp:        return "cmp";
+		case kHandlerJmp:        return "jmp";
+		case kHandlerJmpIf:      return "jmp_if";
+		case kHandlerLogAnd:     return "and";
+		case kHandlerLogOr:      return "or";
+		case kHandlerLogNot:     return "not";
+		case kHandlerNeq:        return "neq";
+		case kHandlerEq:         return "eq";
+		default:                 return "invalid";
+	}
+}
+
+static void writeString(Common::WriteStream &stream, std::string_view string) {
+	stream.writeUint32LE(string.size());
+	stream.write(string.data(), string.size());
+}
+
+static std::string readString(Common::ReadStream &stream) {
+	return stream.readFixedSizeString(stream.readUint32LE());
+}
+
+namespace AWE::Script {
+
+Program::Program(Common::ReadStream &code, const EntryPoints &entryPoints, const DPFile &parameters,
+				 const DebugEntries &debugEntries) : _entryPoints(entryPoints), _debugEntries(debugEntries) {
+	decode(code, parameters);
+}
+
+Program::Program(Common::ReadStream &stream) {
+	// Programs are stored with their size, so that truncated programs are detected before using any of their data
+	std::vector<byte> data(stream.readUint32LE());
+	if (stream.read(data.data(), data.size()) != data.size())
+		throw std::runtime_error("Script program is truncated");
+
+	Common::MemoryReadStream program(data.data(), data.size(), false);
+	load(program);
+	if (program.pos() != data.size())
+		throw std::runtime_error("Script program has an invalid size");
+}
+
+void Program::load(Common::ReadStream &stream) {
+	// Strings are stored once in a table, since atoms are only valid within a process
+	std::vector<Common::Atom> strings(stream.readUint32LE());
+	for (auto &string : strings) {
+		string = Atoms.intern(readString(stream));
+	}
+
+	const auto getString = [&](uint32_t index) {
+		if (index == kNoString)
+			return String{Common::kEmptyAtom};
+		if (index >= strings.size())
+			throw std::runtime_error("Invalid string index in script program");
+		return String{strings[index]};
+	};
+
+	_gids.resize(stream.readUint32LE());
+	for (auto &gid : _gids) {
+		gid.type = stream.readUint32LE();
+		gid.id = stream.readUint32LE();
+	}
+
+	_callSites.resize(stream.readUint32LE());
+	for (auto &site : _callSites) {
+		site.global = stream.readByte() != 0;
+		site.object = getString(stream.readUint32LE());
+		site.method = getString(stream.readUint32LE());
+	}
+
+	_instructions.resize(stream.readUint32LE());
+	for (auto &instruction : _instructions) {
+		instruction.handler = stream.readByte();
+		instruction.param1 = stream.readByte();
+		instruction.param2 = stream.readByte();
+		instruction.param3 = stream.readByte();
+		instruction.operand = stream.readUint32LE();
+	}
+
+	// Verify every index, so that running the program never accesses anything outside of it
+	if (_instructions.empty() || _instructions.back().handler != kHandlerInvalid)
+		throw std::runtime_error("Script program is not terminated");
+
+	for (auto &instruction : _instructions) {
+		switch (instruction.handler) {
+			case kHandlerPushString:
+				instruction.operand = getString(instruction.operand).atom;
+				break;
+
+			case kHandlerPushGID:
+				if (instruction.operand >= _gids.size())
+					throw std::runtime_error("Invalid gid index in script program");
+				break;
+
+			case kHandlerCallGlobal:
+			case kHandlerCallObject:
+				if (instruction.operand >= _callSites.size())
+					throw std::runtime_error("Invalid call site index in script program");
+				break;
+
+			case kHandlerJmp:
+			case kHandlerJmpIf:
+				if (instruction.operand >= _instructions.size())
+					throw std::runtime_error("Invalid jump target in script program");
+				break;
+
+			default:
+				if (instruction.handler > kHandlerInvalid)
+					throw std::runtime_error("Invalid handler in script program");
+				break;
+		}
+	}
+
+	const uint32_t numEntryPoints = stream.readUint32LE();
+	for (uint32_t i = 0; i < numEntryPoints; ++i) {
+		std::string name = readString(stream);
+		const uint32_t index = stream.readUint32LE();
+		if (index >= _instructions.size())
+			throw std::runtime_error("Invalid entry point in script program");
+		_entryPoints[name] = index;
+	}
+
+	const uint32_t numDebugEntries = stream.readUint32LE();
+	for (uint32_t i = 0; i < numDebugEntries; ++i) {
+		const uint32_t id = stream.readUint32LE();
+		_debugEntries[id] = readString(stream);
+	}
+}
+
+void Program::save(Common::WriteStream &stream) const {
+	Common::DynamicMemoryWriteStream program(true);
+
+	std::vector<Common::Atom> strings;
+	std::map<Common::Atom, uint32_t> stringIndices;
+	const auto getStringIndex = [&](Common::Atom atom) {
+		if (atom == Common::kEmptyAtom)
+			return kNoString;
+
+		const auto iter = stringIndices.find(atom);
+		if (iter != stringIndices.end())
+			return iter->second;
+
+		stringIndices[atom] = strings.size();
+		strings.emplace_back(atom);
+		return static_cast<uint32_t>(strings.size() - 1);
+	};
+
+	std::vector<Instruction> instructions(_instructions);
+	for (auto &instruction : instructions) {
+		if (instruction.handler == kHandlerPushString)
+			instruction.operand = getStringIndex(instruction.operand);
+	}
+
+	std::vector<std::pair<uint32_t, uint32_t>> callSiteNames;
+	for (const auto &site : _callSites) {
+		callSiteNames.emplace_back(getStringIndex(site.object.atom), getStringIndex(site.method.atom));
+	}
+
+	program.writeUint32LE(strings.size());
+	for (const auto atom : strings) {
+		writeString(program, Atoms.getString(atom));
+	}
+
+	program.writeUint32LE(_gids.size());
+	for (const auto &gid : _gids) {
+		program.writeUint32LE(gid.type);
+		program.writeUint32LE(gid.id);
+	}
+
+	program.writeUint32LE(_callSites.size());
+	for (size_t i = 0; i < _callSites.size(); ++i) {
+		program.writeByte(_callSites[i].global);
+		program.writeUint32LE(callSiteNames[i].first);
+		program.writeUint32LE(callSiteNames[i].second);
+	}
+
+	program.writeUint32LE(instructions.size());
+	for (const auto &instruction : instructions) {
+		program.writeByte(instruction.handler);
+		program.writeByte(instruction.param1);
+		program.writeByte(instruction.param2);
+		program.writeByte(instruction.param3);
+		program.writeUint32LE(instruction.operand);
+	}
+
+	program.writeUint32LE(_entryPoints.size());
+	for (const auto &[name, index] : _entryPoints) {
+		writeString(program, name);
+		program.writeUint32LE(index);
+	}
+
+	program.writeUint32LE(_debugEntries.size());
+	for (const auto &[id, name] : _debugEntries) {
+		program.writeUint32LE(id);
+		writeString(program, name);
+	}
+
+	stream.writeUint32LE(program.getLength());
+	stream.write(program.getData(), program.getLength());
+}
+
+std::string Program::disassemble() const {
+	std::multimap<uint32_t, std::string> labels;
+	for (const auto &[name, index] : _entryPoints) {
+		labels.emplace(index, name);
+	}
+
+	std::string disassembly;
+	for (size_t i = 0; i < _instructions.size(); ++i) {
+		const auto range = labels.equal_range(i);
+		for (auto iter = range.first; iter != range.second; ++iter) {
+			disassembly += fmt::format("{}:\n", iter->second);
+		}
+
+		// The terminating instruction is only listed if something refers to it
+		const Instruction &instruction = _instructions[i];
+		if (i == _instructions.size() - 1 && range.first == range.second)
+			break;
+
+		std::string line = fmt::format("  {:04}  {}", i, getMnemonic(instruction.handler));
+		switch (instruction.handler) {
+			case kHandlerPush:
+				line += fmt::format(" {}", instruction.operand);
+				break;
+
+			case kHandlerPushString:
+				line += fmt::format(" \"{}\"", Atoms.getString(instruction.operand));
+				break;
+
+			case kHandlerPushGID: {
+				const GID &gid = _gids[instruction.operand];
+				line += fmt::format(" {}:{:x}", gid.type, gid.id);
+				break;
+			}
+
+			case kHandlerCallGlobal:
+			case kHandlerCallObject: {
+				const CallSite &site = _callSites[instruction.operand];
+				line += fmt::format(" {} {}", instruction.param1, instruction.param2);
+				if (site.method.atom != Common::kEmptyAtom) {
+					if (site.global)
+						line += fmt::format("  ; {}.{}", site.object.str(), site.method.str());
+					else
+						line += fmt::format("  ; {}", site.method.str());
+				}
+				break;
+			}
+
+			case kHandlerSetMember:
+			case kHandlerGetMember: {
+				line += fmt::format(" {}", instruction.param1);
+				const auto member = _debugEntries.find(instruction.param1);
+				if (member != _debugEntries.end())
+					line += fmt::format("  ; {}", member->second);
+				break;
+			}
+
+			case kHandlerJmp:
+			case kHandlerJmpIf:
+				line += fmt::format(" {:04}", instruction.operand);
+				break;
+
+			case kHandlerInvalid:
+				if (i < _instructions.size() - 1)
+					line += fmt::format(" {:02x}", instruction.operand);
+				break;
+
+			default:
+				break;
+		}
+
+		disassembly += line + "\n";
+	}
+
+	return disassembly;
+}
+
+const std::vector<Program::Instruction> &Program::getInstructions() const {
+	return _instructions;
+}
+
+size_t Program::getNumInstructions() const {
+	return _instructions.size() - 1;
+}
+
+const std::vector<GID> &Program::getGIDs() const {
+	return _gids;
+}
+
+const std::vector<Program::CallSite> &Program::getCallSites() const {
+	return _callSites;
+}
+
+const EntryPoints &Program::getEntryPoints() const {
+	return _entryPoints;
+}
+
+const DebugEntries &Program::getDebugEntries() const {
+	return _debugEntries;
+}
+
+void Program::decode(Common::ReadStream &code, const DPFile &parameters) {
+	code.seek(0, Common::ReadStream::END);
+	const size_t codeSize = code.pos();
+	code.seek(0);
+
+	// Map every 4 byte word starting an instruction to the index of the instruction
+	std::vector<uint32_t> wordToInstruction(codeSize / 4 + 1, std::numeric_limits<uint32_t>::max());
+	std::vector<std::pair<size_t, size_t>> jumps;
+
+	while (code.pos() + 4 <= codeSize) {
+		wordToInstruction[code.pos() / 4] = _instructions.size();
+
+		Instruction instruction{};
+		instruction.param1 = code.readByte();
+		instruction.param2 = code.readByte();
+		instruction.param3 = code.readByte();
+
+		const auto opcode = Opcode(code.readByte());
+		instruction.handler = getHandler(opcode);
+
+		// An instruction cut off by the end of the code can't be executed
+		if (code.pos() + getOperandSize(opcode) > codeSize) {
+			instruction.handler = kHandlerInvalid;
+			instruction.operand = opcode;
+			_instructions.emplace_back(instruction);
+			break;
+		}
+
+		switch (instruction.handler) {
+			case kHandlerPush:
+				instruction.operand = code.readUint32LE();
+
+				// Whether a constant is a string only depends on the constant itself, so intern it right away
+				if (parameters.hasString(instruction.operand)) {
+					instruction.handler = kHandlerPushString;
+					instruction.operand = parameters.getAtom(instruction.operand);
+				}
+				break;
+
+			case kHandlerPushGID: {
+				GID gid;
+				gid.type = code.readUint32LE();
+				gid.id = code.readUint32BE();
+
+				instruction.operand = _gids.size();
+				_gids.emplace_back(gid);
+				break;
+			}
+
+			case kHandlerCallGlobal:
+			case kHandlerCallObject: {
+				CallSite site{};
+				site.global = instruction.handler == kHandlerCallGlobal;
+
+				// The names are usually pushed right before the call, remember them to bind the call site when linking
+				const size_t numInstructions = _instructions.size();
+				if (site.global && numInstructions >= 2 &&
+					_instructions[numInstructions - 1].handler == kHandlerPushString &&
+					_instructions[numInstructions - 2].handler == kHandlerPushString) {
+					site.object.atom = _instructions[numInstructions - 1].operand;
+					site.method.atom = _instructions[numInstructions - 2].operand;
+				} else if (!site.global && numInstructions >= 2 &&
+					_instructions[numInstructions - 2].handler == kHandlerPushString) {
+					site.method.atom = _instructions[numInstructions - 2].operand;
+				}
+
+				instruction.operand = _callSites.size();
+				_callSites.emplace_back(site);
+				break;
+			}
+
+			case kHandlerJmp:
+			case kHandlerJmpIf: {
+				// Jumps are relative to the end of the instruction in 4 byte words
+				const auto offset = static_cast<int32_t>(code.readUint32LE());
+				jumps.emplace_back(_instructions.size(), code.pos() / 4 + offset);
+				break;
+			}
+
+			case kHandlerInvalid:
+				instruction.operand = opcode;
+				break;
+
+			default:
+				break;
+		}
+
+		_instructions.emplace_back(instruction);
+	}
+
+	// Running past the end of the code or jumping outside of it ends up in an invalid instruction
+	const auto end = static_cast<uint32_t>(_instructions.size());
+	_instructions.emplace_back(Instruction{kHandlerInvalid, 0, 0, 0, 0});
+	if (code.pos() / 4 < wordToInstruction.size())
+		wordToInstruction[code.pos() / 4] = end;
+
+	for (const auto &jump : jumps) {
+		uint32_t target = end;
+		if (jump.second < wordToInstruction.size() && wordToInstruction[jump.second] != std::numeric_limits<uint32_t>::max())
+			target = wordToInstruction[jump.second];
+		else
+			spdlog::warn("Invalid jump target {} in bytecode", jump.second);
+
+		_instructions[jump.first].operand = target;
+	}
+
+	for (auto &entryPoint : _entryPoints) {
+		if (entryPoint.second < wordToInstruction.size() && wordToInstruction[entryPoint.second] != std::numeric_limits<uint32_t>::max())
+			entryPoint.second = wordToInstruction[entryPoint.second];
+		else
+			entryPoint.second = end;
+	}
+}
+
+} // End of namespace AWE::Script
@@ -0,0 +1,178 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_AWE_SCRIPT_PROGRAM_H
+#define OPENAWE_AWE_SCRIPT_PROGRAM_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/common/readstream.h"
+#include "src/common/types.h"
+#include "src/common/writestream.h"
+
+#include "src/awe/dpfile.h"
+#include "src/awe/types.h"
+#include "src/awe/script/types.h"
+
+namespace AWE::Script {
+
+class Program;
+
+typedef std::shared_ptr<const Program> ProgramPtr;
+typedef std::map<std::string, uint32_t> EntryPoints;
+typedef std::map<uint32_t, std::string> DebugEntries;
+
+/*!
+ * The handlers of the instructions in the order of the dispatch table
+ */
+enum Handler : byte {
+	kHandlerPush,
+	kHandlerPushString,
+	kHandlerPushGID,
+	kHandlerCallGlobal,
+	kHandlerCallObject,
+	kHandlerRet,
+	kHandlerIntToFloat,
+	kHandlerSetMember,
+	kHandlerGetMember,
+	kHandlerCmp,
+	kHandlerJmp,
+	kHandlerJmpIf,
+	kHandlerLogAnd,
+	kHandlerLogOr,
+	kHandlerLogNot,
+	kHandlerNeq,
+	kHandlerEq,
+	kHandlerInvalid
+};
+
+/*!
+ * \brief The decoded and verified code of a script
+ *
+ * The bytecode of a script is decoded in one pass into an array of fixed
+ * size instructions. Pushed constants are classified as strings or integers
+ * and strings are interned, the targets of jumps and the entry points are
+ * resolved to instruction indices and the names of called functions are
+ * collected per call site. Jumps and entry points outside of the code end
+ * in an invalid instruction terminating the array, so that executing a
+ * program never leaves it.
+ *
+ * A program is immutable and independent of the context it runs in, so it
+ * can be shared by every script using the same code and cached in
+ * snapshots.
+ */
+class Program : Common::Noncopyable {
+public:
+	/*!
+	 * \brief A decoded instruction
+	 *
+	 * The handler is the dense index of the instruction in the dispatch table.
+	 * The operand is the constant of a push, the atom of a pushed string, the index of the gid of a
+	 * push_gid, the index of the call site of a call, the index of the target
+	 * instruction of a jump or the raw opcode of an unknown instruction.
+	 */
+	struct Instruction {
+		byte handler;
+		byte param1, param2, param3;
+		uint32_t operand;
+	};
+
+	/*!
+	 * \brief The names a call instruction is known to call
+	 *
+	 * The names are taken from the strings pushed directly before the call
+	 * and are empty if they are only known when running the script. The
+	 * object name is only used by call_global.
+	 */
+	struct CallSite {
+		bool global;
+		String object;
+		String method;
+	};
+
+	/*!
+	 * Decode the bytecode of a script
+	 *
+	 * \param code the stream containing the code
+	 * \param entryPoints the entry points of the script as offsets in 4 byte words
+	 * \param parameters the dp file containing the string constants
+	 * \param debugEntries the names of members
+	 */
+	Program(Common::ReadStream &code, const EntryPoints &entryPoints, const DPFile &parameters,
+			const DebugEntries &debugEntries);
+
+	/*!
+	 * Load a program previously written with save, verifying all indices
+	 * \param stream the stream to read the program from
+	 */
+	explicit Program(Common::ReadStream &stream);
+
+	/*!
+	 * Write the program, so that it can be loaded again without decoding its bytecode
+	 * \param stream the stream to write the program to
+	 */
+	void save(Common::WriteStream &stream) const;
+
+	/*!
+	 * Get a human readable listing of the program
+	 * \return the disassembly of the program
+	 */
+	std::string disassemble() const;
+
+	/*!
+	 * Get the decoded instructions, terminated by an invalid instruction
+	 * \return the instructions of the program
+	 */
+	const std::vector<Instruction> &getInstructions() const;
+
+	/*!
+	 * Get the number of decoded instructions
+	 * \return the number of instructions without the terminating invalid instruction
+	 */
+	size_t getNumInstructions() const;
+
+	const std::vector<GID> &getGIDs() const;
+	const std::vector<CallSite> &getCallSites() const;
+
+	/*!
+	 * Get the entry points of the program
+	 * \return the entry points by name as instruction indices
+	 */
+	const EntryPoints &getEntryPoints() const;
+
+	const DebugEntries &getDebugEntries() const;
+
+private:
+	void load(Common::ReadStream &stream);
+	void decode(Common::ReadStream &code, const DPFile &parameters);
+
+	std::vector<Instruction> _instructions;
+	std::vector<GID> _gids;
+	std::vector<CallSite> _callSites;
+	EntryPoints _entryPoints;
+	DebugEntries _debugEntries;
+};
+
+} // End of namespace AWE::Script
+
+#endif // OPENAWE_AWE_SCRIPT_PROGRAM_H
@@ -0,0 +1,80 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "src/common/log.h"
+
+#include "src/awe/script/scheduler.h"
+
+namespace AWE::Script {
+
+Scheduler::Scheduler(Context &context) : _context(context) {
+}
+
+Scheduler::TimerId Scheduler::suspend(std::shared_ptr<const Bytecode::Continuation> continuation, std::chrono::milliseconds delay) {
+	const uint64_t deadline = _timers.getTime() + std::max<int64_t>(delay.count(), 0);
+	return _timers.schedule(deadline, [this, continuation = std::move(continuation)](){
+		resume(*continuation);
+	});
+}
+
+bool Scheduler::cancel(TimerId id) {
+	return _timers.cancel(id);
+}
+
+size_t Scheduler::update(std::chrono::milliseconds delta) {
+	if (delta.count() <= 0)
+		return 0;
+
+	return _timers.advance(_timers.getTime() + delta.count());
+}
+
+std::chrono::milliseconds Scheduler::getTime() const {
+	return std::chrono::milliseconds(_timers.getTime());
+}
+
+size_t Scheduler::size() const {
+	return _timers.size();
+}
+
+void Scheduler::resume(const Bytecode::Continuation &continuation) {
+	entt::registry &registry = _context.getRegistry();
+	if (!registry.valid(continuation.caller)) {
+		LOG_DEBUG("Dropping suspended script of destroyed entity");
+		return;
+	}
+
+	const BytecodePtr *bytecode = registry.try_get<BytecodePtr>(continuation.caller);
+	if (!bytecode || (*bytecode)->getProgram() != continuation.program) {
+		LOG_DEBUG("Dropping suspended script of entity with changed script");
+		return;
+	}
+
+	try {
+		(*bytecode)->resume(_context, continuation);
+	} catch (std::exception &e) {
+		spdlog::error("Error while resuming script: {}", e.what());
+	}
+}
+
+} // End of namespace AWE::Script
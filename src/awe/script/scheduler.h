@@ -0,0 +1,95 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_AWE_SCRIPT_SCHEDULER_H
+#define OPENAWE_AWE_SCRIPT_SCHEDULER_H
+
+#include <chrono>
+#include <memory>
+
+#include "src/common/timerwheel.h"
+
+#include "src/awe/script/bytecode.h"
+#include "src/awe/script/context.h"
+
+namespace AWE::Script {
+
+/*!
+ * \brief Scheduler resuming suspended scripts after a delay
+ *
+ * Scripts waiting for a timer or a delay are suspended with their frame
+ * saved into a continuation, which is stored in a timer wheel with a
+ * resolution of one millisecond. Updating the scheduler advances its clock
+ * and resumes every script whose deadline passed, in the order of their
+ * deadlines. Scripts whose entity was destroyed or got another script in
+ * the meantime are dropped.
+ */
+class Scheduler {
+public:
+	typedef Common::TimerWheel::TimerId TimerId;
+
+	Scheduler(Context &context);
+
+	/*!
+	 * Suspend a script. This is not thread safe, scripts running in parallel have to suspend through their command
+	 * buffer
+	 *
+	 * \param continuation the saved frame of the script
+	 * \param delay the time after which the script should be resumed
+	 * \return the id of the timer resuming the script
+	 */
+	TimerId suspend(std::shared_ptr<const Bytecode::Continuation> continuation, std::chrono::milliseconds delay);
+
+	/*!
+	 * Cancel a suspended script, so that it is never resumed
+	 * \param id the id of the timer returned when suspending the script
+	 * \return if the script was still suspended
+	 */
+	bool cancel(TimerId id);
+
+	/*!
+	 * Advance the clock of the scheduler and resume all scripts whose delay passed
+	 * \param delta the time passed since the last update
+	 * \return the number of resumed scripts
+	 */
+	size_t update(std::chrono::milliseconds delta);
+
+	/*!
+	 * Get the time the scheduler advanced so far
+	 * \return the time of the scheduler
+	 */
+	std::chrono::milliseconds getTime() const;
+
+	/*!
+	 * Get the number of suspended scripts
+	 * \return the number of scripts waiting to be resumed
+	 */
+	size_t size() const;
+
+private:
+	void resume(const Bytecode::Continuation &continuation);
+
+	Context &_context;
+	Common::TimerWheel _timers;
+};
+
+} // End of namespace AWE::Script
+
+#endif // OPENAWE_AWE_SCRIPT_SCHEDULER_H
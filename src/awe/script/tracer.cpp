@@ -0,0 +1,121 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fmt/format.h>
+
+#include "src/awe/types.h"
+#include "src/awe/script/tracer.h"
+
+namespace AWE::Script {
+
+Tracer::Tracer(const entt::registry &registry, const GIDRegistryFile *gidRegistry) :
+	_registry(registry),
+	_gidRegistry(gidRegistry) {
+}
+
+void Tracer::record(
+		entt::entity caller,
+		entt::entity object,
+		String global,
+		String method,
+		Common::Span<const Variable> arguments,
+		bool implemented,
+		const std::optional<Variable> &ret
+) {
+	std::string call = fmt::format(
+			"{}: {}.{}(",
+			formatEntity(caller),
+			object != entt::null ? formatEntity(object) : std::string(global.str()),
+			method.str()
+	);
+
+	for (size_t i = 0; i < arguments.size(); ++i) {
+		if (i > 0)
+			call += ", ";
+		call += formatVariable(arguments[i]);
+	}
+	call += ")";
+
+	if (ret)
+		call += " -> " + formatVariable(*ret);
+	if (!implemented)
+		call += "  ; not implemented";
+
+	std::lock_guard<std::mutex> lock(_access);
+	_calls.emplace_back(std::move(call));
+}
+
+std::vector<std::string> Tracer::getCalls() const {
+	std::lock_guard<std::mutex> lock(_access);
+	return _calls;
+}
+
+size_t Tracer::getNumCalls() const {
+	std::lock_guard<std::mutex> lock(_access);
+	return _calls.size();
+}
+
+void Tracer::reset() {
+	std::lock_guard<std::mutex> lock(_access);
+	_calls.clear();
+}
+
+void Tracer::save(Common::WriteStream &stream) const {
+	std::lock_guard<std::mutex> lock(_access);
+	for (const auto &call : _calls) {
+		stream.writeString(call);
+		stream.writeString("\n");
+	}
+}
+
+std::string Tracer::formatEntity(entt::entity entity) const {
+	if (entity == entt::null)
+		return "null";
+
+	// Entities are numbered differently in every run, so only their gid identifies them
+	const GID *gid = _registry.try_get<GID>(entity);
+	if (!gid)
+		return "entity";
+
+	if (_gidRegistry) {
+		const std::string name = _gidRegistry->getString(*gid);
+		if (!name.empty())
+			return name;
+	}
+
+	return fmt::format("{}:{:x}", gid->type, gid->id);
+}
+
+std::string Tracer::formatVariable(const Variable &variable) const {
+	switch (variable.getType()) {
+		case Variable::kInt:
+			return fmt::format("{}", static_cast<int32_t>(variable.getInt()));
+		case Variable::kFloat:
+			return fmt::format("{}f", variable.getFloat());
+		case Variable::kEntity:
+			return formatEntity(variable.getEntity());
+		case Variable::kString:
+			return fmt::format("\"{}\"", variable.getString().str());
+	}
+
+	return "?";
+}
+
+} // End of namespace AWE::Script
@@ -0,0 +1,116 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_AWE_SCRIPT_TRACER_H
+#define OPENAWE_AWE_SCRIPT_TRACER_H
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "src/common/span.h"
+#include "src/common/types.h"
+#include "src/common/writestream.h"
+
+#include "src/awe/gidregistryfile.h"
+#include "src/awe/script/types.h"
+
+namespace AWE::Script {
+
+/*!
+ * \brief Records the native functions called by scripts
+ *
+ * Every call is recorded as one line of text with the calling script, the
+ * called object and method, the arguments and the returned value. Entities
+ * are written by the name or value of their gid, so that traces of the same data can be compared
+ * between runs and builds to detect changes in the behaviour of scripts.
+ * Calls are recorded once they returned, so calls made by scripts run from
+ * within a native function are recorded before the call of that function.
+ * Scripts are only traced while a tracer is set in their context.
+ */
+class Tracer : Common::Noncopyable {
+public:
+	/*!
+	 * Create a tracer for scripts in a registry
+	 * \param registry the registry containing the gids of the entities
+	 * \param gidRegistry the names of the gids to write instead of the gids or nullptr to write the gids
+	 */
+	explicit Tracer(const entt::registry &registry, const GIDRegistryFile *gidRegistry = nullptr);
+
+	/*!
+	 * Record a call of a native function
+	 * \param caller the entity of the calling script
+	 * \param object the entity the method is called for or entt::null for global objects
+	 * \param global the name of the global object, if the method is not called for an entity
+	 * \param method the name of the method
+	 * \param arguments the arguments of the call
+	 * \param implemented if the native function is implemented, otherwise the call was skipped
+	 * \param ret the value returned by the function, if any
+	 */
+	void record(
+			entt::entity caller,
+			entt::entity object,
+			String global,
+			String method,
+			Common::Span<const Variable> arguments,
+			bool implemented,
+			const std::optional<Variable> &ret
+	);
+
+	/*!
+	 * Get all recorded calls
+	 * \return the calls in the order they returned
+	 */
+	std::vector<std::string> getCalls() const;
+
+	/*!
+	 * Get the number of recorded calls
+	 * \return the number of calls
+	 */
+	size_t getNumCalls() const;
+
+	/*!
+	 * Remove all recorded calls
+	 */
+	void reset();
+
+	/*!
+	 * Write all recorded calls, one per line
+	 * \param stream the stream to write the calls to
+	 */
+	void save(Common::WriteStream &stream) const;
+
+private:
+	std::string formatEntity(entt::entity entity) const;
+	std::string formatVariable(const Variable &variable) const;
+
+	const entt::registry &_registry;
+	const GIDRegistryFile *_gidRegistry;
+
+	mutable std::mutex _access;
+	std::vector<std::string> _calls;
+};
+
+} // End of namespace AWE::Script
+
+#endif // OPENAWE_AWE_SCRIPT_TRACER_H
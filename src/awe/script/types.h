@@ -21,16 +21,125 @@
 #ifndef OPENAWE_AWE_SCRIPT_TYPES_H
 #define OPENAWE_AWE_SCRIPT_TYPES_H
 
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
 #include <entt/entt.hpp>
-#include <variant>
+
+#include "src/common/atomtable.h"
 
 namespace AWE::Script {
 
-typedef std::variant<
-        uint32_t,
-        std::string,
-        entt::entity
-> Variable;
+/*!
+ * \brief A string value of a script
+ *
+ * Strings are interned into the atom table, so that they can be put on the
+ * stack and compared without touching the string data and without any
+ * allocation.
+ */
+struct String {
+	Common::Atom atom;
+
+	std::string_view str() const {
+		return Atoms.getString(atom);
+	}
+
+	bool operator==(const String &other) const {
+		return atom == other.atom;
+	}
+
+	bool operator!=(const String &other) const {
+		return atom != other.atom;
+	}
+};
+
+/*!
+ * \brief A value of a script
+ *
+ * Every value of a script is a 32 bit word tagged with its type, so values
+ * are trivially copyable, need no allocation and fit into 8 bytes. Since
+ * the bytecode itself is untyped, integers and floats are both numbers and
+ * can be read as either, reinterpreting their bits.
+ */
+class Variable {
+public:
+	enum Type : uint32_t {
+		kInt,
+		kFloat,
+		kEntity,
+		kString
+	};
+
+	/*!
+	 * Create an uninitialized value, a value initialized one is the integer 0
+	 */
+	Variable() = default;
+
+	constexpr Variable(uint32_t value) : _type(kInt), _value(value) {
+	}
+
+	constexpr Variable(int32_t value) : _type(kInt), _value(static_cast<uint32_t>(value)) {
+	}
+
+	constexpr Variable(bool value) : _type(kInt), _value(value ? 1 : 0) {
+	}
+
+	Variable(float value) : _type(kFloat), _value(0) {
+		std::memcpy(&_value, &value, 4);
+	}
+
+	constexpr Variable(entt::entity value) : _type(kEntity), _value(static_cast<uint32_t>(value)) {
+	}
+
+	constexpr Variable(String value) : _type(kString), _value(value.atom) {
+	}
+
+	Type getType() const {
+		return _type;
+	}
+
+	/*!
+	 * Get the raw 32 bit word of the value regardless of its type
+	 * \return the word of the value
+	 */
+	uint32_t getWord() const {
+		return _value;
+	}
+
+	uint32_t getInt() const {
+		if (_type != kInt && _type != kFloat)
+			throw std::runtime_error("Script value is not a number");
+		return _value;
+	}
+
+	float getFloat() const {
+		float value;
+		const uint32_t word = getInt();
+		std::memcpy(&value, &word, 4);
+		return value;
+	}
+
+	entt::entity getEntity() const {
+		if (_type != kEntity)
+			throw std::runtime_error("Script value is not an entity");
+		return static_cast<entt::entity>(_value);
+	}
+
+	String getString() const {
+		if (_type != kString)
+			throw std::runtime_error("Script value is not a string");
+		return String{_value};
+	}
+
+private:
+	Type _type;
+	uint32_t _value;
+};
+
+static_assert(sizeof(Variable) == 8, "Script values should fit into 8 bytes");
+static_assert(std::is_trivial_v<Variable>, "Script values should be trivial");
 
 }
 
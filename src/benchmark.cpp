@@ -0,0 +1,182 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "src/common/memorytracker.h"
+#include "src/common/strutil.h"
+
+#include "src/benchmark.h"
+
+static double toMilliseconds(std::chrono::nanoseconds duration) {
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+template<typename T>
+static T getPercentile(const std::vector<T> &sortedValues, double percentile) {
+	if (sortedValues.empty())
+		return T();
+
+	// Nearest rank percentile
+	const size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sortedValues.size()));
+	return sortedValues[std::clamp<size_t>(rank, 1, sortedValues.size()) - 1];
+}
+
+Benchmark::Benchmark(const std::string &scenario, unsigned int numFrames) :
+	_scenario(scenario),
+	_numFrames(numFrames),
+	_cameraPath({glm::vec3(0.0f, 500.0f, 0.0f)}),
+	_episodeSnapshot(false) {
+}
+
+const std::string &Benchmark::getScenario() const {
+	return _scenario;
+}
+
+unsigned int Benchmark::getNumFrames() const {
+	return _numFrames;
+}
+
+void Benchmark::setCameraPath(const std::vector<glm::vec3> &path) {
+	if (path.empty())
+		throw std::runtime_error("Camera path needs at least one waypoint");
+
+	_cameraPath = path;
+}
+
+glm::vec3 Benchmark::getCameraPosition(unsigned int frame) const {
+	if (_cameraPath.size() == 1 || _numFrames <= 1)
+		return _cameraPath.front();
+
+	std::vector<float> lengths(_cameraPath.size() - 1);
+	for (size_t i = 0; i < lengths.size(); ++i)
+		lengths[i] = glm::distance(_cameraPath[i], _cameraPath[i + 1]);
+
+	float distance = std::accumulate(lengths.begin(), lengths.end(), 0.0f) *
+			static_cast<float>(std::min(frame, _numFrames - 1)) / static_cast<float>(_numFrames - 1);
+	for (size_t i = 0; i < lengths.size(); ++i) {
+		if (distance <= lengths[i] && lengths[i] > 0.0f)
+			return glm::mix(_cameraPath[i], _cameraPath[i + 1], distance / lengths[i]);
+		distance -= lengths[i];
+	}
+
+	return _cameraPath.back();
+}
+
+void Benchmark::addStage(const std::string &name, std::chrono::nanoseconds duration) {
+	_stages.emplace_back(name, toMilliseconds(duration));
+}
+
+void Benchmark::setEpisodeSnapshot(bool restored) {
+	_episodeSnapshot = restored;
+}
+
+void Benchmark::addFrame(std::chrono::nanoseconds duration, unsigned int numDrawCalls, unsigned int numVisibleModels,
+						 unsigned int numCulledModels) {
+	_frameTimes.emplace_back(toMilliseconds(duration));
+	_drawCalls.emplace_back(numDrawCalls);
+	_visibleModels.emplace_back(numVisibleModels);
+	_culledModels.emplace_back(numCulledModels);
+}
+
+void Benchmark::save(Common::WriteStream &stream) const {
+	std::vector<double> frameTimes = _frameTimes;
+	std::sort(frameTimes.begin(), frameTimes.end());
+	std::vector<unsigned int> drawCalls = _drawCalls;
+	std::sort(drawCalls.begin(), drawCalls.end());
+
+	const double totalFrameTime = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0);
+	const double totalDrawCalls = std::accumulate(drawCalls.begin(), drawCalls.end(), 0.0);
+	const double numFrames = std::max<double>(1.0, frameTimes.size());
+
+	stream.writeString("{\n");
+	stream.writeString(fmt::format("\t\"scenario\": \"{}\",\n", Common::escapeJSON(_scenario)));
+	stream.writeString(fmt::format("\t\"frames\": {},\n", frameTimes.size()));
+	stream.writeString(fmt::format("\t\"episodeSnapshot\": {},\n", _episodeSnapshot));
+
+	stream.writeString("\t\"stages\": {");
+	for (size_t i = 0; i < _stages.size(); ++i) {
+		stream.writeString(fmt::format(
+			"{}\n\t\t\"{}\": {:.3f}",
+			i == 0 ? "" : ",",
+			Common::escapeJSON(_stages[i].first),
+			_stages[i].second
+		));
+	}
+	stream.writeString("\n\t},\n");
+
+	stream.writeString(fmt::format(
+		"\t\"frameTime\": {{\n"
+		"\t\t\"mean\": {:.3f},\n"
+		"\t\t\"min\": {:.3f},\n"
+		"\t\t\"p50\": {:.3f},\n"
+		"\t\t\"p90\": {:.3f},\n"
+		"\t\t\"p95\": {:.3f},\n"
+		"\t\t\"p99\": {:.3f},\n"
+		"\t\t\"max\": {:.3f}\n"
+		"\t}},\n",
+		totalFrameTime / numFrames,
+		getPercentile(frameTimes, 0.0),
+		getPercentile(frameTimes, 50.0),
+		getPercentile(frameTimes, 90.0),
+		getPercentile(frameTimes, 95.0),
+		getPercentile(frameTimes, 99.0),
+		getPercentile(frameTimes, 100.0)
+	));
+
+	stream.writeString(fmt::format(
+		"\t\"drawCalls\": {{\n"
+		"\t\t\"mean\": {:.1f},\n"
+		"\t\t\"p50\": {},\n"
+		"\t\t\"max\": {}\n"
+		"\t}},\n",
+		totalDrawCalls / numFrames,
+		getPercentile(drawCalls, 50.0),
+		getPercentile(drawCalls, 100.0)
+	));
+
+	stream.writeString(fmt::format(
+		"\t\"culling\": {{\n"
+		"\t\t\"visibleMean\": {:.1f},\n"
+		"\t\t\"culledMean\": {:.1f}\n"
+		"\t}},\n",
+		std::accumulate(_visibleModels.begin(), _visibleModels.end(), 0.0) / numFrames,
+		std::accumulate(_culledModels.begin(), _culledModels.end(), 0.0) / numFrames
+	));
+
+	stream.writeString("\t\"memoryPeaks\": {");
+	for (unsigned int i = 0; i < Common::kNumMemoryTags; ++i) {
+		const auto tag = static_cast<Common::MemoryTag>(i);
+		stream.writeString(fmt::format(
+			"{}\n\t\t\"{}\": {}",
+			i == 0 ? "" : ",",
+			Common::MemoryTracker::getTagName(tag),
+			MemoryTracking.getTotalPeak(tag)
+		));
+	}
+	stream.writeString("\n\t}\n");
+
+	stream.writeString("}\n");
+}
@@ -0,0 +1,122 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_BENCHMARK_H
+#define OPENAWE_BENCHMARK_H
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "src/common/writestream.h"
+
+/*!
+ * \brief Collects the measurements of a headless benchmark run
+ *
+ * A benchmark loads an episode, flies the camera along a fixed path for a
+ * given number of frames and records the time of every load stage and
+ * frame together with the draw calls and the memory peaks of the
+ * subsystems. The results are written as json, so that they can be compared
+ * between runs, for example to track regressions in CI.
+ */
+class Benchmark {
+public:
+	/*!
+	 * Create a new benchmark
+	 * \param scenario the episode description to load, for example "round:1 gameworld:scene1_reststop"
+	 * \param numFrames the number of frames to run after loading
+	 */
+	Benchmark(const std::string &scenario, unsigned int numFrames);
+
+	const std::string &getScenario() const;
+	unsigned int getNumFrames() const;
+
+	/*!
+	 * Set the waypoints of the camera path, the camera moves through them
+	 * with constant speed over the frames of the benchmark
+	 * \param path the waypoints of the path, at least one
+	 */
+	void setCameraPath(const std::vector<glm::vec3> &path);
+
+	/*!
+	 * Get the position of the camera for a frame
+	 * \param frame the frame to get the camera position for
+	 * \return the interpolated position on the camera path
+	 */
+	glm::vec3 getCameraPosition(unsigned int frame) const;
+
+	/*!
+	 * Run a function and record its duration as a load stage
+	 * \param name the name of the stage
+	 * \param function the function to run
+	 */
+	template<typename F>
+	void measureStage(const std::string &name, F function) {
+		const auto start = std::chrono::steady_clock::now();
+		function();
+		addStage(name, std::chrono::steady_clock::now() - start);
+	}
+
+	/*!
+	 * Record the duration of a load stage
+	 * \param name the name of the stage
+	 * \param duration the time the stage took
+	 */
+	void addStage(const std::string &name, std::chrono::nanoseconds duration);
+
+	/*!
+	 * Record if the episode was restored from its snapshot
+	 * \param restored if the snapshot of the episode was used
+	 */
+	void setEpisodeSnapshot(bool restored);
+
+	/*!
+	 * Record a frame
+	 * \param duration the time the frame took
+	 * \param numDrawCalls the number of draw calls of the frame
+	 * \param numVisibleModels the number of models inside the view frustum
+	 * \param numCulledModels the number of models culled by the view frustum
+	 */
+	void addFrame(std::chrono::nanoseconds duration, unsigned int numDrawCalls, unsigned int numVisibleModels,
+				  unsigned int numCulledModels);
+
+	/*!
+	 * Write the results as json
+	 * \param stream the stream to write the results to
+	 */
+	void save(Common::WriteStream &stream) const;
+
+private:
+	std::string _scenario;
+	unsigned int _numFrames;
+
+	std::vector<glm::vec3> _cameraPath;
+
+	std::vector<std::pair<std::string, double>> _stages;
+	bool _episodeSnapshot;
+	std::vector<double> _frameTimes;
+	std::vector<unsigned int> _drawCalls;
+	std::vector<unsigned int> _visibleModels, _culledModels;
+};
+
+#endif //OPENAWE_BENCHMARK_H
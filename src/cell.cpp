@@ -0,0 +1,111 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "src/awe/binarchive.h"
+#include "src/awe/cidfile.h"
+
+#include "src/cell.h"
+#include "src/common/log.h"
+#include "src/common/profiler.h"
+
+Cell::Cell(entt::registry &registry, const std::string &levelFolder, const glm::u32vec2 &position, bool highDetail) :
+	ObjectCollection(registry),
+	_levelFolder(levelFolder),
+	_position(position),
+	_highDetail(highDetail),
+	_loaded(false),
+	_committed(false),
+	_nextStaticObject(0),
+	_nextFoliageInstance(0) {
+}
+
+void Cell::load() {
+	PROFILE_ZONE("Cell::load");
+	const std::string name = fmt::format("{}{:0>3}_{:0>3}", _highDetail ? "HD" : "LD", _position.x, _position.y);
+	LOG_DEBUG("Loading cell {}", name);
+
+	try {
+		std::unique_ptr<Common::ReadStream> cellStream(getResource(fmt::format("{}/{}.bin", _levelFolder, name)));
+		if (!cellStream)
+			throw std::runtime_error(fmt::format("Cell {} not found", name));
+
+		AWE::BINArchive cell(*cellStream);
+
+		std::unique_ptr<Common::ReadStream> staticObjects(cell.getResource("cid_staticobject.bin"));
+		if (staticObjects) {
+			AWE::CIDFile cid(*staticObjects, kStaticObject);
+			_staticObjects = cid.getContainers();
+		}
+
+		std::unique_ptr<Common::ReadStream> foliageData(cell.getResource("cid_foliagedata.bin"));
+		if (foliageData) {
+			AWE::FoliageDataFile foliageDataFile(*foliageData);
+			_foliages = foliageDataFile.getFoliages();
+			_foliageInstances = foliageDataFile.getInstances();
+		}
+	} catch (std::exception &e) {
+		spdlog::warn("Couldn't load cell {}: {}", name, e.what());
+	}
+
+	_loaded.store(true, std::memory_order_release);
+}
+
+size_t Cell::commit(size_t maxObjects) {
+	PROFILE_ZONE("Cell::commit");
+	if (!isLoaded() || _committed)
+		return 0;
+
+	size_t numObjects = 0;
+	for (; _nextStaticObject < _staticObjects.size() && numObjects < maxObjects; ++_nextStaticObject, ++numObjects)
+		ObjectCollection::load(_staticObjects[_nextStaticObject], kStaticObject);
+
+	for (; _nextFoliageInstance < _foliageInstances.size() && numObjects < maxObjects; ++_nextFoliageInstance, ++numObjects) {
+		const auto &instance = _foliageInstances[_nextFoliageInstance];
+		loadFoliage(_foliages[instance.foliageId], instance.position);
+	}
+
+	if (_nextStaticObject == _staticObjects.size() && _nextFoliageInstance == _foliageInstances.size()) {
+		// The parsed data is not needed anymore once every entity exists
+		_committed = true;
+		_staticObjects = std::vector<AWE::Object>();
+		_foliageInstances = std::vector<AWE::FoliageDataFile::Instance>();
+	}
+
+	return numObjects;
+}
+
+bool Cell::isLoaded() const {
+	return _loaded.load(std::memory_order_acquire);
+}
+
+bool Cell::isCommitted() const {
+	return _committed;
+}
+
+const glm::u32vec2 &Cell::getPosition() const {
+	return _position;
+}
+
+bool Cell::isHighDetail() const {
+	return _highDetail;
+}
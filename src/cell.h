@@ -0,0 +1,84 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_CELL_H
+#define OPENAWE_CELL_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "src/awe/foliagedatafile.h"
+
+#include "src/objectcollection.h"
+
+/*!
+ * \brief A single low or high detail cell of a level
+ *
+ * Cells are loaded in two steps. load() reads and parses the archives of the
+ * cell without touching the registry and can therefore run on a worker
+ * thread. commit() afterwards creates the entities on the main thread in
+ * bounded steps, so that streaming a cell never stalls a whole frame. The
+ * same applies to unloading with destroyEntities().
+ */
+class Cell : public ObjectCollection {
+public:
+	Cell(entt::registry &registry, const std::string &levelFolder, const glm::u32vec2 &position, bool highDetail);
+
+	/*!
+	 * Read and parse the data of the cell. This doesn't modify the registry
+	 * and is safe to call from a worker thread
+	 */
+	void load();
+
+	/*!
+	 * Create the entities for the parsed objects of the cell
+	 * \param maxObjects the maximum number of objects to create
+	 * \return the number of created objects
+	 */
+	size_t commit(size_t maxObjects);
+
+	bool isLoaded() const;
+	bool isCommitted() const;
+
+	using ObjectCollection::destroyEntities;
+	using ObjectCollection::getNumEntities;
+
+	const glm::u32vec2 &getPosition() const;
+	bool isHighDetail() const;
+
+private:
+	const std::string _levelFolder;
+	const glm::u32vec2 _position;
+	const bool _highDetail;
+
+	std::atomic_bool _loaded;
+	bool _committed;
+
+	std::vector<AWE::Object> _staticObjects;
+	std::vector<std::string> _foliages;
+	std::vector<AWE::FoliageDataFile::Instance> _foliageInstances;
+	size_t _nextStaticObject, _nextFoliageInstance;
+};
+
+
+#endif //OPENAWE_CELL_H
@@ -0,0 +1,308 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+#include "src/common/aabbtree.h"
+
+namespace Common {
+
+static const uint32_t kNullNode = AABBTree::kInvalidProxy;
+
+/*!
+ * The size of the traversal stack. The height of the balanced tree stays far below for any number of objects
+ * addressable by proxies
+ */
+static const size_t kMaxStackSize = 256;
+
+static BoundBox enlarge(const BoundBox &box, float margin) {
+	return BoundBox{
+		box.xmin - margin, box.ymin - margin, box.zmin - margin,
+		box.xmax + margin, box.ymax + margin, box.zmax + margin
+	};
+}
+
+AABBTree::AABBTree(float margin) : _margin(margin), _root(kNullNode), _freeNodes(kNullNode), _size(0) {
+}
+
+AABBTree::Proxy AABBTree::insert(const BoundBox &box, uint32_t value) {
+	const uint32_t leaf = allocateNode();
+
+	Node &node = _nodes[leaf];
+	node.box = enlarge(box, _margin);
+	node.left = kNullNode;
+	node.right = kNullNode;
+	node.height = 0;
+	node.value = value;
+
+	insertLeaf(leaf);
+	_size++;
+
+	return leaf;
+}
+
+void AABBTree::remove(Proxy proxy) {
+	assert(proxy < _nodes.size() && _nodes[proxy].isLeaf());
+
+	removeLeaf(proxy);
+	freeNode(proxy);
+	_size--;
+}
+
+bool AABBTree::move(Proxy proxy, const BoundBox &box) {
+	assert(proxy < _nodes.size() && _nodes[proxy].isLeaf());
+
+	if (_nodes[proxy].box.contains(box))
+		return false;
+
+	removeLeaf(proxy);
+	_nodes[proxy].box = enlarge(box, _margin);
+	insertLeaf(proxy);
+
+	return true;
+}
+
+void AABBTree::clear() {
+	_nodes.clear();
+	_root = kNullNode;
+	_freeNodes = kNullNode;
+	_size = 0;
+}
+
+uint32_t AABBTree::getValue(Proxy proxy) const {
+	return _nodes[proxy].value;
+}
+
+const BoundBox &AABBTree::getBoundBox(Proxy proxy) const {
+	return _nodes[proxy].box;
+}
+
+size_t AABBTree::size() const {
+	return _size;
+}
+
+unsigned int AABBTree::getHeight() const {
+	return _root == kNullNode ? 0 : _nodes[_root].height;
+}
+
+void AABBTree::query(const BoundBox &box, std::vector<uint32_t> &values) const {
+	traverse([&box](const BoundBox &nodeBox) { return nodeBox.intersect(box); }, values);
+}
+
+void AABBTree::query(const BoundSphere &sphere, std::vector<uint32_t> &values) const {
+	traverse([&sphere](const BoundBox &nodeBox) { return nodeBox.intersect(sphere.position, sphere.radius); }, values);
+}
+
+void AABBTree::query(const Frustum &frustum, std::vector<uint32_t> &values) const {
+	traverse([&frustum](const BoundBox &nodeBox) { return frustum.intersects(nodeBox); }, values);
+}
+
+void AABBTree::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, std::vector<uint32_t> &values) const {
+	const glm::vec3 inverseDirection = 1.0f / direction;
+	traverse([&](const BoundBox &nodeBox) { return nodeBox.intersect(origin, inverseDirection, maxDistance); }, values);
+}
+
+uint32_t AABBTree::allocateNode() {
+	if (_freeNodes == kNullNode) {
+		_nodes.emplace_back();
+		return _nodes.size() - 1;
+	}
+
+	const uint32_t node = _freeNodes;
+	_freeNodes = _nodes[node].parent;
+	return node;
+}
+
+void AABBTree::freeNode(uint32_t node) {
+	_nodes[node].parent = _freeNodes;
+	_nodes[node].height = -1;
+	_freeNodes = node;
+}
+
+void AABBTree::insertLeaf(uint32_t leaf) {
+	if (_root == kNullNode) {
+		_root = leaf;
+		_nodes[leaf].parent = kNullNode;
+		return;
+	}
+
+	// Descend towards the sibling for which the surface area added to the tree is the smallest
+	const BoundBox box = _nodes[leaf].box;
+	uint32_t sibling = _root;
+	while (!_nodes[sibling].isLeaf()) {
+		const Node &node = _nodes[sibling];
+		const float area = node.box.getSurfaceArea();
+		const float combinedArea = node.box.merge(box).getSurfaceArea();
+
+		// Creating a new parent for this node and the leaf, or descending further, which grows this node as well
+		const float cost = 2.0f * combinedArea;
+		const float inheritedCost = 2.0f * (combinedArea - area);
+
+		const auto getCost = [&](uint32_t child) {
+			const BoundBox &childBox = _nodes[child].box;
+			const float childCost = childBox.merge(box).getSurfaceArea() + inheritedCost;
+			return _nodes[child].isLeaf() ? childCost : childCost - childBox.getSurfaceArea();
+		};
+
+		const float leftCost = getCost(node.left);
+		const float rightCost = getCost(node.right);
+		if (cost < leftCost && cost < rightCost)
+			break;
+
+		sibling = leftCost < rightCost ? node.left : node.right;
+	}
+
+	const uint32_t oldParent = _nodes[sibling].parent;
+	const uint32_t newParent = allocateNode();
+
+	Node &parent = _nodes[newParent];
+	parent.box = box.merge(_nodes[sibling].box);
+	parent.parent = oldParent;
+	parent.left = sibling;
+	parent.right = leaf;
+	parent.height = _nodes[sibling].height + 1;
+	parent.value = 0;
+
+	_nodes[sibling].parent = newParent;
+	_nodes[leaf].parent = newParent;
+
+	if (oldParent == kNullNode)
+		_root = newParent;
+	else if (_nodes[oldParent].left == sibling)
+		_nodes[oldParent].left = newParent;
+	else
+		_nodes[oldParent].right = newParent;
+
+	refit(newParent);
+}
+
+void AABBTree::removeLeaf(uint32_t leaf) {
+	if (leaf == _root) {
+		_root = kNullNode;
+		return;
+	}
+
+	// The sibling of the leaf takes the place of their parent
+	const uint32_t parent = _nodes[leaf].parent;
+	const uint32_t grandParent = _nodes[parent].parent;
+	const uint32_t sibling = _nodes[parent].left == leaf ? _nodes[parent].right : _nodes[parent].left;
+
+	_nodes[sibling].parent = grandParent;
+	if (grandParent == kNullNode)
+		_root = sibling;
+	else if (_nodes[grandParent].left == parent)
+		_nodes[grandParent].left = sibling;
+	else
+		_nodes[grandParent].right = sibling;
+
+	freeNode(parent);
+	refit(grandParent);
+}
+
+uint32_t AABBTree::balance(uint32_t a) {
+	Node &nodeA = _nodes[a];
+	if (nodeA.isLeaf() || nodeA.height < 2)
+		return a;
+
+	const uint32_t b = nodeA.left;
+	const uint32_t c = nodeA.right;
+	Node &nodeB = _nodes[b];
+	Node &nodeC = _nodes[c];
+
+	const int difference = nodeC.height - nodeB.height;
+	if (difference >= -1 && difference <= 1)
+		return a;
+
+	// The taller child takes the place of the node, which takes over the shorter grandchild
+	const uint32_t up = difference > 1 ? c : b;
+	Node &nodeUp = _nodes[up];
+	Node &nodeOther = difference > 1 ? nodeB : nodeC;
+
+	const uint32_t f = nodeUp.left;
+	const uint32_t g = nodeUp.right;
+	const bool keepLeft = _nodes[f].height > _nodes[g].height;
+	const uint32_t kept = keepLeft ? f : g;
+	const uint32_t moved = keepLeft ? g : f;
+
+	nodeUp.left = a;
+	nodeUp.right = kept;
+	nodeUp.parent = nodeA.parent;
+	nodeA.parent = up;
+	_nodes[moved].parent = a;
+
+	if (nodeUp.parent == kNullNode)
+		_root = up;
+	else if (_nodes[nodeUp.parent].left == a)
+		_nodes[nodeUp.parent].left = up;
+	else
+		_nodes[nodeUp.parent].right = up;
+
+	if (difference > 1)
+		nodeA.right = moved;
+	else
+		nodeA.left = moved;
+
+	nodeA.box = nodeOther.box.merge(_nodes[moved].box);
+	nodeA.height = 1 + std::max(nodeOther.height, _nodes[moved].height);
+	nodeUp.box = nodeA.box.merge(_nodes[kept].box);
+	nodeUp.height = 1 + std::max(nodeA.height, _nodes[kept].height);
+
+	return up;
+}
+
+void AABBTree::refit(uint32_t node) {
+	while (node != kNullNode) {
+		node = balance(node);
+
+		Node &current = _nodes[node];
+		current.box = _nodes[current.left].box.merge(_nodes[current.right].box);
+		current.height = 1 + std::max(_nodes[current.left].height, _nodes[current.right].height);
+
+		node = current.parent;
+	}
+}
+
+template<typename Test>
+void AABBTree::traverse(const Test &test, std::vector<uint32_t> &values) const {
+	if (_root == kNullNode)
+		return;
+
+	std::array<uint32_t, kMaxStackSize> stack;
+	size_t stackSize = 0;
+	stack[stackSize++] = _root;
+
+	while (stackSize > 0) {
+		const Node &node = _nodes[stack[--stackSize]];
+		if (!test(node.box))
+			continue;
+
+		if (node.isLeaf()) {
+			values.emplace_back(node.value);
+			continue;
+		}
+
+		stack[stackSize++] = node.right;
+		stack[stackSize++] = node.left;
+	}
+}
+
+} // End of namespace Common
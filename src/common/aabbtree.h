@@ -0,0 +1,180 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_AABBTREE_H
+#define OPENAWE_AABBTREE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "src/common/frustum.h"
+#include "src/common/types.h"
+
+namespace Common {
+
+/*!
+ * \brief A dynamic tree of axis aligned bounding boxes for moving objects
+ *
+ * Every object is stored in a leaf with its box enlarged by a margin, so
+ * that small movements don't change the tree. An object leaving its
+ * enlarged box is removed and inserted again as sibling of the node whose
+ * surface area grows the least, and the tree is kept balanced by rotations
+ * on the way back to the root. Objects are referenced by proxies, which stay
+ * valid until the object is removed, and identified by a value, which the
+ * queries return.
+ *
+ * Queries append the values of all objects whose enlarged boxes pass the
+ * test to the given vector without clearing it, so that several trees can
+ * be queried into the same results.
+ */
+class AABBTree {
+public:
+	typedef uint32_t Proxy;
+
+	static constexpr Proxy kInvalidProxy = 0xFFFFFFFF;
+
+	/*!
+	 * Create a new empty tree
+	 * \param margin the distance by which the boxes of objects are enlarged
+	 */
+	explicit AABBTree(float margin = 0.5f);
+
+	/*!
+	 * Insert an object into the tree
+	 * \param box the box of the object
+	 * \param value the value returned by queries finding the object
+	 * \return the proxy of the object
+	 */
+	Proxy insert(const BoundBox &box, uint32_t value);
+
+	/*!
+	 * Remove an object from the tree, which invalidates its proxy
+	 * \param proxy the proxy of the object
+	 */
+	void remove(Proxy proxy);
+
+	/*!
+	 * Update the box of an object
+	 * \param proxy the proxy of the object
+	 * \param box the new box of the object
+	 * \return if the object left its enlarged box and was reinserted
+	 */
+	bool move(Proxy proxy, const BoundBox &box);
+
+	/*!
+	 * Remove all objects from the tree
+	 */
+	void clear();
+
+	uint32_t getValue(Proxy proxy) const;
+
+	/*!
+	 * Get the box of an object enlarged by the margin of the tree
+	 * \param proxy the proxy of the object
+	 * \return the enlarged box of the object
+	 */
+	const BoundBox &getBoundBox(Proxy proxy) const;
+
+	size_t size() const;
+
+	/*!
+	 * Get the height of the tree, which grows logarithmically with the number of objects
+	 * \return the number of levels below the root
+	 */
+	unsigned int getHeight() const;
+
+	/*!
+	 * Find the objects intersecting a box
+	 * \param box the box to test against
+	 * \param values the vector to which the values of the found objects are added
+	 */
+	void query(const BoundBox &box, std::vector<uint32_t> &values) const;
+
+	/*!
+	 * Find the objects intersecting a sphere
+	 * \param sphere the sphere to test against
+	 * \param values the vector to which the values of the found objects are added
+	 */
+	void query(const BoundSphere &sphere, std::vector<uint32_t> &values) const;
+
+	/*!
+	 * Find the objects inside or intersecting a view frustum
+	 * \param frustum the frustum to test against
+	 * \param values the vector to which the values of the found objects are added
+	 */
+	void query(const Frustum &frustum, std::vector<uint32_t> &values) const;
+
+	/*!
+	 * Find the objects hit by a ray in no particular order
+	 * \param origin the start of the ray
+	 * \param direction the normalized direction of the ray
+	 * \param maxDistance the length of the ray
+	 * \param values the vector to which the values of the found objects are added
+	 */
+	void raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, std::vector<uint32_t> &values) const;
+
+private:
+	struct Node {
+		BoundBox box;
+		uint32_t parent; // The parent of used nodes or the next free node
+		uint32_t left, right;
+		int height; // Zero for leafs and -1 for free nodes
+		uint32_t value;
+
+		bool isLeaf() const {
+			return height == 0;
+		}
+	};
+
+	uint32_t allocateNode();
+	void freeNode(uint32_t node);
+
+	void insertLeaf(uint32_t leaf);
+	void removeLeaf(uint32_t leaf);
+
+	/*!
+	 * Rotate the taller child of a node up, if the heights of its children differ by more than one
+	 * \param node the node to balance
+	 * \return the node now at the position of the given node
+	 */
+	uint32_t balance(uint32_t node);
+
+	/*!
+	 * Update the boxes and heights from a node up to the root, balancing every node on the way
+	 * \param node the first node to update
+	 */
+	void refit(uint32_t node);
+
+	template<typename Test>
+	void traverse(const Test &test, std::vector<uint32_t> &values) const;
+
+	const float _margin;
+
+	std::vector<Node> _nodes;
+	uint32_t _root;
+	uint32_t _freeNodes;
+	size_t _size;
+};
+
+} // End of namespace Common
+
+#endif //OPENAWE_AABBTREE_H
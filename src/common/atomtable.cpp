@@ -0,0 +1,83 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <mutex>
+#include <stdexcept>
+
+#include "src/common/atomtable.h"
+
+namespace Common {
+
+AtomTable::AtomTable() {
+	_strings.emplace_back();
+	_atoms[_strings.back()] = kEmptyAtom;
+}
+
+Atom AtomTable::intern(std::string_view str) {
+	if (str.empty())
+		return kEmptyAtom;
+
+	{
+		std::shared_lock l(_access);
+		const auto iter = _atoms.find(str);
+		if (iter != _atoms.end())
+			return iter->second;
+	}
+
+	std::unique_lock l(_access);
+
+	// Check again, since another thread could have added the string in the meantime
+	const auto iter = _atoms.find(str);
+	if (iter != _atoms.end())
+		return iter->second;
+
+	const auto atom = static_cast<Atom>(_strings.size());
+	_strings.emplace_back(str);
+	_atoms[_strings.back()] = atom;
+
+	return atom;
+}
+
+bool AtomTable::find(std::string_view str, Atom &atom) const {
+	std::shared_lock l(_access);
+
+	const auto iter = _atoms.find(str);
+	if (iter == _atoms.end())
+		return false;
+
+	atom = iter->second;
+	return true;
+}
+
+std::string_view AtomTable::getString(Atom atom) const {
+	std::shared_lock l(_access);
+
+	if (atom >= _strings.size())
+		throw std::runtime_error("Invalid atom");
+
+	return _strings[atom];
+}
+
+size_t AtomTable::size() const {
+	std::shared_lock l(_access);
+	return _strings.size();
+}
+
+} // End of namespace Common
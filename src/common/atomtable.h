@@ -0,0 +1,95 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMON_ATOMTABLE_H
+#define COMMON_ATOMTABLE_H
+
+#include <cstdint>
+
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "src/common/singleton.h"
+
+namespace Common {
+
+/*!
+ * A small integer representing an interned string. Equal strings always
+ * get the same atom, so atoms can be compared and hashed instead of the
+ * strings itself. The atom 0 always represents the empty string.
+ */
+typedef uint32_t Atom;
+
+static const Atom kEmptyAtom = 0;
+
+/*!
+ * \brief Table of interned strings
+ *
+ * The atom table stores every string given to it exactly once and assigns
+ * it a stable atom. The string data stays valid for the lifetime of the
+ * table, so views obtained by getString can be held indefinitely. The
+ * table is safe to be used from multiple threads.
+ */
+class AtomTable : public Singleton<AtomTable> {
+public:
+	AtomTable();
+
+	/*!
+	 * Get the atom for a string, adding the string if it is not already in the table
+	 * \param str the string to intern
+	 * \return the atom representing the string
+	 */
+	Atom intern(std::string_view str);
+
+	/*!
+	 * Get the atom for a string without adding it to the table
+	 * \param str the string to look for
+	 * \param atom the atom of the string if found
+	 * \return if the string was found in the table
+	 */
+	bool find(std::string_view str, Atom &atom) const;
+
+	/*!
+	 * Get the string represented by an atom
+	 * \param atom the atom to get the string for
+	 * \return a view to the string, which stays valid for the lifetime of the table
+	 */
+	std::string_view getString(Atom atom) const;
+
+	/*!
+	 * Get the number of strings in the table including the empty string
+	 * \return the number of strings in the table
+	 */
+	size_t size() const;
+
+private:
+	mutable std::shared_mutex _access;
+	std::deque<std::string> _strings;
+	std::unordered_map<std::string_view, Atom> _atoms;
+};
+
+} // End of namespace Common
+
+#define Atoms Common::AtomTable::instance()
+
+#endif // COMMON_ATOMTABLE_H
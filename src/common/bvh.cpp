@@ -0,0 +1,226 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "src/common/bvh.h"
+
+namespace Common {
+
+/*!
+ * The number of objects up to which a node becomes a leaf
+ */
+static const uint32_t kMaxLeafObjects = 4;
+
+/*!
+ * The number of bins into which the objects are sorted to evaluate the surface area heuristic
+ */
+static const unsigned int kNumBins = 16;
+
+/*!
+ * The depth at which nodes become leafs regardless of their number of objects, which bounds the stack needed for
+ * traversing the hierarchy
+ */
+static const unsigned int kMaxDepth = 62;
+
+BVH::BVH(const std::vector<Object> &objects) {
+	if (objects.empty())
+		return;
+
+	const uint32_t numObjects = objects.size();
+	std::vector<glm::vec3> centers(numObjects);
+	std::vector<uint32_t> order(numObjects);
+	for (uint32_t i = 0; i < numObjects; ++i) {
+		centers[i] = objects[i].first.getCenter();
+		order[i] = i;
+	}
+
+	struct Range {
+		uint32_t node, first, count, depth;
+	};
+
+	// A binary tree with at least one object per leaf never has more than 2n - 1 nodes
+	_nodes.reserve(2 * numObjects - 1);
+	_nodes.emplace_back();
+
+	std::vector<Range> ranges{{0, 0, numObjects, 0}};
+	while (!ranges.empty()) {
+		const Range range = ranges.back();
+		ranges.pop_back();
+
+		const auto begin = order.begin() + range.first, end = begin + range.count;
+
+		BoundBox box = objects[*begin].first;
+		glm::vec3 centerMin = centers[*begin], centerMax = centerMin;
+		for (auto iter = begin + 1; iter != end; ++iter) {
+			box = box.merge(objects[*iter].first);
+			centerMin = glm::min(centerMin, centers[*iter]);
+			centerMax = glm::max(centerMax, centers[*iter]);
+		}
+
+		Node &node = _nodes[range.node];
+		node.box = box;
+		node.first = range.first;
+		node.count = range.count;
+
+		if (range.count <= kMaxLeafObjects || range.depth >= kMaxDepth)
+			continue;
+
+		// Split along the axis in which the centers are spread the most
+		const glm::vec3 extent = centerMax - centerMin;
+		unsigned int axis = 0;
+		if (extent.y > extent[axis])
+			axis = 1;
+		if (extent.z > extent[axis])
+			axis = 2;
+
+		auto middle = begin + range.count / 2;
+		if (extent[axis] > 0.0f) {
+			// Sort the centers into bins and split between the two bins with the lowest surface area cost
+			const float scale = kNumBins / extent[axis];
+			const auto getBin = [&](uint32_t object) {
+				return std::min(static_cast<unsigned int>((centers[object][axis] - centerMin[axis]) * scale), kNumBins - 1);
+			};
+
+			std::array<BoundBox, kNumBins> binBoxes;
+			std::array<uint32_t, kNumBins> binCounts{};
+			for (auto iter = begin; iter != end; ++iter) {
+				const unsigned int bin = getBin(*iter);
+				binBoxes[bin] = binCounts[bin] == 0 ? objects[*iter].first : binBoxes[bin].merge(objects[*iter].first);
+				binCounts[bin]++;
+			}
+
+			// The cost of all bins right of a split, indexed by the first bin of the right side
+			std::array<float, kNumBins> rightCosts{};
+			std::array<uint32_t, kNumBins> rightCounts{};
+			BoundBox rightBox{};
+			uint32_t rightCount = 0;
+			for (unsigned int bin = kNumBins - 1; bin > 0; --bin) {
+				if (binCounts[bin] > 0) {
+					rightBox = rightCount == 0 ? binBoxes[bin] : rightBox.merge(binBoxes[bin]);
+					rightCount += binCounts[bin];
+				}
+				rightCosts[bin] = rightCount * (rightCount == 0 ? 0.0f : rightBox.getSurfaceArea());
+				rightCounts[bin] = rightCount;
+			}
+
+			// The lowest and highest center fall into the first and last bin, so there is always a valid split
+			unsigned int split = 1;
+			float bestCost = std::numeric_limits<float>::max();
+			BoundBox leftBox{};
+			uint32_t leftCount = 0;
+			for (unsigned int bin = 0; bin < kNumBins - 1; ++bin) {
+				if (binCounts[bin] > 0) {
+					leftBox = leftCount == 0 ? binBoxes[bin] : leftBox.merge(binBoxes[bin]);
+					leftCount += binCounts[bin];
+				}
+				if (leftCount == 0 || rightCounts[bin + 1] == 0)
+					continue;
+
+				const float cost = leftCount * leftBox.getSurfaceArea() + rightCosts[bin + 1];
+				if (cost < bestCost) {
+					bestCost = cost;
+					split = bin + 1;
+				}
+			}
+
+			middle = std::partition(begin, end, [&](uint32_t object) { return getBin(object) < split; });
+		}
+
+		const uint32_t left = _nodes.size();
+		const uint32_t leftCount = middle - begin;
+		_nodes[range.node].first = left;
+		_nodes[range.node].count = 0;
+		_nodes.emplace_back();
+		_nodes.emplace_back();
+
+		ranges.push_back({left, range.first, leftCount, range.depth + 1});
+		ranges.push_back({left + 1, range.first + leftCount, range.count - leftCount, range.depth + 1});
+	}
+
+	// Store the objects in the order of the leafs, so that every leaf references a continuous range
+	_boxes.reserve(numObjects);
+	_values.reserve(numObjects);
+	for (const auto object : order) {
+		_boxes.emplace_back(objects[object].first);
+		_values.emplace_back(objects[object].second);
+	}
+}
+
+size_t BVH::size() const {
+	return _values.size();
+}
+
+bool BVH::empty() const {
+	return _values.empty();
+}
+
+const BoundBox &BVH::getBoundBox() const {
+	return _nodes.front().box;
+}
+
+void BVH::query(const BoundBox &box, std::vector<uint32_t> &values) const {
+	traverse([&box](const BoundBox &nodeBox) { return nodeBox.intersect(box); }, values);
+}
+
+void BVH::query(const BoundSphere &sphere, std::vector<uint32_t> &values) const {
+	traverse([&sphere](const BoundBox &nodeBox) { return nodeBox.intersect(sphere.position, sphere.radius); }, values);
+}
+
+void BVH::query(const Frustum &frustum, std::vector<uint32_t> &values) const {
+	traverse([&frustum](const BoundBox &nodeBox) { return frustum.intersects(nodeBox); }, values);
+}
+
+void BVH::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, std::vector<uint32_t> &values) const {
+	const glm::vec3 inverseDirection = 1.0f / direction;
+	traverse([&](const BoundBox &nodeBox) { return nodeBox.intersect(origin, inverseDirection, maxDistance); }, values);
+}
+
+template<typename Test>
+void BVH::traverse(const Test &test, std::vector<uint32_t> &values) const {
+	if (_nodes.empty())
+		return;
+
+	// Every level of the hierarchy leaves at most one sibling on the stack
+	std::array<uint32_t, kMaxDepth + 2> stack;
+	size_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const Node &node = _nodes[stack[--stackSize]];
+		if (!test(node.box))
+			continue;
+
+		if (node.count == 0) {
+			stack[stackSize++] = node.first + 1;
+			stack[stackSize++] = node.first;
+			continue;
+		}
+
+		for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+			if (test(_boxes[i]))
+				values.emplace_back(_values[i]);
+		}
+	}
+}
+
+} // End of namespace Common
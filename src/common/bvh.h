@@ -0,0 +1,116 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_BVH_H
+#define OPENAWE_BVH_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "src/common/frustum.h"
+#include "src/common/types.h"
+
+namespace Common {
+
+/*!
+ * \brief A bounding volume hierarchy over objects which never move
+ *
+ * The hierarchy is built once over all objects, splitting them with the
+ * surface area heuristic, and stored as a flat array of nodes with the
+ * objects of every leaf next to each other. It can't be changed afterwards,
+ * so objects which move belong into an AABBTree instead. Every object is
+ * identified by a value, which the queries return.
+ *
+ * Queries append the values of all objects whose boxes pass the test to the
+ * given vector without clearing it, so that several hierarchies can be
+ * queried into the same results.
+ */
+class BVH {
+public:
+	typedef std::pair<BoundBox, uint32_t> Object;
+
+	BVH() = default;
+
+	/*!
+	 * Build a hierarchy over a list of objects
+	 * \param objects the boxes of the objects together with their values
+	 */
+	explicit BVH(const std::vector<Object> &objects);
+
+	size_t size() const;
+	bool empty() const;
+
+	/*!
+	 * Get the box around all objects of the hierarchy
+	 * \return the bounding box of the root node, which is only valid if the hierarchy is not empty
+	 */
+	const BoundBox &getBoundBox() const;
+
+	/*!
+	 * Find the objects intersecting a box
+	 * \param box the box to test against
+	 * \param values the vector to which the values of the found objects are added
+	 */
+	void query(const BoundBox &box, std::vector<uint32_t> &values) const;
+
+	/*!
+	 * Find the objects intersecting a sphere
+	 * \param sphere the sphere to test against
+	 * \param values the vector to which the values of the found objects are added
+	 */
+	void query(const BoundSphere &sphere, std::vector<uint32_t> &values) const;
+
+	/*!
+	 * Find the objects inside or intersecting a view frustum
+	 * \param frustum the frustum to test against
+	 * \param values the vector to which the values of the found objects are added
+	 */
+	void query(const Frustum &frustum, std::vector<uint32_t> &values) const;
+
+	/*!
+	 * Find the objects hit by a ray in no particular order
+	 * \param origin the start of the ray
+	 * \param direction the normalized direction of the ray
+	 * \param maxDistance the length of the ray
+	 * \param values the vector to which the values of the found objects are added
+	 */
+	void raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, std::vector<uint32_t> &values) const;
+
+private:
+	struct Node {
+		BoundBox box;
+		uint32_t first; // The first of both children for inner nodes or the first object for leafs
+		uint32_t count; // The number of objects for leafs or zero for inner nodes
+	};
+
+	template<typename Test>
+	void traverse(const Test &test, std::vector<uint32_t> &values) const;
+
+	std::vector<Node> _nodes;
+	std::vector<BoundBox> _boxes;
+	std::vector<uint32_t> _values;
+};
+
+} // End of namespace Common
+
+#endif //OPENAWE_BVH_H
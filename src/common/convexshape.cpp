@@ -26,10 +26,14 @@
 
 namespace Common {
 
-ConvexShape::ConvexShape(const std::vector<glm::vec2> &points) : _lines(generateLines(points)) {
+ConvexShape::ConvexShape(const std::vector<glm::vec2> &points) : _points(points), _lines(generateLines(points)) {
 
 }
 
+const std::vector<glm::vec2> &ConvexShape::getPoints() const {
+	return _points;
+}
+
 bool ConvexShape::intersect(const glm::vec3 &position) const {
 	return intersect(glm::vec2(position.x, position.y));
 }
@@ -35,6 +35,8 @@ public:
 	bool intersect(const glm::vec3 &position) const;
 	bool intersect(const glm::vec2 &position) const;
 
+	const std::vector<glm::vec2> &getPoints() const;
+
 private:
 	struct Line {
 		glm::vec2 p1, p2;
@@ -49,6 +51,7 @@ private:
 	bool intersect(Line l1, Line l2) const;
 	std::vector<Line> generateLines(std::vector<glm::vec2> points) const;
 
+	std::vector<glm::vec2> _points;
 	std::vector<Line> _lines;
 };
 
@@ -0,0 +1,200 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define OPENAWE_FRUSTUM_SSE
+#endif
+
+#include "src/common/frustum.h"
+
+namespace Common {
+
+void BoundSpheres::clear() {
+	_x.clear();
+	_y.clear();
+	_z.clear();
+	_radius.clear();
+}
+
+void BoundSpheres::reserve(size_t size) {
+	_x.reserve(size);
+	_y.reserve(size);
+	_z.reserve(size);
+	_radius.reserve(size);
+}
+
+void BoundSpheres::add(const BoundSphere &sphere) {
+	_x.emplace_back(sphere.position.x);
+	_y.emplace_back(sphere.position.y);
+	_z.emplace_back(sphere.position.z);
+	_radius.emplace_back(sphere.radius);
+}
+
+size_t BoundSpheres::size() const {
+	return _radius.size();
+}
+
+const float *BoundSpheres::getX() const {
+	return _x.data();
+}
+
+const float *BoundSpheres::getY() const {
+	return _y.data();
+}
+
+const float *BoundSpheres::getZ() const {
+	return _z.data();
+}
+
+const float *BoundSpheres::getRadius() const {
+	return _radius.data();
+}
+
+Frustum::Frustum(const glm::mat4 &viewProjection) {
+	// Extract the planes from the rows of the matrix, as described by Gribb and Hartmann
+	const glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+	const glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+	const glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+	const glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+	_planes = {
+		row3 + row0,
+		row3 - row0,
+		row3 + row1,
+		row3 - row1,
+		row3 + row2,
+		row3 - row2
+	};
+
+	// Normalize the planes, so that the distance of a point to a plane can be compared with a radius
+	for (auto &plane : _planes) {
+		const float length = glm::length(glm::vec3(plane));
+		if (length > 0.0f)
+			plane /= length;
+	}
+}
+
+const std::array<glm::vec4, 6> &Frustum::getPlanes() const {
+	return _planes;
+}
+
+bool Frustum::intersects(const BoundSphere &sphere) const {
+	// Summed in the same order as the vectorized culling, so that both always agree
+	for (const auto &plane : _planes) {
+		const float distance = sphere.position.x * plane.x + plane.w + sphere.position.y * plane.y + sphere.position.z * plane.z;
+		if (!(distance >= -sphere.radius))
+			return false;
+	}
+
+	return true;
+}
+
+bool Frustum::intersects(const BoundBox &box) const {
+	for (const auto &plane : _planes) {
+		// Only the corner furthest along the normal of the plane has to be tested
+		const glm::vec3 corner(
+			plane.x >= 0.0f ? box.xmax : box.xmin,
+			plane.y >= 0.0f ? box.ymax : box.ymin,
+			plane.z >= 0.0f ? box.zmax : box.zmin
+		);
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+			return false;
+	}
+
+	return true;
+}
+
+size_t Frustum::cull(const BoundSpheres &spheres, std::vector<byte> &visible) const {
+	const size_t count = spheres.size();
+	visible.resize(count);
+
+	const float *x = spheres.getX();
+	const float *y = spheres.getY();
+	const float *z = spheres.getZ();
+	const float *radius = spheres.getRadius();
+
+	size_t first = 0, numVisible = 0;
+
+#if defined(__AVX__)
+	for (; first + 8 <= count; first += 8) {
+		const __m256 sphereX = _mm256_loadu_ps(x + first);
+		const __m256 sphereY = _mm256_loadu_ps(y + first);
+		const __m256 sphereZ = _mm256_loadu_ps(z + first);
+		const __m256 negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radius + first));
+
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (const auto &plane : _planes) {
+			__m256 distance = _mm256_add_ps(_mm256_mul_ps(sphereX, _mm256_set1_ps(plane.x)), _mm256_set1_ps(plane.w));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(sphereY, _mm256_set1_ps(plane.y)));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(sphereZ, _mm256_set1_ps(plane.z)));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negativeRadius, _CMP_GE_OQ));
+		}
+
+		const int mask = _mm256_movemask_ps(inside);
+		for (unsigned int i = 0; i < 8; ++i) {
+			visible[first + i] = (mask >> i) & 1;
+			numVisible += visible[first + i];
+		}
+	}
+#elif defined(OPENAWE_FRUSTUM_SSE)
+	for (; first + 4 <= count; first += 4) {
+		const __m128 sphereX = _mm_loadu_ps(x + first);
+		const __m128 sphereY = _mm_loadu_ps(y + first);
+		const __m128 sphereZ = _mm_loadu_ps(z + first);
+		const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + first));
+
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (const auto &plane : _planes) {
+			__m128 distance = _mm_add_ps(_mm_mul_ps(sphereX, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+			distance = _mm_add_ps(distance, _mm_mul_ps(sphereY, _mm_set1_ps(plane.y)));
+			distance = _mm_add_ps(distance, _mm_mul_ps(sphereZ, _mm_set1_ps(plane.z)));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+		}
+
+		const int mask = _mm_movemask_ps(inside);
+		for (unsigned int i = 0; i < 4; ++i) {
+			visible[first + i] = (mask >> i) & 1;
+			numVisible += visible[first + i];
+		}
+	}
+#endif
+
+	// The remaining spheres, which don't fill a whole register
+	return numVisible + cullScalar(spheres, first, visible.data());
+}
+
+size_t Frustum::cullScalar(const BoundSpheres &spheres, size_t first, byte *visible) const {
+	size_t numVisible = 0;
+	for (size_t i = first; i < spheres.size(); ++i) {
+		const BoundSphere sphere{
+			glm::vec3(spheres.getX()[i], spheres.getY()[i], spheres.getZ()[i]),
+			spheres.getRadius()[i]
+		};
+		visible[i] = intersects(sphere) ? 1 : 0;
+		numVisible += visible[i];
+	}
+
+	return numVisible;
+}
+
+} // End of namespace Common
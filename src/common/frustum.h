@@ -0,0 +1,110 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_FRUSTUM_H
+#define OPENAWE_FRUSTUM_H
+
+#include <array>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "src/common/types.h"
+
+namespace Common {
+
+/*!
+ * \brief Bounding spheres stored as structure of arrays
+ *
+ * Storing every component in its own array allows testing several spheres
+ * at once with SIMD instructions.
+ */
+class BoundSpheres {
+public:
+	void clear();
+	void reserve(size_t size);
+	void add(const BoundSphere &sphere);
+
+	size_t size() const;
+
+	const float *getX() const;
+	const float *getY() const;
+	const float *getZ() const;
+	const float *getRadius() const;
+
+private:
+	std::vector<float> _x, _y, _z, _radius;
+};
+
+/*!
+ * \brief A view frustum for culling bounding volumes
+ *
+ * The six planes of the frustum are extracted from a view projection
+ * matrix with the normals pointing inside. A sphere is visible if it is not
+ * completely outside of any plane, which is conservative for spheres near
+ * the corners of the frustum. Culling many spheres uses AVX to test eight
+ * spheres at once if it is enabled at compile time, SSE2 to test four if it
+ * is available and plain C++ otherwise, all with the same results.
+ */
+class Frustum {
+public:
+	/*!
+	 * Create the frustum of a view projection matrix
+	 * \param viewProjection the matrix transforming world coordinates into OpenGL clip space
+	 */
+	explicit Frustum(const glm::mat4 &viewProjection);
+
+	/*!
+	 * Get the normalized planes of the frustum
+	 * \return the left, right, bottom, top, near and far plane as normal and distance
+	 */
+	const std::array<glm::vec4, 6> &getPlanes() const;
+
+	/*!
+	 * Check if a sphere is inside or intersects the frustum
+	 * \param sphere the sphere to check
+	 * \return if the sphere is potentially visible
+	 */
+	bool intersects(const BoundSphere &sphere) const;
+
+	/*!
+	 * Check if an axis aligned box is inside or intersects the frustum
+	 * \param box the box to check
+	 * \return if the box is at least partially inside of the frustum
+	 */
+	bool intersects(const BoundBox &box) const;
+
+	/*!
+	 * Check which of a number of spheres are inside or intersect the frustum
+	 * \param spheres the spheres to check
+	 * \param visible receives 1 for every potentially visible sphere and 0 for every other, in the order of the spheres
+	 * \return the number of potentially visible spheres
+	 */
+	size_t cull(const BoundSpheres &spheres, std::vector<byte> &visible) const;
+
+private:
+	size_t cullScalar(const BoundSpheres &spheres, size_t first, byte *visible) const;
+
+	std::array<glm::vec4, 6> _planes;
+};
+
+} // End of namespace Common
+
+#endif //OPENAWE_FRUSTUM_H
@@ -0,0 +1,68 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SRC_COMMON_LOG_H
+#define SRC_COMMON_LOG_H
+
+#include <spdlog/spdlog.h>
+
+/*
+ * Logging macros, which check the level of the default logger before their
+ * arguments are evaluated. Expensive arguments like gid lookups therefore
+ * cost nothing if the level is disabled at runtime. Levels below
+ * OPENAWE_LOG_LEVEL are removed at compile time completely, which is used
+ * to strip trace and debug messages from release builds.
+ */
+
+#ifndef OPENAWE_LOG_LEVEL
+#	define OPENAWE_LOG_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+#define LOG_CALL(level, ...) \
+	do { \
+		if (spdlog::default_logger_raw()->should_log(level)) \
+			spdlog::default_logger_raw()->log(level, __VA_ARGS__); \
+	} while (false)
+
+#if OPENAWE_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
+#	define LOG_TRACE(...) LOG_CALL(spdlog::level::trace, __VA_ARGS__)
+#else
+#	define LOG_TRACE(...) do {} while (false)
+#endif
+
+#if OPENAWE_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
+#	define LOG_DEBUG(...) LOG_CALL(spdlog::level::debug, __VA_ARGS__)
+#else
+#	define LOG_DEBUG(...) do {} while (false)
+#endif
+
+#if OPENAWE_LOG_LEVEL <= SPDLOG_LEVEL_INFO
+#	define LOG_INFO(...) LOG_CALL(spdlog::level::info, __VA_ARGS__)
+#else
+#	define LOG_INFO(...) do {} while (false)
+#endif
+
+#if OPENAWE_LOG_LEVEL <= SPDLOG_LEVEL_WARN
+#	define LOG_WARN(...) LOG_CALL(spdlog::level::warn, __VA_ARGS__)
+#else
+#	define LOG_WARN(...) do {} while (false)
+#endif
+
+#endif // SRC_COMMON_LOG_H
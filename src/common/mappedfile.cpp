@@ -0,0 +1,124 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "src/common/mappedfile.h"
+
+#if OS_LINUX || OS_MACOS
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace Common {
+
+MappedFile::MappedFile(const std::string &file) : _data(nullptr), _size(0), _position(0) {
+	if (!std::filesystem::is_regular_file(file))
+		throw std::runtime_error("file not found");
+
+#if OS_LINUX || OS_MACOS
+	int fd = open(file.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw std::runtime_error("Couldn't open file for mapping");
+
+	struct stat fileStat{};
+	if (fstat(fd, &fileStat) != 0) {
+		close(fd);
+		throw std::runtime_error("Couldn't determine size of mapped file");
+	}
+
+	_size = fileStat.st_size;
+	if (_size > 0) {
+		void *data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) {
+			close(fd);
+			throw std::runtime_error("Couldn't map file");
+		}
+
+		_data = static_cast<const byte *>(data);
+	}
+
+	// The mapping stays valid after the descriptor is closed
+	close(fd);
+#else
+	std::ifstream in(file, std::ios::binary);
+	_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	_data = _buffer.data();
+	_size = _buffer.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if OS_LINUX || OS_MACOS
+	if (_data)
+		munmap(const_cast<byte *>(_data), _size);
+#endif
+}
+
+const byte *MappedFile::getData() const {
+	return _data;
+}
+
+size_t MappedFile::size() const {
+	return _size;
+}
+
+size_t MappedFile::read(void *data, size_t length) {
+	size_t sizeToRead = std::min(length, _size - std::min(_position, _size));
+	std::memcpy(data, _data + _position, sizeToRead);
+	_position += sizeToRead;
+	return sizeToRead;
+}
+
+void MappedFile::seek(ptrdiff_t length, ReadStream::SeekOrigin origin) {
+	ptrdiff_t position = 0;
+	switch (origin) {
+		case BEGIN:
+			position = length;
+			break;
+		case CURRENT:
+			position = _position + length;
+			break;
+		case END:
+			position = _size + length;
+			break;
+	}
+
+	if (position < 0 || static_cast<size_t>(position) > _size)
+		throw std::runtime_error("Mapped file out of bounds");
+
+	_position = position;
+}
+
+bool MappedFile::eos() const {
+	return _position >= _size;
+}
+
+size_t MappedFile::pos() const {
+	return _position;
+}
+
+} // End of namespace Common
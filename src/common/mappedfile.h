@@ -0,0 +1,78 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SRC_COMMON_MAPPEDFILE_H
+#define SRC_COMMON_MAPPEDFILE_H
+
+#include <string>
+#include <vector>
+
+#include "src/common/readstream.h"
+#include "src/common/types.h"
+
+namespace Common {
+
+/*!
+ * \brief Read only stream over a memory mapped file
+ *
+ * Maps a whole file into memory and allows to access its contents either as
+ * a regular read stream or directly through a pointer, which allows to read
+ * large structures without copying them first. On platforms without mmap
+ * the file is read into memory instead.
+ */
+class MappedFile : public ReadStream, Noncopyable {
+public:
+	/*!
+	 * Map the given file into memory
+	 * \param file the file to map
+	 */
+	explicit MappedFile(const std::string &file);
+	~MappedFile();
+
+	/*!
+	 * Get a pointer to the mapped data of the file
+	 * \return the pointer to the beginning of the mapped file
+	 */
+	const byte *getData() const;
+
+	/*!
+	 * Get the size of the mapped file
+	 * \return the size of the mapped file in bytes
+	 */
+	size_t size() const;
+
+	size_t read(void *data, size_t length) override;
+
+	size_t pos() const override;
+
+	bool eos() const override;
+
+	void seek(ptrdiff_t length, SeekOrigin origin) override;
+
+private:
+	const byte *_data;
+	size_t _size, _position;
+
+	std::vector<byte> _buffer;
+};
+
+} // End of namespace Common
+
+#endif // SRC_COMMON_MAPPEDFILE_H
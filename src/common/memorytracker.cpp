@@ -0,0 +1,188 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "src/common/memorytracker.h"
+
+namespace Common {
+
+static const char *kMemoryTagNames[kNumMemoryTags] = {
+	"archives",
+	"containers",
+	"meshes",
+	"textures",
+	"registry",
+	"bytecode"
+};
+
+static std::string formatBytes(size_t bytes) {
+	if (bytes < 1024 * 1024)
+		return fmt::format("{:.1f} KiB", static_cast<double>(bytes) / 1024.0);
+	return fmt::format("{:.1f} MiB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+}
+
+MemoryTracker::MemoryTracker() : _logInterval(0), _lastLog(std::chrono::steady_clock::now()) {
+	for (unsigned int i = 0; i < kNumMemoryTags; ++i) {
+		_live[i].store(0);
+		_peak[i].store(0);
+		_totalPeak[i].store(0);
+		_budget[i].store(0);
+	}
+}
+
+void MemoryTracker::allocate(MemoryTag tag, size_t size) {
+	updatePeak(tag, _live[tag].fetch_add(size, std::memory_order_relaxed) + size);
+}
+
+void MemoryTracker::free(MemoryTag tag, size_t size) {
+	_live[tag].fetch_sub(size, std::memory_order_relaxed);
+}
+
+void MemoryTracker::set(MemoryTag tag, size_t size) {
+	_live[tag].store(size, std::memory_order_relaxed);
+	updatePeak(tag, size);
+}
+
+size_t MemoryTracker::getLive(MemoryTag tag) const {
+	return _live[tag].load(std::memory_order_relaxed);
+}
+
+size_t MemoryTracker::getPeak(MemoryTag tag) const {
+	return _peak[tag].load(std::memory_order_relaxed);
+}
+
+size_t MemoryTracker::getTotalPeak(MemoryTag tag) const {
+	return _totalPeak[tag].load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::resetPeaks() {
+	for (unsigned int i = 0; i < kNumMemoryTags; ++i)
+		_peak[i].store(_live[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void MemoryTracker::setBudget(MemoryTag tag, size_t size) {
+	_budget[tag].store(size, std::memory_order_relaxed);
+}
+
+bool MemoryTracker::checkBudgets(const std::string &context) const {
+	bool withinBudgets = true;
+	for (unsigned int i = 0; i < kNumMemoryTags; ++i) {
+		const size_t budget = _budget[i].load(std::memory_order_relaxed);
+		const size_t peak = _peak[i].load(std::memory_order_relaxed);
+		if (budget == 0 || peak <= budget)
+			continue;
+
+		spdlog::warn(
+			"{} exceeded the {} memory budget with {} of {}",
+			context,
+			kMemoryTagNames[i],
+			formatBytes(peak),
+			formatBytes(budget)
+		);
+		withinBudgets = false;
+	}
+
+	return withinBudgets;
+}
+
+void MemoryTracker::setLogInterval(std::chrono::seconds interval) {
+	_logInterval = interval;
+}
+
+void MemoryTracker::update() {
+	if (_logInterval.count() == 0)
+		return;
+
+	const auto now = std::chrono::steady_clock::now();
+	if (now - _lastLog < _logInterval)
+		return;
+
+	_lastLog = now;
+
+	std::string usage;
+	for (unsigned int i = 0; i < kNumMemoryTags; ++i) {
+		if (!usage.empty())
+			usage += ", ";
+		usage += fmt::format("{} {}", kMemoryTagNames[i], formatBytes(_live[i].load(std::memory_order_relaxed)));
+	}
+	spdlog::info("Memory usage: {}", usage);
+}
+
+void MemoryTracker::dump() const {
+	spdlog::info("{:<12} {:>14} {:>14} {:>14}", "Subsystem", "Live", "Peak", "Budget");
+	for (unsigned int i = 0; i < kNumMemoryTags; ++i) {
+		const size_t budget = _budget[i].load(std::memory_order_relaxed);
+		spdlog::info(
+			"{:<12} {:>14} {:>14} {:>14}",
+			kMemoryTagNames[i],
+			formatBytes(_live[i].load(std::memory_order_relaxed)),
+			formatBytes(_peak[i].load(std::memory_order_relaxed)),
+			budget == 0 ? "-" : formatBytes(budget)
+		);
+	}
+}
+
+const char *MemoryTracker::getTagName(MemoryTag tag) {
+	return kMemoryTagNames[tag];
+}
+
+bool MemoryTracker::getTag(const std::string &name, MemoryTag &tag) {
+	for (unsigned int i = 0; i < kNumMemoryTags; ++i) {
+		if (name == kMemoryTagNames[i]) {
+			tag = static_cast<MemoryTag>(i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void MemoryTracker::updatePeak(MemoryTag tag, size_t live) {
+	size_t peak = _peak[tag].load(std::memory_order_relaxed);
+	while (live > peak && !_peak[tag].compare_exchange_weak(peak, live, std::memory_order_relaxed));
+
+	size_t totalPeak = _totalPeak[tag].load(std::memory_order_relaxed);
+	while (live > totalPeak && !_totalPeak[tag].compare_exchange_weak(totalPeak, live, std::memory_order_relaxed));
+}
+
+TrackedMemory::TrackedMemory(MemoryTag tag, size_t size) : _tag(tag), _size(0) {
+	resize(size);
+}
+
+TrackedMemory::~TrackedMemory() {
+	resize(0);
+}
+
+void TrackedMemory::resize(size_t size) {
+	if (size > _size)
+		MemoryTracking.allocate(_tag, size - _size);
+	else if (size < _size)
+		MemoryTracking.free(_tag, _size - size);
+
+	_size = size;
+}
+
+size_t TrackedMemory::size() const {
+	return _size;
+}
+
+} // End of namespace Common
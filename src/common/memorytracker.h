@@ -0,0 +1,202 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SRC_COMMON_MEMORYTRACKER_H
+#define SRC_COMMON_MEMORYTRACKER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include "src/common/singleton.h"
+#include "src/common/types.h"
+
+namespace Common {
+
+/*!
+ * Subsystems for which the memory usage is accounted
+ */
+enum MemoryTag {
+	kMemoryArchives,
+	kMemoryContainers,
+	kMemoryMeshes,
+	kMemoryTextures,
+	kMemoryRegistry,
+	kMemoryBytecode,
+
+	kNumMemoryTags
+};
+
+/*!
+ * \brief Accounting of the memory used by the big owners of data
+ *
+ * The memory tracker doesn't hook into the allocator, instead the classes
+ * owning large amounts of memory report how much they hold, usually through
+ * a TrackedMemory member. For every subsystem the live and peak bytes are
+ * kept, which can be logged periodically or on demand. Additionally, soft
+ * budgets can be set, which are checked against the peaks after a load.
+ */
+class MemoryTracker : public Singleton<MemoryTracker> {
+public:
+	MemoryTracker();
+
+	/*!
+	 * Account memory allocated by a subsystem
+	 * \param tag the subsystem which allocated the memory
+	 * \param size the number of allocated bytes
+	 */
+	void allocate(MemoryTag tag, size_t size);
+
+	/*!
+	 * Account memory freed by a subsystem
+	 * \param tag the subsystem which freed the memory
+	 * \param size the number of freed bytes
+	 */
+	void free(MemoryTag tag, size_t size);
+
+	/*!
+	 * Set the memory used by a subsystem, for subsystems which can only be
+	 * measured as a whole
+	 * \param tag the subsystem to set the memory for
+	 * \param size the number of bytes used by the subsystem
+	 */
+	void set(MemoryTag tag, size_t size);
+
+	/*!
+	 * Get the bytes currently used by a subsystem
+	 * \param tag the subsystem to get the memory for
+	 * \return the number of bytes currently used
+	 */
+	size_t getLive(MemoryTag tag) const;
+
+	/*!
+	 * Get the highest number of bytes used by a subsystem since the last
+	 * call of resetPeaks()
+	 * \param tag the subsystem to get the memory for
+	 * \return the peak number of bytes used
+	 */
+	size_t getPeak(MemoryTag tag) const;
+
+	/*!
+	 * Get the highest number of bytes used by a subsystem since the start,
+	 * which is not affected by resetPeaks()
+	 * \param tag the subsystem to get the memory for
+	 * \return the peak number of bytes used
+	 */
+	size_t getTotalPeak(MemoryTag tag) const;
+
+	/*!
+	 * Reset the peaks of all subsystems to their current usage
+	 */
+	void resetPeaks();
+
+	/*!
+	 * Set a soft budget for a subsystem, 0 removes the budget
+	 * \param tag the subsystem to set the budget for
+	 * \param size the budget in bytes
+	 */
+	void setBudget(MemoryTag tag, size_t size);
+
+	/*!
+	 * Warn about every subsystem whose peak exceeded its budget
+	 * \param context a description of what was done, for example the loaded level
+	 * \return if all subsystems stayed within their budgets
+	 */
+	bool checkBudgets(const std::string &context) const;
+
+	/*!
+	 * Set the interval in which update() logs the memory usage
+	 * \param interval the interval between two log lines, 0 disables the log
+	 */
+	void setLogInterval(std::chrono::seconds interval);
+
+	/*!
+	 * Log the memory usage if the log interval has passed since the last log
+	 */
+	void update();
+
+	/*!
+	 * Log the live and peak memory of every subsystem
+	 */
+	void dump() const;
+
+	/*!
+	 * Get the name of a subsystem as used in logs and on the command line
+	 * \param tag the subsystem to get the name for
+	 * \return the name of the subsystem
+	 */
+	static const char *getTagName(MemoryTag tag);
+
+	/*!
+	 * Get a subsystem by its name
+	 * \param name the name of the subsystem
+	 * \param tag the variable in which the subsystem is stored
+	 * \return if a subsystem with the name exists
+	 */
+	static bool getTag(const std::string &name, MemoryTag &tag);
+
+private:
+	void updatePeak(MemoryTag tag, size_t live);
+
+	std::array<std::atomic<size_t>, kNumMemoryTags> _live;
+	std::array<std::atomic<size_t>, kNumMemoryTags> _peak;
+	std::array<std::atomic<size_t>, kNumMemoryTags> _totalPeak;
+	std::array<std::atomic<size_t>, kNumMemoryTags> _budget;
+
+	std::chrono::seconds _logInterval;
+	std::chrono::steady_clock::time_point _lastLog;
+};
+
+/*!
+ * \brief Accounts a block of memory of a subsystem for its lifetime
+ */
+class TrackedMemory : Noncopyable {
+public:
+	/*!
+	 * Create a new accounted block of memory
+	 * \param tag the subsystem to account the memory for
+	 * \param size the initial size of the memory
+	 */
+	explicit TrackedMemory(MemoryTag tag, size_t size = 0);
+	~TrackedMemory();
+
+	/*!
+	 * Change the size of the accounted memory
+	 * \param size the new size in bytes
+	 */
+	void resize(size_t size);
+
+	/*!
+	 * Get the size of the accounted memory
+	 * \return the size in bytes
+	 */
+	size_t size() const;
+
+private:
+	const MemoryTag _tag;
+	size_t _size;
+};
+
+} // End of namespace Common
+
+#define MemoryTracking Common::MemoryTracker::instance()
+
+#endif // SRC_COMMON_MEMORYTRACKER_H
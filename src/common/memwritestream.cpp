@@ -18,6 +18,7 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include "memwritestream.h"
@@ -51,7 +52,8 @@ void DynamicMemoryWriteStream::write(const void *data, size_t length) {
 
 void DynamicMemoryWriteStream::extendCapacity() {
 	byte *oldData = _data;
-	_capacity += 4096;
+	// Grow geometrically, so that large buffers don't need to be copied for every page
+	_capacity = std::max<size_t>(4096, _capacity * 2);
 	_data = new unsigned char[_capacity];
 	std::memset(_data, 0, _capacity);
 
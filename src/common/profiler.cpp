@@ -0,0 +1,165 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "src/common/profiler.h"
+#include "src/common/strutil.h"
+
+namespace Common {
+
+Profiler::ThreadBuffer::ThreadBuffer(unsigned int id) : id(id), size(0), dropped(0) {
+	for (auto &chunk : chunks)
+		chunk.store(nullptr);
+}
+
+Profiler::ThreadBuffer::~ThreadBuffer() {
+	for (auto &chunk : chunks)
+		delete [] chunk.load();
+}
+
+void Profiler::ThreadBuffer::add(const Event &event) {
+	// Only the owning thread appends events, so the size can be read relaxed here
+	const size_t index = size.load(std::memory_order_relaxed);
+	const size_t chunkIndex = index / kChunkSize;
+	if (chunkIndex >= kMaxChunks) {
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Event *chunk = chunks[chunkIndex].load(std::memory_order_relaxed);
+	if (!chunk) {
+		chunk = new Event[kChunkSize];
+		chunks[chunkIndex].store(chunk, std::memory_order_release);
+	}
+
+	chunk[index % kChunkSize] = event;
+	size.store(index + 1, std::memory_order_release);
+}
+
+Profiler::Profiler() : _epoch(std::chrono::steady_clock::now()), _recording(false) {
+}
+
+Profiler::~Profiler() {
+}
+
+void Profiler::start() {
+	_recording.store(true);
+}
+
+void Profiler::stop() {
+	_recording.store(false);
+}
+
+void Profiler::addZone(const char *name, uint64_t start, uint64_t end) {
+	getThreadBuffer().add({name, kZone, start, static_cast<int64_t>(end - start)});
+}
+
+void Profiler::addCounter(const char *name, int64_t value) {
+	getThreadBuffer().add({name, kCounter, getTime(), value});
+}
+
+void Profiler::setThreadName(const std::string &name) {
+	ThreadBuffer &buffer = getThreadBuffer();
+	std::lock_guard<std::mutex> l(_threadsAccess);
+	buffer.name = name;
+}
+
+size_t Profiler::getNumEvents() {
+	std::lock_guard<std::mutex> l(_threadsAccess);
+	size_t numEvents = 0;
+	for (const auto &thread : _threads)
+		numEvents += thread->size.load(std::memory_order_acquire);
+	return numEvents;
+}
+
+void Profiler::save(WriteStream &stream) {
+	std::lock_guard<std::mutex> l(_threadsAccess);
+
+	stream.writeString("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+	bool first = true;
+	const auto writeEvent = [&](const std::string &event) {
+		if (!first)
+			stream.writeString(",\n");
+		stream.writeString(event);
+		first = false;
+	};
+
+	for (const auto &thread : _threads) {
+		if (!thread->name.empty()) {
+			writeEvent(fmt::format(
+				"{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+				thread->id,
+				escapeJSON(thread->name)
+			));
+		}
+
+		const size_t size = thread->size.load(std::memory_order_acquire);
+		for (size_t i = 0; i < size; ++i) {
+			const Event *chunk = thread->chunks[i / ThreadBuffer::kChunkSize].load(std::memory_order_acquire);
+			const Event &event = chunk[i % ThreadBuffer::kChunkSize];
+
+			// Chrome traces use microseconds as time unit
+			switch (event.type) {
+				case kZone:
+					writeEvent(fmt::format(
+						"{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+						escapeJSON(event.name),
+						thread->id,
+						static_cast<double>(event.time) / 1000.0,
+						static_cast<double>(event.value) / 1000.0
+					));
+					break;
+
+				case kCounter:
+					writeEvent(fmt::format(
+						"{{\"name\":\"{}\",\"ph\":\"C\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"args\":{{\"value\":{}}}}}",
+						escapeJSON(event.name),
+						thread->id,
+						static_cast<double>(event.time) / 1000.0,
+						event.value
+					));
+					break;
+			}
+		}
+
+		const size_t dropped = thread->dropped.load(std::memory_order_relaxed);
+		if (dropped > 0)
+			spdlog::warn("Profiler dropped {} events of thread {}", dropped, thread->id);
+	}
+
+	stream.writeString("]}\n");
+}
+
+Profiler::ThreadBuffer &Profiler::getThreadBuffer() {
+	static thread_local ThreadBuffer *buffer = nullptr;
+	if (buffer)
+		return *buffer;
+
+	// Registering a thread is the only time recording takes a lock
+	std::lock_guard<std::mutex> l(_threadsAccess);
+	_threads.emplace_back(std::make_unique<ThreadBuffer>(_threads.size()));
+	buffer = _threads.back().get();
+	return *buffer;
+}
+
+} // End of namespace Common
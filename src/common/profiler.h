@@ -0,0 +1,195 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SRC_COMMON_PROFILER_H
+#define SRC_COMMON_PROFILER_H
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "src/common/singleton.h"
+#include "src/common/writestream.h"
+
+namespace Common {
+
+/*!
+ * \brief Lightweight instrumentation of load and frame times
+ *
+ * The profiler records timed zones and counter values into per thread
+ * buffers. Only the owning thread writes into a buffer and publishes new
+ * events with an atomic size, so recording never takes a lock. The recorded
+ * events can be written as Chrome trace event JSON, which can be opened in
+ * chrome://tracing or Perfetto.
+ *
+ * Events are only recorded between start() and stop(). The PROFILE_* macros
+ * below compile to nothing if OPENAWE_PROFILING is not defined.
+ */
+class Profiler : public Singleton<Profiler> {
+public:
+	Profiler();
+	~Profiler();
+
+	/*!
+	 * Start recording events
+	 */
+	void start();
+
+	/*!
+	 * Stop recording events, already recorded events are kept
+	 */
+	void stop();
+
+	/*!
+	 * Check if the profiler currently records events
+	 * \return if events are recorded
+	 */
+	bool isRecording() const {
+		return _recording.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	 * Get the current time of the profiler clock
+	 * \return the time in nanoseconds since the profiler was created
+	 */
+	uint64_t getTime() const {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count();
+	}
+
+	/*!
+	 * Record a finished zone for the current thread
+	 * \param name the name of the zone, which has to outlive the profiler
+	 * \param start the start time of the zone
+	 * \param end the end time of the zone
+	 */
+	void addZone(const char *name, uint64_t start, uint64_t end);
+
+	/*!
+	 * Record the current value of a counter for the current thread
+	 * \param name the name of the counter, which has to outlive the profiler
+	 * \param value the current value of the counter
+	 */
+	void addCounter(const char *name, int64_t value);
+
+	/*!
+	 * Set the name under which the current thread appears in the trace
+	 * \param name the name of the thread
+	 */
+	void setThreadName(const std::string &name);
+
+	/*!
+	 * Get the number of events recorded over all threads
+	 * \return the number of recorded events
+	 */
+	size_t getNumEvents();
+
+	/*!
+	 * Write all recorded events as Chrome trace event JSON
+	 * \param stream the stream to write the trace to
+	 */
+	void save(WriteStream &stream);
+
+private:
+	enum EventType {
+		kZone,
+		kCounter
+	};
+
+	struct Event {
+		const char *name;
+		EventType type;
+		uint64_t time;
+		int64_t value;
+	};
+
+	struct ThreadBuffer {
+		static constexpr size_t kChunkSize = 4096;
+		static constexpr size_t kMaxChunks = 1024;
+
+		ThreadBuffer(unsigned int id);
+		~ThreadBuffer();
+
+		void add(const Event &event);
+
+		const unsigned int id;
+		std::string name;
+		std::atomic<size_t> size;
+		std::atomic<size_t> dropped;
+		std::array<std::atomic<Event *>, kMaxChunks> chunks;
+	};
+
+	ThreadBuffer &getThreadBuffer();
+
+	const std::chrono::steady_clock::time_point _epoch;
+	std::atomic_bool _recording;
+
+	std::mutex _threadsAccess;
+	std::vector<std::unique_ptr<ThreadBuffer>> _threads;
+};
+
+/*!
+ * \brief Records the time between its construction and destruction as zone
+ */
+class ProfileZone : Noncopyable {
+public:
+	explicit ProfileZone(const char *name) : _name(name), _active(Profiler::instance().isRecording()) {
+		if (_active)
+			_start = Profiler::instance().getTime();
+	}
+
+	~ProfileZone() {
+		if (_active)
+			Profiler::instance().addZone(_name, _start, Profiler::instance().getTime());
+	}
+
+private:
+	const char *_name;
+	const bool _active;
+	uint64_t _start = 0;
+};
+
+} // End of namespace Common
+
+#define Profile Common::Profiler::instance()
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef OPENAWE_PROFILING
+#	define PROFILE_ZONE(name) Common::ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#	define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#	define PROFILE_COUNTER(name, value) \
+		do { \
+			if (Profile.isRecording()) \
+				Profile.addCounter(name, static_cast<int64_t>(value)); \
+		} while (false)
+#	define PROFILE_THREAD(name) Profile.setThreadName(name)
+#else
+#	define PROFILE_ZONE(name) do {} while (false)
+#	define PROFILE_FUNCTION() do {} while (false)
+#	define PROFILE_COUNTER(name, value) do {} while (false)
+#	define PROFILE_THREAD(name) do {} while (false)
+#endif
+
+#endif // SRC_COMMON_PROFILER_H
@@ -0,0 +1,95 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SRC_COMMON_SPAN_H
+#define SRC_COMMON_SPAN_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace Common {
+
+/*!
+ * \brief A non owning view of a contiguous sequence of elements
+ *
+ * A minimal replacement for std::span, which is only available since C++20.
+ * The viewed elements have to outlive the span.
+ */
+template<typename T>
+class Span {
+public:
+	constexpr Span() : _data(nullptr), _size(0) {
+	}
+
+	constexpr Span(T *data, size_t size) : _data(data), _size(size) {
+	}
+
+	template<typename U>
+	Span(std::vector<U> &vector) : _data(vector.data()), _size(vector.size()) {
+	}
+
+	template<typename U>
+	Span(const std::vector<U> &vector) : _data(vector.data()), _size(vector.size()) {
+	}
+
+	constexpr T *data() const {
+		return _data;
+	}
+
+	constexpr size_t size() const {
+		return _size;
+	}
+
+	constexpr bool empty() const {
+		return _size == 0;
+	}
+
+	constexpr T *begin() const {
+		return _data;
+	}
+
+	constexpr T *end() const {
+		return _data + _size;
+	}
+
+	constexpr T &operator[](size_t index) const {
+		return _data[index];
+	}
+
+	/*!
+	 * Get an element with bounds checking
+	 * \param index the index of the element
+	 * \return a reference to the element
+	 */
+	T &at(size_t index) const {
+		if (index >= _size)
+			throw std::out_of_range("Span index out of range");
+		return _data[index];
+	}
+
+private:
+	T *_data;
+	size_t _size;
+};
+
+} // End of namespace Common
+
+#endif // SRC_COMMON_SPAN_H
@@ -22,6 +22,7 @@
 #include <iostream>
 
 #include <zlib.h>
+#include <fmt/format.h>
 
 #include "strutil.h"
 
@@ -71,4 +72,20 @@ uint32_t crc32(const std::string &str) {
 	);
 }
 
+std::string escapeJSON(const std::string &str) {
+	std::string escaped;
+	escaped.reserve(str.size());
+	for (const char c : str) {
+		if (c == '"' || c == '\\') {
+			escaped += '\\';
+			escaped += c;
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			escaped += fmt::format("\\u{:04x}", static_cast<unsigned int>(c));
+		} else {
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
 }
@@ -64,6 +64,13 @@ std::vector<std::string> split(const std::string &str, const std::regex &split);
  */
 uint32_t crc32(const std::string &str);
 
+/*!
+ * Escape a string, so that it can be used as string value in json
+ * \param str the string to escape
+ * \return the escaped string
+ */
+std::string escapeJSON(const std::string &str);
+
 }
 
 #endif //AWE_STRUTIL_H
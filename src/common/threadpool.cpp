@@ -23,14 +23,18 @@
 #include <fmt/format.h>
 
 #include "src/common/threadpool.h"
+#include "src/common/profiler.h"
 
 namespace Common {
 
 ThreadPool::ThreadPool() : _threads(std::max<int>(std::thread::hardware_concurrency() - 1, 0)) {
 	_finished.store(false);
 
-	for (auto &thread : _threads) {
-		thread = std::thread(std::bind(&ThreadPool::run, this));
+	// Construct the profiler before the workers, so that it is destroyed after they are joined
+	Profiler::instance();
+
+	for (size_t i = 0; i < _threads.size(); ++i) {
+		_threads[i] = std::thread(std::bind(&ThreadPool::run, this, i));
 	}
 }
 
@@ -44,11 +48,24 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::add(Runnable runnable) {
+	// Without worker threads, for example on single core systems, run the task directly
+	if (_threads.empty()) {
+		runnable();
+		return;
+	}
+
 	std::lock_guard<std::mutex> l(_taskAccess);
 	_tasks.push(runnable);
+	PROFILE_COUNTER("ThreadPool::tasks", _tasks.size());
+}
+
+size_t ThreadPool::getNumThreads() const {
+	return _threads.size();
 }
 
-void ThreadPool::run() {
+void ThreadPool::run(size_t index) {
+	PROFILE_THREAD(fmt::format("Worker {}", index));
+
 	while (!_finished) {
 		_taskAccess.lock();
 		if (_tasks.empty()) {
@@ -59,8 +76,10 @@ void ThreadPool::run() {
 
 		Runnable runnable = _tasks.front();
 		_tasks.pop();
+		PROFILE_COUNTER("ThreadPool::tasks", _tasks.size());
 		_taskAccess.unlock();
 
+		PROFILE_ZONE("ThreadPool::run");
 		runnable();
 	}
 }
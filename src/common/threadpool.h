@@ -42,8 +42,14 @@ public:
 
 	void add(Runnable runnable);
 
+	/*!
+	 * Get the number of worker threads, which may be zero on single core systems
+	 * \return the number of worker threads
+	 */
+	size_t getNumThreads() const;
+
 private:
-	void run();
+	void run(size_t index);
 
 	std::atomic_bool _finished;
 	std::condition_variable _taskCond;
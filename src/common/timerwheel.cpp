@@ -0,0 +1,210 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "src/common/timerwheel.h"
+
+namespace Common {
+
+TimerWheel::TimerWheel(uint64_t time) : _time(time), _size(0) {
+	_lists.fill(List{kNone, kNone});
+	_levelSizes.fill(0);
+}
+
+TimerWheel::TimerId TimerWheel::schedule(uint64_t deadline, Callback callback) {
+	uint32_t index;
+	if (_free.empty()) {
+		index = _timers.size();
+		_timers.emplace_back(Timer{0, 1, kNone, kNone, kNone, nullptr});
+	} else {
+		index = _free.back();
+		_free.pop_back();
+	}
+
+	// Deadlines in the past expire with the next tick
+	Timer &timer = _timers[index];
+	timer.deadline = std::max(deadline, _time + 1);
+	timer.callback = std::move(callback);
+
+	insert(index);
+	_size++;
+
+	return (static_cast<TimerId>(timer.generation) << 32u) | index;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+	const uint32_t index = id & 0xFFFFFFFFu;
+	const uint32_t generation = id >> 32u;
+
+	if (index >= _timers.size())
+		return false;
+
+	const Timer &timer = _timers[index];
+	if (timer.generation != generation || timer.list == kNone)
+		return false;
+
+	unlink(index);
+	release(index);
+
+	return true;
+}
+
+size_t TimerWheel::advance(uint64_t time) {
+	size_t expired = 0;
+
+	while (_time < time) {
+		// Nothing can expire on the way, so skip right to the end
+		if (_size == 0) {
+			_time = time;
+			break;
+		}
+
+		// If the lower wheels are empty, nothing can happen until the lowest wheel with timers reaches its next slot
+		unsigned int lowest = 0;
+		while (_levelSizes[lowest] == 0)
+			lowest++;
+		if (lowest > 0) {
+			const uint64_t skipped = _time | ((static_cast<uint64_t>(1) << (kSlotBits * lowest)) - 1);
+			if (skipped >= time) {
+				_time = time;
+				break;
+			}
+			_time = skipped;
+		}
+
+		_time++;
+
+		// Find the highest wheel which completed a turn with this tick and distribute its timers downwards
+		unsigned int level = 0;
+		while (level < kNumLevels && ((_time >> (kSlotBits * level)) & (kNumSlots - 1)) == 0)
+			level++;
+		for (; level > 0; --level)
+			cascade(level);
+
+		// Expire every timer in the current slot of the first wheel
+		const uint32_t list = _time & (kNumSlots - 1);
+		while (_lists[list].head != kNone) {
+			const uint32_t index = _lists[list].head;
+			unlink(index);
+
+			Callback callback = std::move(_timers[index].callback);
+			release(index);
+
+			callback();
+			expired++;
+		}
+	}
+
+	return expired;
+}
+
+uint64_t TimerWheel::getTime() const {
+	return _time;
+}
+
+size_t TimerWheel::size() const {
+	return _size;
+}
+
+void TimerWheel::insert(uint32_t index) {
+	const Timer &timer = _timers[index];
+
+	// The wheel is selected by the highest slot index in which the deadline differs from the current time
+	const uint64_t difference = timer.deadline ^ _time;
+	unsigned int level = 0;
+	while (level < kNumLevels && (difference >> (kSlotBits * (level + 1))) != 0)
+		level++;
+
+	if (level == kNumLevels) {
+		link(index, kNumLevels * kNumSlots);
+		return;
+	}
+
+	const uint32_t slot = (timer.deadline >> (kSlotBits * level)) & (kNumSlots - 1);
+	link(index, level * kNumSlots + slot);
+}
+
+void TimerWheel::link(uint32_t index, uint32_t list) {
+	Timer &timer = _timers[index];
+	timer.list = list;
+	timer.previous = _lists[list].tail;
+	_levelSizes[list / kNumSlots]++;
+	timer.next = kNone;
+
+	if (timer.previous != kNone)
+		_timers[timer.previous].next = index;
+	else
+		_lists[list].head = index;
+	_lists[list].tail = index;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+	Timer &timer = _timers[index];
+
+	if (timer.previous != kNone)
+		_timers[timer.previous].next = timer.next;
+	else
+		_lists[timer.list].head = timer.next;
+
+	if (timer.next != kNone)
+		_timers[timer.next].previous = timer.previous;
+	else
+		_lists[timer.list].tail = timer.previous;
+
+	_levelSizes[timer.list / kNumSlots]--;
+
+	timer.list = kNone;
+	timer.previous = kNone;
+	timer.next = kNone;
+}
+
+void TimerWheel::release(uint32_t index) {
+	Timer &timer = _timers[index];
+	timer.callback = nullptr;
+
+	// Invalidate all ids handed out for this timer, skipping the zero generation to keep ids non zero
+	if (++timer.generation == 0)
+		timer.generation = 1;
+
+	_free.emplace_back(index);
+	_size--;
+}
+
+void TimerWheel::cascade(unsigned int level) {
+	uint32_t list;
+	if (level == kNumLevels)
+		list = kNumLevels * kNumSlots;
+	else
+		list = level * kNumSlots + ((_time >> (kSlotBits * level)) & (kNumSlots - 1));
+
+	// Detach the whole list first, since reinserting may put timers back into the overflow list
+	uint32_t index = _lists[list].head;
+	_lists[list] = List{kNone, kNone};
+
+	while (index != kNone) {
+		const uint32_t next = _timers[index].next;
+		_levelSizes[level]--;
+		insert(index);
+		index = next;
+	}
+}
+
+} // End of namespace Common
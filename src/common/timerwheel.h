@@ -0,0 +1,139 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SRC_COMMON_TIMERWHEEL_H
+#define SRC_COMMON_TIMERWHEEL_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Common {
+
+/*!
+ * \brief Hierarchical timer wheel
+ *
+ * Timers are kept in four wheels of 256 slots each. The first wheel holds
+ * the timers expiring within the next 256 ticks, one slot per tick, and
+ * every further wheel covers 256 times the range of the previous one.
+ * Whenever the first wheel completed a turn, the timers of the next slot of
+ * the second wheel are distributed over the first wheel and so on. Timers
+ * too far in the future for all wheels wait in an overflow list. This makes
+ * scheduling, cancelling and expiring a timer O(1) amortized, independent
+ * of the number of timers. Turns of wheels without any timers are skipped
+ * when advancing. Timers scheduled at the same tick for the same
+ * deadline expire in the order they were scheduled.
+ *
+ * The length of a tick is up to the user of the wheel, it only counts them.
+ */
+class TimerWheel {
+public:
+	typedef uint64_t TimerId;
+	typedef std::function<void()> Callback;
+
+	static constexpr TimerId kInvalidTimer = 0;
+
+	/*!
+	 * Create a new timer wheel
+	 * \param time the tick the wheel starts at
+	 */
+	explicit TimerWheel(uint64_t time = 0);
+
+	/*!
+	 * Schedule a timer
+	 *
+	 * \param deadline the tick at which the timer expires, timers with a deadline in the past expire with the next
+	 * advance
+	 * \param callback the function called when the timer expires
+	 * \return the id of the timer, which can be used to cancel it
+	 */
+	TimerId schedule(uint64_t deadline, Callback callback);
+
+	/*!
+	 * Cancel a timer
+	 * \param id the id of the timer to cancel
+	 * \return if the timer was still pending
+	 */
+	bool cancel(TimerId id);
+
+	/*!
+	 * Advance the wheel to a given tick and call the callbacks of all timers expiring until then. The callbacks may
+	 * schedule and cancel timers
+	 *
+	 * \param time the tick to advance to
+	 * \return the number of expired timers
+	 */
+	size_t advance(uint64_t time);
+
+	/*!
+	 * Get the current tick of the wheel
+	 * \return the current tick
+	 */
+	uint64_t getTime() const;
+
+	/*!
+	 * Get the number of pending timers
+	 * \return the number of timers in the wheel
+	 */
+	size_t size() const;
+
+private:
+	static constexpr unsigned int kNumLevels = 4;
+	static constexpr unsigned int kSlotBits = 8;
+	static constexpr unsigned int kNumSlots = 1u << kSlotBits;
+	static constexpr uint32_t kNone = UINT32_MAX;
+
+	struct Timer {
+		uint64_t deadline;
+		uint32_t generation;
+		uint32_t list;
+		uint32_t previous;
+		uint32_t next;
+		Callback callback;
+	};
+
+	struct List {
+		uint32_t head;
+		uint32_t tail;
+	};
+
+	void insert(uint32_t index);
+	void link(uint32_t index, uint32_t list);
+	void unlink(uint32_t index);
+	void release(uint32_t index);
+	void cascade(unsigned int level);
+
+	uint64_t _time;
+	size_t _size;
+
+	std::vector<Timer> _timers;
+	std::vector<uint32_t> _free;
+
+	// The lists of every slot of every wheel followed by the overflow list
+	std::array<List, kNumLevels * kNumSlots + 1> _lists;
+
+	// The number of timers in every wheel followed by the overflow list
+	std::array<size_t, kNumLevels + 1> _levelSizes;
+};
+
+} // End of namespace Common
+
+#endif // SRC_COMMON_TIMERWHEEL_H
@@ -21,6 +21,8 @@
 #ifndef SRC_COMMON_TYPES_H
 #define SRC_COMMON_TYPES_H
 
+#include <algorithm>
+
 #include <glm/glm.hpp>
 
 #define OS_LINUX linux || __linux
@@ -51,6 +53,64 @@ private:
 struct BoundBox {
 	float xmin, ymin, zmin;
 	float xmax, ymax, zmax;
+
+	inline glm::vec3 getMin() const {
+		return glm::vec3(xmin, ymin, zmin);
+	}
+
+	inline glm::vec3 getMax() const {
+		return glm::vec3(xmax, ymax, zmax);
+	}
+
+	inline glm::vec3 getCenter() const {
+		return (getMin() + getMax()) * 0.5f;
+	}
+
+	inline float getSurfaceArea() const {
+		const glm::vec3 size = getMax() - getMin();
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	inline BoundBox merge(const BoundBox &boundBox) const {
+		return BoundBox{
+			std::min(xmin, boundBox.xmin), std::min(ymin, boundBox.ymin), std::min(zmin, boundBox.zmin),
+			std::max(xmax, boundBox.xmax), std::max(ymax, boundBox.ymax), std::max(zmax, boundBox.zmax)
+		};
+	}
+
+	inline bool contains(const BoundBox &boundBox) const {
+		return xmin <= boundBox.xmin && ymin <= boundBox.ymin && zmin <= boundBox.zmin &&
+			xmax >= boundBox.xmax && ymax >= boundBox.ymax && zmax >= boundBox.zmax;
+	}
+
+	inline bool intersect(const BoundBox &boundBox) const {
+		return xmin <= boundBox.xmax && xmax >= boundBox.xmin &&
+			ymin <= boundBox.ymax && ymax >= boundBox.ymin &&
+			zmin <= boundBox.zmax && zmax >= boundBox.zmin;
+	}
+
+	inline bool intersect(const glm::vec3 &position, float radius) const {
+		const glm::vec3 closest = glm::clamp(position, getMin(), getMax());
+		const glm::vec3 distance = position - closest;
+		return glm::dot(distance, distance) <= radius * radius;
+	}
+
+	/*!
+	 * Intersect a ray segment with the box using the slab method
+	 * \param origin the start of the ray
+	 * \param inverseDirection the component wise inverse of the ray direction
+	 * \param maxDistance the length of the ray in units of its direction
+	 * \return if the segment hits or starts inside the box
+	 */
+	inline bool intersect(const glm::vec3 &origin, const glm::vec3 &inverseDirection, float maxDistance) const {
+		const glm::vec3 t1 = (getMin() - origin) * inverseDirection;
+		const glm::vec3 t2 = (getMax() - origin) * inverseDirection;
+		const glm::vec3 tmin = glm::min(t1, t2);
+		const glm::vec3 tmax = glm::max(t1, t2);
+		const float enter = std::max({tmin.x, tmin.y, tmin.z, 0.0f});
+		const float exit = std::min({tmax.x, tmax.y, tmax.z, maxDistance});
+		return enter <= exit;
+	}
 };
 
 struct BoundSphere {
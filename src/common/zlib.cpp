@@ -69,12 +69,28 @@ ReadStream *compressZLIB(byte *data, size_t decompressedSize) {
 			9,
 			Z_DEFAULT_STRATEGY
 	);
+	if (zResult != Z_OK)
+		throw std::runtime_error("Error initializing z_stream");
+
+	const size_t maxCompressedSize = deflateBound(&stream, decompressedSize);
+	byte *compressedData = new byte[maxCompressedSize];
+
+	stream.avail_in = decompressedSize;
+	stream.next_in = data;
+	stream.avail_out = maxCompressedSize;
+	stream.next_out = compressedData;
 
-	// TODO
+	zResult = deflate(&stream, Z_FINISH);
+	if (zResult != Z_STREAM_END) {
+		deflateEnd(&stream);
+		delete [] compressedData;
+		throw std::runtime_error("Error deflating");
+	}
 
+	const size_t compressedSize = stream.total_out;
 	deflateEnd(&stream);
 
-	return nullptr;
+	return new MemoryReadStream(compressedData, compressedSize);
 }
 
 } // End of namespace Common
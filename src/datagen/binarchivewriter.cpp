@@ -0,0 +1,49 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+
+#include "src/common/zlib.h"
+
+#include "src/datagen/binarchivewriter.h"
+
+namespace DataGen {
+
+void BINArchiveWriter::addResource(const std::string &name, std::vector<byte> data) {
+	_files.emplace_back(File{name, std::move(data)});
+}
+
+void BINArchiveWriter::write(Common::WriteStream &bin) const {
+	std::vector<byte> data;
+
+	bin.writeUint32LE(_files.size());
+	for (const auto &file : _files) {
+		bin.writeUint32LE(file.name.size());
+		bin.writeString(file.name);
+		bin.writeUint32LE(file.data.size());
+
+		data.insert(data.end(), file.data.begin(), file.data.end());
+	}
+
+	std::unique_ptr<Common::ReadStream> compressed(Common::compressZLIB(data.data(), data.size()));
+	bin.writeStream(compressed.get());
+}
+
+} // End of namespace DataGen
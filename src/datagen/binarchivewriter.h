@@ -0,0 +1,63 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_DATAGEN_BINARCHIVEWRITER_H
+#define OPENAWE_DATAGEN_BINARCHIVEWRITER_H
+
+#include <string>
+#include <vector>
+
+#include "src/common/writestream.h"
+
+namespace DataGen {
+
+/*!
+ * \brief Writer for zlib compressed bin archives
+ *
+ * Bin archives consist of a list of file names and sizes, followed by the
+ * zlib compressed concatenation of all files.
+ */
+class BINArchiveWriter {
+public:
+	/*!
+	 * Add a file to the archive
+	 * \param name the name of the file
+	 * \param data the content of the file
+	 */
+	void addResource(const std::string &name, std::vector<byte> data);
+
+	/*!
+	 * Write the archive
+	 * \param bin the stream to write the archive to
+	 */
+	void write(Common::WriteStream &bin) const;
+
+private:
+	struct File {
+		std::string name;
+		std::vector<byte> data;
+	};
+
+	std::vector<File> _files;
+};
+
+} // End of namespace DataGen
+
+#endif //OPENAWE_DATAGEN_BINARCHIVEWRITER_H
@@ -0,0 +1,221 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdexcept>
+
+#include "src/common/atomtable.h"
+#include "src/common/strutil.h"
+
+#include "src/datagen/cidfilewriter.h"
+
+static const uint32_t kDeadBeef = 0xDEADBEEF;
+
+namespace DataGen {
+
+CIDFileWriter::CIDFileWriter(DPFileWriter &dp, ObjectType type, unsigned int version, Format format) :
+	_dp(dp), _type(type), _version(version), _format(format), _numElements(0), _objects(true) {
+	switch (type) {
+		case kStaticObject:
+		case kDynamicObject:
+		case kCharacter:
+		case kTrigger:
+		case kScript:
+			break;
+		default:
+			throw std::runtime_error("Unsupported content type");
+	}
+}
+
+void CIDFileWriter::addStaticObject(const AWE::Templates::StaticObject &staticObject) {
+	Common::DynamicMemoryWriteStream payload(true);
+
+	writeRotation(payload, staticObject.rotation);
+	writePosition(payload, staticObject.position);
+	writeRID(payload, staticObject.physicsResource);
+	payload.writeZeros(4);
+	writeRID(payload, staticObject.meshResource);
+	payload.writeZeros(17);
+
+	writeObject("content::StaticObject", _version, payload);
+}
+
+void CIDFileWriter::addDynamicObject(const AWE::Templates::DynamicObject &dynamicObject) {
+	Common::DynamicMemoryWriteStream payload(true);
+
+	writeRotation(payload, dynamicObject.rotation);
+	writePosition(payload, dynamicObject.position);
+	writeRID(payload, dynamicObject.physicsResource);
+	writeAtom(payload, dynamicObject.resourcePath);
+	writeRID(payload, dynamicObject.meshResource);
+	writeAtom(payload, dynamicObject.identifier);
+	payload.writeZeros(16);
+	writeGID(payload, dynamicObject.gid);
+	payload.writeZeros(_version == 12 ? 13 : 9);
+
+	writeObject("content::DynamicObject", _version, payload);
+}
+
+void CIDFileWriter::addCharacter(const AWE::Templates::Character &character, const std::vector<rid_t> &resources) {
+	Common::DynamicMemoryWriteStream payload(true);
+
+	writeGID(payload, character.gid);
+	writeGID(payload, character.classGid);
+	if (_version == 13)
+		payload.writeZeros(1);
+
+	writeRID(payload, character.meshResource);
+	writeRotation(payload, character.rotation);
+	writePosition(payload, character.position);
+
+	payload.writeUint32LE(resources.size());
+	for (const auto rid : resources) {
+		writeRID(payload, rid);
+	}
+
+	if (_version == 17) {
+		payload.writeZeros(4);
+		payload.writeUint32LE(character.identifier.size());
+		payload.writeString(character.identifier);
+		writeRID(payload, character.clothResource);
+		payload.writeZeros(48);
+		writeRID(payload, character.fxaResource);
+		payload.writeZeros(1);
+		writeRID(payload, character.animgraphResource);
+		payload.writeZeros(9);
+		for (int i = 0; i < 4; ++i) {
+			writeRID(payload, 0);
+		}
+	} else {
+		payload.writeZeros(0x3A);
+	}
+
+	writeObject("content::Character", _version, payload);
+}
+
+void CIDFileWriter::addTrigger(const AWE::Templates::Trigger &trigger, const std::vector<uint32_t> &values) {
+	Common::DynamicMemoryWriteStream payload(true);
+
+	writeGID(payload, trigger.gid2);
+	writeGID(payload, trigger.gid);
+	payload.writeZeros(4);
+	writeAtom(payload, trigger.identifier);
+	payload.writeZeros(4);
+	writeAtom(payload, trigger.localeString);
+	payload.writeZeros(12);
+	payload.writeUint32LE(values.size());
+	payload.writeUint32LE(_dp.addValues(values));
+	payload.writeZeros(_version == 20 ? 7 : 3);
+
+	writeObject("content::Trigger", _version, payload);
+}
+
+void CIDFileWriter::addScript(const AWE::Templates::Script &script) {
+	Common::DynamicMemoryWriteStream payload(true);
+
+	writeGID(payload, script.gid);
+
+	// The script variables are a nested object without debug entries
+	Common::DynamicMemoryWriteStream variables(true);
+	variables.writeUint32LE(script.script.codeSize);
+	variables.writeUint32LE(script.script.offsetCode);
+	variables.writeUint32LE(script.script.numHandlers);
+	variables.writeUint32LE(script.script.offsetHandlers);
+	variables.writeUint32LE(script.script.numVariables);
+	variables.writeUint32LE(script.script.offsetVariables);
+	variables.writeUint32LE(script.script.numSignals);
+	variables.writeUint32LE(script.script.offsetSignals);
+
+	if (_format == kStructured) {
+		payload.writeUint32LE(kDeadBeef);
+		payload.writeUint32LE(variables.getLength() + 20);
+		payload.writeUint32LE(Common::crc32(Common::toLower("content::ScriptVariables")));
+		payload.writeUint32LE(1);
+		payload.write(variables.getData(), variables.getLength());
+		payload.writeUint32LE(kDeadBeef);
+	} else {
+		payload.write(variables.getData(), variables.getLength());
+	}
+
+	writeObject("content::Script", _version, payload);
+}
+
+void CIDFileWriter::write(Common::WriteStream &cid) {
+	cid.writeUint32LE(_version);
+	cid.writeUint32LE(0); // Content type
+	cid.writeUint32LE(_numElements);
+	cid.writeZeros(4);
+	cid.write(_objects.getData(), _objects.getLength());
+}
+
+void CIDFileWriter::writeObject(const char *contentName, unsigned int version, Common::DynamicMemoryWriteStream &payload) {
+	if (_format == kStructured) {
+		_objects.writeUint32LE(kDeadBeef);
+		_objects.writeUint32LE(payload.getLength() + 20);
+		_objects.writeUint32LE(Common::crc32(Common::toLower(contentName)));
+		_objects.writeUint32LE(version);
+	}
+
+	_objects.write(payload.getData(), payload.getLength());
+
+	if (_format == kStructured)
+		_objects.writeUint32LE(kDeadBeef);
+
+	_numElements++;
+}
+
+void CIDFileWriter::writeRID(Common::WriteStream &stream, rid_t rid) {
+	if (_format == kStructured) {
+		stream.writeUint32LE(kDeadBeef);
+		stream.writeUint32LE(24);
+		stream.writeUint32LE(Common::crc32(Common::toLower("content::ResourceID")));
+		stream.writeUint32LE(0);
+	}
+
+	stream.writeUint32BE(rid);
+
+	if (_format == kStructured)
+		stream.writeUint32LE(kDeadBeef);
+}
+
+void CIDFileWriter::writeGID(Common::WriteStream &stream, const GID &gid) {
+	stream.writeUint32LE(gid.type);
+	stream.writeUint32BE(gid.id);
+}
+
+void CIDFileWriter::writeAtom(Common::WriteStream &stream, Common::Atom atom) {
+	const std::string_view string = Atoms.getString(atom);
+	stream.writeUint32LE(string.empty() ? 0 : _dp.addString(std::string(string)));
+}
+
+void CIDFileWriter::writePosition(Common::WriteStream &stream, const glm::vec3 &position) {
+	stream.writeIEEEFloatLE(position.x);
+	stream.writeIEEEFloatLE(position.y);
+	stream.writeIEEEFloatLE(position.z);
+}
+
+void CIDFileWriter::writeRotation(Common::WriteStream &stream, const glm::mat3 &rotation) {
+	for (int i = 0; i < 3; ++i) {
+		stream.writeIEEEFloatLE(rotation[i].x);
+		stream.writeIEEEFloatLE(rotation[i].y);
+		stream.writeIEEEFloatLE(rotation[i].z);
+	}
+}
+
+} // End of namespace DataGen
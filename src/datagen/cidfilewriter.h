@@ -0,0 +1,94 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_DATAGEN_CIDFILEWRITER_H
+#define OPENAWE_DATAGEN_CIDFILEWRITER_H
+
+#include <vector>
+
+#include "src/common/memwritestream.h"
+
+#include "src/awe/object.h"
+#include "src/awe/types.h"
+
+#include "src/datagen/dpfilewriter.h"
+
+namespace DataGen {
+
+/*!
+ * \brief Writer for cid files
+ *
+ * Cid files hold a list of objects of the same type. Alan Wake stores them
+ * in a simple format, in which the objects follow each other without any
+ * framing. Alan Wakes American Nightmare wraps every object, including
+ * nested resource ids, into a structured container with a content hash, a
+ * version and its size. Strings and value arrays are written to the given
+ * dp file, which has to be loaded together with the cid file.
+ */
+class CIDFileWriter {
+public:
+	enum Format {
+		kSimple,
+		kStructured
+	};
+
+	/*!
+	 * Create a writer for a cid file
+	 * \param dp the dp file to store strings and values in
+	 * \param type the type of the objects in this cid file, either kStaticObject, kDynamicObject, kCharacter, kTrigger
+	 * or kScript
+	 * \param version the version of the objects
+	 * \param format the format in which the objects are written
+	 */
+	CIDFileWriter(DPFileWriter &dp, ObjectType type, unsigned int version, Format format);
+
+	void addStaticObject(const AWE::Templates::StaticObject &staticObject);
+	void addDynamicObject(const AWE::Templates::DynamicObject &dynamicObject);
+	void addCharacter(const AWE::Templates::Character &character, const std::vector<rid_t> &resources);
+	void addTrigger(const AWE::Templates::Trigger &trigger, const std::vector<uint32_t> &values);
+	void addScript(const AWE::Templates::Script &script);
+
+	/*!
+	 * Write the cid file
+	 * \param cid the stream to write the cid file to
+	 */
+	void write(Common::WriteStream &cid);
+
+private:
+	void writeObject(const char *contentName, unsigned int version, Common::DynamicMemoryWriteStream &payload);
+
+	void writeRID(Common::WriteStream &stream, rid_t rid);
+	void writeGID(Common::WriteStream &stream, const GID &gid);
+	void writeAtom(Common::WriteStream &stream, Common::Atom atom);
+	void writePosition(Common::WriteStream &stream, const glm::vec3 &position);
+	void writeRotation(Common::WriteStream &stream, const glm::mat3 &rotation);
+
+	DPFileWriter &_dp;
+	const ObjectType _type;
+	const unsigned int _version;
+	const Format _format;
+
+	uint32_t _numElements;
+	Common::DynamicMemoryWriteStream _objects;
+};
+
+} // End of namespace DataGen
+
+#endif //OPENAWE_DATAGEN_CIDFILEWRITER_H
@@ -0,0 +1,101 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include "src/datagen/dpfilewriter.h"
+
+namespace DataGen {
+
+/*!
+ * Encode a relative offset into the data section the way it is decoded by DPFile. The lowest byte has to be non zero
+ * for strings
+ */
+static uint32_t encodeOffset(uint32_t relativeOffset) {
+	return ((relativeOffset / 8) << 8u) | 0x01u;
+}
+
+DPFileWriter::DPFileWriter() : _data(8, 0) {
+}
+
+uint32_t DPFileWriter::addString(const std::string &str) {
+	const auto existing = _strings.find(str);
+	if (existing != _strings.end())
+		return existing->second;
+
+	const uint32_t offset = encodeOffset(align());
+	_data.insert(_data.end(), str.begin(), str.end());
+	_data.emplace_back(0);
+
+	_stringOffsets.emplace_back(offset);
+	_strings[str] = offset;
+
+	return offset;
+}
+
+uint32_t DPFileWriter::addValues(const std::vector<uint32_t> &values) {
+	const uint32_t relativeOffset = align();
+	for (const auto value : values) {
+		_data.emplace_back(value & 0xFFu);
+		_data.emplace_back((value >> 8u) & 0xFFu);
+		_data.emplace_back((value >> 16u) & 0xFFu);
+		_data.emplace_back((value >> 24u) & 0xFFu);
+	}
+
+	// Keep the offsets of entries unique, even for empty arrays
+	if (values.empty())
+		_data.resize(_data.size() + 4, 0);
+
+	_valueOffsets.emplace_back(relativeOffset);
+
+	return encodeOffset(relativeOffset);
+}
+
+void DPFileWriter::write(Common::WriteStream &dp, bool v2) const {
+	if (v2) {
+		dp.writeUint32LE(_valueOffsets.size());
+		dp.writeUint32LE(0); // References
+		dp.writeUint32LE(_stringOffsets.size());
+		dp.writeUint32LE(_data.size());
+		dp.writeZeros(12);
+	} else {
+		dp.writeUint32LE(_valueOffsets.size());
+		dp.writeUint32LE(_stringOffsets.size());
+		dp.writeUint32LE(_data.size());
+		dp.writeZeros(8);
+	}
+
+	for (const auto offset : _valueOffsets) {
+		dp.writeUint32LE(offset);
+	}
+
+	for (const auto offset : _stringOffsets) {
+		dp.writeUint32LE(offset);
+	}
+
+	dp.write(_data.data(), _data.size());
+}
+
+uint32_t DPFileWriter::align() {
+	_data.resize((_data.size() + 7) / 8 * 8, 0);
+	return _data.size();
+}
+
+} // End of namespace DataGen
@@ -0,0 +1,77 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_DATAGEN_DPFILEWRITER_H
+#define OPENAWE_DATAGEN_DPFILEWRITER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "src/common/writestream.h"
+
+namespace DataGen {
+
+/*!
+ * \brief Writer for dp files
+ *
+ * Dp files hold the strings and value arrays referenced by cid files and
+ * scripts. Every entry is aligned to 8 bytes in the data section and is
+ * referenced by an encoded offset, as it is expected by DPFile. The first
+ * 8 bytes of the data section are kept empty, so that no valid string
+ * offset collides with a small integer constant in bytecode.
+ */
+class DPFileWriter {
+public:
+	DPFileWriter();
+
+	/*!
+	 * Add a string to the data section, equal strings are only stored once
+	 * \param str the string to add
+	 * \return the encoded offset of the string
+	 */
+	uint32_t addString(const std::string &str);
+
+	/*!
+	 * Add an array of 32 bit values to the data section
+	 * \param values the values to add
+	 * \return the encoded offset of the values
+	 */
+	uint32_t addValues(const std::vector<uint32_t> &values);
+
+	/*!
+	 * Write the dp file
+	 * \param dp the stream to write the dp file to
+	 * \param v2 if the header of Alan Wakes American Nightmare should be written instead of the one of Alan Wake
+	 */
+	void write(Common::WriteStream &dp, bool v2) const;
+
+private:
+	uint32_t align();
+
+	std::vector<byte> _data;
+	std::vector<uint32_t> _valueOffsets;
+	std::vector<uint32_t> _stringOffsets;
+	std::map<std::string, uint32_t> _strings;
+};
+
+} // End of namespace DataGen
+
+#endif //OPENAWE_DATAGEN_DPFILEWRITER_H
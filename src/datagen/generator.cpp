@@ -0,0 +1,283 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <filesystem>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "src/common/atomtable.h"
+#include "src/common/memwritestream.h"
+#include "src/common/writefile.h"
+
+#include "src/datagen/binarchivewriter.h"
+#include "src/datagen/cidfilewriter.h"
+#include "src/datagen/dpfilewriter.h"
+#include "src/datagen/generator.h"
+#include "src/datagen/resources.h"
+#include "src/datagen/rmdparchivewriter.h"
+
+static const float kCellSize = 128.0f;
+
+static const uint32_t kGIDTypeDynamicObject = 1;
+static const uint32_t kGIDTypeCharacter     = 2;
+static const uint32_t kGIDTypeTrigger       = 3;
+static const uint32_t kGIDTypeScript        = 4;
+
+template<typename T> static std::vector<byte> getData(T &writer) {
+	Common::DynamicMemoryWriteStream stream(true);
+	writer.write(stream);
+	return std::vector<byte>(stream.getData(), stream.getData() + stream.getLength());
+}
+
+static std::vector<byte> getData(const DataGen::DPFileWriter &dp, bool v2) {
+	Common::DynamicMemoryWriteStream stream(true);
+	dp.write(stream, v2);
+	return std::vector<byte>(stream.getData(), stream.getData() + stream.getLength());
+}
+
+namespace DataGen {
+
+Generator::Generator(const Scale &scale, uint32_t seed) : _scale(scale), _seed(seed), _nextGID(1) {
+}
+
+bool Generator::getScale(const std::string &name, Scale &scale) {
+	if (name == "small")
+		scale = {4, 64, 16, 4, 8, 8, 16, 8, 64, 8, 16, 4, 16, 64};
+	else if (name == "medium")
+		scale = {64, 256, 64, 16, 32, 64, 64, 64, 256, 64, 64, 32, 32, 256};
+	else if (name == "large")
+		scale = {256, 1024, 256, 64, 128, 256, 128, 256, 512, 256, 256, 128, 64, 512};
+	else
+		return false;
+
+	return true;
+}
+
+Generator::Resources Generator::generateResources(Game game) {
+	// Both games get the same objects and gids, only their formats differ
+	_random.seed(_seed);
+	_nextGID = 1;
+	_gids.clear();
+
+	Resources resources;
+
+	for (unsigned int i = 0; i < _scale.numMeshes; ++i) {
+		const unsigned int version = game == kNightmare ? 21 : 19 + i % 2;
+		resources[fmt::format("meshes/mesh_{:03}.binmsh", i)] = writeBINMSH(
+				version,
+				_scale.meshResolution,
+				kCellSize * 0.25f
+		);
+	}
+
+	static const uint32_t kTextureFormats[] = {6, 5, 9};
+	const auto numMipmaps = static_cast<unsigned int>(std::log2(std::max(_scale.textureSize, 4u) / 4)) + 1;
+	for (unsigned int i = 0; i < _scale.numTextures; ++i) {
+		resources[fmt::format("textures/texture_{:03}.tex", i)] = writeTEX(
+				kTextureFormats[i % 3],
+				_scale.textureSize,
+				numMipmaps,
+				_random
+		);
+		resources[fmt::format("textures/texture_{:03}.dds", i)] = writeDDS(_scale.textureSize, numMipmaps, _random);
+	}
+
+	for (unsigned int i = 0; i < _scale.numAnimations; ++i) {
+		resources[fmt::format("animations/animation_{:03}.binhkx", i)] = writeHavokAnimation(
+				_scale.animationBones,
+				_scale.animationFrames,
+				_random
+		);
+	}
+
+	for (unsigned int i = 0; i < _scale.numCells; ++i) {
+		generateCell(game, i, resources);
+	}
+
+	generateScripts(game, resources);
+
+	resources["GIDRegistry.txt"] = writeGIDRegistry(_gids);
+
+	return resources;
+}
+
+void Generator::generate(const std::string &path) {
+	for (const auto game : {kAlanWake, kNightmare}) {
+		const std::string name = game == kNightmare ? "nightmare" : "alanwake";
+		const Resources resources = generateResources(game);
+
+		RMDPArchiveWriter archive(game == kNightmare ? 7 : 2);
+		size_t size = 0;
+		for (const auto &resource : resources) {
+			const std::filesystem::path file = std::filesystem::path(path) / name / resource.first;
+			std::filesystem::create_directories(file.parent_path());
+
+			Common::WriteFile stream(file.string());
+			stream.write(resource.second.data(), resource.second.size());
+
+			archive.addResource(resource.first, resource.second);
+			size += resource.second.size();
+		}
+
+		Common::WriteFile bin((std::filesystem::path(path) / (name + ".bin")).string());
+		Common::WriteFile rmdp((std::filesystem::path(path) / (name + ".rmdp")).string());
+		archive.write(bin, rmdp);
+
+		spdlog::info("Generated {} files with {} bytes for {}", resources.size(), size, name);
+	}
+}
+
+void Generator::generateCell(Game game, unsigned int cell, Resources &resources) {
+	const bool nightmare = game == kNightmare;
+	const CIDFileWriter::Format format = nightmare ? CIDFileWriter::kStructured : CIDFileWriter::kSimple;
+	const std::string prefix = fmt::format("objects/cell_{:03}", cell);
+
+	std::uniform_int_distribution<uint32_t> mesh(0, std::max(_scale.numMeshes, 1u) - 1);
+
+	DPFileWriter dp;
+	CIDFileWriter staticObjects(dp, kStaticObject, 6, format);
+	CIDFileWriter dynamicObjects(dp, kDynamicObject, nightmare ? 12 : 11, format);
+	CIDFileWriter characters(dp, kCharacter, nightmare ? 17 : 13, format);
+	CIDFileWriter triggers(dp, kTrigger, nightmare ? 20 : 18, format);
+
+	for (unsigned int i = 0; i < _scale.staticObjectsPerCell; ++i) {
+		AWE::Templates::StaticObject staticObject{};
+		staticObject.rotation = getRandomRotation();
+		staticObject.position = getRandomPosition(cell);
+		staticObject.meshResource = mesh(_random) + 1;
+		staticObject.physicsResource = staticObject.meshResource + 0x1000;
+		staticObjects.addStaticObject(staticObject);
+	}
+
+	for (unsigned int i = 0; i < _scale.dynamicObjectsPerCell; ++i) {
+		const std::string identifier = fmt::format("cell_{:03}_dynamicobject_{}", cell, i);
+
+		AWE::Templates::DynamicObject dynamicObject{};
+		dynamicObject.gid = createGID(kGIDTypeDynamicObject, identifier);
+		dynamicObject.rotation = getRandomRotation();
+		dynamicObject.position = getRandomPosition(cell);
+		dynamicObject.meshResource = mesh(_random) + 1;
+		dynamicObject.physicsResource = dynamicObject.meshResource + 0x1000;
+		dynamicObject.resourcePath = Atoms.intern(fmt::format("meshes/mesh_{:03}.binmsh", dynamicObject.meshResource - 1));
+		dynamicObject.identifier = Atoms.intern(identifier);
+		dynamicObjects.addDynamicObject(dynamicObject);
+	}
+
+	for (unsigned int i = 0; i < _scale.charactersPerCell; ++i) {
+		AWE::Templates::Character character{};
+		character.identifier = fmt::format("cell_{:03}_character_{}", cell, i);
+		character.gid = createGID(kGIDTypeCharacter, character.identifier);
+		character.classGid = GID{kGIDTypeCharacter, 0};
+		character.rotation = getRandomRotation();
+		character.position = getRandomPosition(cell);
+		character.meshResource = mesh(_random) + 1;
+		character.clothResource = character.meshResource + 0x2000;
+		character.fxaResource = character.meshResource + 0x3000;
+		character.animgraphResource = character.meshResource + 0x4000;
+		characters.addCharacter(character, {character.meshResource + 0x5000, character.meshResource + 0x6000});
+	}
+
+	for (unsigned int i = 0; i < _scale.triggersPerCell; ++i) {
+		const std::string identifier = fmt::format("cell_{:03}_trigger_{}", cell, i);
+
+		AWE::Templates::Trigger trigger{};
+		trigger.gid = createGID(kGIDTypeTrigger, identifier);
+		trigger.gid2 = trigger.gid;
+		trigger.identifier = Atoms.intern(identifier);
+		trigger.localeString = Atoms.intern(fmt::format("trigger_{}", i % 16));
+		std::vector<uint32_t> values(4);
+		for (auto &value : values) {
+			value = _random();
+		}
+		triggers.addTrigger(trigger, values);
+	}
+
+	std::vector<std::pair<std::string, std::vector<byte>>> files = {
+		{"staticobjects.cid", getData(staticObjects)},
+		{"dynamicobjects.cid", getData(dynamicObjects)},
+		{"characters.cid", getData(characters)},
+		{"triggers.cid", getData(triggers)},
+		{"objects.dp", getData(dp, nightmare)},
+	};
+
+	// Every cell is available as loose files and packed into a zlib compressed bin archive
+	BINArchiveWriter archive;
+	for (auto &file : files) {
+		archive.addResource(file.first, file.second);
+		resources[prefix + "/" + file.first] = std::move(file.second);
+	}
+	resources[prefix + ".bin"] = getData(archive);
+}
+
+void Generator::generateScripts(Game game, Resources &resources) {
+	const bool nightmare = game == kNightmare;
+
+	DPFileWriter bytecode, parameters, dp;
+	CIDFileWriter scripts(dp, kScript, 1, nightmare ? CIDFileWriter::kStructured : CIDFileWriter::kSimple);
+
+	for (unsigned int i = 0; i < _scale.numScripts; ++i) {
+		AWE::Templates::Script script{};
+		script.gid = createGID(kGIDTypeScript, fmt::format("script_{}", i));
+		script.script = writeBytecode(
+				bytecode,
+				parameters,
+				{"OnInit", "OnTaskActivate", "OnUpdate"},
+				_scale.scriptBlocks,
+				_random
+		);
+		scripts.addScript(script);
+	}
+
+	resources["scripts/bytecode.dp"] = getData(bytecode, nightmare);
+	resources["scripts/bytecodeparameters.dp"] = getData(parameters, nightmare);
+	resources["scripts/scripts.cid"] = getData(scripts);
+}
+
+GID Generator::createGID(uint32_t type, const std::string &name) {
+	const GID gid{type, _nextGID++};
+	_gids.emplace_back(gid, name);
+	return gid;
+}
+
+glm::mat3 Generator::getRandomRotation() {
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	const float yaw = angle(_random);
+	const float c = std::cos(yaw), s = std::sin(yaw);
+
+	glm::mat3 rotation(1.0f);
+	rotation[0] = glm::vec3(c, 0.0f, -s);
+	rotation[2] = glm::vec3(s, 0.0f, c);
+
+	return rotation;
+}
+
+glm::vec3 Generator::getRandomPosition(unsigned int cell) {
+	const auto cellsPerRow = static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<float>(_scale.numCells))));
+	std::uniform_real_distribution<float> offset(0.0f, kCellSize);
+
+	const float x = static_cast<float>(cell % cellsPerRow) * kCellSize + offset(_random);
+	const float z = static_cast<float>(cell / cellsPerRow) * kCellSize + offset(_random);
+
+	return glm::vec3(x, 0.0f, z);
+}
+
+} // End of namespace DataGen
@@ -0,0 +1,119 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_DATAGEN_GENERATOR_H
+#define OPENAWE_DATAGEN_GENERATOR_H
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/common/types.h"
+
+#include "src/awe/types.h"
+
+namespace DataGen {
+
+/*!
+ * \brief The amount of data to generate
+ */
+struct Scale {
+	unsigned int numCells;
+	unsigned int staticObjectsPerCell;
+	unsigned int dynamicObjectsPerCell;
+	unsigned int charactersPerCell;
+	unsigned int triggersPerCell;
+	unsigned int numMeshes;
+	unsigned int meshResolution;
+	unsigned int numTextures;
+	unsigned int textureSize;
+	unsigned int numScripts;
+	unsigned int scriptBlocks;
+	unsigned int numAnimations;
+	unsigned int animationBones;
+	unsigned int animationFrames;
+};
+
+/*!
+ * \brief Generator for synthetic game data
+ *
+ * Generates format valid, but meaningless data, which can be read by the
+ * parsers of the engine, so that benchmarks and stress tests can run
+ * without the original game files. The data is generated once in the
+ * flavour of Alan Wake and once in the flavour of Alan Wakes American
+ * Nightmare, which differ in the versions of the objects, the format of the
+ * cid files, the dp file headers and the version of the rmdp archive they
+ * are packed into. The same seed always produces the same data.
+ */
+class Generator {
+public:
+	enum Game {
+		kAlanWake,
+		kNightmare
+	};
+
+	typedef std::map<std::string, std::vector<byte>> Resources;
+
+	Generator(const Scale &scale, uint32_t seed);
+
+	/*!
+	 * Get one of the predefined scales
+	 * \param name the name of the scale, small, medium or large
+	 * \param scale the scale to set
+	 * \return if a scale with this name exists
+	 */
+	static bool getScale(const std::string &name, Scale &scale);
+
+	/*!
+	 * Generate all files of a game
+	 * \param game the game whose formats should be used
+	 * \return the generated files by their path
+	 */
+	Resources generateResources(Game game);
+
+	/*!
+	 * Generate the data for both games into a directory. For every game the
+	 * files are written into a sub directory and additionally packed into
+	 * a pair of rmdp archives next to it
+	 *
+	 * \param path the directory to write the data to
+	 */
+	void generate(const std::string &path);
+
+private:
+	void generateCell(Game game, unsigned int cell, Resources &resources);
+	void generateScripts(Game game, Resources &resources);
+
+	GID createGID(uint32_t type, const std::string &name);
+	glm::mat3 getRandomRotation();
+	glm::vec3 getRandomPosition(unsigned int cell);
+
+	const Scale _scale;
+	const uint32_t _seed;
+
+	std::mt19937 _random;
+	uint32_t _nextGID;
+	std::vector<std::pair<GID, std::string>> _gids;
+};
+
+} // End of namespace DataGen
+
+#endif //OPENAWE_DATAGEN_GENERATOR_H
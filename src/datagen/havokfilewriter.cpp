@@ -0,0 +1,214 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <map>
+
+#include "src/common/memwritestream.h"
+#include "src/common/strutil.h"
+
+#include "src/datagen/havokfilewriter.h"
+
+static const uint32_t kHeaderSize        = 64;
+static const uint32_t kSectionHeaderSize = 48;
+static const uint32_t kNumSections       = 3;
+
+static const uint32_t kClassNameSection = 0;
+static const uint32_t kDataSection      = 2;
+
+static void alignStream(Common::DynamicMemoryWriteStream &stream, size_t alignment) {
+	while (stream.getLength() % alignment != 0)
+		stream.writeByte(0xFF);
+}
+
+static void writeSectionHeader(
+		Common::WriteStream &binhkx,
+		const std::string &name,
+		uint32_t absoluteDataStart,
+		uint32_t localFixupsOffset,
+		uint32_t globalFixupsOffset,
+		uint32_t virtualFixupsOffset,
+		uint32_t endOffset
+) {
+	binhkx.writeString(name);
+	binhkx.writeZeros(19 - name.size());
+	binhkx.writeByte(0xFF);
+
+	binhkx.writeUint32LE(absoluteDataStart);
+	binhkx.writeUint32LE(localFixupsOffset);
+	binhkx.writeUint32LE(globalFixupsOffset);
+	binhkx.writeUint32LE(virtualFixupsOffset);
+	binhkx.writeUint32LE(endOffset); // Exports
+	binhkx.writeUint32LE(endOffset); // Imports
+	binhkx.writeUint32LE(endOffset);
+}
+
+namespace DataGen {
+
+uint32_t HavokFileWriter::allocate(uint32_t size) {
+	align(16);
+	const uint32_t address = _data.size();
+	_data.resize(_data.size() + size, 0);
+	return address;
+}
+
+uint32_t HavokFileWriter::addString(const std::string &str) {
+	const uint32_t address = _data.size();
+	_data.insert(_data.end(), str.begin(), str.end());
+	_data.emplace_back(0);
+	return address;
+}
+
+uint32_t HavokFileWriter::addData(const std::vector<byte> &data) {
+	align(16);
+	const uint32_t address = _data.size();
+	_data.insert(_data.end(), data.begin(), data.end());
+	return address;
+}
+
+void HavokFileWriter::setUint16(uint32_t address, uint16_t value) {
+	_data[address]     = value & 0xFFu;
+	_data[address + 1] = (value >> 8u) & 0xFFu;
+}
+
+void HavokFileWriter::setUint32(uint32_t address, uint32_t value) {
+	_data[address]     = value & 0xFFu;
+	_data[address + 1] = (value >> 8u) & 0xFFu;
+	_data[address + 2] = (value >> 16u) & 0xFFu;
+	_data[address + 3] = (value >> 24u) & 0xFFu;
+}
+
+void HavokFileWriter::setFloat(uint32_t address, float value) {
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	setUint32(address, bits);
+}
+
+void HavokFileWriter::setPointer(uint32_t address, uint32_t target) {
+	_localFixups.emplace_back(address, target);
+}
+
+void HavokFileWriter::setArray(uint32_t address, uint32_t target, uint32_t count) {
+	if (count > 0)
+		setPointer(address, target);
+	setUint32(address + 4, count);
+	setUint32(address + 8, count | 0x80000000u);
+}
+
+void HavokFileWriter::addObject(uint32_t address, const std::string &className) {
+	_objects.emplace_back(address, className);
+}
+
+void HavokFileWriter::write(Common::WriteStream &binhkx) const {
+	// Class names, referenced by the offset of their name in the section
+	Common::DynamicMemoryWriteStream classNames(true);
+	std::map<std::string, uint32_t> classNameOffsets;
+	for (const auto &object : _objects) {
+		if (classNameOffsets.find(object.second) != classNameOffsets.end())
+			continue;
+
+		uint32_t signature = Common::crc32(object.second);
+		if ((signature & 0xFFu) == 0xFFu)
+			signature &= ~0x01u;
+
+		classNames.writeUint32LE(signature);
+		classNames.writeByte(0x09);
+		classNameOffsets[object.second] = classNames.getLength();
+		classNames.writeString(object.second);
+		classNames.writeByte(0);
+	}
+	classNames.writeUint32LE(0xFFFFFFFF);
+	alignStream(classNames, 16);
+
+	// Data followed by its local, global and virtual fixups
+	Common::DynamicMemoryWriteStream data(true);
+	data.write(_data.data(), _data.size());
+	alignStream(data, 16);
+
+	const uint32_t localFixupsOffset = data.getLength();
+	for (const auto &fixup : _localFixups) {
+		data.writeUint32LE(fixup.first);
+		data.writeUint32LE(fixup.second);
+	}
+	data.writeUint32LE(0xFFFFFFFF);
+	data.writeUint32LE(0xFFFFFFFF);
+	alignStream(data, 16);
+
+	const uint32_t globalFixupsOffset = data.getLength();
+	data.writeUint32LE(0xFFFFFFFF);
+	alignStream(data, 16);
+
+	const uint32_t virtualFixupsOffset = data.getLength();
+	for (const auto &object : _objects) {
+		data.writeUint32LE(object.first);
+		data.writeUint32LE(kClassNameSection);
+		data.writeUint32LE(classNameOffsets.at(object.second));
+	}
+	data.writeUint32LE(0xFFFFFFFF);
+	data.writeUint32LE(0xFFFFFFFF);
+	alignStream(data, 16);
+
+	// HavokFile reads the contents up to their end offset as if it was an absolute position
+	const uint32_t dataStart = kHeaderSize + kNumSections * kSectionHeaderSize;
+	while (data.getLength() < dataStart)
+		data.writeByte(0xFF);
+
+	const uint32_t classNamesStart = dataStart + data.getLength();
+	const uint32_t typesStart = classNamesStart + classNames.getLength();
+
+	binhkx.writeUint32LE(0x57E0E057);
+	binhkx.writeUint32LE(0x10C0C010);
+	binhkx.writeUint32LE(0); // User tag
+	binhkx.writeUint32LE(8); // File version
+
+	// Layout rules, 4 byte pointers, little endian, no padding reuse and empty base class optimization
+	binhkx.writeByte(4);
+	binhkx.writeByte(1);
+	binhkx.writeByte(0);
+	binhkx.writeByte(1);
+
+	binhkx.writeUint32LE(kNumSections);
+	binhkx.writeUint32LE(kDataSection);
+	binhkx.writeUint32LE(0);
+	binhkx.writeUint32LE(kClassNameSection);
+	binhkx.writeUint32LE(_objects.empty() ? 0 : classNameOffsets.at(_objects.front().second));
+
+	const std::string version = "hk_2010.2.0-r1";
+	binhkx.writeString(version);
+	binhkx.writeZeros(15 - version.size());
+	binhkx.writeByte(0xFF);
+
+	binhkx.writeUint32LE(0); // Flags
+	binhkx.writeUint32LE(0xFFFFFFFF);
+
+	const uint32_t classNamesSize = classNames.getLength();
+	writeSectionHeader(binhkx, "__classnames__", classNamesStart, classNamesSize, classNamesSize, classNamesSize, classNamesSize);
+	writeSectionHeader(binhkx, "__types__", typesStart, 0, 0, 0, 0);
+	writeSectionHeader(binhkx, "__data__", dataStart, localFixupsOffset, globalFixupsOffset, virtualFixupsOffset, data.getLength());
+
+	binhkx.write(data.getData(), data.getLength());
+	binhkx.write(classNames.getData(), classNames.getLength());
+}
+
+void HavokFileWriter::align(size_t alignment) {
+	_data.resize((_data.size() + alignment - 1) / alignment * alignment, 0);
+}
+
+} // End of namespace DataGen
@@ -0,0 +1,108 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_DATAGEN_HAVOKFILEWRITER_H
+#define OPENAWE_DATAGEN_HAVOKFILEWRITER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/common/types.h"
+#include "src/common/writestream.h"
+
+namespace DataGen {
+
+/*!
+ * \brief Writer for havok packfiles in the hk_2010.2.0-r1 layout
+ *
+ * The objects are laid out manually in the data section. Space for them is
+ * allocated and their fields are set afterwards, so that objects can point
+ * to data which is allocated after them. Every pointer is stored as a local
+ * fixup and every object as a virtual fixup naming its class, the same way
+ * HavokFile resolves them. Since HavokFile rejects pointers to address 0,
+ * the first allocation should be an object which is not pointed to.
+ */
+class HavokFileWriter {
+public:
+	/*!
+	 * Allocate zero initialized space in the data section, aligned to 16 bytes
+	 * \param size the size of the space to allocate
+	 * \return the address of the allocated space
+	 */
+	uint32_t allocate(uint32_t size);
+
+	/*!
+	 * Add a null terminated string to the data section
+	 * \param str the string to add
+	 * \return the address of the string
+	 */
+	uint32_t addString(const std::string &str);
+
+	/*!
+	 * Add raw data to the data section, aligned to 16 bytes
+	 * \param data the data to add
+	 * \return the address of the data
+	 */
+	uint32_t addData(const std::vector<byte> &data);
+
+	void setUint16(uint32_t address, uint16_t value);
+	void setUint32(uint32_t address, uint32_t value);
+	void setFloat(uint32_t address, float value);
+
+	/*!
+	 * Set a pointer to another address of the data section
+	 * \param address the address of the pointer
+	 * \param target the address the pointer points to
+	 */
+	void setPointer(uint32_t address, uint32_t target);
+
+	/*!
+	 * Set an hkArray consisting of a pointer, a count and the capacity. Empty arrays don't get a pointer
+	 * \param address the address of the hkArray
+	 * \param target the address of the elements
+	 * \param count the number of elements
+	 */
+	void setArray(uint32_t address, uint32_t target, uint32_t count);
+
+	/*!
+	 * Mark an address as an object of the given class
+	 * \param address the address of the object
+	 * \param className the name of the class of the object
+	 */
+	void addObject(uint32_t address, const std::string &className);
+
+	/*!
+	 * Write the packfile
+	 * \param binhkx the stream to write the packfile to
+	 */
+	void write(Common::WriteStream &binhkx) const;
+
+private:
+	void align(size_t alignment);
+
+	std::vector<byte> _data;
+	std::vector<std::pair<uint32_t, uint32_t>> _localFixups;
+	std::vector<std::pair<uint32_t, std::string>> _objects;
+};
+
+} // End of namespace DataGen
+
+#endif //OPENAWE_DATAGEN_HAVOKFILEWRITER_H
@@ -0,0 +1,78 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+
+#include <cxxopts.hpp>
+#include <spdlog/spdlog.h>
+
+#include "src/datagen/generator.h"
+
+int main(int argc, char** argv) {
+	cxxopts::Options options(argv[0], "Generate synthetic game data for benchmarks and stress tests");
+
+	options.add_options()
+		("o,output", "Set the directory to write the data to", cxxopts::value<std::string>()->default_value("data"))
+		("s,scale", "Set the scale of the data, small, medium or large", cxxopts::value<std::string>()->default_value("small"))
+		("seed", "Set the seed of the random number generator", cxxopts::value<uint32_t>()->default_value("1"))
+		("cells", "Override the number of cells", cxxopts::value<unsigned int>())
+		("objects", "Override the number of static objects per cell", cxxopts::value<unsigned int>())
+		("meshes", "Override the number of meshes", cxxopts::value<unsigned int>())
+		("textures", "Override the number of textures", cxxopts::value<unsigned int>())
+		("scripts", "Override the number of scripts", cxxopts::value<unsigned int>())
+		("animations", "Override the number of animations", cxxopts::value<unsigned int>())
+		("h,help", "Print this help");
+
+	auto result = options.parse(argc, argv);
+
+	if (result.count("help")) {
+		std::cout << options.help() << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	DataGen::Scale scale{};
+	if (!DataGen::Generator::getScale(result["scale"].as<std::string>(), scale)) {
+		spdlog::error("Invalid scale {}", result["scale"].as<std::string>());
+		return EXIT_FAILURE;
+	}
+
+	if (result.count("cells"))
+		scale.numCells = result["cells"].as<unsigned int>();
+	if (result.count("objects"))
+		scale.staticObjectsPerCell = result["objects"].as<unsigned int>();
+	if (result.count("meshes"))
+		scale.numMeshes = result["meshes"].as<unsigned int>();
+	if (result.count("textures"))
+		scale.numTextures = result["textures"].as<unsigned int>();
+	if (result.count("scripts"))
+		scale.numScripts = result["scripts"].as<unsigned int>();
+	if (result.count("animations"))
+		scale.numAnimations = result["animations"].as<unsigned int>();
+
+	try {
+		DataGen::Generator generator(scale, result["seed"].as<uint32_t>());
+		generator.generate(result["output"].as<std::string>());
+	} catch (const std::exception &e) {
+		spdlog::critical(e.what());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,558 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "src/common/endianness.h"
+#include "src/common/memwritestream.h"
+
+#include "src/datagen/havokfilewriter.h"
+#include "src/datagen/resources.h"
+
+enum Opcode {
+	kPush       = 0x01,
+	kCallGlobal = 0x03,
+	kIntToFloat = 0x0E,
+	kSetMember  = 0x0F,
+	kGetMember  = 0x10,
+	kCmp        = 0x13,
+	kRet        = 0x0D,
+	kJmpIf      = 0x1A,
+	kLogAnd     = 0x1C,
+	kLogOr      = 0x1D,
+	kLogNot     = 0x1E,
+};
+
+static std::vector<byte> getData(Common::DynamicMemoryWriteStream &stream) {
+	return std::vector<byte>(stream.getData(), stream.getData() + stream.getLength());
+}
+
+static void writeRandom(Common::WriteStream &stream, size_t length, std::mt19937 &random) {
+	for (size_t i = 0; i < length; ++i) {
+		stream.writeByte(random() & 0xFFu);
+	}
+}
+
+static void alignStream(Common::DynamicMemoryWriteStream &stream, size_t alignment) {
+	while (stream.getLength() % alignment != 0)
+		stream.writeByte(0);
+}
+
+/*!
+ * Encode a quaternion the way HavokFile decodes 40 bit quaternions, by storing the three smallest components with
+ * 12 bit each, followed by the index and the sign of the largest component
+ */
+static uint64_t encode40BitQuaternion(const float (&quaternion)[4]) {
+	constexpr float fractal = 0.000345436f;
+
+	unsigned int largest = 0;
+	for (unsigned int i = 1; i < 4; ++i) {
+		if (std::abs(quaternion[i]) > std::abs(quaternion[largest]))
+			largest = i;
+	}
+
+	uint64_t value = 0;
+	unsigned int shift = 0;
+	for (unsigned int i = 0; i < 4; ++i) {
+		if (i == largest)
+			continue;
+
+		const auto component = static_cast<int>(std::lround(quaternion[i] / fractal)) + 0x801;
+		value |= static_cast<uint64_t>(std::clamp(component, 0, 0xFFF)) << shift;
+		shift += 12;
+	}
+
+	value |= static_cast<uint64_t>(largest) << 36u;
+	if (quaternion[largest] < 0.0f)
+		value |= 1ull << 38u;
+
+	return value;
+}
+
+static void writeKnots(Common::WriteStream &stream, unsigned int numItems, unsigned int degree) {
+	stream.writeUint16LE(numItems);
+	stream.writeByte(degree);
+	for (unsigned int i = 0; i < numItems + degree + 2; ++i) {
+		stream.writeByte(std::clamp<int>(static_cast<int>(i) - static_cast<int>(degree), 0, numItems - degree + 1));
+	}
+}
+
+static uint32_t encodeInstruction(Opcode opcode, byte param1 = 0, byte param2 = 0, byte param3 = 0) {
+	return param1 | (param2 << 8u) | (param3 << 16u) | (static_cast<uint32_t>(opcode) << 24u);
+}
+
+namespace DataGen {
+
+std::vector<byte> writeBINMSH(unsigned int version, unsigned int resolution, float size) {
+	if (version < 19 || version > 21)
+		throw std::runtime_error(fmt::format("Unsupported binmsh version {}", version));
+	if (resolution < 2 || resolution > 256)
+		throw std::runtime_error(fmt::format("Invalid binmsh resolution {}", resolution));
+
+	static const unsigned int kVertexSize = 20;
+
+	const uint32_t vertexCount = resolution * resolution;
+	const uint32_t faceCount = (resolution - 1) * (resolution - 1) * 2;
+
+	Common::DynamicMemoryWriteStream binmsh(true);
+
+	binmsh.writeUint32LE(version);
+	binmsh.writeUint32LE(vertexCount * kVertexSize);
+	binmsh.writeUint32LE(faceCount * 3);
+	binmsh.writeUint32LE(2); // 16 bit indices
+	binmsh.writeUint32LE(0); // Flags
+
+	// Vertices with a float position, a byte normal and short texture coordinates
+	for (unsigned int z = 0; z < resolution; ++z) {
+		for (unsigned int x = 0; x < resolution; ++x) {
+			const float u = static_cast<float>(x) / static_cast<float>(resolution - 1);
+			const float v = static_cast<float>(z) / static_cast<float>(resolution - 1);
+
+			binmsh.writeIEEEFloatLE((u - 0.5f) * size);
+			binmsh.writeIEEEFloatLE(std::sin(u * 6.0f) * std::cos(v * 6.0f) * size * 0.05f);
+			binmsh.writeIEEEFloatLE((v - 0.5f) * size);
+
+			binmsh.writeByte(127);
+			binmsh.writeByte(255);
+			binmsh.writeByte(127);
+			binmsh.writeByte(0);
+
+			binmsh.writeUint16LE(static_cast<int16_t>(u * 4096.0f));
+			binmsh.writeUint16LE(static_cast<int16_t>(v * 4096.0f));
+		}
+	}
+
+	for (unsigned int z = 0; z < resolution - 1; ++z) {
+		for (unsigned int x = 0; x < resolution - 1; ++x) {
+			const uint16_t i = z * resolution + x;
+			binmsh.writeUint16LE(i);
+			binmsh.writeUint16LE(i + resolution);
+			binmsh.writeUint16LE(i + 1);
+			binmsh.writeUint16LE(i + 1);
+			binmsh.writeUint16LE(i + resolution);
+			binmsh.writeUint16LE(i + resolution + 1);
+		}
+	}
+
+	binmsh.writeUint32LE(0); // Bones
+
+	// Bounding sphere and box
+	const float extent = size * 0.5f;
+	binmsh.writeIEEEFloatLE(0.0f);
+	binmsh.writeIEEEFloatLE(0.0f);
+	binmsh.writeIEEEFloatLE(0.0f);
+	binmsh.writeIEEEFloatLE(extent * std::sqrt(2.0f));
+	binmsh.writeIEEEFloatLE(-extent);
+	binmsh.writeIEEEFloatLE(-size * 0.05f);
+	binmsh.writeIEEEFloatLE(-extent);
+	binmsh.writeIEEEFloatLE(extent);
+	binmsh.writeIEEEFloatLE(size * 0.05f);
+	binmsh.writeIEEEFloatLE(extent);
+
+	binmsh.writeUint32LE(1); // LODs
+
+	// Material
+	binmsh.writeUint32LE(1);
+	if (version >= 20) {
+		const std::string name = "grid";
+		binmsh.writeUint32LE(name.size());
+		binmsh.writeString(name);
+	}
+
+	const std::string shaderName = "standardmaterial";
+	binmsh.writeUint32LE(shaderName.size() + 1);
+	binmsh.writeString(shaderName);
+	binmsh.writeByte(0);
+
+	binmsh.writeUint32LE(0); // Properties
+	binmsh.writeUint32LE(0); // Blend mode
+	binmsh.writeUint32LE(2); // Cull back faces
+	binmsh.writeUint32LE(1); // Cast shadows
+
+	const std::string attributeName = "g_vDiffuseColor";
+	binmsh.writeUint32LE(1);
+	binmsh.writeUint32LE(attributeName.size() + 1);
+	binmsh.writeString(attributeName);
+	binmsh.writeByte(0);
+	binmsh.writeUint32LE(2); // vec3
+	binmsh.writeIEEEFloatLE(0.5f);
+	binmsh.writeIEEEFloatLE(0.5f);
+	binmsh.writeIEEEFloatLE(0.5f);
+
+	// Mesh
+	binmsh.writeUint32LE(1);
+	binmsh.writeUint32LE(0); // Layer
+	binmsh.writeUint32LE(vertexCount);
+	binmsh.writeUint32LE(faceCount);
+	binmsh.writeUint32LE(0); // Vertex offset
+	binmsh.writeUint32LE(0); // Face offset
+	binmsh.writeZeros(4);
+	if (version >= 21)
+		binmsh.writeZeros(16);
+
+	// Vertex attributes as unknown byte, component and data type
+	binmsh.writeByte(3);
+	binmsh.writeByte(0);
+	binmsh.writeByte(0x02);
+	binmsh.writeByte(0);
+	binmsh.writeByte(0);
+	binmsh.writeByte(0x08);
+	binmsh.writeByte(4);
+	binmsh.writeByte(0);
+	binmsh.writeByte(0x07);
+	binmsh.writeByte(2);
+
+	binmsh.writeUint32LE(0); // Bone map
+
+	return getData(binmsh);
+}
+
+std::vector<byte> writeTEX(uint32_t format, unsigned int size, unsigned int numMipmaps, std::mt19937 &random) {
+	unsigned int blockSize, blockBytes;
+	switch (format) {
+		case 4:
+		case 6:
+		case 8:
+			blockSize = 1;
+			blockBytes = 4;
+			break;
+		case 5:
+			blockSize = 4;
+			blockBytes = 8;
+			break;
+		case 7:
+		case 9:
+			blockSize = 4;
+			blockBytes = 16;
+			break;
+		default:
+			throw std::runtime_error(fmt::format("Unsupported tex format {}", format));
+	}
+
+	Common::DynamicMemoryWriteStream tex(true);
+
+	tex.writeUint32LE(0); // Texture2D
+	tex.writeUint32LE(format);
+	tex.writeUint32LE(size);
+	tex.writeUint32LE(size);
+	tex.writeUint32LE(1); // Depth
+	tex.writeUint32LE(numMipmaps);
+	tex.writeUint32LE(0); // Filter
+	tex.writeZeros(4);
+
+	unsigned int mipmapSize = size;
+	for (unsigned int i = 0; i < numMipmaps; ++i) {
+		const unsigned int blocks = (mipmapSize + blockSize - 1) / blockSize;
+		writeRandom(tex, blocks * blocks * blockBytes, random);
+
+		mipmapSize = std::max(mipmapSize / 2, 4u);
+	}
+
+	return getData(tex);
+}
+
+std::vector<byte> writeDDS(unsigned int size, unsigned int numMipmaps, std::mt19937 &random) {
+	Common::DynamicMemoryWriteStream dds(true);
+
+	dds.writeUint32BE(MKTAG('D', 'D', 'S', 0x20));
+	dds.writeUint32LE(124);
+	dds.writeUint32LE(0x000A1007); // Caps, height, width, pixel format, mipmap count and linear size
+	dds.writeUint32LE(size);
+	dds.writeUint32LE(size);
+	dds.writeUint32LE(std::max(16u, ((size + 3u) / 4u) * ((size + 3u) / 4u) * 16u));
+	dds.writeUint32LE(0); // Depth
+	dds.writeUint32LE(numMipmaps);
+	dds.writeZeros(44);
+
+	// Pixel format
+	dds.writeUint32LE(32);
+	dds.writeUint32LE(0x4); // Four cc
+	dds.writeUint32BE(MKTAG('D', 'X', 'T', '5'));
+	dds.writeZeros(20);
+
+	dds.writeUint32LE(0x401008); // Complex, texture and mipmaps
+	dds.writeZeros(16);
+
+	unsigned int mipmapSize = size;
+	for (unsigned int i = 0; i < numMipmaps; ++i) {
+		writeRandom(dds, std::max(16u, ((mipmapSize + 3u) / 4u) * ((mipmapSize + 3u) / 4u) * 16u), random);
+		mipmapSize /= 2;
+	}
+
+	return getData(dds);
+}
+
+std::vector<byte> writeHavokAnimation(unsigned int numBones, unsigned int numFrames, std::mt19937 &random) {
+	if (numBones == 0 || numFrames == 0)
+		throw std::runtime_error("A havok animation needs at least one bone and one frame");
+
+	static const unsigned int kFramesPerBlock = 64;
+	static const float kFrameDuration = 1.0f / 30.0f;
+	static const float kBoneLength = 0.25f;
+
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+	HavokFileWriter havok;
+
+	// The container comes first, since nothing points to it
+	const uint32_t container = havok.allocate(56);
+	const uint32_t skeleton = havok.allocate(96);
+	const uint32_t animation = havok.allocate(128);
+	havok.addObject(container, "hkaAnimationContainer");
+	havok.addObject(skeleton, "hkaSkeleton");
+	havok.addObject(animation, "hkaSplineCompressedAnimation");
+
+	const uint32_t skeletons = havok.allocate(4);
+	havok.setPointer(skeletons, skeleton);
+	havok.setArray(container + 8, skeletons, 1);
+
+	const uint32_t animations = havok.allocate(4);
+	havok.setPointer(animations, animation);
+	havok.setArray(container + 20, animations, 1);
+
+	havok.setArray(container + 32, 0, 0); // Bindings
+	havok.setArray(container + 44, 0, 0); // Attachments
+
+	// Skeleton as a chain of bones
+	havok.setPointer(skeleton + 8, havok.addString("skeleton"));
+
+	const uint32_t parentIndices = havok.allocate(numBones * 2);
+	const uint32_t bones = havok.allocate(numBones * 8);
+	const uint32_t transforms = havok.allocate(numBones * 48);
+	std::vector<uint32_t> boneNames(numBones);
+	for (unsigned int i = 0; i < numBones; ++i) {
+		havok.setUint16(parentIndices + i * 2, i == 0 ? 0xFFFF : i - 1);
+
+		boneNames[i] = havok.addString(fmt::format("bone_{:03}", i));
+		havok.setPointer(bones + i * 8, boneNames[i]);
+
+		const uint32_t transform = transforms + i * 48;
+		havok.setFloat(transform + 4, i == 0 ? 0.0f : kBoneLength);
+		havok.setFloat(transform + 16, 1.0f);
+		havok.setFloat(transform + 32, 1.0f);
+		havok.setFloat(transform + 36, 1.0f);
+		havok.setFloat(transform + 40, 1.0f);
+	}
+
+	havok.setArray(skeleton + 12, parentIndices, numBones);
+	havok.setArray(skeleton + 24, bones, numBones);
+	havok.setArray(skeleton + 36, transforms, numBones);
+	for (unsigned int i = 0; i < 4; ++i) {
+		havok.setArray(skeleton + 48 + i * 12, 0, 0); // Reference floats, float slots, local frames and partitions
+	}
+
+	// Animation data, split into blocks which contain a spline for the position and the rotation of every track
+	const unsigned int numBlocks = (numFrames + kFramesPerBlock - 1) / kFramesPerBlock;
+
+	std::vector<std::array<float, 3>> velocities(numBones), axes(numBones);
+	for (unsigned int i = 0; i < numBones; ++i) {
+		velocities[i] = {unit(random), unit(random), unit(random)};
+
+		std::array<float, 3> axis = {unit(random), unit(random), unit(random)};
+		const float length = std::max(std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]), 0.001f);
+		axes[i] = {axis[0] / length, axis[1] / length, axis[2] / length};
+	}
+
+	Common::DynamicMemoryWriteStream data(true);
+	std::vector<uint32_t> blockOffsets;
+	for (unsigned int block = 0; block < numBlocks; ++block) {
+		const unsigned int firstFrame = block * kFramesPerBlock;
+		const unsigned int numItems = std::min(kFramesPerBlock, numFrames - firstFrame) - 1;
+		const unsigned int degree = std::min(numItems, 3u);
+
+		blockOffsets.emplace_back(data.getLength());
+
+		// 16 bit positions and 40 bit rotations, both as splines in all components
+		for (unsigned int i = 0; i < numBones; ++i) {
+			data.writeByte(0x05);
+			data.writeByte(0x70);
+			data.writeByte(0xF0);
+			data.writeByte(0x00);
+		}
+
+		for (unsigned int i = 0; i < numBones; ++i) {
+			std::vector<std::array<float, 3>> positions(numItems + 1);
+			std::array<float, 3> minimum{}, maximum{};
+			for (unsigned int item = 0; item <= numItems; ++item) {
+				const float time = static_cast<float>(firstFrame + item) * kFrameDuration;
+				for (unsigned int axis = 0; axis < 3; ++axis) {
+					positions[item][axis] = velocities[i][axis] * time + unit(random) * 0.01f;
+					minimum[axis] = item == 0 ? positions[item][axis] : std::min(minimum[axis], positions[item][axis]);
+					maximum[axis] = item == 0 ? positions[item][axis] : std::max(maximum[axis], positions[item][axis]);
+				}
+			}
+
+			writeKnots(data, numItems, degree);
+			alignStream(data, 4);
+
+			for (unsigned int axis = 0; axis < 3; ++axis) {
+				if (maximum[axis] <= minimum[axis])
+					maximum[axis] = minimum[axis] + 1.0f;
+				data.writeIEEEFloatLE(minimum[axis]);
+				data.writeIEEEFloatLE(maximum[axis]);
+			}
+
+			for (const auto &position : positions) {
+				for (unsigned int axis = 0; axis < 3; ++axis) {
+					const float value = (position[axis] - minimum[axis]) / (maximum[axis] - minimum[axis]);
+					data.writeUint16LE(static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f)));
+				}
+			}
+			alignStream(data, 4);
+
+			writeKnots(data, numItems, degree);
+			for (unsigned int item = 0; item <= numItems; ++item) {
+				const float angle = static_cast<float>(firstFrame + item) * kFrameDuration * (1.0f + static_cast<float>(i % 3));
+				const float sine = std::sin(angle * 0.5f);
+				const float quaternion[4] = {axes[i][0] * sine, axes[i][1] * sine, axes[i][2] * sine, std::cos(angle * 0.5f)};
+
+				const uint64_t value = encode40BitQuaternion(quaternion);
+				for (unsigned int part = 0; part < 5; ++part) {
+					data.writeByte((value >> (part * 8u)) & 0xFFu);
+				}
+			}
+			alignStream(data, 4);
+		}
+
+		// HavokFile reads 40 bit quaternions as 64 bit values
+		data.writeZeros(4);
+		alignStream(data, 16);
+	}
+
+	const uint32_t blockOffsetsAddress = havok.allocate(numBlocks * 4);
+	for (unsigned int i = 0; i < numBlocks; ++i) {
+		havok.setUint32(blockOffsetsAddress + i * 4, blockOffsets[i]);
+	}
+
+	const uint32_t dataAddress = havok.addData(std::vector<byte>(data.getData(), data.getData() + data.getLength()));
+
+	const uint32_t annotations = havok.allocate(numBones * 16);
+	for (unsigned int i = 0; i < numBones; ++i) {
+		havok.setPointer(annotations + i * 16, boneNames[i]);
+	}
+
+	const float blockDuration = static_cast<float>(kFramesPerBlock - 1) * kFrameDuration;
+	havok.setUint32(animation + 8, 5); // Spline compressed
+	havok.setFloat(animation + 12, static_cast<float>(numFrames - 1) * kFrameDuration);
+	havok.setUint32(animation + 16, numBones);
+	havok.setUint32(animation + 20, 0);
+	havok.setArray(animation + 28, annotations, numBones);
+	havok.setUint32(animation + 40, numFrames);
+	havok.setUint32(animation + 44, numBlocks);
+	havok.setUint32(animation + 48, kFramesPerBlock);
+	havok.setUint32(animation + 52, numBones * 4);
+	havok.setFloat(animation + 56, blockDuration);
+	havok.setFloat(animation + 60, 1.0f / blockDuration);
+	havok.setFloat(animation + 64, kFrameDuration);
+	havok.setArray(animation + 68, blockOffsetsAddress, numBlocks);
+	havok.setArray(animation + 80, 0, 0); // Float block offsets
+	havok.setArray(animation + 92, 0, 0); // Transform offsets
+	havok.setArray(animation + 104, 0, 0); // Float offsets
+	havok.setArray(animation + 116, dataAddress, data.getLength());
+
+	Common::DynamicMemoryWriteStream binhkx(true);
+	havok.write(binhkx);
+
+	return getData(binhkx);
+}
+
+std::vector<byte> writeGIDRegistry(const std::vector<std::pair<GID, std::string>> &gids) {
+	std::string registry;
+	for (const auto &gid : gids) {
+		registry += fmt::format("{},{:08X},{}\r\n", gid.first.type, Common::swapBytes(gid.first.id), gid.second);
+	}
+
+	return std::vector<byte>(registry.begin(), registry.end());
+}
+
+AWE::Templates::ScriptVariables writeBytecode(
+		DPFileWriter &bytecode,
+		DPFileWriter &parameters,
+		const std::vector<std::string> &handlers,
+		unsigned int numBlocks,
+		std::mt19937 &random
+) {
+	// Keep integer constants below 256, so that they are never mistaken for string offsets
+	std::uniform_int_distribution<uint32_t> constant(0, 255);
+	std::uniform_int_distribution<uint32_t> block(0, 3);
+
+	const uint32_t gameString = parameters.addString("Game");
+	const uint32_t getRandIntString = parameters.addString("GetRandInt");
+
+	std::vector<uint32_t> code;
+	std::vector<uint32_t> handlerTable;
+	for (const auto &handler : handlers) {
+		handlerTable.emplace_back(code.size());
+		handlerTable.emplace_back(parameters.addString(handler));
+
+		for (unsigned int i = 0; i < numBlocks; ++i) {
+			if (block(random) == 0) {
+				// Call GAME.GetRandInt(upper, lower) and compare the result with a constant
+				const uint32_t lower = constant(random);
+				code.insert(code.end(), {
+						encodeInstruction(kPush), lower,
+						encodeInstruction(kPush), std::max(lower, constant(random)),
+						encodeInstruction(kPush), getRandIntString,
+						encodeInstruction(kPush), gameString,
+						encodeInstruction(kCallGlobal, 2, 1),
+						encodeInstruction(kPush), constant(random),
+						encodeInstruction(kCmp),
+				});
+			} else {
+				// Combine constants logically, compare them, jump conditionally and convert an integer to float
+				const byte member = constant(random);
+				code.insert(code.end(), {
+						encodeInstruction(kPush), constant(random) & 1u,
+						encodeInstruction(kPush), constant(random) & 1u,
+						encodeInstruction(kLogAnd),
+						encodeInstruction(kLogNot),
+						encodeInstruction(kPush), constant(random) & 1u,
+						encodeInstruction(kLogOr),
+						encodeInstruction(kPush), constant(random) & 1u,
+						encodeInstruction(kCmp),
+						encodeInstruction(kJmpIf), 1,
+						encodeInstruction(kGetMember, member),
+						encodeInstruction(kPush), constant(random),
+						encodeInstruction(kIntToFloat),
+						encodeInstruction(kPush), constant(random),
+						encodeInstruction(kCmp),
+						encodeInstruction(kSetMember, member),
+				});
+			}
+		}
+
+		code.emplace_back(encodeInstruction(kRet));
+	}
+
+	AWE::Templates::ScriptVariables script{};
+	script.codeSize = code.size();
+	script.offsetCode = bytecode.addValues(code);
+	script.numHandlers = handlers.size();
+	script.offsetHandlers = bytecode.addValues(handlerTable);
+
+	return script;
+}
+
+} // End of namespace DataGen
@@ -0,0 +1,102 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_DATAGEN_RESOURCES_H
+#define OPENAWE_DATAGEN_RESOURCES_H
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/awe/object.h"
+#include "src/awe/types.h"
+
+#include "src/datagen/dpfilewriter.h"
+
+namespace DataGen {
+
+/*!
+ * Write a binmsh mesh consisting of a single square grid with position, normal and texture coordinates
+ * \param version the version of the mesh, 19, 20 or 21
+ * \param resolution the number of vertices along each side of the grid, at most 256
+ * \param size the edge length of the grid
+ * \return the content of the binmsh file
+ */
+std::vector<byte> writeBINMSH(unsigned int version, unsigned int resolution, float size);
+
+/*!
+ * Write a tex texture with random content
+ * \param format the format id of the texture, 4, 6 or 8 for RGBA8, 5 for DXT1 and 7 or 9 for DXT5
+ * \param size the width and height of the texture
+ * \param numMipmaps the number of mipmaps
+ * \param random the random number generator for the content
+ * \return the content of the tex file
+ */
+std::vector<byte> writeTEX(uint32_t format, unsigned int size, unsigned int numMipmaps, std::mt19937 &random);
+
+/*!
+ * Write a DXT5 compressed dds texture with random content
+ * \param size the width and height of the texture
+ * \param numMipmaps the number of mipmaps
+ * \param random the random number generator for the content
+ * \return the content of the dds file
+ */
+std::vector<byte> writeDDS(unsigned int size, unsigned int numMipmaps, std::mt19937 &random);
+
+/*!
+ * Write a havok packfile with an animation container holding a skeleton of a chain of bones and a spline
+ * compressed animation with one track per bone, using 16 bit positions and 40 bit rotations
+ * \param numBones the number of bones of the skeleton
+ * \param numFrames the number of frames of the animation
+ * \param random the random number generator for the movement of the bones
+ * \return the content of the binhkx file
+ */
+std::vector<byte> writeHavokAnimation(unsigned int numBones, unsigned int numFrames, std::mt19937 &random);
+
+/*!
+ * Write a GIDRegistry.txt file
+ * \param gids the gids and their names
+ * \return the content of the GIDRegistry.txt file
+ */
+std::vector<byte> writeGIDRegistry(const std::vector<std::pair<GID, std::string>> &gids);
+
+/*!
+ * Write the bytecode of a script into a pair of dp files. Every handler consists of the given number of blocks,
+ * which compare constants, combine them logically, jump and call GAME.GetRandInt, and keep the stack balanced
+ *
+ * \param bytecode the dp file to store the code and the handler table in
+ * \param parameters the dp file to store the names of handlers and the string constants in
+ * \param handlers the names of the entry points of the script
+ * \param numBlocks the number of blocks per handler
+ * \param random the random number generator for constants and the order of blocks
+ * \return the script variables referencing the code
+ */
+AWE::Templates::ScriptVariables writeBytecode(
+		DPFileWriter &bytecode,
+		DPFileWriter &parameters,
+		const std::vector<std::string> &handlers,
+		unsigned int numBlocks,
+		std::mt19937 &random
+);
+
+} // End of namespace DataGen
+
+#endif //OPENAWE_DATAGEN_RESOURCES_H
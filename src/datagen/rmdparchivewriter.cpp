@@ -0,0 +1,171 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sstream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <zlib.h>
+
+#include "src/common/strutil.h"
+
+#include "src/datagen/rmdparchivewriter.h"
+
+static const uint32_t kNone = 0xFFFFFFFF;
+
+namespace DataGen {
+
+RMDPArchiveWriter::RMDPArchiveWriter(unsigned int version) : _version(version) {
+	if (version != 2 && version != 7)
+		throw std::runtime_error(fmt::format("Unsupported RMDP Archive version {}", version));
+
+	// The root folder
+	_folders.emplace_back(Folder{"", kNone, {}, {}});
+}
+
+void RMDPArchiveWriter::addResource(const std::string &path, std::vector<byte> data) {
+	std::stringstream stream(_version == 7 ? "d:/data/" + path : path);
+	std::vector<std::string> items;
+	std::string item;
+	while (std::getline(stream, item, '/')) {
+		items.emplace_back(item);
+	}
+
+	if (items.empty())
+		throw std::runtime_error("Empty resource path");
+
+	uint32_t folder = 0;
+	for (size_t i = 0; i < items.size() - 1; ++i) {
+		folder = getFolder(folder, items[i]);
+	}
+
+	_folders[folder].files.emplace_back(_files.size());
+	_files.emplace_back(File{items.back(), folder, std::move(data)});
+}
+
+void RMDPArchiveWriter::write(Common::WriteStream &bin, Common::WriteStream &rmdp) const {
+	// Build the name table, the root folder has no name
+	std::string names;
+	std::vector<uint32_t> folderNameOffsets(_folders.size(), kNone);
+	std::vector<uint32_t> fileNameOffsets(_files.size());
+	for (size_t i = 1; i < _folders.size(); ++i) {
+		folderNameOffsets[i] = names.size();
+		names += _folders[i].name;
+		names += '\0';
+	}
+	for (size_t i = 0; i < _files.size(); ++i) {
+		fileNameOffsets[i] = names.size();
+		names += _files[i].name;
+		names += '\0';
+	}
+
+	// Chain the sub folders and the files of every folder by their successors
+	std::vector<uint32_t> nextFolders(_folders.size(), kNone);
+	std::vector<uint32_t> nextFiles(_files.size(), kNone);
+	for (const auto &folder : _folders) {
+		for (size_t i = 1; i < folder.folders.size(); ++i) {
+			nextFolders[folder.folders[i - 1]] = folder.folders[i];
+		}
+		for (size_t i = 1; i < folder.files.size(); ++i) {
+			nextFiles[folder.files[i - 1]] = folder.files[i];
+		}
+	}
+
+	// Header
+	bin.writeByte(_version == 2 ? 1 : 0);
+	writeUint32(bin, _version);
+	writeUint32(bin, _folders.size());
+	writeUint32(bin, _files.size());
+	if (_version == 2) {
+		writeUint32(bin, names.size());
+		bin.writeByte(0); // Empty path prefix
+	} else {
+		bin.writeUint64LE(1);
+		writeUint32(bin, names.size());
+		bin.writeZeros(8);
+	}
+	bin.writeZeros(120);
+
+	// Folders, every folder links to its first sub folder and its first file
+	for (size_t i = 0; i < _folders.size(); ++i) {
+		const Folder &folder = _folders[i];
+
+		writeUint32(bin, Common::crc32(Common::toLower(folder.name)));
+		writeUint32(bin, nextFolders[i]);
+		writeUint32(bin, folder.parent);
+		writeUint32(bin, 0);
+		writeUint32(bin, folderNameOffsets[i]);
+		writeUint32(bin, folder.folders.empty() ? kNone : folder.folders.front());
+		writeUint32(bin, folder.files.empty() ? kNone : folder.files.front());
+	}
+
+	// Files
+	uint64_t offset = 0;
+	for (size_t i = 0; i < _files.size(); ++i) {
+		const File &file = _files[i];
+
+		writeUint32(bin, Common::crc32(Common::toLower(file.name)));
+		writeUint32(bin, nextFiles[i]);
+		writeUint32(bin, file.folder);
+		writeUint32(bin, 0); // Flags
+		writeUint32(bin, fileNameOffsets[i]);
+		writeUint64(bin, offset);
+		writeUint64(bin, file.data.size());
+		bin.writeUint32LE(::crc32(0L, file.data.data(), file.data.size()));
+
+		if (_version == 7)
+			bin.writeZeros(8); // Write Time
+
+		rmdp.write(file.data.data(), file.data.size());
+		offset += file.data.size();
+	}
+
+	bin.write(names.data(), names.size());
+}
+
+uint32_t RMDPArchiveWriter::getFolder(uint32_t parent, const std::string &name) {
+	const uint32_t nameHash = Common::crc32(Common::toLower(name));
+	for (const auto folder : _folders[parent].folders) {
+		if (Common::crc32(Common::toLower(_folders[folder].name)) == nameHash)
+			return folder;
+	}
+
+	const uint32_t folder = _folders.size();
+	_folders[parent].folders.emplace_back(folder);
+	_folders.emplace_back(Folder{name, parent, {}, {}});
+
+	return folder;
+}
+
+void RMDPArchiveWriter::writeUint32(Common::WriteStream &bin, uint32_t value) const {
+	if (_version == 2)
+		bin.writeUint32BE(value);
+	else
+		bin.writeUint32LE(value);
+}
+
+void RMDPArchiveWriter::writeUint64(Common::WriteStream &bin, uint64_t value) const {
+	if (_version == 2)
+		bin.writeUint64BE(value);
+	else
+		bin.writeUint64LE(value);
+}
+
+} // End of namespace DataGen
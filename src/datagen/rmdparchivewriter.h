@@ -0,0 +1,88 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_DATAGEN_RMDPARCHIVEWRITER_H
+#define OPENAWE_DATAGEN_RMDPARCHIVEWRITER_H
+
+#include <string>
+#include <vector>
+
+#include "src/common/writestream.h"
+
+namespace DataGen {
+
+/*!
+ * \brief Writer for pairs of .bin and .rmdp archives
+ *
+ * The .bin file holds the folder and file tree together with the name table
+ * and the .rmdp file holds the concatenated file data. Version 2 archives,
+ * as used by Alan Wake, are written big endian, version 7 archives, as used
+ * by Alan Wakes American Nightmare, are written little endian and prefix
+ * every path with d:/data/.
+ */
+class RMDPArchiveWriter {
+public:
+	/*!
+	 * Create a writer for an archive
+	 * \param version the version of the archive header, either 2 or 7
+	 */
+	RMDPArchiveWriter(unsigned int version);
+
+	/*!
+	 * Add a file to the archive
+	 * \param path the path of the file, separated by slashes
+	 * \param data the content of the file
+	 */
+	void addResource(const std::string &path, std::vector<byte> data);
+
+	/*!
+	 * Write the archive
+	 * \param bin the stream to write the header and the file tree to
+	 * \param rmdp the stream to write the file data to
+	 */
+	void write(Common::WriteStream &bin, Common::WriteStream &rmdp) const;
+
+private:
+	struct Folder {
+		std::string name;
+		uint32_t parent;
+		std::vector<uint32_t> folders;
+		std::vector<uint32_t> files;
+	};
+
+	struct File {
+		std::string name;
+		uint32_t folder;
+		std::vector<byte> data;
+	};
+
+	uint32_t getFolder(uint32_t parent, const std::string &name);
+
+	void writeUint32(Common::WriteStream &bin, uint32_t value) const;
+	void writeUint64(Common::WriteStream &bin, uint64_t value) const;
+
+	const unsigned int _version;
+	std::vector<Folder> _folders;
+	std::vector<File> _files;
+};
+
+} // End of namespace DataGen
+
+#endif //OPENAWE_DATAGEN_RMDPARCHIVEWRITER_H
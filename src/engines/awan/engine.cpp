@@ -20,6 +20,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include "src/common/log.h"
 #include "src/common/strutil.h"
 
 #include "src/awe/resman.h"
@@ -65,7 +66,7 @@ void Engine::loadEpisode(const std::string &parameters) {
 		if (!bytecode->hasEntryPoint("OnTaskActivate"))
 			continue;
 
-		spdlog::debug("Firing OnTaskActivate on {} {} {:x}", task.getName(), gid.type, gid.id);
+		LOG_DEBUG("Firing OnTaskActivate on {} {} {:x}", task.getName(), gid.type, gid.id);
 
 		AWE::Script::Context context(_registry, *_functions);
 		bytecode->run(context, "OnTaskActivate", item);
@@ -30,12 +30,20 @@ void Functions::activateTask(Functions::Context &ctx) {
 	const entt::entity taskEntity = ctx.getEntity(0);
 
 	entt::registry &registry = ctx.getFunctions<Functions>()._registry;
-	AWE::Script::Context newContext(registry, ctx.functions);
 
 	Task task = registry.get<Task>(taskEntity);
 	AWE::Script::BytecodePtr bytecode = registry.get<AWE::Script::BytecodePtr>(taskEntity);
-	if (bytecode->hasEntryPoint("OnTaskActivate"))
-		bytecode->run(newContext, "OnTaskActivate", taskEntity);
+	if (!bytecode->hasEntryPoint("OnTaskActivate"))
+		return;
+
+	// Run the task in the context of the calling script to keep its scheduler, profiler and tracer
+	if (ctx.script) {
+		bytecode->run(*ctx.script, "OnTaskActivate", taskEntity, ctx.commands);
+		return;
+	}
+
+	AWE::Script::Context newContext(registry, ctx.functions);
+	bytecode->run(newContext, "OnTaskActivate", taskEntity, ctx.commands);
 }
 
 void Functions::playMusic(Functions::Context &ctx) {
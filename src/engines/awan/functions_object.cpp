@@ -42,10 +42,12 @@ void Functions::hide(Context &ctx) {
 	Graphics::ModelPtr model = registry.get<Graphics::ModelPtr>(caller);
 
 	const bool hide = ctx.getInt(0) == 1;
-	if (hide)
-		model->hide();
-	else
-		model->show();
+	ctx.defer([model, hide]() {
+		if (hide)
+			model->hide();
+		else
+			model->show();
+	});
 }
 
 }
@@ -18,23 +18,30 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 
+#include "src/common/memwritestream.h"
+
 #include "src/awe/resman.h"
 #include "src/awe/binarchive.h"
 
 #include "src/episode.h"
+#include "src/common/memorytracker.h"
+#include "src/common/profiler.h"
 
-Episode::Episode(entt::registry &registry, const std::string &world, const std::string &id) :
-	ObjectCollection(registry),
+Episode::Episode(entt::registry &registry, const std::string &world, const std::string &id, bool staging) :
+	ObjectCollection(registry, staging),
 	_id(id),
 	_world(world) {
+	PROFILE_ZONE("Episode::Episode");
 	std::string episodeFolder = fmt::format("worlds/{}/episodes/{}", world, id);
 
-	loadGIDRegistry(ResMan.getResource(fmt::format("{}/GIDRegistry.txt", episodeFolder)));
+	loadGIDRegistry(getResource(fmt::format("{}/GIDRegistry.txt", episodeFolder)));
 
-	std::unique_ptr<Common::ReadStream> episodeStream(ResMan.getResource(fmt::format("{}/episode.bin", episodeFolder)));
+	std::unique_ptr<Common::ReadStream> episodeStream(getResource(fmt::format("{}/episode.bin", episodeFolder)));
 	AWE::BINArchive episode(*episodeStream);
 	std::shared_ptr<DPFile> dp = std::make_shared<DPFile>(episode.getResource("dp_episode.bin"));
 
@@ -44,9 +51,9 @@ Episode::Episode(entt::registry &registry, const std::string &world, const std::
 	// TODO: Alan Wake has several archives without a proper pattern
 	std::unique_ptr<Common::ReadStream> tasksStream;
 	if (ResMan.hasResource(fmt::format("{}/tasks.bin", episodeFolder)))
-		tasksStream.reset(ResMan.getResource(fmt::format("{}/tasks.bin", episodeFolder)));
+		tasksStream.reset(getResource(fmt::format("{}/tasks.bin", episodeFolder)));
 	else if (ResMan.hasResource(fmt::format("{}/root.bin", episodeFolder)))
-		tasksStream.reset(ResMan.getResource(fmt::format("{}/root.bin", episodeFolder)));
+		tasksStream.reset(getResource(fmt::format("{}/root.bin", episodeFolder)));
 
 	AWE::BINArchive tasks(*tasksStream);
 
@@ -96,6 +103,122 @@ Episode::Episode(entt::registry &registry, const std::string &world, const std::
 	load(tasks.getResource("cid_waypointscript.bin"), kScript, dp);
 }
 
+Episode::Episode(
+		entt::registry &registry,
+		const std::string &world,
+		const std::string &id,
+		Common::ReadStream &snapshot,
+		std::vector<std::unique_ptr<Level>> &loadedLevels,
+		bool staging
+) :
+	ObjectCollection(registry, staging),
+	_id(id),
+	_world(world) {
+	PROFILE_ZONE("Episode::Episode (snapshot)");
+	spdlog::info("Restoring episode {} from snapshot", id);
+	restore(snapshot);
+
+	try {
+		const uint32_t numLevels = snapshot.readUint32LE();
+		for (uint32_t i = 0; i < numLevels; ++i) {
+			const std::string levelId = snapshot.readFixedSizeString(snapshot.readUint32LE());
+			const uint32_t levelSize = snapshot.readUint32LE();
+
+			auto loadedLevel = findLevel(loadedLevels, levelId);
+			if (loadedLevel != loadedLevels.end()) {
+				spdlog::info("Reusing level {}", levelId);
+				_levels.emplace_back(std::move(*loadedLevel));
+				loadedLevels.erase(loadedLevel);
+				snapshot.skip(levelSize);
+				continue;
+			}
+
+			_levels.emplace_back(std::make_unique<Level>(_registry, levelId, _world, snapshot, _staging));
+		}
+	} catch (...) {
+		// Hand the levels back, so that loading the episode without the snapshot can still reuse them
+		for (auto &level : _levels)
+			loadedLevels.emplace_back(std::move(level));
+		throw;
+	}
+}
+
 void Episode::loadLevel(const std::string &id) {
-	_levels.emplace_back(std::make_unique<Level>(_registry, id, _world));
+	MemoryTracking.resetPeaks();
+	_levels.emplace_back(std::make_unique<Level>(_registry, id, _world, _staging));
+	MemoryTracking.checkBudgets(fmt::format("Loading level {}", id));
+}
+
+void Episode::loadLevel(const std::string &id, std::vector<std::unique_ptr<Level>> &loadedLevels) {
+	auto loadedLevel = findLevel(loadedLevels, id);
+	if (loadedLevel == loadedLevels.end()) {
+		loadLevel(id);
+		return;
+	}
+
+	spdlog::info("Reusing level {}", id);
+	_levels.emplace_back(std::move(*loadedLevel));
+	loadedLevels.erase(loadedLevel);
+}
+
+bool Episode::hasLevel(const std::string &id) const {
+	return std::any_of(_levels.begin(), _levels.end(), [&](const auto &level){ return level->getId() == id; });
+}
+
+std::vector<std::string> Episode::getLevelIds() const {
+	std::vector<std::string> ids;
+	for (const auto &level : _levels)
+		ids.emplace_back(level->getId());
+	return ids;
+}
+
+std::vector<std::unique_ptr<Level>> Episode::releaseLevels() {
+	std::vector<std::unique_ptr<Level>> levels = std::move(_levels);
+	_levels.clear();
+	return levels;
+}
+
+std::vector<std::unique_ptr<Level>>::iterator Episode::findLevel(std::vector<std::unique_ptr<Level>> &levels, const std::string &id) {
+	return std::find_if(levels.begin(), levels.end(), [&](const auto &level){ return level->getId() == id; });
+}
+
+void Episode::setStreamingRadius(float highDetailRadius, float lowDetailRadius) {
+	for (const auto &level : _levels)
+		level->setStreamingRadius(highDetailRadius, lowDetailRadius);
+}
+
+void Episode::setCellSize(float cellSize) {
+	for (const auto &level : _levels)
+		level->setCellSize(cellSize);
+}
+
+void Episode::update(const glm::vec3 &cameraPosition, SpatialIndex &spatialIndex) {
+	addToSpatialIndex(spatialIndex);
+	for (const auto &level : _levels)
+		level->update(cameraPosition, spatialIndex);
+}
+
+ObjectCollection::Inputs Episode::getInputs() const {
+	Inputs inputs = ObjectCollection::getInputs();
+	for (const auto &level : _levels) {
+		const Inputs levelInputs = level->getInputs();
+		inputs.insert(inputs.end(), levelInputs.begin(), levelInputs.end());
+	}
+	return inputs;
+}
+
+void Episode::save(Common::WriteStream &snapshot) const {
+	ObjectCollection::save(snapshot);
+
+	// Every level is prefixed with its size, so that already loaded levels can be skipped on restore
+	snapshot.writeUint32LE(_levels.size());
+	for (const auto &level : _levels) {
+		Common::DynamicMemoryWriteStream levelData(true);
+		level->save(levelData);
+
+		snapshot.writeUint32LE(level->getId().size());
+		snapshot.writeString(level->getId());
+		snapshot.writeUint32LE(levelData.getLength());
+		snapshot.write(levelData.getData(), levelData.getLength());
+	}
 }
@@ -26,11 +26,88 @@
 
 class Episode : public ObjectCollection {
 public:
-	Episode(entt::registry &registry, const std::string &id, const std::string &world);
+	Episode(entt::registry &registry, const std::string &world, const std::string &id, bool staging = false);
+
+	/*!
+	 * Restore an episode together with its levels from a snapshot. Levels
+	 * which are already loaded are taken over instead of being restored.
+	 * \param registry the registry in which the entities are created
+	 * \param world the world of the episode
+	 * \param id the id of the episode
+	 * \param snapshot the snapshot written by save()
+	 * \param loadedLevels levels of a previous episode which can be reused
+	 * \param staging if the episode is restored outside of the main thread into a staging registry
+	 */
+	Episode(
+		entt::registry &registry,
+		const std::string &world,
+		const std::string &id,
+		Common::ReadStream &snapshot,
+		std::vector<std::unique_ptr<Level>> &loadedLevels,
+		bool staging = false
+	);
 
 	void loadLevel(const std::string &id);
 
+	/*!
+	 * Load a level or take it over from the levels of a previous episode
+	 * \param id the id of the level
+	 * \param loadedLevels levels of a previous episode which can be reused
+	 */
+	void loadLevel(const std::string &id, std::vector<std::unique_ptr<Level>> &loadedLevels);
+
+	/*!
+	 * Check if a level is part of this episode
+	 * \param id the id of the level
+	 * \return if the level is loaded in this episode
+	 */
+	bool hasLevel(const std::string &id) const;
+
+	/*!
+	 * Get the ids of all levels of this episode
+	 * \return the ids of the levels
+	 */
+	std::vector<std::string> getLevelIds() const;
+
+	/*!
+	 * Release the levels of this episode, so that they can be reused by the
+	 * next episode
+	 * \return the levels of this episode
+	 */
+	std::vector<std::unique_ptr<Level>> releaseLevels();
+
+	/*!
+	 * Set the distances around the camera in which the cells of all levels are resident
+	 * \param highDetailRadius the radius for high detail cells in world units
+	 * \param lowDetailRadius the radius for low detail cells in world units
+	 */
+	void setStreamingRadius(float highDetailRadius, float lowDetailRadius);
+
+	/*!
+	 * Set the size of a single cell of all levels in world units
+	 * \param cellSize the edge length of a cell
+	 */
+	void setCellSize(float cellSize);
+
+	/*!
+	 * Update the streamed cells of all levels and add the loaded entities to
+	 * the spatial index
+	 * \param cameraPosition the current position of the camera
+	 * \param spatialIndex the spatial index for the entities of the episode
+	 */
+	void update(const glm::vec3 &cameraPosition, SpatialIndex &spatialIndex);
+
+	Inputs getInputs() const override;
+
+	/*!
+	 * Write the episode together with its levels into a snapshot
+	 * \param snapshot the stream to write the snapshot to
+	 */
+	void save(Common::WriteStream &snapshot) const;
+
 private:
+	static std::vector<std::unique_ptr<Level>>::iterator findLevel(std::vector<std::unique_ptr<Level>> &levels, const std::string &id);
+
 	const std::string _id, _world;
 
 	std::vector<std::unique_ptr<Level>> _levels;
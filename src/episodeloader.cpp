@@ -0,0 +1,179 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "src/common/memreadstream.h"
+#include "src/common/profiler.h"
+#include "src/common/threadpool.h"
+
+#include "src/episodeloader.h"
+
+/*!
+ * The number of models which are created per frame while committing an episode
+ */
+static const size_t kMaxCommittedModelsPerFrame = 512;
+
+EpisodeLoader::EpisodeLoader(
+		const std::string &world,
+		const std::string &episode,
+		bool loadWorld,
+		const std::vector<std::string> &loadedLevels,
+		bool useSnapshots
+) :
+	_worldName(world),
+	_episodeName(episode),
+	_loadWorld(loadWorld),
+	_loadedLevels(loadedLevels),
+	_useSnapshots(useSnapshots),
+	_global(true),
+	_episode(true),
+	_step(0),
+	_numSteps(1),
+	_finished(false),
+	_restoredFromSnapshot(false),
+	_restored(false),
+	_committed(false) {
+}
+
+EpisodeLoader::~EpisodeLoader() {
+	// The worker references this loader, so wait for it before destroying anything
+	if (_worker.valid())
+		_worker.wait();
+}
+
+void EpisodeLoader::start() {
+	// The task owns the promise, so that it stays valid until the waiting thread is woken up
+	auto done = std::make_shared<std::promise<void>>();
+	_worker = done->get_future();
+	Threads.add([this, done](){
+		run();
+		done->set_value();
+	});
+}
+
+bool EpisodeLoader::isFinished() const {
+	return _finished.load(std::memory_order_acquire);
+}
+
+void EpisodeLoader::wait() {
+	if (_worker.valid())
+		_worker.wait();
+}
+
+bool EpisodeLoader::isRestoredFromSnapshot() const {
+	return _restoredFromSnapshot;
+}
+
+float EpisodeLoader::getProgress() const {
+	return static_cast<float>(_step.load()) / static_cast<float>(_numSteps.load());
+}
+
+bool EpisodeLoader::isCommitting() const {
+	return _restored && !_committed;
+}
+
+bool EpisodeLoader::commit(entt::registry &registry, std::unique_ptr<World> &world) {
+	PROFILE_ZONE("EpisodeLoader::commit");
+	if (!isFinished())
+		throw std::runtime_error("Episode loader has not finished yet");
+	if (_error)
+		std::rethrow_exception(_error);
+
+	if (!_restored) {
+		spdlog::info("Committing episode {} from {}", _episodeName, _worldName);
+		_restored = true;
+
+		if (_loadWorld) {
+			// Destroy the old world first, so that its entities don't collide with the new gids
+			world.reset();
+			world = std::make_unique<World>(registry, _worldName);
+
+			Common::MemoryReadStream global(_global.getData(), _global.getLength(), false);
+			world->restoreGlobal(global);
+		}
+
+		Common::MemoryReadStream episode(_episode.getData(), _episode.getLength(), false);
+		world->restoreEpisode(_episodeName, episode);
+	}
+
+	// The models are created in bounded steps, a step creating fewer models than allowed was the last one
+	_committed = ObjectCollection::createModels(registry, kMaxCommittedModelsPerFrame) < kMaxCommittedModelsPerFrame;
+	return _committed;
+}
+
+const std::string &EpisodeLoader::getWorldName() const {
+	return _worldName;
+}
+
+const std::string &EpisodeLoader::getEpisodeName() const {
+	return _episodeName;
+}
+
+void EpisodeLoader::run() {
+	PROFILE_ZONE("EpisodeLoader::run");
+	try {
+		World world(_staging, _worldName, true);
+		world.setUseSnapshots(_useSnapshots);
+
+		// Levels which are already loaded are taken over by the commit instead. Snapshots always contain every level
+		// of the episode, the commit skips the loaded ones when restoring
+		std::vector<std::string> levelFileNames;
+		for (const auto &fileName : world.getLevelFileNames(_episodeName)) {
+			if (std::find(_loadedLevels.begin(), _loadedLevels.end(), fileName) == _loadedLevels.end())
+				levelFileNames.emplace_back(fileName);
+		}
+
+		_numSteps = (_useSnapshots ? 1 : levelFileNames.size() + 1) + (_loadWorld ? 2 : 1);
+		advance();
+
+		if (_loadWorld) {
+			world.loadGlobal();
+			world.save(_global);
+			advance();
+		}
+
+		if (_useSnapshots) {
+			_restoredFromSnapshot = world.loadEpisode(_episodeName);
+			world.saveEpisode(_episode);
+		} else {
+			Episode episode(_staging, _worldName, _episodeName, true);
+			advance();
+
+			for (const auto &fileName : levelFileNames) {
+				episode.loadLevel(fileName);
+				advance();
+			}
+
+			episode.save(_episode);
+		}
+	} catch (...) {
+		_error = std::current_exception();
+	}
+
+	_step = _numSteps.load();
+	_finished.store(true, std::memory_order_release);
+}
+
+void EpisodeLoader::advance() {
+	++_step;
+}
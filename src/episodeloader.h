@@ -0,0 +1,139 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_EPISODELOADER_H
+#define OPENAWE_EPISODELOADER_H
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "src/common/memwritestream.h"
+
+#include "src/world.h"
+
+/*!
+ * \brief Loads a world and episode in the background
+ *
+ * The loader builds the world, episode and levels on a worker thread into
+ * its own staging registry and serializes them into a command buffer. The
+ * main thread keeps running meanwhile and applies the buffer to the real
+ * registry with commit() once loading finished. Models are only created
+ * during the commit, since they need the graphics context of the main thread.
+ * Their creation is spread across several frames, so that committing a large
+ * episode doesn't stall a single frame. If snapshots are used, the episode is
+ * restored from and cached in its snapshot on the worker thread as well.
+ */
+class EpisodeLoader {
+public:
+	/*!
+	 * Create a new episode loader
+	 * \param world the name of the world of the episode
+	 * \param episode the id of the episode
+	 * \param loadWorld if the world and its global data need to be loaded too
+	 * \param loadedLevels levels which are already loaded and are reused instead of loaded again
+	 * \param useSnapshots if the episode should be restored from and cached in a binary snapshot
+	 */
+	EpisodeLoader(
+		const std::string &world,
+		const std::string &episode,
+		bool loadWorld,
+		const std::vector<std::string> &loadedLevels = {},
+		bool useSnapshots = false
+	);
+	~EpisodeLoader();
+
+	/*!
+	 * Start loading on the thread pool
+	 */
+	void start();
+
+	/*!
+	 * Check if the loader has finished, either successfully or with an error
+	 * \return if the loader has finished
+	 */
+	bool isFinished() const;
+
+	/*!
+	 * Wait until the loader has finished
+	 */
+	void wait();
+
+	/*!
+	 * Check if the episode was restored from its snapshot
+	 * \return if the snapshot was used, only valid after the loader has finished
+	 */
+	bool isRestoredFromSnapshot() const;
+
+	/*!
+	 * Get the progress of loading
+	 * \return the progress between 0 and 1
+	 */
+	float getProgress() const;
+
+	/*!
+	 * Check if the commit has started but not finished yet. The world must
+	 * not be updated meanwhile, since not all of its models exist yet
+	 * \return if the loader is committing
+	 */
+	bool isCommitting() const;
+
+	/*!
+	 * Apply the loaded data to the main registry. This has to be called on
+	 * the main thread between two frames after the loader has finished,
+	 * once per frame until it returns true. The first call restores the
+	 * entities, every call creates a bounded number of their models. If
+	 * loading failed, the exception of the worker is rethrown.
+	 * \param registry the main registry
+	 * \param world the current world, which is replaced if the loader loaded a new world
+	 * \return if the commit has finished
+	 */
+	bool commit(entt::registry &registry, std::unique_ptr<World> &world);
+
+	const std::string &getWorldName() const;
+	const std::string &getEpisodeName() const;
+
+private:
+	void run();
+	void advance();
+
+	const std::string _worldName, _episodeName;
+	const bool _loadWorld;
+	const std::vector<std::string> _loadedLevels;
+	const bool _useSnapshots;
+
+	entt::registry _staging;
+	Common::DynamicMemoryWriteStream _global, _episode;
+
+	std::atomic<unsigned int> _step, _numSteps;
+	std::atomic_bool _finished;
+	std::future<void> _worker;
+	std::exception_ptr _error;
+	bool _restoredFromSnapshot;
+	bool _restored, _committed;
+};
+
+
+#endif //OPENAWE_EPISODELOADER_H
@@ -22,12 +22,20 @@
 #include <memory>
 
 #include <cxxopts.hpp>
+#include <fmt/format.h>
+#include <spdlog/async.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
 
 #include <src/graphics/fontman.h>
 #include "src/graphics/text.h"
 
 #include "src/common/threadpool.h"
 #include "src/common/strutil.h"
+#include "src/common/convexshape.h"
+#include "src/common/log.h"
+#include "src/common/memorytracker.h"
+#include "src/common/profiler.h"
+#include "src/common/writefile.h"
 
 #include "src/physics/physicsman.h"
 
@@ -36,12 +44,44 @@
 #include "src/game.h"
 #include "src/awe/cidfile.h"
 #include "src/awe/havokfile.h"
+#include "src/awe/script/dispatcher.h"
 
 #include "src/engines/awan/engine.h"
 
 #include "src/sound/soundman.h"
 
 #include "src/task.h"
+#include "src/transform.h"
+
+// Suspended scripts are resumed with a fixed frame time in benchmarks, so that the runs are reproducible
+static const std::chrono::milliseconds kBenchmarkFrameTime(16);
+
+/*!
+ * Estimate the memory used by the component storages of the registry
+ * \param registry the registry to estimate the memory for
+ * \return the estimated number of bytes
+ */
+template<typename... Components>
+static size_t getComponentMemory(entt::registry &registry) {
+	// Every storage holds its components and a sparse set mapping entities to them
+	return ((registry.view<Components>().size() * (sizeof(Components) + 2 * sizeof(entt::entity))) + ...);
+}
+
+/*!
+ * Update the memory accounted for the registry
+ * \param registry the registry to account the memory for
+ */
+static void trackRegistryMemory(entt::registry &registry) {
+	MemoryTracking.set(Common::kMemoryRegistry, getComponentMemory<
+			GID,
+			Transform,
+			Task,
+			Graphics::ModelPtr,
+			Common::ConvexShape,
+			AWE::Templates::CharacterClass,
+			AWE::Script::BytecodePtr
+	>(registry));
+}
 
 bool Game::parseArguments(int argc, char **argv) {
 	cxxopts::Options options(argv[0], "OpenAWE - Reimplementation of the Alan Wake Engine");
@@ -52,6 +92,19 @@ bool Game::parseArguments(int argc, char **argv) {
 		("r,renderer", "Set the the graphics renderer",cxxopts::value<std::string>())
 		("l,locale", "Set the language of the game", cxxopts::value<std::string>())
 		("d,debug", "Set the used level for debugging messages", cxxopts::value<unsigned int>()->default_value("4"))
+		("async-log", "Write log messages from a background thread")
+		("snapshots", "Cache loaded episodes in binary snapshots for faster reloading")
+		("memory-log", "Log the memory usage of every subsystem in the given interval in seconds", cxxopts::value<unsigned int>())
+		("memory-budget", "Set a soft memory budget in MiB for a subsystem, for example meshes=512", cxxopts::value<std::vector<std::string>>())
+		("benchmark", "Run without a window, load the given episode, for example \"round:1 gameworld:scene1_reststop\", and measure its performance", cxxopts::value<std::string>())
+		("benchmark-frames", "Set the number of frames to run in the benchmark", cxxopts::value<unsigned int>()->default_value("1000"))
+		("benchmark-camera", "Set the waypoints of the camera in the benchmark as x,y,z;x,y,z;...", cxxopts::value<std::string>()->default_value("0,500,0;0,500,-5000"))
+		("benchmark-output", "Set the file into which the benchmark results are written as json", cxxopts::value<std::string>()->default_value("benchmark.json"))
+		("trace", "Record a Chrome trace of load and frame times into the given file", cxxopts::value<std::string>())
+		("script-profile", "Profile scripts and native functions and write a report into the given file, the measurements are added to the trace as well", cxxopts::value<std::string>())
+		("script-budget", "Set the time in milliseconds script events may run per frame, 0 runs all waiting events at once", cxxopts::value<float>()->default_value("4"))
+		("streaming-radius", "Set the radii around the camera in which high and low detail cells are loaded as high,low in world units", cxxopts::value<std::string>())
+		("cell-size", "Set the edge length of the streamed cells in world units", cxxopts::value<float>())
 		("h,help", "Print this help");
 
 	auto result = options.parse(argc, argv);
@@ -64,14 +117,92 @@ bool Game::parseArguments(int argc, char **argv) {
 	if (result.count("path"))
 		_path = result["path"].as<std::string>();
 
+	_useSnapshots = result.count("snapshots") > 0;
+
+	_scriptBudget = std::chrono::microseconds(static_cast<int64_t>(std::max(result["script-budget"].as<float>(), 0.0f) * 1000.0f));
+
+	if (result.count("streaming-radius")) {
+		const std::string radius = result["streaming-radius"].as<std::string>();
+		const std::vector<std::string> radii = Common::split(radius, std::regex(","));
+		if (radii.size() != 2) {
+			spdlog::error("Invalid streaming radius {}", radius);
+			return false;
+		}
+
+		_streamingRadius = std::make_pair(std::stof(radii[0]), std::stof(radii[1]));
+	}
+
+	if (result.count("cell-size")) {
+		_cellSize = result["cell-size"].as<float>();
+		if (*_cellSize <= 0.0f) {
+			spdlog::error("Invalid cell size {}", *_cellSize);
+			return false;
+		}
+	}
+
+	if (result.count("memory-log"))
+		MemoryTracking.setLogInterval(std::chrono::seconds(result["memory-log"].as<unsigned int>()));
+
+	if (result.count("memory-budget")) {
+		for (const auto &budget : result["memory-budget"].as<std::vector<std::string>>()) {
+			const auto separator = budget.find('=');
+			Common::MemoryTag tag;
+			if (separator == std::string::npos || !Common::MemoryTracker::getTag(budget.substr(0, separator), tag)) {
+				spdlog::error("Invalid memory budget {}", budget);
+				return false;
+			}
+
+			MemoryTracking.setBudget(tag, std::stoull(budget.substr(separator + 1)) * 1024 * 1024);
+		}
+	}
+
+	if (result.count("benchmark")) {
+		_benchmark = std::make_unique<Benchmark>(result["benchmark"].as<std::string>(), result["benchmark-frames"].as<unsigned int>());
+		_benchmarkOutput = result["benchmark-output"].as<std::string>();
+
+		std::vector<glm::vec3> cameraPath;
+		for (const auto &waypoint : Common::split(result["benchmark-camera"].as<std::string>(), std::regex(";"))) {
+			const std::vector<std::string> coordinates = Common::split(waypoint, std::regex(","));
+			if (coordinates.size() != 3) {
+				spdlog::error("Invalid camera waypoint {}", waypoint);
+				return false;
+			}
+
+			cameraPath.emplace_back(std::stof(coordinates[0]), std::stof(coordinates[1]), std::stof(coordinates[2]));
+		}
+		_benchmark->setCameraPath(cameraPath);
+	}
+
+	if (result.count("script-profile")) {
+		_scriptProfileFile = result["script-profile"].as<std::string>();
+		_scriptProfiler = std::make_unique<AWE::Script::Profiler>(_registry);
+	}
+
+	if (result.count("trace")) {
+		_traceFile = result["trace"].as<std::string>();
+#ifndef OPENAWE_PROFILING
+		spdlog::warn("OpenAWE was built without profiling, the trace will be empty");
+#endif
+		PROFILE_THREAD("Main");
+		Profile.start();
+	}
+
+	if (result.count("async-log")) {
+		spdlog::init_thread_pool(8192, 1);
+		spdlog::set_default_logger(spdlog::create_async<spdlog::sinks::stdout_color_sink_mt>("openawe"));
+	}
+
 	spdlog::set_level(spdlog::level::level_enum(6 - std::clamp(result["debug"].as<uint>(), 0u, 6u)));
 
 	return true;
 }
 
 void Game::init() {
+	PROFILE_ZONE("Game::init");
 	spdlog::info("Initializing AWE...");
 
+	const auto indexStart = std::chrono::steady_clock::now();
+
 	if (_path.empty()) {
 		spdlog::warn("No data path given, using current working directory");
 		_path = "./";
@@ -135,35 +266,57 @@ void Game::init() {
 		ResMan.indexStreamedResource("resourcedb/cid_streamedtexture.bin");
 	}
 
+	if (_benchmark)
+		_benchmark->addStage("index", std::chrono::steady_clock::now() - indexStart);
+
 	_engine->getConfiguration().read();
 
-	_platform.init();
+	if (_benchmark) {
+		// Benchmarks run headless without window, graphics context and sound
+		GfxMan.initNull();
+	} else {
+		_platform.init();
 
-	_window = std::make_unique<Graphics::Window>(Graphics::Window::kOpenGL);
-	if (hasPackmeta)
-		_window->setTitle("Alan Wakes American Nightmare");
-	else
-		_window->setTitle("Alan Wake");
+		_window = std::make_unique<Graphics::Window>(Graphics::Window::kOpenGL);
+		if (hasPackmeta)
+			_window->setTitle("Alan Wakes American Nightmare");
+		else
+			_window->setTitle("Alan Wake");
 
-	GfxMan.initOpenGL(*_window);
-	//GfxMan.setAmbianceState("scene1_reststop_creepy");
+		GfxMan.initOpenGL(*_window);
+		//GfxMan.setAmbianceState("scene1_reststop_creepy");
 
-	// Initialize sound
-	spdlog::info("Initializing sound system");
-	SoundMan.init();
+		// Initialize sound
+		spdlog::info("Initializing sound system");
+		SoundMan.init();
+	}
 
 	// Initialize fonts
 	spdlog::info("Loading font fixedsys");
 	FontMan.load("fonts/fixedsys.binfnt", "fixedsys");
 
 	_context = std::make_unique<AWE::Script::Context>(_registry, _engine->getFunctions());
+	_eventQueue = std::make_unique<AWE::Script::EventQueue>(*_context);
+	_eventQueue->setTimeBudget(_scriptBudget);
+	_engine->getFunctions().setEventQueue(_eventQueue.get());
+	_scheduler = std::make_unique<AWE::Script::Scheduler>(*_context);
+	_context->setScheduler(_scheduler.get());
+	_context->setProfiler(_scriptProfiler.get());
 
 	_global = std::make_unique<Global>(_registry);
 
-	loadEpisode("round:1 gameworld:scene1_reststop");
+	if (!_benchmark)
+		loadEpisodeAsync("round:1 gameworld:scene1_reststop");
 }
 
 void Game::start() {
+	if (_benchmark) {
+		runBenchmark();
+		writeTrace();
+		writeScriptProfile();
+		return;
+	}
+
 	spdlog::info("Starting AWE...");
 
 	glm::vec3 cameraPosition(0.0f, 500.0f,0.0f);
@@ -177,6 +330,10 @@ void Game::start() {
 	text.setText(u"OpenAWE - v0.0.1");
 	text.show();
 
+	Graphics::Text loadingText;
+	loadingText.show();
+	int loadingPercent = -1;
+
 	bool forward = false, backward = false, left = false, right = false, up = false, down = false, turnLeft = false, turnRight = false;
 	_window->setKeyCallback([&](int key, int scancode, int action, int mods){
 		if (key == GLFW_KEY_W)
@@ -195,11 +352,37 @@ void Game::start() {
 			turnLeft = action == GLFW_PRESS || action == GLFW_REPEAT;
 		else if (key == GLFW_KEY_E)
 			turnRight = action == GLFW_PRESS || action == GLFW_REPEAT;
+		else if (key == GLFW_KEY_F9 && action == GLFW_PRESS)
+			MemoryTracking.dump();
 	});
 
 	bool exit = false;
-	std::chrono::system_clock::time_point last, now;
+	std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now(), now;
 	while (!exit) {
+		PROFILE_ZONE("Game::frame");
+
+		// Apply background loads between two frames, so that a frame never sees a half restored episode
+		if (_episodeLoader) {
+			if (_episodeLoader->isFinished()) {
+				commitEpisode();
+				if (!_episodeLoader) {
+					loadingText.setText(u"");
+					loadingPercent = -1;
+				}
+			} else if (static_cast<int>(_episodeLoader->getProgress() * 100.0f) != loadingPercent) {
+				loadingPercent = static_cast<int>(_episodeLoader->getProgress() * 100.0f);
+				const std::string loading = fmt::format("Loading {}%", loadingPercent);
+				loadingText.setText(std::u16string(loading.begin(), loading.end()));
+			}
+		}
+
+		now = std::chrono::steady_clock::now();
+		const auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(now - last);
+		last += delta;
+
+		_scheduler->update(delta);
+		_eventQueue->update();
+
 		GfxMan.drawFrame();
 
 		if (forward)
@@ -220,8 +403,14 @@ void Game::start() {
 			GfxMan.setCamera(camera);
 		}
 
-		now = std::chrono::system_clock::now();
-		std::chrono::system_clock::duration delta = std::chrono::duration_cast<std::chrono::milliseconds>(now - last);
+		// A world which is still being committed is missing models, which the spatial index needs
+		if (_world && !(_episodeLoader && _episodeLoader->isCommitting()))
+			_world->update(cameraPosition, _spatialIndex);
+		_spatialIndex.update();
+
+		trackRegistryMemory(_registry);
+		MemoryTracking.update();
+
 		//Threads.add([=](){PhysicsMan.update(delta.count());});
 
 		_platform.update();
@@ -234,44 +423,169 @@ void Game::start() {
 	_engine->getConfiguration().write();
 
 	_platform.terminate();
+
+	writeTrace();
+	writeScriptProfile();
 }
 
-void Game::loadEpisode(const std::string &data) {
+void Game::loadEpisodeAsync(const std::string &data) {
 	std::vector<std::string> parameters = Common::split(data, std::regex(" "));
 	std::vector<std::string> episode = Common::split(parameters.back(), std::regex(":"));
 
 	std::string worldName = episode[0];
 	std::string episodeName = episode[1];
 
-	if (!_world || _world->getName() != worldName) {
-		_world = std::make_unique<World>(_registry, worldName);
-		_world->loadGlobal();
+	spdlog::info("Loading episode {} from {} in the background", episodeName, worldName);
+
+	const bool loadWorld = !_world || _world->getName() != worldName;
+
+	// A newer request replaces a pending one, the loader waits for its worker when destroyed
+	_episodeLoader = std::make_unique<EpisodeLoader>(
+		worldName,
+		episodeName,
+		loadWorld,
+		loadWorld ? std::vector<std::string>() : _world->getLoadedLevels(),
+		_useSnapshots
+	);
+	_episodeLoaderParameters = parameters[0];
+	_episodeLoader->start();
+}
+
+void Game::commitEpisode() {
+	try {
+		if (!_episodeLoader->commit(_registry, _world))
+			return;
+	} catch (std::exception &e) {
+		spdlog::error("Couldn't load episode {} from {}: {}", _episodeLoader->getEpisodeName(), _episodeLoader->getWorldName(), e.what());
+		_episodeLoader.reset();
+		return;
 	}
 
-	_world->loadEpisode(episodeName);
+	_episodeLoader.reset();
 
-	// Call OnInit on every object
-	auto bytecodeView = _registry.view<AWE::Script::BytecodePtr>();
-	for (const auto &item : bytecodeView) {
-		auto gid = _registry.get<GID>(item);
-		auto bytecode = _registry.get<AWE::Script::BytecodePtr>(item);
-		spdlog::debug("Firing OnInit on {} {:x}", gid.type, gid.id);
-		bytecode->run(*_context, "OnInit", item);
+	_world->setUseSnapshots(_useSnapshots);
+	applyStreamingSettings();
+
+	startEpisode(_episodeLoaderParameters);
+}
+
+void Game::runBenchmark() {
+	spdlog::info("Running benchmark {} for {} frames", _benchmark->getScenario(), _benchmark->getNumFrames());
+
+	std::vector<std::string> parameters = Common::split(_benchmark->getScenario(), std::regex(" "));
+	std::vector<std::string> episode = Common::split(parameters.back(), std::regex(":"));
+	if (episode.size() != 2)
+		throw std::runtime_error(fmt::format("Invalid benchmark scenario {}", _benchmark->getScenario()));
+
+	_benchmark->measureStage("global", [&](){
+		_world = std::make_unique<World>(_registry, episode[0]);
+		_world->setUseSnapshots(_useSnapshots);
+		_world->loadGlobal();
+	});
+	_benchmark->measureStage("episode", [&](){
+		// Load through the same background loader as the game, including its snapshots
+		EpisodeLoader loader(episode[0], episode[1], false, {}, _useSnapshots);
+		loader.start();
+		loader.wait();
+		while (!loader.commit(_registry, _world));
+		applyStreamingSettings();
+
+		_benchmark->setEpisodeSnapshot(loader.isRestoredFromSnapshot());
+	});
+	_benchmark->measureStage("scripts", [&](){
+		startEpisode(parameters[0]);
+
+		// Measure every event sent on startup, not only posting them
+		while (!_eventQueue->empty())
+			_eventQueue->update();
+	});
+
+	trackRegistryMemory(_registry);
+
+	Graphics::Camera camera;
+	camera.setDirection(glm::vec3(0.0f, 0.0f, -1.0f));
+
+	for (unsigned int frame = 0; frame < _benchmark->getNumFrames(); ++frame) {
+		PROFILE_ZONE("Game::frame");
+		const auto start = std::chrono::steady_clock::now();
+
+		const glm::vec3 cameraPosition = _benchmark->getCameraPosition(frame);
+		camera.setPosition(cameraPosition);
+		GfxMan.setCamera(camera);
+
+		_world->update(cameraPosition, _spatialIndex);
+		_spatialIndex.update();
+		_scheduler->update(kBenchmarkFrameTime);
+		_eventQueue->update();
+		GfxMan.drawFrame();
+
+		_benchmark->addFrame(
+				std::chrono::steady_clock::now() - start,
+				GfxMan.getNumDrawCalls(),
+				GfxMan.getNumVisibleModels(),
+				GfxMan.getNumCulledModels()
+		);
+
+		trackRegistryMemory(_registry);
 	}
 
+	spdlog::info("Writing benchmark results to {}", _benchmarkOutput);
+	Common::WriteFile output(_benchmarkOutput);
+	_benchmark->save(output);
+}
+
+void Game::writeTrace() {
+	if (_traceFile.empty())
+		return;
+
+	Profile.stop();
+	spdlog::info("Writing trace to {}", _traceFile);
+	Common::WriteFile trace(_traceFile);
+	Profile.save(trace);
+}
+
+void Game::writeScriptProfile() {
+	if (!_scriptProfiler)
+		return;
+
+	spdlog::info("Writing script profile to {}", _scriptProfileFile);
+	Common::WriteFile profile(_scriptProfileFile);
+	_scriptProfiler->save(profile);
+}
+
+void Game::applyStreamingSettings() {
+	if (_cellSize)
+		_world->setCellSize(*_cellSize);
+	if (_streamingRadius)
+		_world->setStreamingRadius(_streamingRadius->first, _streamingRadius->second);
+}
+
+void Game::startEpisode(const std::string &parameters) {
+	PROFILE_ZONE("Game::startEpisode");
+	// Resolve the gid references of all scripts now that the registry is populated
+	_context->linkScripts();
+
+	// OnInit runs on every object at once using all cores, the events it sends are spread across the following
+	// frames by the event queue
+	AWE::Script::Dispatcher dispatcher(*_context);
+	dispatcher.run("OnInit");
+
 	// Activate starter tasks
 	auto taskView = _registry.view<Task, AWE::Script::BytecodePtr>();
 	for (const auto &item : taskView) {
 		auto gid = _registry.get<GID>(item);
 		auto task = _registry.get<Task>(item);
-		auto bytecode = _registry.get<AWE::Script::BytecodePtr>(item);
 
 		if (!task.isActiveOnStartup())
 			continue;
 
-		spdlog::debug("Firing OnTaskActivate on {} {:x}", gid.type, gid.id);
-		bytecode->run(*_context, "OnTaskActivate", item);
+		LOG_DEBUG("Firing OnTaskActivate on {} {:x}", gid.type, gid.id);
+		_eventQueue->post(item, "OnTaskActivate");
 	}
 
-	_engine->loadEpisode(parameters[0]);
+	// Without a time budget the task activations run right away, otherwise within the following frames
+	if (_eventQueue->getTimeBudget().count() == 0)
+		_eventQueue->update();
+
+	_engine->loadEpisode(parameters);
 }
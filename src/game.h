@@ -21,13 +21,19 @@
 #ifndef AWE_GAME_H
 #define AWE_GAME_H
 
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <utility>
 
 #include <spdlog/spdlog.h>
 
 #include <entt/entt.hpp>
 
+#include "src/awe/script/eventqueue.h"
 #include "src/awe/script/functions.h"
+#include "src/awe/script/profiler.h"
+#include "src/awe/script/scheduler.h"
 
 #include "src/graphics/window.h"
 #include "src/graphics/platform.h"
@@ -38,6 +44,9 @@
 #include "engine.h"
 #include "src/global.h"
 #include "src/world.h"
+#include "src/episodeloader.h"
+#include "src/benchmark.h"
+#include "src/spatialindex.h"
 
 class Game {
 public:
@@ -46,22 +55,67 @@ public:
 	void init();
 	void start();
 
-	void loadEpisode(const std::string &data);
+	/*!
+	 * Load an episode in the background while the game keeps running. The
+	 * episode replaces the current one at the beginning of the first frame
+	 * after it finished loading.
+	 * \param data the episode description, for example "round:1 gameworld:scene1_reststop"
+	 */
+	void loadEpisodeAsync(const std::string &data);
 
 private:
+	void commitEpisode();
+	void startEpisode(const std::string &parameters);
+
+	/*!
+	 * Load the episode of the benchmark, run its frames headless and write
+	 * the results
+	 */
+	void runBenchmark();
+
+	/*!
+	 * Write the recorded trace, if a trace file was given
+	 */
+	void writeTrace();
+
+	/*!
+	 * Write the report of the script profiler, if a script profile file was given
+	 */
+	void writeScriptProfile();
+
+	/*!
+	 * Apply the streaming radius and cell size given on the command line to the levels of the current episode
+	 */
+	void applyStreamingSettings();
+
 	std::string _path;
+	bool _useSnapshots = false;
+	std::string _traceFile;
+	std::string _scriptProfileFile;
+	std::chrono::microseconds _scriptBudget{0};
+	std::optional<std::pair<float, float>> _streamingRadius;
+	std::optional<float> _cellSize;
+
+	std::unique_ptr<Benchmark> _benchmark;
+	std::string _benchmarkOutput;
 
 	entt::registry _registry;
+	SpatialIndex _spatialIndex{_registry};
 
 	Video::Player _player;
 
 	Graphics::Platform _platform;
 	std::unique_ptr<Graphics::Window> _window;
 
+	std::unique_ptr<AWE::Script::Profiler> _scriptProfiler;
 	std::unique_ptr<AWE::Script::Context> _context;
+	std::unique_ptr<AWE::Script::EventQueue> _eventQueue;
+	std::unique_ptr<AWE::Script::Scheduler> _scheduler;
 
 	std::unique_ptr<Global> _global;
 	std::unique_ptr<World> _world;
+	std::unique_ptr<EpisodeLoader> _episodeLoader;
+	std::string _episodeLoaderParameters;
 	std::unique_ptr<Engine> _engine;
 	std::unique_ptr<AWE::Script::Functions> _functions;
 };
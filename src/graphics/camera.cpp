@@ -36,7 +36,7 @@ void Camera::setDirection(const glm::vec3 &direction) {
 	_direction = direction;
 }
 
-glm::mat4 Camera::getLookAt() {
+glm::mat4 Camera::getLookAt() const {
 	return glm::lookAt(_position, _position + _direction, glm::vec3(0.0f, 1.0f, 0.0f));
 }
 
@@ -32,7 +32,7 @@ public:
 	void setPosition(const glm::vec3 &position);
 	void setDirection(const glm::vec3 &direction);
 
-	glm::mat4 getLookAt();
+	glm::mat4 getLookAt() const;
 
 private:
 	glm::vec3 _position;
@@ -26,6 +26,7 @@
 
 #include "src/graphics/gfxman.h"
 #include "src/graphics/opengl/renderer.h"
+#include "src/graphics/null/renderer.h"
 
 namespace Graphics {
 
@@ -36,6 +37,13 @@ void GraphicsManager::initOpenGL(Window &window) {
 	_renderer = std::make_unique<Graphics::OpenGL::Renderer>(window);
 }
 
+void GraphicsManager::initNull() {
+	if (_renderer)
+		throw std::runtime_error("Renderer already initialized");
+
+	_renderer = std::make_unique<Graphics::Null::Renderer>();
+}
+
 void GraphicsManager::addModel(Model *model) {
 	_renderer->addModel(model);
 }
@@ -114,6 +122,18 @@ void GraphicsManager::setAmbianceState(const std::string &id) {
 	_renderer->setAmbianceState(AmbianceState(*ambianceFile));
 }
 
+unsigned int GraphicsManager::getNumDrawCalls() const {
+	return _renderer->getNumDrawCalls();
+}
+
+unsigned int GraphicsManager::getNumVisibleModels() const {
+	return _renderer->getNumVisibleModels();
+}
+
+unsigned int GraphicsManager::getNumCulledModels() const {
+	return _renderer->getNumCulledModels();
+}
+
 Camera GraphicsManager::getCamera() const {
 	return _camera;
 }
@@ -38,6 +38,12 @@ class GraphicsManager : public Common::Singleton<GraphicsManager> {
 public:
 	void initOpenGL(Window &window);
 
+	/*!
+	 * Initialize a renderer which doesn't draw anything, for running
+	 * without a window
+	 */
+	void initNull();
+
 	Camera getCamera() const;
 	void setCamera(const Camera &camera);
 
@@ -65,6 +71,24 @@ public:
 
 	void drawFrame();
 
+	/*!
+	 * Get the number of draw calls issued in the last frame
+	 * \return the number of draw calls
+	 */
+	unsigned int getNumDrawCalls() const;
+
+	/*!
+	 * Get the number of models inside the view frustum in the last frame
+	 * \return the number of visible models
+	 */
+	unsigned int getNumVisibleModels() const;
+
+	/*!
+	 * Get the number of models culled because they were outside of the view frustum in the last frame
+	 * \return the number of culled models
+	 */
+	unsigned int getNumCulledModels() const;
+
 private:
 	struct AsyncTexture {
 		const ImageDecoder &decoder;
@@ -100,6 +100,8 @@ DDS::DDS(Common::ReadStream *dds) {
 		width /= 2;
 		height /= 2;
 	}
+
+	trackMemory();
 }
 
 }
@@ -23,7 +23,7 @@
 
 namespace Graphics {
 
-ImageDecoder::ImageDecoder() : _format(kRGBA8), _compressed(false), _type(kTexture2D) {
+ImageDecoder::ImageDecoder() : _format(kRGBA8), _compressed(false), _type(kTexture2D), _memory(Common::kMemoryTextures) {
 
 }
 
@@ -57,6 +57,17 @@ ImageDecoder::Type ImageDecoder::getType() const {
 	return _type;
 }
 
+void ImageDecoder::trackMemory() {
+	size_t size = 0;
+	for (const auto &layer : _layers) {
+		for (const auto &mipmap : layer) {
+			size += mipmap.data.size() * mipmap.dataSize;
+		}
+	}
+
+	_memory.resize(size);
+}
+
 size_t ImageDecoder::getImageSize(unsigned int width, unsigned int height) {
 	switch (_format) {
 		case kGrayScale:
@@ -21,6 +21,7 @@
 #ifndef AWE_DECODER_H
 #define AWE_DECODER_H
 
+#include <src/common/memorytracker.h>
 #include <src/common/types.h>
 #include <vector>
 
@@ -62,10 +63,18 @@ public:
 protected:
 	size_t getImageSize(unsigned int width, unsigned int height);
 
+	/*!
+	 * Account the memory of the decoded mipmaps, should be called after
+	 * the image was decoded
+	 */
+	void trackMemory();
+
 	std::vector<std::vector<Mipmap>> _layers;
 	Format _format;
 	Type _type;
 	bool _compressed;
+
+	Common::TrackedMemory _memory;
 };
 
 } // End of namespace Graphics
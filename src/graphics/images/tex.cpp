@@ -114,6 +114,8 @@ TEX::TEX(Common::ReadStream &tex) {
 		height = std::max(height, 4u);
 		depth = std::max(depth, 1u);
 	}
+
+	trackMemory();
 }
 
 }
@@ -18,11 +18,19 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <limits>
+
 #include "mesh.h"
 
 namespace Graphics {
 
-Mesh::Mesh() : _indices(Common::UUID::generateNil()) {
+static const float kInfinity = std::numeric_limits<float>::infinity();
+
+Mesh::Mesh() :
+	_indices(Common::UUID::generateNil()),
+	_boundSphere{glm::vec3(0.0f), kInfinity},
+	_boundBox{-kInfinity, -kInfinity, -kInfinity, kInfinity, kInfinity, kInfinity},
+	_memory(Common::kMemoryMeshes) {
 
 }
 
@@ -34,6 +42,14 @@ Common::UUID Mesh::getIndices() const {
 	return _indices;
 }
 
+const Common::BoundSphere &Mesh::getBoundSphere() const {
+	return _boundSphere;
+}
+
+const Common::BoundBox &Mesh::getBoundBox() const {
+	return _boundBox;
+}
+
 const std::map<std::string, glm::mat3x4> & Mesh::getInitialJointPositions() const {
 	return _initialPose;
 }
@@ -46,4 +62,9 @@ void Mesh::addPartMesh(const Mesh::PartMesh &partMesh) {
 	_meshs.emplace_back(partMesh);
 }
 
+void Mesh::setBounds(const Common::BoundSphere &boundSphere, const Common::BoundBox &boundBox) {
+	_boundSphere = boundSphere;
+	_boundBox = boundBox;
+}
+
 }
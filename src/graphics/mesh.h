@@ -21,8 +21,13 @@
 #ifndef AWE_MESH_H
 #define AWE_MESH_H
 
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "src/common/memorytracker.h"
+#include "src/common/types.h"
 #include "src/common/uuid.h"
 
 #include "src/graphics/material.h"
@@ -59,14 +64,33 @@ public:
 	[[nodiscard]] const std::vector<PartMesh> &getMeshs() const;
 	const std::map<std::string, glm::mat3x4> & getInitialJointPositions() const;
 
+	/*!
+	 * Get the sphere bounding all vertices of the mesh in model space. Meshes without bounds have an infinite
+	 * sphere, so that they are never culled
+	 * \return the bounding sphere of the mesh
+	 */
+	[[nodiscard]] const Common::BoundSphere &getBoundSphere() const;
+
+	/*!
+	 * Get the box bounding all vertices of the mesh in model space
+	 * \return the bounding box of the mesh
+	 */
+	[[nodiscard]] const Common::BoundBox &getBoundBox() const;
+
 	void setIndices(const Common::UUID &indices);
 	void addPartMesh(const PartMesh &partMesh);
+	void setBounds(const Common::BoundSphere &boundSphere, const Common::BoundBox &boundBox);
 
 protected:
 	std::vector<PartMesh> _meshs;
 	std::map<std::string, glm::mat3x4> _initialPose;
 
 	Common::UUID _indices;
+
+	Common::BoundSphere _boundSphere;
+	Common::BoundBox _boundBox;
+
+	Common::TrackedMemory _memory;
 };
 
 } // End of namespace Graphics
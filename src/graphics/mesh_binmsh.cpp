@@ -26,6 +26,7 @@
 #include <src/awe/resman.h>
 #include <src/graphics/images/tex.h>
 #include <src/common/writefile.h>
+#include "src/common/profiler.h"
 #include "mesh_binmsh.h"
 #include "gfxman.h"
 #include "textureman.h"
@@ -40,6 +41,7 @@ BINMSHMesh::BINMSHMesh() {
 }
 
 void BINMSHMesh::load(Common::ReadStream *binmsh) {
+	PROFILE_ZONE("BINMSHMesh::load");
 	uint32_t version = binmsh->readUint32LE();
 
 	if (version != 21 && version != 20 && version != 19)
@@ -60,6 +62,9 @@ void BINMSHMesh::load(Common::ReadStream *binmsh) {
 	_indices = GfxMan.registerIndices(indicesData, indicesCount * indicesType);
 	delete [] indicesData;
 
+	// Account the vertex and index data uploaded to the gpu
+	_memory.resize(vertexBufferSize + indicesCount * indicesType);
+
 	uint32_t boneCount = binmsh->readUint32LE();
 	for (int i = 0; i < boneCount; ++i) {
 		uint32_t boneNameLength = binmsh->readUint32LE();
@@ -110,6 +115,8 @@ void BINMSHMesh::load(Common::ReadStream *binmsh) {
 	assert(boundBox.ymax >= boundBox.ymin);
 	assert(boundBox.zmax >= boundBox.zmin);
 
+	setBounds(boundSphere, boundBox);
+
 	uint32_t lodCount = binmsh->readUint32LE();
 
 	uint32_t materialCount = binmsh->readUint32LE();
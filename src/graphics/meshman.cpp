@@ -85,6 +85,19 @@ MeshPtr MeshManager::getMesh(const std::string &path) {
 	}
 }
 
+void MeshManager::collectGarbage() {
+	for (auto iter = _meshRegistry.begin(); iter != _meshRegistry.end();) {
+		const bool placeholder = std::holds_alternative<std::string>(iter->first) && (
+				std::get<std::string>(iter->first) == _missingMeshPath ||
+				std::get<std::string>(iter->first) == _brokenMeshPath
+		);
+		if (iter->second.use_count() == 1 && !placeholder)
+			iter = _meshRegistry.erase(iter);
+		else
+			++iter;
+	}
+}
+
 MeshPtr MeshManager::getMissingMesh() {
 	return getMesh(_missingMeshPath);
 }
@@ -39,6 +39,11 @@ public:
 	MeshPtr getMesh(rid_t rid);
 	MeshPtr getMesh(const std::string &path);
 
+	/*!
+	 * Remove every mesh from the cache, which isn't used anywhere else
+	 */
+	void collectGarbage();
+
 private:
 	MeshPtr getMissingMesh();
 	MeshPtr getBrokenMesh();
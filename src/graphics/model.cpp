@@ -18,6 +18,8 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "src/graphics/model.h"
 #include "src/graphics/gfxman.h"
 #include "src/graphics/meshman.h"
@@ -30,12 +32,12 @@ Model::Model() : _mesh(new Mesh), _position(0.0f), _rotation(1.0f), _scale(1.0f)
 }
 
 Model::Model(rid_t rid) : _position(0.0f, 0.0f, 0.0f), _rotation(0.0f), _scale(1.0f),
-_mesh(MeshMan.getMesh(rid)) {
+_mesh(MeshMan.getMesh(rid)), _meshRid(rid) {
 	show();
 }
 
 Model::Model(const std::string &path)  : _position(0.0f, 0.0f, 0.0f),
-_rotation(1.0f), _scale(1.0f), _mesh(MeshMan.getMesh(path)) {
+_rotation(1.0f), _scale(1.0f), _mesh(MeshMan.getMesh(path)), _meshPath(path) {
 	show();
 }
 
@@ -72,4 +74,28 @@ MeshPtr Model::getMesh() const {
 	return _mesh;
 }
 
+Common::BoundSphere Model::getWorldBoundSphere() const {
+	const Common::BoundSphere &boundSphere = _mesh->getBoundSphere();
+
+	// The radius grows with the largest scale along any axis, including scale contained in the rotation
+	const float maxScale = std::max({
+		glm::length(_rotation[0] * _scale.x),
+		glm::length(_rotation[1] * _scale.y),
+		glm::length(_rotation[2] * _scale.z)
+	});
+
+	return Common::BoundSphere{
+		_position + _rotation * (boundSphere.position * _scale),
+		boundSphere.radius * maxScale
+	};
+}
+
+std::optional<rid_t> Model::getMeshRid() const {
+	return _meshRid;
+}
+
+const std::string &Model::getMeshPath() const {
+	return _meshPath;
+}
+
 }
@@ -23,6 +23,7 @@
 
 #include <vector>
 #include <optional>
+#include <string>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
@@ -56,10 +57,30 @@ public:
 
 	MeshPtr getMesh() const;
 
+	/*!
+	 * Get the bounding sphere of the mesh transformed by the position, rotation and scale of this model
+	 * \return the bounding sphere in world space
+	 */
+	Common::BoundSphere getWorldBoundSphere() const;
+
+	/*!
+	 * Get the resource id from which the mesh of this model was loaded
+	 * \return the resource id or nothing if the mesh wasn't loaded by a resource id
+	 */
+	std::optional<rid_t> getMeshRid() const;
+
+	/*!
+	 * Get the path from which the mesh of this model was loaded
+	 * \return the path or an empty string if the mesh wasn't loaded by a path
+	 */
+	const std::string &getMeshPath() const;
+
 protected:
 	Model();
 
 	MeshPtr _mesh;
+	std::optional<rid_t> _meshRid;
+	std::string _meshPath;
 
 	glm::vec3 _position;
 	glm::vec3 _scale;
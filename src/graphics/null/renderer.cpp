@@ -0,0 +1,63 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/common/profiler.h"
+
+#include "src/graphics/null/renderer.h"
+
+namespace Graphics::Null {
+
+void Renderer::drawFrame() {
+	PROFILE_ZONE("Renderer::drawFrame");
+	_numDrawCalls = 0;
+
+	cullModels(getViewProjection());
+	for (const auto &model : _visibleModels)
+		_numDrawCalls += model->getMesh()->getMeshs().size();
+
+	if (!_currentVideoFrame.isNil())
+		_numDrawCalls += 1;
+
+	for (const auto &element : _guiElements)
+		_numDrawCalls += element->getParts().size();
+}
+
+Common::UUID Renderer::registerVertices(byte *, size_t) {
+	return Common::UUID::generateRandom();
+}
+
+Common::UUID Renderer::registerIndices(byte *, size_t) {
+	return Common::UUID::generateRandom();
+}
+
+Common::UUID Renderer::registerVertexAttributes(const std::string &,
+												const std::vector<VertexAttribute> &,
+												Common::UUID) {
+	return Common::UUID::generateRandom();
+}
+
+Common::UUID Renderer::registerTexture(const ImageDecoder &) {
+	return Common::UUID::generateRandom();
+}
+
+void Renderer::deregisterTexture(const Common::UUID &) {
+}
+
+}
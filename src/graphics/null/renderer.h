@@ -0,0 +1,54 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AWE_NULL_RENDERER_H
+#define AWE_NULL_RENDERER_H
+
+#include "src/graphics/renderer.h"
+
+namespace Graphics::Null {
+
+/*!
+ * \brief Renderer which doesn't draw anything
+ *
+ * The null renderer accepts every resource without uploading it anywhere and
+ * only counts the draw calls a real renderer would issue. It allows to run
+ * the engine without a window or graphics context, for example in headless
+ * benchmarks.
+ */
+class Renderer : public Graphics::Renderer {
+public:
+	void drawFrame() override;
+
+	Common::UUID registerVertices(byte *data, size_t length) override;
+	Common::UUID registerIndices(byte *data, size_t length) override;
+
+	Common::UUID
+	registerVertexAttributes(const std::string &shader, const std::vector<VertexAttribute> &vertexAttributes,
+							 Common::UUID vertexData) override;
+
+	Common::UUID registerTexture(const ImageDecoder &decoder) override;
+
+	void deregisterTexture(const Common::UUID &decoder) override;
+};
+
+}
+
+#endif //AWE_NULL_RENDERER_H
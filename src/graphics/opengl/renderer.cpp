@@ -32,6 +32,7 @@
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 
+#include "src/common/log.h"
 #include "src/common/uuid.h"
 #include "src/common/writefile.h"
 
@@ -42,6 +43,7 @@
 #include "src/graphics/opengl/renderer.h"
 #include "src/graphics/opengl/opengl.h"
 #include "src/graphics/opengl/vbo.h"
+#include "src/common/profiler.h"
 
 namespace Graphics::OpenGL {
 
@@ -80,9 +82,9 @@ Renderer::Renderer(Graphics::Window &window) : _window(window) {
 	spdlog::info("Num OpenGL Extensions: {}", numExtensions);
 
 	std::string extensions;
-	spdlog::debug("Found Extensions:");
+	LOG_DEBUG("Found Extensions:");
 	for (int i = 0; i < numExtensions; ++i) {
-		spdlog::debug("- {}", glGetStringi(GL_EXTENSIONS, i));
+		LOG_DEBUG("- {}", glGetStringi(GL_EXTENSIONS, i));
 	}
 
 	if (!GLEW_EXT_texture_compression_s3tc) {
@@ -265,6 +267,8 @@ Renderer::~Renderer() {
 }
 
 void Renderer::drawFrame() {
+	PROFILE_ZONE("Renderer::drawFrame");
+	_numDrawCalls = 0;
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 	drawWorld();
@@ -275,11 +279,10 @@ void Renderer::drawFrame() {
 }
 
 void Renderer::drawWorld() {
-	glm::mat4 p = glm::perspectiveFov(45.0f, 1920.0f, 1080.0f, 1.0f, 10000.0f);
-	glm::mat4 v = _camera.getLookAt();
-	glm::mat4 vp = p * v;
+	const glm::mat4 vp = getViewProjection();
+	cullModels(vp);
 
-	for (const auto &model : _models) {
+	for (const auto &model : _visibleModels) {
 		const glm::mat4 rotation = model->getRotation();
 		const glm::vec3 position = model->getPosition();
 		const glm::vec3 scale = model->getScale();
@@ -394,6 +397,7 @@ void Renderer::drawWorld() {
 					GL_UNSIGNED_SHORT,
 					reinterpret_cast<void *>(partmesh.offset)
 			);
+			_numDrawCalls += 1;
 
 			assert(glGetError() == GL_NO_ERROR);
 		}
@@ -415,6 +419,7 @@ void Renderer::drawVideo() {
 	program->setUniformSampler("g_sVideoTexture", 0);
 
 	glDrawArrays(GL_TRIANGLES, 0, 6);
+	_numDrawCalls += 1;
 
 	glUseProgram(0);
 }
@@ -451,6 +456,7 @@ void Renderer::drawGUI() {
 					reinterpret_cast<void*>(part.indicesOffset),
 					part.verticesOffset
 			);
+			_numDrawCalls += 1;
 		}
 	}
 
@@ -669,11 +675,11 @@ void Renderer::debugMessageCallback(GLenum source, GLenum type, GLuint id, GLenu
 					spdlog::info(message);
 					break;
 				case GL_DEBUG_SEVERITY_MEDIUM:
-					spdlog::debug(message);
+					LOG_DEBUG(message);
 					break;
                 default:
 				case GL_DEBUG_SEVERITY_LOW:
-					spdlog::trace(message);
+					LOG_TRACE(message);
 					break;
 			}
 			return;
@@ -20,9 +20,13 @@
 
 #include <algorithm>
 
+#include <glm/gtx/transform.hpp>
+
+#include "src/common/profiler.h"
+
 #include "renderer.h"
 
-Graphics::Renderer::Renderer() : _currentVideoFrame(Common::UUID::generateNil()) {
+Graphics::Renderer::Renderer() : _currentVideoFrame(Common::UUID::generateNil()), _numDrawCalls(0), _numCulledModels(0) {
 
 }
 
@@ -49,3 +53,38 @@ void Graphics::Renderer::setAmbianceState(const Graphics::AmbianceState ambiance
 void Graphics::Renderer::setCurrentVideoFrame(const Common::UUID &id) {
 	_currentVideoFrame = id;
 }
+
+unsigned int Graphics::Renderer::getNumDrawCalls() const {
+	return _numDrawCalls;
+}
+
+unsigned int Graphics::Renderer::getNumVisibleModels() const {
+	return _visibleModels.size();
+}
+
+unsigned int Graphics::Renderer::getNumCulledModels() const {
+	return _numCulledModels;
+}
+
+glm::mat4 Graphics::Renderer::getViewProjection() const {
+	const glm::mat4 projection = glm::perspectiveFov(45.0f, 1920.0f, 1080.0f, 1.0f, 10000.0f);
+	return projection * _camera.getLookAt();
+}
+
+void Graphics::Renderer::cullModels(const glm::mat4 &viewProjection) {
+	PROFILE_ZONE("Renderer::cullModels");
+
+	_modelBounds.clear();
+	for (const auto &model : _models)
+		_modelBounds.add(model->getWorldBoundSphere());
+
+	const Common::Frustum frustum(viewProjection);
+	frustum.cull(_modelBounds, _modelVisibility);
+
+	_visibleModels.clear();
+	for (size_t i = 0; i < _models.size(); ++i) {
+		if (_modelVisibility[i])
+			_visibleModels.emplace_back(_models[i]);
+	}
+	_numCulledModels = _models.size() - _visibleModels.size();
+}
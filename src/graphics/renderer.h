@@ -24,6 +24,8 @@
 #include <vector>
 #include <src/graphics/images/decoder.h>
 
+#include "src/common/frustum.h"
+
 #include "src/graphics/model.h"
 #include "src/graphics/camera.h"
 #include "src/graphics/vertexattribute.h"
@@ -57,14 +59,53 @@ public:
 
 	virtual void drawFrame() = 0;
 
+	/*!
+	 * Get the number of draw calls issued in the last frame
+	 * \return the number of draw calls
+	 */
+	unsigned int getNumDrawCalls() const;
+
+	/*!
+	 * Get the number of models inside the view frustum in the last frame
+	 * \return the number of visible models
+	 */
+	unsigned int getNumVisibleModels() const;
+
+	/*!
+	 * Get the number of models culled because they were outside of the view frustum in the last frame
+	 * \return the number of culled models
+	 */
+	unsigned int getNumCulledModels() const;
+
 protected:
+	/*!
+	 * Get the view projection matrix of the current camera
+	 * \return the matrix transforming world coordinates into clip space
+	 */
+	glm::mat4 getViewProjection() const;
+
+	/*!
+	 * Collect the models whose bounding spheres are inside the view frustum into the visible models
+	 * \param viewProjection the view projection matrix to cull against
+	 */
+	void cullModels(const glm::mat4 &viewProjection);
+
 	Camera _camera;
 	AmbianceState _ambiance;
 
 	Common::UUID _currentVideoFrame;
 
+	unsigned int _numDrawCalls;
+	unsigned int _numCulledModels;
+
 	std::vector<Model*> _models;
+	std::vector<Model*> _visibleModels;
 	std::vector<GUIElement *> _guiElements;
+
+private:
+	// Kept between frames, so that culling doesn't allocate
+	Common::BoundSpheres _modelBounds;
+	std::vector<byte> _modelVisibility;
 };
 
 } // End of namespace Graphics
@@ -28,6 +28,7 @@
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 
+#include "src/common/log.h"
 #include "src/common/types.h"
 #include "src/common/memwritestream.h"
 
@@ -163,7 +164,7 @@ std::string ShaderConverter::convertToGLSL() {
 				break;
 		}
 
-		spdlog::debug("Converted {} shader to glsl:\n{}", shaderTypeName, shader);
+		LOG_DEBUG("Converted {} shader to glsl:\n{}", shaderTypeName, shader);
 	}
 
 	MOJOSHADER_freeParseData(parseData);
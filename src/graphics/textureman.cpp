@@ -28,10 +28,12 @@
 #include "src/awe/resman.h"
 
 #include "src/graphics/gfxman.h"
+#include "src/common/profiler.h"
 
 namespace Graphics {
 
 Common::UUID TextureManager::getTexture(const std::string &path) {
+	PROFILE_ZONE("TextureManager::getTexture");
 	if (!std::regex_match(path, std::regex(".*(\\.tex|\\.tex_lo)$")))
 		return Common::UUID::generateNil();
 
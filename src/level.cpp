@@ -18,6 +18,8 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 
@@ -25,20 +27,42 @@
 #include "src/awe/terraindatafile.h"
 #include "src/awe/resman.h"
 
+#include "src/common/threadpool.h"
+
+#include "src/graphics/meshman.h"
+
 #include "src/level.h"
+#include "src/common/profiler.h"
 
-Level::Level(entt::registry &registry, const std::string &id, const std::string &world) : ObjectCollection(registry), _id(id), _world(world) {
+/*!
+ * The number of entities which are created or destroyed by cell streaming
+ * per frame
+ */
+static const size_t kMaxStreamedEntitiesPerFrame = 512;
+
+static const float kDefaultCellSize = 128.0f;
+static const float kDefaultHighDetailRadius = 192.0f;
+static const float kDefaultLowDetailRadius = 448.0f;
+
+Level::Level(entt::registry &registry, const std::string &id, const std::string &world, bool staging) :
+	ObjectCollection(registry, staging),
+	_id(id),
+	_world(world),
+	_levelFolder(fmt::format("worlds/{}/levels/{}", world, id)),
+	_cellSize(kDefaultCellSize),
+	_highDetailRadius(kDefaultHighDetailRadius),
+	_lowDetailRadius(kDefaultLowDetailRadius) {
+	PROFILE_ZONE("Level::Level");
 	spdlog::info("Loading level {}", id);
-	std::string levelFolder = fmt::format("worlds/{}/levels/{}", world, id);
 
-	loadGIDRegistry(ResMan.getResource(fmt::format("{}/GIDRegistry.txt", levelFolder)));
+	loadGIDRegistry(getResource(fmt::format("{}/GIDRegistry.txt", _levelFolder)));
 
-	std::unique_ptr<Common::ReadStream> globalStream(ResMan.getResource(fmt::format("{}/Global.bin", levelFolder)));
+	std::unique_ptr<Common::ReadStream> globalStream(getResource(fmt::format("{}/Global.bin", _levelFolder)));
 	AWE::BINArchive global(*globalStream);
 
 	load(global.getResource("cid_staticobject.bin"), kStaticObject);
 
-	std::unique_ptr<Common::ReadStream> persistentStream(ResMan.getResource(fmt::format("{}/Persistent.bin", levelFolder)));
+	std::unique_ptr<Common::ReadStream> persistentStream(getResource(fmt::format("{}/Persistent.bin", _levelFolder)));
 	AWE::BINArchive persistent(*persistentStream);
 
 	loadBytecode(
@@ -59,23 +83,131 @@ Level::Level(entt::registry &registry, const std::string &id, const std::string
 	spdlog::info("Loading floating scripts for {}", id);
 	load(persistent.getResource("cid_floatingscript.bin"), kFloatingScript, dp);
 
+	// The cells themselves are streamed in depending on the camera position
 	const auto cellInfo = loadCellInfo(global.getResource("cid_cellinfo.bin"));
-	for (const auto &info : cellInfo) {
-		const std::string ldName = fmt::format("LD{:0>3}_{:0>3}", info.x, info.y);
-		const std::string hdName = fmt::format("HD{:0>3}_{:0>3}", info.x, info.y);
-
-		AWE::BINArchive ldCell(fmt::format("{}/{}.bin", levelFolder, ldName));
-		AWE::BINArchive hdCell(fmt::format("{}/{}.bin", levelFolder, hdName));
-		AWE::BINArchive ldCellResources(fmt::format("{}/{}.resources", levelFolder, ldName));
-		AWE::BINArchive hdCellResources(fmt::format("{}/{}.resources", levelFolder, hdName));
-
-		//DPFile dphd(persistent.getResource("dp_hdcell.bin"));
-		load(hdCell.getResource("cid_staticobject.bin")/*, dphd*/, kStaticObject);
-		load(ldCell.getResource("cid_staticobject.bin"), kStaticObject);
-		//loadTerrainData(ldCell.getResource("cid_terraindata.bin"));
-
-		loadFoliageData(hdCell.getResource("cid_foliagedata.bin"));
-		loadFoliageData(ldCell.getResource("cid_foliagedata.bin"));
+	for (const auto &info : cellInfo)
+		_cells[std::make_pair(info.x, info.y)] = CellSlot();
+}
+
+Level::Level(entt::registry &registry, const std::string &id, const std::string &world, Common::ReadStream &snapshot, bool staging) :
+	ObjectCollection(registry, staging),
+	_id(id),
+	_world(world),
+	_levelFolder(fmt::format("worlds/{}/levels/{}", world, id)),
+	_cellSize(kDefaultCellSize),
+	_highDetailRadius(kDefaultHighDetailRadius),
+	_lowDetailRadius(kDefaultLowDetailRadius) {
+	PROFILE_ZONE("Level::Level (snapshot)");
+	spdlog::info("Restoring level {} from snapshot", id);
+	restore(snapshot);
+
+	const uint32_t numCells = snapshot.readUint32LE();
+	for (uint32_t i = 0; i < numCells; ++i) {
+		const uint32_t x = snapshot.readUint32LE();
+		const uint32_t y = snapshot.readUint32LE();
+		_cells[std::make_pair(x, y)] = CellSlot();
+	}
+}
+
+Level::~Level() {
+	// The workers only reference the cells they load, so they have to finish before the cells are destroyed
+	for (auto &loading : _loadingCells)
+		loading.loaded.wait();
+}
+
+const std::string &Level::getId() const {
+	return _id;
+}
+
+void Level::setStreamingRadius(float highDetailRadius, float lowDetailRadius) {
+	_highDetailRadius = highDetailRadius;
+	_lowDetailRadius = lowDetailRadius;
+}
+
+void Level::setCellSize(float cellSize) {
+	_cellSize = cellSize;
+}
+
+void Level::update(const glm::vec3 &cameraPosition, SpatialIndex &spatialIndex) {
+	PROFILE_ZONE("Level::update");
+	addToSpatialIndex(spatialIndex);
+
+	// Release the cells whose workers have finished, if this is the last reference the cell is destroyed right here
+	_loadingCells.erase(std::remove_if(_loadingCells.begin(), _loadingCells.end(), [](const auto &loading){
+		return loading.loaded.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}), _loadingCells.end());
+
+	const glm::vec2 camera(cameraPosition.x, cameraPosition.z);
+	for (auto &[position, cell] : _cells) {
+		const glm::vec2 center = (glm::vec2(position.first, position.second) + 0.5f) * _cellSize;
+		const float distance = glm::distance(camera, center);
+
+		const glm::u32vec2 cellPosition(position.first, position.second);
+		updateCell(cell.highDetail, cellPosition, true, distance <= _highDetailRadius);
+		updateCell(cell.lowDetail, cellPosition, false, distance <= _lowDetailRadius);
+	}
+
+	// Unloading goes first, so that the entity count doesn't grow while the camera moves
+	size_t budget = kMaxStreamedEntitiesPerFrame;
+	bool unloadedCell = false;
+	for (auto iter = _unloadingCells.begin(); iter != _unloadingCells.end() && budget > 0;) {
+		budget -= (*iter)->destroyEntities(budget);
+		if ((*iter)->getNumEntities() == 0) {
+			iter = _unloadingCells.erase(iter);
+			unloadedCell = true;
+		} else {
+			++iter;
+		}
+	}
+
+	if (unloadedCell)
+		MeshMan.collectGarbage();
+
+	for (auto &[position, cell] : _cells) {
+		if (budget == 0)
+			break;
+		commitCell(cell.highDetail, budget, spatialIndex);
+		commitCell(cell.lowDetail, budget, spatialIndex);
+	}
+
+	PROFILE_COUNTER("Level::streamedEntities", kMaxStreamedEntitiesPerFrame - budget);
+	PROFILE_COUNTER("Level::unloadingCells", _unloadingCells.size());
+}
+
+void Level::updateCell(std::shared_ptr<Cell> &cell, const glm::u32vec2 &position, bool highDetail, bool resident) {
+	if (resident && !cell) {
+		cell = std::make_shared<Cell>(_registry, _levelFolder, position, highDetail);
+
+		// The task owns the promise, so that it stays valid until the waiting thread is woken up
+		auto loaded = std::make_shared<std::promise<void>>();
+		_loadingCells.emplace_back(LoadingCell{cell, loaded->get_future()});
+		Threads.add([loadingCell = cell.get(), loaded](){
+			loadingCell->load();
+			loaded->set_value();
+		});
+	} else if (!resident && cell) {
+		// Queries must not find entities which are about to be destroyed
+		cell->removeFromSpatialIndex();
+		_unloadingCells.emplace_back(std::move(cell));
+	}
+}
+
+void Level::commitCell(const std::shared_ptr<Cell> &cell, size_t &budget, SpatialIndex &spatialIndex) {
+	if (!cell)
+		return;
+
+	budget -= cell->commit(budget);
+	if (cell->isCommitted())
+		cell->addToSpatialIndex(spatialIndex);
+}
+
+void Level::save(Common::WriteStream &snapshot) const {
+	ObjectCollection::save(snapshot);
+
+	snapshot.writeUint32LE(_cells.size());
+	for (const auto &[position, cell] : _cells) {
+		snapshot.writeUint32LE(position.first);
+		snapshot.writeUint32LE(position.second);
 	}
 }
 
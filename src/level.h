@@ -21,24 +21,98 @@
 #ifndef OPENAWE_LEVEL_H
 #define OPENAWE_LEVEL_H
 
+#include <future>
+#include <map>
+#include <memory>
+#include <utility>
+
 #include <glm/glm.hpp>
 
 #include "src/common/readstream.h"
 
 #include "src/graphics/terrain.h"
 
+#include "src/cell.h"
 #include "src/objectcollection.h"
 
 class Level : public ObjectCollection {
 public:
-	Level(entt::registry &registry, const std::string &id, const std::string &world);
+	Level(entt::registry &registry, const std::string &id, const std::string &world, bool staging = false);
+
+	/*!
+	 * Restore a level from a snapshot
+	 * \param registry the registry in which the entities are created
+	 * \param id the id of the level
+	 * \param world the world of the level
+	 * \param snapshot the snapshot written by save()
+	 * \param staging if the level is restored outside of the main thread into a staging registry
+	 */
+	Level(entt::registry &registry, const std::string &id, const std::string &world, Common::ReadStream &snapshot, bool staging = false);
+	~Level();
+
+	const std::string &getId() const;
+
+	/*!
+	 * Set the distances around the camera in which cells are resident. High
+	 * detail cells are loaded within the high detail radius, low detail cells
+	 * within the usually larger low detail radius.
+	 * \param highDetailRadius the radius for high detail cells in world units
+	 * \param lowDetailRadius the radius for low detail cells in world units
+	 */
+	void setStreamingRadius(float highDetailRadius, float lowDetailRadius);
+
+	/*!
+	 * Set the size of a single cell in world units
+	 * \param cellSize the edge length of a cell
+	 */
+	void setCellSize(float cellSize);
+
+	/*!
+	 * Update the resident cells for the given camera position. Cells which
+	 * come into range are loaded on worker threads and cells which leave it
+	 * are unloaded. Registry changes are limited to a fixed number of
+	 * entities per call. Cells are added to the spatial index once all
+	 * their entities exist and removed from it before they are unloaded.
+	 * \param cameraPosition the current position of the camera
+	 * \param spatialIndex the spatial index for the entities of the level
+	 */
+	void update(const glm::vec3 &cameraPosition, SpatialIndex &spatialIndex);
+
+	/*!
+	 * Write the level into a snapshot. The cells are not part of the
+	 * snapshot, since they are streamed independently.
+	 * \param snapshot the stream to write the snapshot to
+	 */
+	void save(Common::WriteStream &snapshot) const;
 
 private:
+	struct CellSlot {
+		std::shared_ptr<Cell> lowDetail, highDetail;
+	};
+
+	struct LoadingCell {
+		std::shared_ptr<Cell> cell;
+		std::future<void> loaded;
+	};
+
 	std::vector<glm::u32vec2> loadCellInfo(Common::ReadStream *cid) const;
 	void loadTerrainData(Common::ReadStream *terrainData);
 
+	void updateCell(std::shared_ptr<Cell> &cell, const glm::u32vec2 &position, bool highDetail, bool resident);
+	void commitCell(const std::shared_ptr<Cell> &cell, size_t &budget, SpatialIndex &spatialIndex);
+
 	std::vector<std::unique_ptr<Graphics::Terrain>> _terrains;
 	const std::string _id, _world;
+	const std::string _levelFolder;
+
+	float _cellSize;
+	float _highDetailRadius, _lowDetailRadius;
+
+	std::map<std::pair<uint32_t, uint32_t>, CellSlot> _cells;
+	std::vector<std::shared_ptr<Cell>> _unloadingCells;
+
+	// Cells stay in here until their worker has finished, so that they are always destroyed on the main thread
+	std::vector<LoadingCell> _loadingCells;
 };
 
 
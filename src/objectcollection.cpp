@@ -18,14 +18,21 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <map>
+#include <type_traits>
+
 #include <spdlog/spdlog.h>
 
 #include "common/convexshape.h"
+#include "common/log.h"
+#include "common/memreadstream.h"
+#include "common/profiler.h"
 
 #include "awe/cidfile.h"
 #include "awe/dpfile.h"
 #include "awe/foliagedatafile.h"
 #include "awe/object.h"
+#include "awe/resman.h"
 
 #include "src/graphics/model.h"
 #include "src/graphics/meshman.h"
@@ -37,11 +44,336 @@
 #include "task.h"
 #include "utils.h"
 
-ObjectCollection::ObjectCollection(entt::registry &registry) : _registry(registry) {
+namespace {
+
+template<typename T>
+void writeArray(Common::WriteStream &stream, const std::vector<T> &values) {
+	static_assert(std::is_trivially_copyable_v<T>);
+	stream.writeUint32LE(values.size());
+	stream.write(values.data(), values.size() * sizeof(T));
+}
+
+template<typename T>
+std::vector<T> readArray(Common::ReadStream &stream) {
+	static_assert(std::is_trivially_copyable_v<T>);
+	std::vector<T> values(stream.readUint32LE());
+	if (stream.read(values.data(), values.size() * sizeof(T)) != values.size() * sizeof(T))
+		throw std::runtime_error("Snapshot is truncated");
+	return values;
+}
+
+void writeString(Common::WriteStream &stream, std::string_view string) {
+	stream.writeUint32LE(string.size());
+	stream.write(string.data(), string.size());
+}
+
+std::string readString(Common::ReadStream &stream) {
+	std::string string(stream.readUint32LE(), '\0');
+	stream.read(string.data(), string.size());
+	return string;
+}
+
+std::vector<byte> readAll(Common::ReadStream &stream) {
+	stream.seek(0, Common::ReadStream::END);
+	std::vector<byte> data(stream.pos());
+	stream.seek(0, Common::ReadStream::BEGIN);
+	stream.read(data.data(), data.size());
+	return data;
+}
+
+}
+
+ObjectCollection::ObjectCollection(entt::registry &registry, bool staging) :
+	_registry(registry),
+	_staging(staging),
+	_spatialIndex(nullptr),
+	_bytecodeMemory(Common::kMemoryBytecode) {
 }
 
 ObjectCollection::~ObjectCollection() {
-	_registry.destroy(_entities.begin(), _entities.end());
+	removeFromSpatialIndex();
+
+	if (!_entities.empty())
+		_registry.destroy(_entities.begin(), _entities.end());
+}
+
+void ObjectCollection::addToSpatialIndex(SpatialIndex &spatialIndex) {
+	if (_spatialIndex)
+		return;
+
+	_spatialIndex = &spatialIndex;
+	_spatialIndex->add(this, _entities);
+}
+
+void ObjectCollection::removeFromSpatialIndex() {
+	if (!_spatialIndex)
+		return;
+
+	_spatialIndex->remove(this);
+	_spatialIndex = nullptr;
+}
+
+ObjectCollection::Inputs ObjectCollection::getInputs() const {
+	return _inputs;
+}
+
+Common::ReadStream *ObjectCollection::getResource(const std::string &path) {
+	uint32_t hash;
+	if (ResMan.getResourceHash(path, hash))
+		_inputs.emplace_back(path, hash);
+
+	return ResMan.getResource(path);
+}
+
+void ObjectCollection::save(Common::WriteStream &snapshot) const {
+	std::map<entt::entity, uint32_t> indices;
+	for (const auto &entity : _entities) {
+		if (_registry.valid(entity))
+			indices.emplace(entity, indices.size());
+	}
+
+	std::vector<uint32_t> gidIndices, transformIndices, taskIndices, shapeIndices, modelIndices;
+	std::vector<GID> gids;
+	std::vector<Transform> transforms;
+	for (const auto &entity : _entities) {
+		if (!_registry.valid(entity))
+			continue;
+
+		const uint32_t index = indices[entity];
+		if (const auto *gid = _registry.try_get<GID>(entity)) {
+			gidIndices.emplace_back(index);
+			gids.emplace_back(*gid);
+		}
+		if (const auto *transform = _registry.try_get<Transform>(entity)) {
+			transformIndices.emplace_back(index);
+			transforms.emplace_back(*transform);
+		}
+		if (_registry.try_get<Task>(entity))
+			taskIndices.emplace_back(index);
+		if (_registry.try_get<Common::ConvexShape>(entity))
+			shapeIndices.emplace_back(index);
+		if (_registry.try_get<Graphics::ModelPtr>(entity) || _registry.try_get<ModelReference>(entity))
+			modelIndices.emplace_back(index);
+	}
+
+	std::vector<entt::entity> entities(indices.size());
+	for (const auto &[entity, index] : indices)
+		entities[index] = entity;
+
+	// The inputs are kept, so that a restored collection can be written into a snapshot again
+	snapshot.writeUint32LE(_inputs.size());
+	for (const auto &[path, hash] : _inputs) {
+		writeString(snapshot, path);
+		snapshot.writeUint32LE(hash);
+	}
+
+	snapshot.writeUint32LE(entities.size());
+
+	// Plain components are written as arrays, so that they can be inserted in bulk
+	writeArray(snapshot, gidIndices);
+	writeArray(snapshot, gids);
+	writeArray(snapshot, transformIndices);
+	writeArray(snapshot, transforms);
+
+	snapshot.writeUint32LE(taskIndices.size());
+	for (const auto &index : taskIndices) {
+		const auto &task = _registry.get<Task>(entities[index]);
+		snapshot.writeUint32LE(index);
+		writeString(snapshot, task.getName());
+		snapshot.writeByte(task.isActiveOnStartup());
+		snapshot.writeUint32LE(task.getActiveOnStartupRounds().size());
+		for (const bool round : task.getActiveOnStartupRounds())
+			snapshot.writeByte(round);
+		writeArray(snapshot, task.getPlayerCharacters());
+	}
+
+	snapshot.writeUint32LE(shapeIndices.size());
+	for (const auto &index : shapeIndices) {
+		snapshot.writeUint32LE(index);
+		writeArray(snapshot, _registry.get<Common::ConvexShape>(entities[index]).getPoints());
+	}
+
+	// Models only store the reference to their mesh, which is loaded again on restore
+	snapshot.writeUint32LE(modelIndices.size());
+	for (const auto &index : modelIndices) {
+		ModelReference reference;
+		if (const auto *model = _registry.try_get<Graphics::ModelPtr>(entities[index])) {
+			reference.rid = (*model)->getMeshRid();
+			reference.path = (*model)->getMeshPath();
+			reference.position = (*model)->getPosition();
+			reference.rotation = (*model)->getRotation();
+		} else {
+			reference = _registry.get<ModelReference>(entities[index]);
+		}
+
+		snapshot.writeUint32LE(index);
+		snapshot.writeByte(reference.rid.has_value());
+		snapshot.writeUint32LE(reference.rid.value_or(0));
+		writeString(snapshot, reference.path);
+		snapshot.write(&reference.position, sizeof(glm::vec3));
+		snapshot.write(&reference.rotation, sizeof(glm::mat3));
+	}
+
+	// Scripts are stored as references into the bytecode collection
+	writeArray(snapshot, _bytecodeData);
+	writeArray(snapshot, _bytecodeParametersData);
+	writeArray(snapshot, _scripts);
+
+	// The decoded programs are cached, so that restoring doesn't have to decode the bytecode again
+	if (_bytecode)
+		_bytecode->save(snapshot);
+	else
+		snapshot.writeUint32LE(0);
+}
+
+void ObjectCollection::restore(Common::ReadStream &snapshot) {
+	const uint32_t numInputs = snapshot.readUint32LE();
+	for (uint32_t i = 0; i < numInputs; ++i) {
+		const std::string path = readString(snapshot);
+		_inputs.emplace_back(path, snapshot.readUint32LE());
+	}
+
+	const size_t firstEntity = _entities.size();
+	_entities.resize(firstEntity + snapshot.readUint32LE());
+	_registry.create(_entities.begin() + firstEntity, _entities.end());
+
+	const auto getEntities = [&](const std::vector<uint32_t> &indices) {
+		std::vector<entt::entity> entities;
+		entities.reserve(indices.size());
+		for (const auto &index : indices) {
+			if (firstEntity + index >= _entities.size())
+				throw std::runtime_error("Invalid entity index in snapshot");
+			entities.emplace_back(_entities[firstEntity + index]);
+		}
+		return entities;
+	};
+
+	const auto gidEntities = getEntities(readArray<uint32_t>(snapshot));
+	const auto gids = readArray<GID>(snapshot);
+	if (gids.size() != gidEntities.size())
+		throw std::runtime_error("Invalid number of gids in snapshot");
+	_registry.insert<GID>(gidEntities.begin(), gidEntities.end(), gids.begin());
+
+	const auto transformEntities = getEntities(readArray<uint32_t>(snapshot));
+	const auto transforms = readArray<Transform>(snapshot);
+	if (transforms.size() != transformEntities.size())
+		throw std::runtime_error("Invalid number of transforms in snapshot");
+	_registry.insert<Transform>(transformEntities.begin(), transformEntities.end(), transforms.begin());
+
+	std::vector<uint32_t> taskIndices(snapshot.readUint32LE());
+	std::vector<Task> tasks;
+	tasks.reserve(taskIndices.size());
+	for (auto &index : taskIndices) {
+		index = snapshot.readUint32LE();
+		const Common::Atom name = Atoms.intern(readString(snapshot));
+		const bool activateOnStartup = snapshot.readByte() != 0;
+		std::vector<bool> activateOnStartupRound(snapshot.readUint32LE());
+		for (size_t i = 0; i < activateOnStartupRound.size(); ++i)
+			activateOnStartupRound[i] = snapshot.readByte() != 0;
+		const auto playerCharacter = readArray<GID>(snapshot);
+
+		tasks.emplace_back(name, playerCharacter, activateOnStartup, activateOnStartupRound);
+	}
+	const auto taskEntities = getEntities(taskIndices);
+	_registry.insert<Task>(taskEntities.begin(), taskEntities.end(), tasks.begin());
+
+	std::vector<uint32_t> shapeIndices(snapshot.readUint32LE());
+	std::vector<Common::ConvexShape> shapes;
+	shapes.reserve(shapeIndices.size());
+	for (auto &index : shapeIndices) {
+		index = snapshot.readUint32LE();
+		shapes.emplace_back(readArray<glm::vec2>(snapshot));
+	}
+	const auto shapeEntities = getEntities(shapeIndices);
+	_registry.insert<Common::ConvexShape>(shapeEntities.begin(), shapeEntities.end(), shapes.begin());
+
+	const uint32_t numModels = snapshot.readUint32LE();
+	for (uint32_t i = 0; i < numModels; ++i) {
+		const uint32_t index = snapshot.readUint32LE();
+		const bool hasRid = snapshot.readByte() != 0;
+		const rid_t rid = snapshot.readUint32LE();
+		const std::string path = readString(snapshot);
+
+		glm::vec3 position;
+		glm::mat3 rotation;
+		snapshot.read(&position, sizeof(glm::vec3));
+		snapshot.read(&rotation, sizeof(glm::mat3));
+
+		// Loading the meshes is left to createModels(), so that it can be spread across several frames
+		ModelReference &reference = _registry.emplace<ModelReference>(getEntities({index}).front());
+		if (hasRid)
+			reference.rid = rid;
+		reference.path = path;
+		reference.position = position;
+		reference.rotation = rotation;
+	}
+
+	_bytecodeData = readArray<byte>(snapshot);
+	_bytecodeParametersData = readArray<byte>(snapshot);
+	_bytecodeMemory.resize(_bytecodeData.size() + _bytecodeParametersData.size());
+	if (!_bytecodeData.empty()) {
+		_bytecode = std::make_unique<AWE::Script::Collection>(
+				new Common::MemoryReadStream(_bytecodeData.data(), _bytecodeData.size(), false),
+				new Common::MemoryReadStream(_bytecodeParametersData.data(), _bytecodeParametersData.size(), false)
+		);
+	}
+
+	const auto scripts = readArray<ScriptAttachment>(snapshot);
+	if (_bytecode)
+		_bytecode->restore(snapshot);
+	else if (snapshot.readUint32LE() != 0)
+		throw std::runtime_error("Snapshot contains programs without bytecode");
+
+	if (!scripts.empty()) {
+		if (!_bytecode)
+			throw std::runtime_error("Snapshot contains scripts without bytecode");
+
+		// Build the gid lookup once instead of searching the registry for every script
+		std::map<GID, entt::entity> entitiesByGID;
+		const auto gidView = _registry.view<GID>();
+		for (const auto &entity : gidView)
+			entitiesByGID.emplace(gidView.get<GID>(entity), entity);
+
+		for (const auto &script : scripts) {
+			const auto iter = entitiesByGID.find(script.gid);
+			if (iter == entitiesByGID.end()) {
+				// Like when loading, scripts of entities outside of the staging registry are attached on commit
+				if (!_staging)
+					throw std::runtime_error("Couldn't find script entity");
+
+				_scripts.emplace_back(script);
+				continue;
+			}
+
+			attachScript(iter->second, script.gid, script.script);
+		}
+	}
+}
+
+size_t ObjectCollection::createModels(entt::registry &registry, size_t maxModels) {
+	PROFILE_ZONE("ObjectCollection::createModels");
+
+	// Collect the entities first, since creating a model removes the entity from the view
+	std::vector<entt::entity> entities;
+	const auto referenceView = registry.view<ModelReference>();
+	for (const auto &entity : referenceView) {
+		if (entities.size() >= maxModels)
+			break;
+		entities.emplace_back(entity);
+	}
+
+	for (const auto &entity : entities) {
+		const ModelReference reference = registry.get<ModelReference>(entity);
+		registry.remove<ModelReference>(entity);
+
+		Graphics::ModelPtr model = registry.emplace<Graphics::ModelPtr>(entity) = reference.rid ?
+				std::make_shared<Graphics::Model>(*reference.rid) :
+				std::make_shared<Graphics::Model>(reference.path);
+		model->getPosition() = reference.position;
+		model->getRotation() = reference.rotation;
+	}
+
+	return entities.size();
 }
 
 void ObjectCollection::loadGIDRegistry(Common::ReadStream *stream) {
@@ -50,12 +382,59 @@ void ObjectCollection::loadGIDRegistry(Common::ReadStream *stream) {
 }
 
 void ObjectCollection::loadBytecode(Common::ReadStream *bytecode, Common::ReadStream *bytecodeParameters) {
+	std::unique_ptr<Common::ReadStream> bytecodeStream(bytecode), bytecodeParametersStream(bytecodeParameters);
+
+	// Keep the raw bytecode, so that it can be written into snapshots
+	_bytecodeData = readAll(*bytecodeStream);
+	_bytecodeParametersData = readAll(*bytecodeParametersStream);
+	_bytecodeMemory.resize(_bytecodeData.size() + _bytecodeParametersData.size());
+
 	_bytecode = std::make_unique<AWE::Script::Collection>(
-			bytecode,
-			bytecodeParameters
+			new Common::MemoryReadStream(_bytecodeData.data(), _bytecodeData.size(), false),
+			new Common::MemoryReadStream(_bytecodeParametersData.data(), _bytecodeParametersData.size(), false)
 	);
 }
 
+template<typename Mesh>
+void ObjectCollection::createModel(entt::entity entity, const Mesh &mesh, const glm::vec3 &position, const glm::mat3 &rotation) {
+	// Models upload their meshes to the gpu, which is only possible on the main thread
+	if (_staging) {
+		ModelReference &reference = _registry.emplace<ModelReference>(entity);
+		if constexpr (std::is_same_v<Mesh, rid_t>)
+			reference.rid = mesh;
+		else
+			reference.path = mesh;
+		reference.position = position;
+		reference.rotation = rotation;
+		return;
+	}
+
+	Graphics::ModelPtr model = _registry.emplace<Graphics::ModelPtr>(entity) = std::make_shared<Graphics::Model>(mesh);
+	model->getPosition() = position;
+	model->getRotation() = rotation;
+}
+
+void ObjectCollection::attachScript(entt::entity entity, GID gid, const AWE::Templates::ScriptVariables &script) {
+	_registry.emplace_or_replace<AWE::Script::BytecodePtr>(entity) = AWE::Script::BytecodePtr(_bytecode->createScript(script));
+	_scripts.emplace_back(ScriptAttachment{gid, script});
+}
+
+void ObjectCollection::attachScript(GID gid, const AWE::Templates::ScriptVariables &script) {
+	const entt::entity scriptEntity = getEntityByGID(_registry, gid);
+	if (scriptEntity != entt::null) {
+		attachScript(scriptEntity, gid, script);
+		return;
+	}
+
+	// The entity might belong to the world or to a reused level, which are not part of the staging registry. The
+	// script is only recorded then and attached to the entity when the collection is restored into the registry of
+	// the game
+	if (!_staging)
+		throw std::runtime_error("Couldn't find script entity");
+
+	_scripts.emplace_back(ScriptAttachment{gid, script});
+}
+
 void ObjectCollection::load(Common::ReadStream *stream, ObjectType type) {
 	std::unique_ptr<Common::ReadStream> cidStream(stream);
 	AWE::CIDFile cid(*cidStream, type, nullptr);
@@ -81,20 +460,29 @@ void ObjectCollection::loadFoliageData(Common::ReadStream *foliageData) {
 	std::unique_ptr<Common::ReadStream> foliageDataStream(foliageData);
 	AWE::FoliageDataFile foliageDataFile(*foliageDataStream);
 
-	std::vector<Graphics::MeshPtr> foliageMeshs;
-	for (const auto &foliage : foliageDataFile.getFoliages()) {
-		foliageMeshs.emplace_back(MeshMan.getMesh(foliage));
+	const auto &foliages = foliageDataFile.getFoliages();
+	for (const auto &instance : foliageDataFile.getInstances()) {
+		loadFoliage(foliages[instance.foliageId], instance.position);
 	}
+}
 
-	for (const auto &instance : foliageDataFile.getInstances()) {
-		entt::entity foliage = _registry.create();
-		Graphics::ModelPtr model = _registry.emplace<Graphics::ModelPtr>(foliage) = std::make_shared<Graphics::Model>(foliageMeshs[instance.foliageId]);
+void ObjectCollection::loadFoliage(const std::string &mesh, const glm::vec3 &position) {
+	entt::entity foliage = _registry.create();
+	// The mesh manager caches the meshes, so every foliage mesh is only loaded once
+	createModel(foliage, mesh, position, glm::identity<glm::mat3>());
+
+	_entities.emplace_back(foliage);
+}
 
-		model->getPosition() = instance.position;
-		model->getRotation() = glm::identity<glm::mat3>();
+size_t ObjectCollection::destroyEntities(size_t maxEntities) {
+	const size_t numEntities = std::min(maxEntities, _entities.size());
+	_registry.destroy(_entities.end() - numEntities, _entities.end());
+	_entities.resize(_entities.size() - numEntities);
+	return numEntities;
+}
 
-		_entities.emplace_back(foliage);
-	}
+size_t ObjectCollection::getNumEntities() const {
+	return _entities.size();
 }
 
 void ObjectCollection::load(const AWE::Object &container, ObjectType type) {
@@ -124,9 +512,10 @@ void ObjectCollection::loadSkeleton(const AWE::Object &container) {
 
 	auto skeletonEntity = _registry.create();
 	_registry.emplace<GID>(skeletonEntity) = skeleton.gid;
+	_entities.emplace_back(skeletonEntity);
 	// TODO: Load a representation of the skeleton
 
-	spdlog::debug("Loading skeleton {}", skeleton.name);
+	LOG_DEBUG("Loading skeleton {}", Atoms.getString(skeleton.name));
 }
 
 void ObjectCollection::loadAnimation(const AWE::Object &container) {
@@ -134,9 +523,10 @@ void ObjectCollection::loadAnimation(const AWE::Object &container) {
 
 	auto animationEntity = _registry.create();
 	_registry.emplace<GID>(animationEntity) = animation.gid;
+	_entities.emplace_back(animationEntity);
 	// TODO: Load a representation of the animation
 
-	spdlog::debug("Loading animation {} for skeleton {}", animation.name, _gid->getString(animation.skeletonGid));
+	LOG_DEBUG("Loading animation {} for skeleton {}", Atoms.getString(animation.name), _gid->getString(animation.skeletonGid));
 }
 
 void ObjectCollection::loadNotebookPage(const AWE::Object &container) {
@@ -146,7 +536,7 @@ void ObjectCollection::loadNotebookPage(const AWE::Object &container) {
 	_registry.emplace<GID>(notebookPageEntity) = notebookPage.gid;
 	_entities.emplace_back(notebookPageEntity);
 
-	spdlog::debug("Loading notebook page {}", _gid->getString(notebookPage.gid));
+	LOG_DEBUG("Loading notebook page {}", _gid->getString(notebookPage.gid));
 }
 
 void ObjectCollection::loadStaticObject(const AWE::Object &container) {
@@ -154,12 +544,9 @@ void ObjectCollection::loadStaticObject(const AWE::Object &container) {
 
 	auto staticObjectEntity = _registry.create();
 	_registry.emplace<Transform>(staticObjectEntity) = Transform(staticObject.position, staticObject.rotation);
-	Graphics::ModelPtr model = _registry.emplace<Graphics::ModelPtr>(staticObjectEntity) = std::make_shared<Graphics::Model>(staticObject.meshResource);
+	createModel(staticObjectEntity, staticObject.meshResource, staticObject.position, staticObject.rotation);
 	// TODO: Physics Resource
 
-	model->getPosition() = staticObject.position;
-	model->getRotation() = staticObject.rotation;
-
 	_entities.emplace_back(staticObjectEntity);
 }
 
@@ -169,28 +556,20 @@ void ObjectCollection::loadDynamicObject(const AWE::Object &container) {
 	auto dynamicObjectEntity = _registry.create();
 	_registry.emplace<GID>(dynamicObjectEntity) = dynamicObject.gid;
 	_registry.emplace<Transform>(dynamicObjectEntity) = Transform(dynamicObject.position, dynamicObject.rotation);
-	Graphics::ModelPtr model = _registry.emplace<Graphics::ModelPtr>(dynamicObjectEntity) = std::make_shared<Graphics::Model>(dynamicObject.meshResource);
+	createModel(dynamicObjectEntity, dynamicObject.meshResource, dynamicObject.position, dynamicObject.rotation);
 	// TODO: Physics Resource
 
-	model->getPosition() = dynamicObject.position;
-	model->getRotation() = dynamicObject.rotation;
-
 	_entities.emplace_back(dynamicObjectEntity);
 
-	spdlog::debug("Loading dynamic object {}", _gid->getString(dynamicObject.gid));
+	LOG_DEBUG("Loading dynamic object {}", _gid->getString(dynamicObject.gid));
 }
 
 void ObjectCollection::loadDynamicObjectScript(const AWE::Object &container) {
 	const auto dynamicObjectScript = std::any_cast<AWE::Templates::DynamicObjectScript>(container);
 
-	const entt::entity scriptEntity = getEntityByGID(_registry, dynamicObjectScript.gid);
-	if (scriptEntity == entt::null)
-		throw std::runtime_error("Couldn't find script entity");
-
-	_registry.emplace<AWE::Script::BytecodePtr>(scriptEntity) = AWE::Script::BytecodePtr(_bytecode->createScript(
-			dynamicObjectScript.script));
+	attachScript(dynamicObjectScript.gid, dynamicObjectScript.script);
 
-	spdlog::debug("Loading script for dynamic object {}", _gid->getString(dynamicObjectScript.gid));
+	LOG_DEBUG("Loading script for dynamic object {}", _gid->getString(dynamicObjectScript.gid));
 }
 
 void ObjectCollection::loadCharacter(const AWE::Object &container) {
@@ -199,15 +578,12 @@ void ObjectCollection::loadCharacter(const AWE::Object &container) {
 	auto characterEntity = _registry.create();
 	_registry.emplace<GID>(characterEntity) = character.gid;
 	_registry.emplace<Transform>(characterEntity) = Transform(character.position, character.rotation);
-	Graphics::ModelPtr model = _registry.emplace<Graphics::ModelPtr>(characterEntity) = std::make_shared<Graphics::Model>(character.meshResource);
+	createModel(characterEntity, character.meshResource, character.position, character.rotation);
 	// TODO: Physics and Cloth Resource
 
-	model->getPosition() = character.position;
-	model->getRotation() = character.rotation;
-
 	_entities.emplace_back(characterEntity);
 
-	spdlog::debug("Loading character {}", _gid->getString(character.gid));
+	LOG_DEBUG("Loading character {}", _gid->getString(character.gid));
 }
 
 void ObjectCollection::loadScriptInstance(const AWE::Object &container) {
@@ -216,21 +592,17 @@ void ObjectCollection::loadScriptInstance(const AWE::Object &container) {
 	auto scriptInstanceEntity = _registry.create();
 	_registry.emplace<GID>(scriptInstanceEntity) = scriptInstance.gid;
 	_registry.emplace<Transform>(scriptInstanceEntity) = Transform(scriptInstance.position,  scriptInstance.rotation);
+	_entities.emplace_back(scriptInstanceEntity);
 
-	spdlog::debug("Loading script instance {}", _gid->getString(scriptInstance.gid));
+	LOG_DEBUG("Loading script instance {}", _gid->getString(scriptInstance.gid));
 }
 
 void ObjectCollection::loadScript(const AWE::Object &container) {
 	const auto scriptInstanceScript = std::any_cast<AWE::Templates::Script>(container);
 
-	entt::entity scriptEntity = getEntityByGID(_registry, scriptInstanceScript.gid);
-	if (scriptEntity == entt::null)
-		throw std::runtime_error("Couldn't find script entity");
-
-	_registry.emplace<AWE::Script::BytecodePtr>(scriptEntity) = AWE::Script::BytecodePtr(_bytecode->createScript(
-			scriptInstanceScript.script));
+	attachScript(scriptInstanceScript.gid, scriptInstanceScript.script);
 
-	spdlog::debug("Loading script for object {}", _gid->getString(scriptInstanceScript.gid));
+	LOG_DEBUG("Loading script for object {}", _gid->getString(scriptInstanceScript.gid));
 }
 
 void ObjectCollection::loadFloatingScript(const AWE::Object &container) {
@@ -239,10 +611,11 @@ void ObjectCollection::loadFloatingScript(const AWE::Object &container) {
 	auto floatingScriptEntity = _registry.create();
 	_registry.emplace<GID>(floatingScriptEntity) = floatingScript.gid;
 	_registry.emplace<Transform>(floatingScriptEntity) = Transform(floatingScript.position, floatingScript.rotation);
-	_registry.emplace<AWE::Script::BytecodePtr>(floatingScriptEntity) = AWE::Script::BytecodePtr(
-			_bytecode->createScript(floatingScript.script));
+	attachScript(floatingScriptEntity, floatingScript.gid, floatingScript.script);
+
+	_entities.emplace_back(floatingScriptEntity);
 
-	spdlog::debug("Loading floating script {}", _gid->getString(floatingScript.gid));
+	LOG_DEBUG("Loading floating script {}", _gid->getString(floatingScript.gid));
 }
 
 void ObjectCollection::loadPointLight(const AWE::Object &container) {
@@ -251,8 +624,9 @@ void ObjectCollection::loadPointLight(const AWE::Object &container) {
 	auto pointLightEntity = _registry.create();
 	_registry.emplace<GID>(pointLightEntity) = pointLight.gid;
 	_registry.emplace<Transform>(pointLightEntity) = Transform(pointLight.position, pointLight.rotation);
+	_entities.emplace_back(pointLightEntity);
 
-	spdlog::debug("Loading point light {}", _gid->getString(pointLight.gid));
+	LOG_DEBUG("Loading point light {}", _gid->getString(pointLight.gid));
 }
 
 void ObjectCollection::loadAreaTrigger(const AWE::Object &container) {
@@ -261,17 +635,20 @@ void ObjectCollection::loadAreaTrigger(const AWE::Object &container) {
 	auto areaTriggerEntity = _registry.create();
 	_registry.emplace<GID>(areaTriggerEntity) = areaTrigger.gid;
 	_registry.emplace<Common::ConvexShape>(areaTriggerEntity) = areaTrigger.positions;
+	_entities.emplace_back(areaTriggerEntity);
 
-	spdlog::debug("Loading area trigger {}", areaTrigger.identifier);
+	LOG_DEBUG("Loading area trigger {}", Atoms.getString(areaTrigger.identifier));
 }
 
 void ObjectCollection::loadTaskDefinition(const AWE::Object &container) {
 	const auto taskDefinition = std::any_cast<AWE::Templates::TaskDefinition>(container);
 
-	auto taskEntity = _registry.create();
 	if (taskDefinition.gid.isNil())
 		return;
 
+	auto taskEntity = _registry.create();
+	_entities.emplace_back(taskEntity);
+
 	_registry.emplace<GID>(taskEntity) = taskDefinition.gid;
 	_registry.emplace<Transform>(taskEntity) = Transform(taskDefinition.position, taskDefinition.rotation);
 	_registry.emplace<Task>(taskEntity) = Task(
@@ -281,7 +658,7 @@ void ObjectCollection::loadTaskDefinition(const AWE::Object &container) {
 		taskDefinition.activateOnStartupRound
 	);
 
-	spdlog::debug("Loading task {}", _gid->getString(taskDefinition.gid));
+	LOG_DEBUG("Loading task {}", _gid->getString(taskDefinition.gid));
 }
 
 void ObjectCollection::loadWaypoint(const AWE::Object &container) {
@@ -290,8 +667,9 @@ void ObjectCollection::loadWaypoint(const AWE::Object &container) {
 	auto wayPointEntity = _registry.create();
 	_registry.emplace<GID>(wayPointEntity) = wayPoint.gid;
 	_registry.emplace<Transform>(wayPointEntity) = Transform(wayPoint.position, wayPoint.rotation);
+	_entities.emplace_back(wayPointEntity);
 
-	spdlog::debug("Loading way point {}", _gid->getString(wayPoint.gid));
+	LOG_DEBUG("Loading way point {}", _gid->getString(wayPoint.gid));
 }
 
 void ObjectCollection::loadSound(const AWE::Object &container) {
@@ -299,9 +677,10 @@ void ObjectCollection::loadSound(const AWE::Object &container) {
 
 	auto soundEntity = _registry.create();
 	_registry.emplace<GID>(soundEntity) = sound.gid;
+	_entities.emplace_back(soundEntity);
 	// TODO
 
-	spdlog::debug("Loading sound {}", _gid->getString(sound.gid));
+	LOG_DEBUG("Loading sound {}", _gid->getString(sound.gid));
 }
 
 void ObjectCollection::loadTrigger(const AWE::Object &container) {
@@ -312,7 +691,7 @@ void ObjectCollection::loadTrigger(const AWE::Object &container) {
 
 	_entities.emplace_back(triggerEntity);
 
-	spdlog::debug("Loading trigger {}", _gid->getString(trigger.gid));
+	LOG_DEBUG("Loading trigger {}", _gid->getString(trigger.gid));
 }
 
 void ObjectCollection::loadCharacterClass(const AWE::Object &container) {
@@ -324,7 +703,7 @@ void ObjectCollection::loadCharacterClass(const AWE::Object &container) {
 
 	_entities.emplace_back(characterClassEntity);
 
-	spdlog::debug("Loading character class {}", _gid->getString(characterClass.gid));
+	LOG_DEBUG("Loading character class {}", _gid->getString(characterClass.gid));
 }
 
 void ObjectCollection::loadKeyFramedObject(const AWE::Object &container) {
@@ -333,14 +712,11 @@ void ObjectCollection::loadKeyFramedObject(const AWE::Object &container) {
 	auto keyFramedObjectEntity = _registry.create();
 	_registry.emplace<GID>(keyFramedObjectEntity) = keyFramedObject.gid;
 	_registry.emplace<Transform>(keyFramedObjectEntity) = Transform(keyFramedObject.position2, keyFramedObject.rotation2);
-	Graphics::ModelPtr model = _registry.emplace<Graphics::ModelPtr>(keyFramedObjectEntity) = std::make_shared<Graphics::Model>(keyFramedObject.meshResource);
+	createModel(keyFramedObjectEntity, keyFramedObject.meshResource, keyFramedObject.position2, keyFramedObject.rotation2);
 	// TODO: Physics Resource
 
-	model->getPosition() = keyFramedObject.position2;
-	model->getRotation() = keyFramedObject.rotation2;
-
 
 	_entities.emplace_back(keyFramedObjectEntity);
 
-	spdlog::debug("Loading dynamic object {}", _gid->getString(keyFramedObject.gid));
+	LOG_DEBUG("Loading dynamic object {}", _gid->getString(keyFramedObject.gid));
 }
@@ -21,22 +21,108 @@
 #ifndef OPENAWE_OBJECTCOLLECTION_H
 #define OPENAWE_OBJECTCOLLECTION_H
 
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <entt/entt.hpp>
+#include <glm/glm.hpp>
 
+#include "src/common/memorytracker.h"
 #include "src/common/readstream.h"
+#include "src/common/writestream.h"
 
 #include "src/awe/script/collection.h"
 #include "src/awe/gidregistryfile.h"
 #include "src/awe/cidfile.h"
 
+#include "src/spatialindex.h"
+
+/*!
+ * \brief Reference to the mesh of a model which is not created yet
+ *
+ * Collections loaded into a staging registry store this component instead
+ * of a model, since models can only be created on the main thread. Restored
+ * collections store it as well, their models are created afterwards with
+ * ObjectCollection::createModels().
+ */
+struct ModelReference {
+	std::optional<rid_t> rid;
+	std::string path;
+	glm::vec3 position;
+	glm::mat3 rotation;
+};
+
 class ObjectCollection {
 public:
+	/*!
+	 * A list of resource paths together with the hash of their contents
+	 */
+	typedef std::vector<std::pair<std::string, uint32_t>> Inputs;
+
 	virtual ~ObjectCollection();
 
+	/*!
+	 * Get the resources from which this collection was loaded together
+	 * with the hashes of their contents
+	 * \return the inputs of this collection
+	 */
+	virtual Inputs getInputs() const;
+
+	/*!
+	 * Write the entities of this collection with their components into a
+	 * snapshot, from which they can be restored without loading the original
+	 * resources again. The data is written in the native byte order, since
+	 * snapshots are only meant as a local cache.
+	 * \param snapshot the stream to write the snapshot to
+	 */
+	void save(Common::WriteStream &snapshot) const;
+
+	/*!
+	 * Create the models of entities which only reference their mesh, like
+	 * the entities of restored collections. This has to be called on the main
+	 * thread before the collections are added to a spatial index.
+	 * \param registry the registry containing the entities
+	 * \param maxModels the maximum number of models to create
+	 * \return the number of created models
+	 */
+	static size_t createModels(entt::registry &registry, size_t maxModels);
+
+	/*!
+	 * Add the entities of this collection to a spatial index, if they are
+	 * not part of one yet. The entities are removed from it again when the
+	 * collection is destroyed.
+	 * \param spatialIndex the spatial index to add the entities to
+	 */
+	void addToSpatialIndex(SpatialIndex &spatialIndex);
+
+	/*!
+	 * Remove the entities of this collection from the spatial index they were added to
+	 */
+	void removeFromSpatialIndex();
+
 protected:
-	ObjectCollection(entt::registry &registry);
+	/*!
+	 * Create a new object collection
+	 * \param registry the registry in which the entities are created
+	 * \param staging if the collection is loaded outside of the main thread into a staging registry
+	 */
+	ObjectCollection(entt::registry &registry, bool staging = false);
+
+	/*!
+	 * Get a resource from the resource manager and record it together with
+	 * the hash of its contents as an input of this collection
+	 * \param path the path of the resource
+	 * \return the resource or nullptr if it doesn't exist
+	 */
+	Common::ReadStream *getResource(const std::string &path);
+
+	/*!
+	 * Restore the entities of this collection from a snapshot written by save()
+	 * \param snapshot the stream to read the snapshot from
+	 */
+	void restore(Common::ReadStream &snapshot);
 
 	void loadGIDRegistry(Common::ReadStream *stream);
 	void loadBytecode(Common::ReadStream *bytecode, Common::ReadStream *bytecodeParameters);
@@ -46,10 +132,26 @@ protected:
 
 	void loadFoliageData(Common::ReadStream *foliageData);
 
+	void load(const AWE::Object &container, ObjectType type);
+	void loadFoliage(const std::string &mesh, const glm::vec3 &position);
+
+	/*!
+	 * Destroy the most recently created entities of this collection
+	 * \param maxEntities the maximum number of entities to destroy
+	 * \return the number of destroyed entities
+	 */
+	size_t destroyEntities(size_t maxEntities);
+
+	/*!
+	 * Get the number of entities created by this collection
+	 * \return the number of entities
+	 */
+	size_t getNumEntities() const;
+
 	entt::registry &_registry;
+	const bool _staging;
 
 private:
-	void load(const AWE::Object &container, ObjectType type);
 
 	void loadSkeleton(const AWE::Object &container);
 	void loadAnimation(const AWE::Object &container);
@@ -70,7 +172,23 @@ private:
 	void loadCharacterClass(const AWE::Object &container);
 	void loadKeyFramedObject(const AWE::Object &container);
 
+	template<typename Mesh>
+	void createModel(entt::entity entity, const Mesh &mesh, const glm::vec3 &position, const glm::mat3 &rotation);
+	void attachScript(entt::entity entity, GID gid, const AWE::Templates::ScriptVariables &script);
+	void attachScript(GID gid, const AWE::Templates::ScriptVariables &script);
+
+	struct ScriptAttachment {
+		GID gid;
+		AWE::Templates::ScriptVariables script;
+	};
+
 	std::vector<entt::entity> _entities;
+	std::vector<ScriptAttachment> _scripts;
+	SpatialIndex *_spatialIndex;
+	std::vector<byte> _bytecodeData, _bytecodeParametersData;
+	Common::TrackedMemory _bytecodeMemory;
+	Inputs _inputs;
+
 	std::unique_ptr<AWE::GIDRegistryFile> _gid;
 	std::unique_ptr<AWE::Script::Collection> _bytecode;
 };
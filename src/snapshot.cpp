@@ -0,0 +1,94 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "src/common/platform.h"
+#include "src/common/profiler.h"
+#include "src/common/types.h"
+#include "src/common/writefile.h"
+
+#include "src/awe/resman.h"
+
+#include "src/snapshot.h"
+
+static const uint32_t kSnapshotMagic = MKTAG('A', 'W', 'S', 'S');
+static const uint32_t kSnapshotVersion = 5;
+
+std::string Snapshot::getPath(const std::string &world, const std::string &episode) {
+	return fmt::format("{}/openawe/snapshots/{}_{}.bin", Common::getUserDataDirectory(), world, episode);
+}
+
+void Snapshot::write(const std::string &file, const Episode &episode) {
+	PROFILE_ZONE("Snapshot::write");
+	std::filesystem::create_directories(std::filesystem::path(file).parent_path());
+
+	// Write into a temporary file first, so that an interrupted write never leaves a broken snapshot
+	const std::string temporaryFile = file + ".tmp";
+	{
+		Common::WriteFile snapshot(temporaryFile);
+
+		snapshot.writeUint32BE(kSnapshotMagic);
+		snapshot.writeUint32LE(kSnapshotVersion);
+
+		const auto inputs = episode.getInputs();
+		snapshot.writeUint32LE(inputs.size());
+		for (const auto &[path, hash] : inputs) {
+			snapshot.writeUint32LE(path.size());
+			snapshot.writeString(path);
+			snapshot.writeUint32LE(hash);
+		}
+
+		episode.save(snapshot);
+	}
+
+	std::filesystem::rename(temporaryFile, file);
+}
+
+Snapshot::Snapshot(const std::string &file) : _file(file) {
+	if (_file.readUint32BE() != kSnapshotMagic)
+		throw std::runtime_error("Invalid snapshot file");
+	if (_file.readUint32LE() != kSnapshotVersion)
+		throw std::runtime_error("Unsupported snapshot version");
+
+	const uint32_t numInputs = _file.readUint32LE();
+	_inputs.resize(numInputs);
+	for (auto &[path, hash] : _inputs) {
+		path = _file.readFixedSizeString(_file.readUint32LE());
+		hash = _file.readUint32LE();
+	}
+}
+
+bool Snapshot::isUpToDate() const {
+	for (const auto &[path, hash] : _inputs) {
+		uint32_t currentHash;
+		if (!ResMan.getResourceHash(path, currentHash) || currentHash != hash)
+			return false;
+	}
+
+	return true;
+}
+
+Common::ReadStream &Snapshot::getStream() {
+	return _file;
+}
@@ -0,0 +1,80 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_SNAPSHOT_H
+#define OPENAWE_SNAPSHOT_H
+
+#include <string>
+
+#include "src/common/mappedfile.h"
+
+#include "src/episode.h"
+
+/*!
+ * \brief Binary snapshot of a loaded episode
+ *
+ * A snapshot contains the entities and components of an episode and its
+ * levels, so that the episode can be restored without parsing the gid
+ * registries, dp files, bytecode and cid files again. Every snapshot stores
+ * the hashes of the resources it was created from and is only considered up
+ * to date as long as these hashes match the current game data.
+ */
+class Snapshot {
+public:
+	/*!
+	 * Get the path under which the snapshot of an episode is cached
+	 * \param world the world of the episode
+	 * \param episode the id of the episode
+	 * \return the path to the snapshot file
+	 */
+	static std::string getPath(const std::string &world, const std::string &episode);
+
+	/*!
+	 * Write a snapshot of an episode
+	 * \param file the path of the snapshot file
+	 * \param episode the episode to write the snapshot of
+	 */
+	static void write(const std::string &file, const Episode &episode);
+
+	/*!
+	 * Open a snapshot file by mapping it into memory
+	 * \param file the path of the snapshot file
+	 */
+	explicit Snapshot(const std::string &file);
+
+	/*!
+	 * Check if the resources from which this snapshot was created are unchanged
+	 * \return if the snapshot is up to date
+	 */
+	bool isUpToDate() const;
+
+	/*!
+	 * Get the stream containing the episode data of the snapshot
+	 * \return the stream positioned at the episode data
+	 */
+	Common::ReadStream &getStream();
+
+private:
+	Common::MappedFile _file;
+	ObjectCollection::Inputs _inputs;
+};
+
+
+#endif //OPENAWE_SNAPSHOT_H
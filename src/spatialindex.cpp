@@ -0,0 +1,166 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include "src/common/convexshape.h"
+#include "src/common/profiler.h"
+
+#include "src/awe/types.h"
+
+#include "src/graphics/model.h"
+
+#include "src/spatialindex.h"
+#include "src/transform.h"
+
+/*!
+ * The distance by which area triggers reach out of the plane of their outline
+ */
+static const float kAreaTriggerExtent = 1.0e5f;
+
+static Common::BoundBox getPointBox(const glm::vec3 &position) {
+	return Common::BoundBox{position.x, position.y, position.z, position.x, position.y, position.z};
+}
+
+SpatialIndex::SpatialIndex(entt::registry &registry) : _registry(registry), _numStaticEntities(0) {
+}
+
+void SpatialIndex::add(const ObjectCollection *collection, const std::vector<entt::entity> &entities) {
+	PROFILE_ZONE("SpatialIndex::add");
+	remove(collection);
+
+	Collection &index = _collections[collection];
+	std::vector<Common::BVH::Object> staticEntities;
+	for (const auto &entity : entities) {
+		const auto box = getBoundBox(entity);
+		if (!box)
+			continue;
+
+		if (_registry.all_of<GID, Graphics::ModelPtr>(entity))
+			index.dynamicEntities.emplace_back(_dynamicEntities.insert(*box, entt::to_integral(entity)));
+		else
+			staticEntities.emplace_back(*box, entt::to_integral(entity));
+	}
+
+	index.staticEntities = Common::BVH(staticEntities);
+	_numStaticEntities += index.staticEntities.size();
+}
+
+void SpatialIndex::remove(const ObjectCollection *collection) {
+	const auto iter = _collections.find(collection);
+	if (iter == _collections.end())
+		return;
+
+	for (const auto proxy : iter->second.dynamicEntities)
+		_dynamicEntities.remove(proxy);
+
+	_numStaticEntities -= iter->second.staticEntities.size();
+	_collections.erase(iter);
+}
+
+void SpatialIndex::update() {
+	PROFILE_ZONE("SpatialIndex::update");
+	size_t numMoved = 0;
+	for (const auto &[collection, index] : _collections) {
+		for (const auto proxy : index.dynamicEntities) {
+			const auto box = getBoundBox(static_cast<entt::entity>(_dynamicEntities.getValue(proxy)));
+			if (box && _dynamicEntities.move(proxy, *box))
+				numMoved++;
+		}
+	}
+
+	PROFILE_COUNTER("SpatialIndex::staticEntities", _numStaticEntities);
+	PROFILE_COUNTER("SpatialIndex::dynamicEntities", _dynamicEntities.size());
+	PROFILE_COUNTER("SpatialIndex::movedEntities", numMoved);
+}
+
+size_t SpatialIndex::getNumStaticEntities() const {
+	return _numStaticEntities;
+}
+
+size_t SpatialIndex::getNumDynamicEntities() const {
+	return _dynamicEntities.size();
+}
+
+void SpatialIndex::query(const Common::BoundBox &box, std::vector<entt::entity> &entities) const {
+	collect([&box](const auto &tree, std::vector<uint32_t> &values) { tree.query(box, values); }, entities);
+}
+
+void SpatialIndex::query(const Common::BoundSphere &sphere, std::vector<entt::entity> &entities) const {
+	collect([&sphere](const auto &tree, std::vector<uint32_t> &values) { tree.query(sphere, values); }, entities);
+}
+
+void SpatialIndex::query(const Common::Frustum &frustum, std::vector<entt::entity> &entities) const {
+	collect([&frustum](const auto &tree, std::vector<uint32_t> &values) { tree.query(frustum, values); }, entities);
+}
+
+void SpatialIndex::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, std::vector<entt::entity> &entities) const {
+	collect([&](const auto &tree, std::vector<uint32_t> &values) {
+		tree.raycast(origin, direction, maxDistance, values);
+	}, entities);
+}
+
+std::optional<Common::BoundBox> SpatialIndex::getBoundBox(entt::entity entity) const {
+	const auto *model = _registry.try_get<Graphics::ModelPtr>(entity);
+	if (model && *model) {
+		const Common::BoundSphere sphere = (*model)->getWorldBoundSphere();
+
+		// Meshes without bounds have an infinite sphere and are indexed by their position only
+		if (!std::isfinite(sphere.radius))
+			return getPointBox((*model)->getPosition());
+
+		return Common::BoundBox{
+			sphere.position.x - sphere.radius, sphere.position.y - sphere.radius, sphere.position.z - sphere.radius,
+			sphere.position.x + sphere.radius, sphere.position.y + sphere.radius, sphere.position.z + sphere.radius
+		};
+	}
+
+	const auto *shape = _registry.try_get<Common::ConvexShape>(entity);
+	if (shape && !shape->getPoints().empty()) {
+		// The outline lies in the plane ConvexShape::intersect() tests in, the trigger reaches far along the third axis
+		const auto &points = shape->getPoints();
+		Common::BoundBox box{points[0].x, points[0].y, -kAreaTriggerExtent, points[0].x, points[0].y, kAreaTriggerExtent};
+		for (const auto &point : points) {
+			box.xmin = std::min(box.xmin, point.x);
+			box.ymin = std::min(box.ymin, point.y);
+			box.xmax = std::max(box.xmax, point.x);
+			box.ymax = std::max(box.ymax, point.y);
+		}
+		return box;
+	}
+
+	const auto *transform = _registry.try_get<Transform>(entity);
+	if (transform)
+		return getPointBox(transform->getTranslation());
+
+	return std::nullopt;
+}
+
+template<typename Query>
+void SpatialIndex::collect(const Query &query, std::vector<entt::entity> &entities) const {
+	std::vector<uint32_t> values;
+	for (const auto &[collection, index] : _collections)
+		query(index.staticEntities, values);
+	query(_dynamicEntities, values);
+
+	entities.reserve(entities.size() + values.size());
+	for (const auto value : values)
+		entities.emplace_back(static_cast<entt::entity>(value));
+}
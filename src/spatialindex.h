@@ -0,0 +1,127 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_SPATIALINDEX_H
+#define OPENAWE_SPATIALINDEX_H
+
+#include <map>
+#include <optional>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include "src/common/aabbtree.h"
+#include "src/common/bvh.h"
+#include "src/common/frustum.h"
+#include "src/common/types.h"
+
+class ObjectCollection;
+
+/*!
+ * \brief Spatial index over the entities of the loaded object collections
+ *
+ * Collections like the world, episodes, levels and streamed cells are added
+ * as a whole once all their entities exist and removed before their entities
+ * are destroyed. Entities which never move, like static objects, foliage,
+ * point lights and area triggers, go into a bounding volume hierarchy built
+ * once per collection. Entities with a GID and a model can be moved by
+ * scripts and go into a dynamic tree shared by all collections, whose boxes
+ * are refreshed by update(). Entities without a model, transform or area
+ * shape have no position and are not indexed.
+ *
+ * Queries return every entity whose box passes the test, so callers still
+ * have to do exact tests, for example against the convex shape of an area
+ * trigger.
+ */
+class SpatialIndex {
+public:
+	explicit SpatialIndex(entt::registry &registry);
+
+	/*!
+	 * Add the entities of a collection to the index
+	 * \param collection the collection, which is used as key for removing the entities again
+	 * \param entities the entities of the collection
+	 */
+	void add(const ObjectCollection *collection, const std::vector<entt::entity> &entities);
+
+	/*!
+	 * Remove the entities of a collection from the index
+	 * \param collection the collection whose entities are removed
+	 */
+	void remove(const ObjectCollection *collection);
+
+	/*!
+	 * Update the boxes of the dynamic entities to their current position
+	 */
+	void update();
+
+	size_t getNumStaticEntities() const;
+	size_t getNumDynamicEntities() const;
+
+	/*!
+	 * Find the entities intersecting a box
+	 * \param box the box to test against
+	 * \param entities the vector to which the found entities are added
+	 */
+	void query(const Common::BoundBox &box, std::vector<entt::entity> &entities) const;
+
+	/*!
+	 * Find the entities intersecting a sphere
+	 * \param sphere the sphere to test against
+	 * \param entities the vector to which the found entities are added
+	 */
+	void query(const Common::BoundSphere &sphere, std::vector<entt::entity> &entities) const;
+
+	/*!
+	 * Find the entities inside or intersecting a view frustum
+	 * \param frustum the frustum to test against
+	 * \param entities the vector to which the found entities are added
+	 */
+	void query(const Common::Frustum &frustum, std::vector<entt::entity> &entities) const;
+
+	/*!
+	 * Find the entities hit by a ray in no particular order
+	 * \param origin the start of the ray
+	 * \param direction the normalized direction of the ray
+	 * \param maxDistance the length of the ray
+	 * \param entities the vector to which the found entities are added
+	 */
+	void raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, std::vector<entt::entity> &entities) const;
+
+private:
+	struct Collection {
+		Common::BVH staticEntities;
+		std::vector<Common::AABBTree::Proxy> dynamicEntities;
+	};
+
+	std::optional<Common::BoundBox> getBoundBox(entt::entity entity) const;
+
+	template<typename Query>
+	void collect(const Query &query, std::vector<entt::entity> &entities) const;
+
+	entt::registry &_registry;
+
+	std::map<const ObjectCollection *, Collection> _collections;
+	Common::AABBTree _dynamicEntities;
+	size_t _numStaticEntities;
+};
+
+#endif //OPENAWE_SPATIALINDEX_H
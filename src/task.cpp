@@ -22,11 +22,11 @@
 
 #include <utility>
 
-Task::Task() : _activateOnStartup(false), _active(false) {
+Task::Task() : _name(Common::kEmptyAtom), _activateOnStartup(false), _active(false) {
 
 }
 
-Task::Task(const std::string &name, const std::vector<GID> &playerCharacter, bool activateOnStartup, std::vector<bool> activateOnStartupRound) :
+Task::Task(Common::Atom name, const std::vector<GID> &playerCharacter, bool activateOnStartup, std::vector<bool> activateOnStartupRound) :
 	_name(name),
 	_activateOnStartup(activateOnStartup),
 	_activateOnStartupRound(std::move(activateOnStartupRound)),
@@ -34,8 +34,8 @@ Task::Task(const std::string &name, const std::vector<GID> &playerCharacter, boo
 	_active(false) {
 }
 
-const std::string &Task::getName() const {
-	return _name;
+std::string_view Task::getName() const {
+	return Atoms.getString(_name);
 }
 
 bool Task::isActiveOnStartup() const {
@@ -56,6 +56,14 @@ GID Task::getPlayerCharacter(unsigned int round) const {
 	return _playerCharacter[round];
 }
 
+const std::vector<GID> &Task::getPlayerCharacters() const {
+	return _playerCharacter;
+}
+
+const std::vector<bool> &Task::getActiveOnStartupRounds() const {
+	return _activateOnStartupRound;
+}
+
 void Task::activate() {
 	_active = true;
 }
@@ -22,7 +22,9 @@
 #define OPENAWE_TASK_H
 
 #include <vector>
-#include <string>
+#include <string_view>
+
+#include "src/common/atomtable.h"
 
 #include "src/awe/types.h"
 
@@ -39,13 +41,13 @@ public:
 
 	/*!
 	 * Create a new task
-	 * \param name The name of the task
+	 * \param name The interned name of the task
 	 * \param playerCharacter A vector of gids, which character is the player controlled one
 	 * \param activateOnStartup Activate the task on startup
 	 * \param activateOnStartupRound Activate the task on startup of a specific round
 	 */
 	Task(
-		const std::string &name,
+		Common::Atom name,
 		const std::vector<GID> &playerCharacter,
 		bool activateOnStartup,
 		std::vector<bool> activateOnStartupRound
@@ -56,7 +58,7 @@ public:
 	 * Get the name of the task
 	 * \return The name of the task
 	 */
-	const std::string &getName() const;
+	std::string_view getName() const;
 
 	/*!
 	 * If this task should be activated on startup
@@ -79,11 +81,23 @@ public:
 	 */
 	GID getPlayerCharacter(unsigned int round = 0) const;
 
+	/*!
+	 * Get the player characters for all rounds
+	 * \return A vector of gids of the player characters
+	 */
+	const std::vector<GID> &getPlayerCharacters() const;
+
+	/*!
+	 * Get for every round if this task should be activated on its startup
+	 * \return A vector with the activation flags of every round
+	 */
+	const std::vector<bool> &getActiveOnStartupRounds() const;
+
 	void activate();
 	void complete();
 
 private:
-	std::string _name;
+	Common::Atom _name;
 	bool _activateOnStartup;
 	std::vector<bool> _activateOnStartupRound;
 	std::vector<GID> _playerCharacter;
@@ -0,0 +1,86 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <set>
+
+#include <cxxopts.hpp>
+#include <spdlog/spdlog.h>
+#include <fmt/format.h>
+
+#include "src/common/readfile.h"
+
+#include "src/awe/binarchive.h"
+#include "src/awe/script/collection.h"
+
+#include "src/tools/scripts.h"
+
+int main(int argc, char** argv) {
+	cxxopts::Options options(argv[0], "Disassemble the script bytecode of a persistent or tasks archive");
+
+	options.add_options()
+		("i,input", "Set the archive to disassemble, for example Persistent.bin or tasks.bin", cxxopts::value<std::string>())
+		("h,help", "Print this help");
+
+	options.parse_positional({"input"});
+
+	auto result = options.parse(argc, argv);
+
+	if (result.count("help") || !result.count("input")) {
+		std::cout << options.help() << std::endl;
+		return result.count("help") ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	try {
+		Common::ReadFile archiveFile(result["input"].as<std::string>());
+		AWE::BINArchive archive(archiveFile);
+
+		if (!archive.hasResource("dp_bytecode.bin") || !archive.hasResource("dp_bytecodeparameters.bin"))
+			throw std::runtime_error("Archive doesn't contain any bytecode");
+
+		const Tools::Scripts scripts = Tools::loadScripts(archive);
+
+		AWE::Script::Collection collection(
+				archive.getResource("dp_bytecode.bin"),
+				archive.getResource("dp_bytecodeparameters.bin")
+		);
+
+		// Scripts sharing their code are only printed once
+		std::set<AWE::Script::ProgramPtr> printed;
+		for (const auto &[gid, script] : scripts) {
+			const auto program = collection.getProgram(script);
+			if (!printed.insert(program).second)
+				continue;
+
+			std::cout << fmt::format(
+					"; script {}:{:08x} at offset {:08x}, {} bytes\n",
+					gid.type, gid.id, script.offsetCode, script.codeSize
+			);
+			std::cout << program->disassemble() << std::endl;
+		}
+
+		spdlog::info("Disassembled {} programs of {} scripts", printed.size(), scripts.size());
+	} catch (const std::exception &e) {
+		spdlog::critical(e.what());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,272 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <regex>
+
+#include <cxxopts.hpp>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "src/common/writefile.h"
+
+#include "src/awe/binarchive.h"
+#include "src/awe/gidregistryfile.h"
+#include "src/awe/resman.h"
+#include "src/awe/script/bytecode.h"
+#include "src/awe/script/collection.h"
+#include "src/awe/script/context.h"
+#include "src/awe/script/functions.h"
+#include "src/awe/script/tracer.h"
+
+#include "src/engines/awan/engine.h"
+
+#include "src/tools/scripts.h"
+
+// The entry points run by the game when starting an episode, in the order they are run. The game only runs
+// OnTaskActivate on the tasks which are active on startup, the harness doesn't load tasks and runs it on every script
+static const char *const kEntryPoints[] = {"OnInit", "OnTaskActivate"};
+
+// The number of differences between the trace and the golden file which are reported
+static const size_t kMaxReportedDifferences = 10;
+
+/*!
+ * Index all rmdp archives of a directory, like the game does
+ */
+static void indexArchives(const std::string &path) {
+	for (const auto &entry : std::filesystem::directory_iterator(path)) {
+		if (!entry.is_regular_file() || entry.path().extension() != ".rmdp")
+			continue;
+
+		const std::string rmdpFile = entry.path().string();
+		const std::string binFile = std::regex_replace(rmdpFile, std::regex("\\.rmdp$"), ".bin");
+
+		spdlog::info("Indexing archive {}", entry.path().filename().string());
+		ResMan.indexArchive(binFile, rmdpFile);
+	}
+}
+
+static Common::ReadStream *getResource(const std::string &path) {
+	Common::ReadStream *stream = ResMan.getResource(path);
+	if (!stream)
+		throw std::runtime_error(fmt::format("Couldn't find resource {}", path));
+	return stream;
+}
+
+/*!
+ * Compare the trace with a golden file and report the first differences
+ * \return the number of differing lines
+ */
+static size_t compareTrace(const std::vector<std::string> &calls, const std::string &goldenFile) {
+	std::ifstream golden(goldenFile);
+	if (!golden)
+		throw std::runtime_error(fmt::format("Couldn't open golden file {}", goldenFile));
+
+	std::vector<std::string> expected;
+	for (std::string line; std::getline(golden, line);) {
+		expected.emplace_back(line);
+	}
+
+	size_t differences = 0;
+	for (size_t i = 0; i < std::max(calls.size(), expected.size()); ++i) {
+		const std::string &actualCall = i < calls.size() ? calls[i] : "<end of trace>";
+		const std::string &expectedCall = i < expected.size() ? expected[i] : "<end of trace>";
+		if (actualCall == expectedCall)
+			continue;
+
+		if (differences++ < kMaxReportedDifferences)
+			spdlog::error("Line {}: expected {} but got {}", i + 1, expectedCall, actualCall);
+	}
+
+	return differences;
+}
+
+int main(int argc, char** argv) {
+	cxxopts::Options options(argv[0], "Run the scripts of an episode without graphics and sound and record their native calls");
+
+	options.add_options()
+		("d,data", "Set the directory containing the archives of the game", cxxopts::value<std::string>()->default_value("."))
+		("w,world", "Set the world of the episode", cxxopts::value<std::string>()->default_value(""))
+		("e,episode", "Set the episode to run the scripts of, otherwise the scripts generated by awe_datagen are run", cxxopts::value<std::string>())
+		("i,iterations", "Set how often all entry points are run to measure the throughput", cxxopts::value<unsigned int>()->default_value("10"))
+		("engine", "Set the engine whose native functions scripts call, none or awan", cxxopts::value<std::string>()->default_value("none"))
+		("seed", "Set the seed of the random functions of scripts", cxxopts::value<uint32_t>()->default_value("1"))
+		("t,trace", "Write the native calls of the first run to a file", cxxopts::value<std::string>())
+		("g,golden", "Compare the native calls of the first run with a file", cxxopts::value<std::string>())
+		("h,help", "Print this help");
+
+	auto result = options.parse(argc, argv);
+
+	if (result.count("help")) {
+		std::cout << options.help() << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	try {
+		indexArchives(result["data"].as<std::string>());
+
+		// Only the gid names, the bytecode and the scripts are loaded, not the objects the scripts belong to
+		std::unique_ptr<AWE::GIDRegistryFile> gidRegistry;
+		std::unique_ptr<AWE::Script::Collection> collection;
+		Tools::Scripts scripts;
+		if (result.count("episode")) {
+			const std::string episodeFolder = fmt::format(
+					"worlds/{}/episodes/{}",
+					result["world"].as<std::string>(),
+					result["episode"].as<std::string>()
+			);
+
+			std::unique_ptr<Common::ReadStream> gidStream(getResource(episodeFolder + "/GIDRegistry.txt"));
+			gidRegistry = std::make_unique<AWE::GIDRegistryFile>(*gidStream);
+
+			// TODO: Alan Wake has several archives without a proper pattern
+			const std::string tasksFile = ResMan.hasResource(episodeFolder + "/tasks.bin") ? "tasks.bin" : "root.bin";
+			std::unique_ptr<Common::ReadStream> tasksStream(getResource(fmt::format("{}/{}", episodeFolder, tasksFile)));
+			AWE::BINArchive tasks(*tasksStream);
+
+			collection = std::make_unique<AWE::Script::Collection>(
+					tasks.getResource("dp_bytecode.bin"),
+					tasks.getResource("dp_bytecodeparameters.bin")
+			);
+			scripts = Tools::loadScripts(tasks);
+		} else {
+			std::unique_ptr<Common::ReadStream> gidStream(getResource("GIDRegistry.txt"));
+			gidRegistry = std::make_unique<AWE::GIDRegistryFile>(*gidStream);
+
+			collection = std::make_unique<AWE::Script::Collection>(
+					getResource("scripts/bytecode.dp"),
+					getResource("scripts/bytecodeparameters.dp")
+			);
+			Tools::loadScripts<AWE::Templates::Script>(getResource("scripts/scripts.cid"), kScript, nullptr, scripts);
+		}
+
+		entt::registry registry;
+		std::vector<std::pair<entt::entity, AWE::Script::BytecodePtr>> bytecodes;
+		for (const auto &[gid, script] : scripts) {
+			const entt::entity entity = registry.create();
+			registry.emplace<GID>(entity) = gid;
+			const auto &bytecode = registry.emplace<AWE::Script::BytecodePtr>(entity) = AWE::Script::BytecodePtr(collection->createScript(script));
+			bytecodes.emplace_back(entity, bytecode);
+		}
+
+		spdlog::info("Loaded {} scripts with {} programs", bytecodes.size(), collection->getNumPrograms());
+
+		// The engines provide the game specific functions, without an engine only the common functions are bound
+		const std::string engineName = result["engine"].as<std::string>();
+		std::unique_ptr<Engine> engine;
+		std::unique_ptr<AWE::Script::Functions> commonFunctions;
+		if (engineName == "awan")
+			engine = std::make_unique<Engines::AlanWakesAmericanNightmare::Engine>(registry);
+		else if (engineName == "none")
+			commonFunctions = std::make_unique<AWE::Script::Functions>(registry);
+		else
+			throw std::runtime_error(fmt::format("Invalid engine {}", engineName));
+
+		AWE::Script::Functions &functions = engine ? engine->getFunctions() : *commonFunctions;
+		functions.setSeed(result["seed"].as<uint32_t>());
+
+		AWE::Script::Context context(registry, functions);
+		context.linkScripts();
+
+		size_t numRuns = 0, numErrors = 0;
+		const auto runAll = [&](bool first) {
+			for (const auto entryPoint : kEntryPoints) {
+				for (const auto &[entity, bytecode] : bytecodes) {
+					if (!bytecode->hasEntryPoint(entryPoint))
+						continue;
+
+					try {
+						bytecode->run(context, entryPoint, entity);
+					} catch (const std::exception &e) {
+						// Failing scripts fail the same way in every iteration
+						if (first) {
+							spdlog::error("{} of {} failed: {}", entryPoint, entt::to_integral(entity), e.what());
+							numErrors++;
+						}
+					}
+					numRuns++;
+				}
+			}
+		};
+
+		// Only the first run is traced, so that tracing doesn't affect the measured throughput
+		AWE::Script::Tracer tracer(registry, gidRegistry.get());
+		context.setTracer(&tracer);
+		runAll(true);
+		context.setTracer(nullptr);
+
+		const size_t runsPerIteration = numRuns;
+		const unsigned int iterations = result["iterations"].as<unsigned int>();
+
+		uint64_t instructions = 0;
+		for (const auto &[entity, bytecode] : bytecodes) {
+			instructions -= bytecode->getNumExecutedInstructions();
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < iterations; ++i) {
+			runAll(false);
+		}
+		const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+		for (const auto &[entity, bytecode] : bytecodes) {
+			instructions += bytecode->getNumExecutedInstructions();
+		}
+
+		spdlog::info(
+				"Ran {} entry points {} times in {:.3f} ms, {:.0f} entry points and {:.0f} instructions per second",
+				runsPerIteration,
+				iterations,
+				duration.count() * 1000.0,
+				duration.count() > 0.0 ? (numRuns - runsPerIteration) / duration.count() : 0.0,
+				duration.count() > 0.0 ? instructions / duration.count() : 0.0
+		);
+		spdlog::info("Recorded {} native calls in the first run", tracer.getNumCalls());
+
+		if (result.count("trace")) {
+			Common::WriteFile traceFile(result["trace"].as<std::string>());
+			tracer.save(traceFile);
+		}
+
+		if (result.count("golden")) {
+			const size_t differences = compareTrace(tracer.getCalls(), result["golden"].as<std::string>());
+			if (differences > 0) {
+				spdlog::error("The native calls differ from the golden file in {} lines", differences);
+				return EXIT_FAILURE;
+			}
+
+			spdlog::info("The native calls match the golden file");
+		}
+
+		if (numErrors > 0) {
+			spdlog::error("{} entry points failed", numErrors);
+			return EXIT_FAILURE;
+		}
+	} catch (const std::exception &e) {
+		spdlog::critical(e.what());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
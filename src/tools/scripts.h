@@ -0,0 +1,89 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENAWE_TOOLS_SCRIPTS_H
+#define OPENAWE_TOOLS_SCRIPTS_H
+
+#include <any>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "src/awe/binarchive.h"
+#include "src/awe/cidfile.h"
+#include "src/awe/dpfile.h"
+#include "src/awe/object.h"
+#include "src/awe/types.h"
+
+namespace Tools {
+
+typedef std::vector<std::pair<GID, AWE::Templates::ScriptVariables>> Scripts;
+
+/*!
+ * Add the gids and variables of all scripts in a cid file
+ * \param cid the cid file containing the scripts, which is deleted afterwards, or nullptr to add nothing
+ * \param type the type of the objects in the cid file
+ * \param dp the data pool of the cid file
+ * \param scripts the scripts to add to
+ */
+template<typename T>
+void loadScripts(Common::ReadStream *cid, ObjectType type, const std::shared_ptr<DPFile> &dp, Scripts &scripts) {
+	if (!cid)
+		return;
+
+	std::unique_ptr<Common::ReadStream> stream(cid);
+	AWE::CIDFile file(*stream, type, dp);
+	for (const auto &container : file.getContainers()) {
+		const auto object = std::any_cast<T>(container);
+		scripts.emplace_back(object.gid, object.script);
+	}
+}
+
+/*!
+ * Get the scripts of all objects in a persistent or tasks archive
+ * \param archive the archive containing the objects
+ * \return the gids and variables of the scripts in the order the game loads them
+ */
+inline Scripts loadScripts(const AWE::BINArchive &archive) {
+	// Levels store their objects in dp_persistent.bin, episodes in dp_task.bin
+	std::shared_ptr<DPFile> dp;
+	if (archive.hasResource("dp_persistent.bin"))
+		dp = std::make_shared<DPFile>(archive.getResource("dp_persistent.bin"));
+	else if (archive.hasResource("dp_task.bin"))
+		dp = std::make_shared<DPFile>(archive.getResource("dp_task.bin"));
+	else
+		throw std::runtime_error("Archive doesn't contain a data pool for its objects");
+
+	Scripts scripts;
+	loadScripts<AWE::Templates::DynamicObjectScript>(archive.getResource("cid_dynamicobjectscript.bin"), kDynamicObjectScript, dp, scripts);
+	loadScripts<AWE::Templates::CharacterScript>(archive.getResource("cid_characterscript.bin"), kCharacterScript, dp, scripts);
+	loadScripts<AWE::Templates::Script>(archive.getResource("cid_scriptinstancescript.bin"), kScript, dp, scripts);
+	loadScripts<AWE::Templates::FloatingScript>(archive.getResource("cid_floatingscript.bin"), kFloatingScript, dp, scripts);
+	loadScripts<AWE::Templates::Script>(archive.getResource("cid_triggerscript.bin"), kScript, dp, scripts);
+	loadScripts<AWE::Templates::Script>(archive.getResource("cid_areatriggerscript.bin"), kScript, dp, scripts);
+	loadScripts<AWE::Templates::Script>(archive.getResource("cid_taskscript.bin"), kScript, dp, scripts);
+	loadScripts<AWE::Templates::Script>(archive.getResource("cid_waypointscript.bin"), kScript, dp, scripts);
+
+	return scripts;
+}
+
+} // End of namespace Tools
+
+#endif // OPENAWE_TOOLS_SCRIPTS_H
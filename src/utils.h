@@ -26,7 +26,7 @@
 #include "src/awe/types.h"
 
 entt::entity getEntityByGID(entt::registry &registry, GID gid) {
-	static const auto gidView = registry.view<GID>();
+	const auto gidView = registry.view<GID>();
 	entt::entity finalEntity = entt::null;
 	for (const auto &entity : gidView) {
 		GID g = registry.get<GID>(entity);
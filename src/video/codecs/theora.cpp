@@ -240,7 +240,7 @@ Graphics::Surface * Theora::getNextFrame() {
 
 	switch (_pixelFormat) {
 		case TH_PF_420:
-			decodeYUV420(yuv, frame);
+			decodeYUV420(yuv, _picX, _picY, _width, _height, reinterpret_cast<byte *>(frame->getData(0)));
 			break;
 		default:
 			throw std::runtime_error("Invalid or unsupported pixel format");
@@ -303,26 +303,30 @@ void Theora::getNextAudio(Sound::Buffer &buffer, unsigned int stream) {
 	);
 }
 
-void Theora::decodeYUV420(th_img_plane *ycbcr, Graphics::Surface *surface) {
+void Theora::decodeYUV420(
+	const th_img_plane *ycbcr,
+	unsigned int picX, unsigned int picY,
+	unsigned int width, unsigned int height,
+	byte *dst
+) {
 	// Conversion taken from:
 	// http://hg.icculus.org/icculus/theoraplay/file/tip/theoraplay_cvtrgb.h
 
-	auto *dst = reinterpret_cast<byte*>(surface->getData(0));
 	const int ystride = ycbcr[0].stride;
 	const int cbstride = ycbcr[1].stride;
 	const int crstride = ycbcr[2].stride;
-	const int yoff = (_picX & ~1) + ystride * (_picY & ~1);
-	const int cboff = (_picX / 2) + (cbstride) * (_picY / 2);
+	const int yoff = (picX & ~1) + ystride * (picY & ~1);
+	const int cboff = (picX / 2) + (cbstride) * (picY / 2);
 	const byte *py = ycbcr[0].data + yoff;
 	const byte *pcb = ycbcr[1].data + cboff;
 	const byte *pcr = ycbcr[2].data + cboff;
 
-	for (int posy = 0; posy < _height; posy++)
+	for (int posy = 0; posy < height; posy++)
 	{
 		int posx, poshalfx;
 
 		posx = 0;
-		for (poshalfx = 0; poshalfx < (_width / 2); poshalfx++, posx += 2)
+		for (poshalfx = 0; poshalfx < (width / 2); poshalfx++, posx += 2)
 		{
 			const byte y1 = py[posx];
 			const byte y2 = py[posx + 1];
@@ -30,6 +30,23 @@ public:
 
 	void getNextAudio(Sound::Buffer &buffer, unsigned int stream) override;
 
+	/*!
+	 * Convert a planar YUV 4:2:0 image into packed RGB
+	 *
+	 * \param ycbcr The three planes of the image
+	 * \param picX The x offset of the picture inside the planes
+	 * \param picY The y offset of the picture inside the planes
+	 * \param width The width of the picture
+	 * \param height The height of the picture
+	 * \param dst The destination buffer with at least width * height * 3 bytes
+	 */
+	static void decodeYUV420(
+		const th_img_plane *ycbcr,
+		unsigned int picX, unsigned int picY,
+		unsigned int width, unsigned int height,
+		byte *dst
+	);
+
 private:
 	struct VideoStream {
 		ogg_stream_state _videoStream;
@@ -43,8 +60,6 @@ private:
 		vorbis_info info;
 	};
 
-	void decodeYUV420(th_ycbcr_buffer, Graphics::Surface *);
-
 	void queuePage(ogg_page *page);
 	void bufferData();
 
@@ -18,8 +18,11 @@
  * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <assert.h>
+#include <filesystem>
 #include <iostream>
+#include <limits>
 #include <memory>
 
 #include <spdlog/spdlog.h>
@@ -37,9 +40,13 @@
 #include "src/awe/havokfile.h"
 #include "src/awe/script/collection.h"
 
-World::World(entt::registry &registry, const std::string &name) :
-	ObjectCollection(registry),
-	_name(name)
+#include "src/snapshot.h"
+#include "src/common/profiler.h"
+
+World::World(entt::registry &registry, const std::string &name, bool staging) :
+	ObjectCollection(registry, staging),
+	_name(name),
+	_useSnapshots(false)
 {
 	std::string filename = fmt::format("globaldb/{}.xml", _name);
 
@@ -56,7 +63,12 @@ const std::string &World::getName() const {
 	return _name;
 }
 
+void World::setUseSnapshots(bool useSnapshots) {
+	_useSnapshots = useSnapshots;
+}
+
 void World::loadGlobal() {
+	PROFILE_ZONE("World::loadGlobal");
 	spdlog::info("Loading global data from {}", _name);
 	std::string globalFolder = fmt::format("worlds/{}/episodes/global", _name);
 
@@ -91,12 +103,131 @@ void World::loadGlobal() {
 	load(tasks.getResource("cid_characterscript.bin"), kCharacterScript, dp);
 }
 
-void World::loadEpisode(const std::string &id) {
+bool World::loadEpisode(const std::string &id) {
 	spdlog::info("Loading episode {} from {}", id, _name);
 	WorldFile::Level level = _world->getLevel(id);
 
-	_currentEpisode = std::make_unique<Episode>(_registry, _name, id);
+	std::vector<std::unique_ptr<Level>> levels = releaseLevels(id);
+
+	const std::string snapshotFile = Snapshot::getPath(_name, id);
+	if (_useSnapshots && loadEpisodeSnapshot(id, snapshotFile, levels))
+		return true;
+
+	_currentEpisode = std::make_unique<Episode>(_registry, _name, id, _staging);
 	for (const auto &fileName : level.fileNames) {
-		_currentEpisode->loadLevel(fileName);
+		_currentEpisode->loadLevel(fileName, levels);
 	}
+
+	if (_useSnapshots) {
+		spdlog::info("Writing snapshot of episode {} to {}", id, snapshotFile);
+		try {
+			Snapshot::write(snapshotFile, *_currentEpisode);
+		} catch (std::exception &e) {
+			spdlog::warn("Couldn't write snapshot of episode {}: {}", id, e.what());
+		}
+	}
+
+	return false;
+}
+
+void World::saveEpisode(Common::WriteStream &stream) const {
+	if (!_currentEpisode)
+		throw std::runtime_error("No episode loaded");
+
+	_currentEpisode->save(stream);
+}
+
+std::vector<std::string> World::getLevelFileNames(const std::string &id) const {
+	return _world->getLevel(id).fileNames;
+}
+
+void World::restoreGlobal(Common::ReadStream &stream) {
+	restore(stream);
+}
+
+void World::restoreEpisode(const std::string &id, Common::ReadStream &stream) {
+	std::vector<std::unique_ptr<Level>> levels = releaseLevels(id);
+	restoreEpisode(id, stream, levels);
+}
+
+std::vector<std::string> World::getLoadedLevels() const {
+	if (!_currentEpisode)
+		return {};
+	return _currentEpisode->getLevelIds();
+}
+
+std::vector<std::unique_ptr<Level>> World::releaseLevels(const std::string &id) {
+	if (!_currentEpisode)
+		return {};
+
+	std::vector<std::unique_ptr<Level>> levels = _currentEpisode->releaseLevels();
+	_currentEpisode.reset();
+
+	// Unload the levels which are not used by the next episode before anything new is loaded
+	const auto fileNames = getLevelFileNames(id);
+	levels.erase(std::remove_if(levels.begin(), levels.end(), [&](const auto &level){
+		return std::find(fileNames.begin(), fileNames.end(), level->getId()) == fileNames.end();
+	}), levels.end());
+
+	spdlog::info("Keeping {} levels for episode {}", levels.size(), id);
+
+	return levels;
+}
+
+void World::restoreEpisode(const std::string &id, Common::ReadStream &stream, std::vector<std::unique_ptr<Level>> &levels) {
+	_currentEpisode.reset();
+	_currentEpisode = std::make_unique<Episode>(_registry, _name, id, stream, levels, _staging);
+
+	// Levels which were expected to be reused, but are not loaded anymore, are loaded now
+	for (const auto &fileName : getLevelFileNames(id)) {
+		if (!_currentEpisode->hasLevel(fileName))
+			_currentEpisode->loadLevel(fileName, levels);
+	}
+}
+
+void World::setStreamingRadius(float highDetailRadius, float lowDetailRadius) {
+	if (_currentEpisode)
+		_currentEpisode->setStreamingRadius(highDetailRadius, lowDetailRadius);
+}
+
+void World::setCellSize(float cellSize) {
+	if (_currentEpisode)
+		_currentEpisode->setCellSize(cellSize);
+}
+
+void World::update(const glm::vec3 &cameraPosition, SpatialIndex &spatialIndex) {
+	addToSpatialIndex(spatialIndex);
+	if (_currentEpisode)
+		_currentEpisode->update(cameraPosition, spatialIndex);
+}
+
+bool World::loadEpisodeSnapshot(const std::string &id, const std::string &snapshotFile, std::vector<std::unique_ptr<Level>> &levels) {
+	if (!std::filesystem::is_regular_file(snapshotFile))
+		return false;
+
+	try {
+		Snapshot snapshot(snapshotFile);
+		if (!snapshot.isUpToDate()) {
+			spdlog::info("Snapshot of episode {} is outdated", id);
+			return false;
+		}
+
+		restoreEpisode(id, snapshot.getStream(), levels);
+
+		// Staged models are created when the staging registry is committed
+		if (!_staging)
+			createModels(_registry, std::numeric_limits<size_t>::max());
+	} catch (std::exception &e) {
+		spdlog::warn("Couldn't restore episode {} from snapshot: {}", id, e.what());
+
+		// Keep the levels the episode has already taken over, so that they are reused by loading without the snapshot
+		if (_currentEpisode) {
+			for (auto &level : _currentEpisode->releaseLevels())
+				levels.emplace_back(std::move(level));
+			_currentEpisode.reset();
+		}
+		return false;
+	}
+
+	return true;
 }
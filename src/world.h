@@ -35,15 +35,90 @@
 
 class World : public ObjectCollection {
 public:
-	World(entt::registry &registry, const std::string &name);
+	World(entt::registry &registry, const std::string &name, bool staging = false);
 
 	const std::string &getName() const;
 
+	/*!
+	 * Set if episodes should be restored from and cached in binary snapshots
+	 * \param useSnapshots if snapshots should be used
+	 */
+	void setUseSnapshots(bool useSnapshots);
+
 	void loadGlobal();
-	void loadEpisode(const std::string &id);
+
+	/*!
+	 * Load an episode, from its snapshot if snapshots are used and the
+	 * snapshot is up to date. Otherwise a new snapshot is written afterwards
+	 * \param id the id of the episode
+	 * \return if the episode was restored from its snapshot
+	 */
+	bool loadEpisode(const std::string &id);
+
+	/*!
+	 * Write the current episode together with its levels, so that it can be
+	 * restored by restoreEpisode()
+	 * \param stream the stream to write the episode to
+	 */
+	void saveEpisode(Common::WriteStream &stream) const;
+
+	/*!
+	 * Get the file names of the levels used by an episode
+	 * \param id the id of the episode
+	 * \return the level file names of the episode
+	 */
+	std::vector<std::string> getLevelFileNames(const std::string &id) const;
+
+	/*!
+	 * Restore the global data of the world written by save(). The models of
+	 * the restored entities are created by ObjectCollection::createModels()
+	 * \param stream the stream containing the global data
+	 */
+	void restoreGlobal(Common::ReadStream &stream);
+
+	/*!
+	 * Replace the current episode by an episode restored from a stream
+	 * written by Episode::save(). The models of the restored entities are
+	 * created by ObjectCollection::createModels()
+	 * \param id the id of the episode
+	 * \param stream the stream containing the episode data
+	 */
+	void restoreEpisode(const std::string &id, Common::ReadStream &stream);
+
+	/*!
+	 * Get the ids of the levels of the current episode
+	 * \return the level ids or an empty vector if no episode is loaded
+	 */
+	std::vector<std::string> getLoadedLevels() const;
+
+	/*!
+	 * Set the distances around the camera in which the cells of the current episode are resident
+	 * \param highDetailRadius the radius for high detail cells in world units
+	 * \param lowDetailRadius the radius for low detail cells in world units
+	 */
+	void setStreamingRadius(float highDetailRadius, float lowDetailRadius);
+
+	/*!
+	 * Set the size of a single cell of the current episode in world units
+	 * \param cellSize the edge length of a cell
+	 */
+	void setCellSize(float cellSize);
+
+	/*!
+	 * Update the streamed parts of the current episode and add the loaded
+	 * entities to the spatial index
+	 * \param cameraPosition the current position of the camera
+	 * \param spatialIndex the spatial index for the entities of the world
+	 */
+	void update(const glm::vec3 &cameraPosition, SpatialIndex &spatialIndex);
 
 private:
+	std::vector<std::unique_ptr<Level>> releaseLevels(const std::string &id);
+	void restoreEpisode(const std::string &id, Common::ReadStream &stream, std::vector<std::unique_ptr<Level>> &levels);
+	bool loadEpisodeSnapshot(const std::string &id, const std::string &snapshotFile, std::vector<std::unique_ptr<Level>> &levels);
+
 	const std::string _name;
+	bool _useSnapshots;
 	std::unique_ptr<WorldFile> _world;
 	std::unique_ptr<Episode> _currentEpisode;
 };
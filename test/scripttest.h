@@ -0,0 +1,141 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_SCRIPTTEST_H
+#define TEST_SCRIPTTEST_H
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/common/memreadstream.h"
+#include "src/common/memwritestream.h"
+
+#include "src/awe/script/bytecode.h"
+#include "src/awe/script/functions.h"
+#include "src/awe/script/program.h"
+
+#include "src/datagen/dpfilewriter.h"
+
+/*!
+ * Helpers shared by the tests of the script vm
+ */
+namespace ScriptTest {
+
+/*!
+ * Encode an instruction word of the script bytecode
+ *
+ * \param opcode the opcode of the instruction
+ * \param param1 the first parameter of the instruction
+ * \param param2 the second parameter of the instruction
+ * \return the encoded instruction
+ */
+inline uint32_t encode(byte opcode, byte param1 = 0, byte param2 = 0) {
+	return param1 | (param2 << 8u) | (static_cast<uint32_t>(opcode) << 24u);
+}
+
+/*!
+ * Decode a program from 4 byte words
+ *
+ * \param code the words of the bytecode
+ * \param entryPoints the entry points as offsets in words
+ * \param parameters the string constants of the program
+ * \return the decoded program
+ */
+inline AWE::Script::ProgramPtr createProgram(
+		const std::vector<uint32_t> &code,
+		const AWE::Script::EntryPoints &entryPoints,
+		const DataGen::DPFileWriter &parameters = DataGen::DPFileWriter()
+) {
+	Common::DynamicMemoryWriteStream codeStream(true);
+	for (const auto word : code) {
+		codeStream.writeUint32LE(word);
+	}
+
+	Common::DynamicMemoryWriteStream parametersStream(false);
+	parameters.write(parametersStream, false);
+
+	Common::MemoryReadStream codeReadStream(codeStream.getData(), codeStream.getLength(), false);
+	const DPFile dp(new Common::MemoryReadStream(parametersStream.getData(), parametersStream.getLength()));
+
+	return std::make_shared<const AWE::Script::Program>(codeReadStream, entryPoints, dp, AWE::Script::DebugEntries());
+}
+
+/*!
+ * Create a bytecode running a program decoded from 4 byte words
+ *
+ * \param code the words of the bytecode
+ * \param entryPoints the entry points as offsets in words
+ * \param parameters the string constants of the program
+ * \return the bytecode running the decoded program
+ */
+inline AWE::Script::BytecodePtr createBytecode(
+		const std::vector<uint32_t> &code,
+		const AWE::Script::EntryPoints &entryPoints,
+		const DataGen::DPFileWriter &parameters = DataGen::DPFileWriter()
+) {
+	return std::make_shared<AWE::Script::Bytecode>(createProgram(code, entryPoints, parameters));
+}
+
+/*!
+ * Native functions which record which entities call them. Record records the calling entity and its first
+ * parameter, if any, Sleep blocks for 2 milliseconds and Wait suspends the script for the given milliseconds
+ */
+class RecordingFunctions : public AWE::Script::Functions {
+public:
+	RecordingFunctions(entt::registry &registry) : AWE::Script::Functions(registry) {
+	}
+
+	std::vector<entt::entity> calls;
+	std::vector<int> values;
+
+protected:
+	NativeFunction getFunction(const std::string &name) override {
+		if (name == "Record")
+			return &RecordingFunctions::record;
+		if (name == "Sleep")
+			return &RecordingFunctions::sleep;
+		if (name == "Wait")
+			return &RecordingFunctions::wait;
+		return AWE::Script::Functions::getFunction(name);
+	}
+
+private:
+	static void record(Context &ctx) {
+		auto &functions = ctx.getFunctions<RecordingFunctions>();
+		functions.calls.emplace_back(ctx.thisEntity);
+		if (!ctx.parameters.empty())
+			functions.values.emplace_back(ctx.getInt(0));
+	}
+
+	static void sleep(Context &ctx) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+
+	static void wait(Context &ctx) {
+		ctx.suspend(std::chrono::milliseconds(ctx.getInt(0)));
+	}
+};
+
+}
+
+#endif //TEST_SCRIPTTEST_H
@@ -0,0 +1,528 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/common/memreadstream.h"
+#include "src/common/memwritestream.h"
+
+#include "src/awe/script/context.h"
+#include "src/awe/script/dispatcher.h"
+#include "src/awe/script/functions.h"
+#include "src/awe/script/profiler.h"
+#include "src/awe/script/tracer.h"
+
+#include "test/scripttest.h"
+
+using ScriptTest::createBytecode;
+using ScriptTest::createProgram;
+using ScriptTest::encode;
+
+class BytecodeTest : public testing::Test {
+protected:
+	BytecodeTest() : functions(registry), context(registry, functions) {
+	}
+
+	entt::registry registry;
+	AWE::Script::Functions functions;
+	AWE::Script::Context context;
+};
+
+TEST_F(BytecodeTest, decode) {
+	const auto bytecode = createBytecode({
+		encode(0x01), 7,        // push 7
+		encode(0x02), 1, 2,     // push_gid
+		encode(0x0D),           // ret
+	}, {{"OnInit", 0}, {"OnUpdate", 5}});
+
+	EXPECT_EQ(bytecode->getNumInstructions(), 3);
+	EXPECT_TRUE(bytecode->hasEntryPoint("OnInit"));
+	EXPECT_TRUE(bytecode->hasEntryPoint("OnUpdate"));
+	EXPECT_FALSE(bytecode->hasEntryPoint("OnDestroy"));
+
+	EXPECT_NO_THROW(bytecode->run(context, "OnUpdate", entt::null));
+	EXPECT_EQ(bytecode->getNumExecutedInstructions(), 1);
+
+	EXPECT_NO_THROW(bytecode->run(context, "OnInit", entt::null));
+	EXPECT_EQ(bytecode->getNumExecutedInstructions(), 4);
+}
+
+TEST_F(BytecodeTest, jumps) {
+	const auto bytecode = createBytecode({
+		encode(0x01), 1,        // push 1
+		encode(0x01), 1,        // push 1
+		encode(0x13),           // cmp
+		encode(0x1A), 1,        // jmp_if +1
+		encode(0x7F),           // unknown, skipped
+		encode(0x15), 2,        // jmp +2
+		encode(0x7F),           // unknown, skipped
+		encode(0x7F),           // unknown, skipped
+		encode(0x0D),           // ret
+	}, {{"OnInit", 0}});
+
+	EXPECT_NO_THROW(bytecode->run(context, "OnInit", entt::null));
+	EXPECT_EQ(bytecode->getNumExecutedInstructions(), 6);
+}
+
+TEST_F(BytecodeTest, conditionalJumps) {
+	const auto bytecode = createBytecode({
+		encode(0x01), 1,        // push 1
+		encode(0x01), 2,        // push 2
+		encode(0x13),           // cmp
+		encode(0x1A), 1,        // jmp_if +1, not taken
+		encode(0x0D),           // ret
+		encode(0x7F),           // unknown
+	}, {{"OnInit", 0}});
+
+	EXPECT_NO_THROW(bytecode->run(context, "OnInit", entt::null));
+	EXPECT_EQ(bytecode->getNumExecutedInstructions(), 5);
+}
+
+TEST_F(BytecodeTest, invalidCode) {
+	const auto bytecode = createBytecode({
+		encode(0x7F),           // unknown
+		encode(0x15), 100,      // jmp +100, outside of the code
+		encode(0x01),           // push, cut off
+	}, {{"OnUnknown", 0}, {"OnJump", 1}, {"OnCutOff", 3}});
+
+	EXPECT_THROW(bytecode->run(context, "OnUnknown", entt::null), std::runtime_error);
+	EXPECT_THROW(bytecode->run(context, "OnJump", entt::null), std::runtime_error);
+	EXPECT_THROW(bytecode->run(context, "OnCutOff", entt::null), std::runtime_error);
+}
+
+TEST_F(BytecodeTest, pushStrings) {
+	DataGen::DPFileWriter parameters;
+	const uint32_t game = parameters.addString("Game");
+	const uint32_t getRandInt = parameters.addString("GetRandInt");
+
+	const auto bytecode = createBytecode({
+		encode(0x01), 3,          // push 3
+		encode(0x01), 3,          // push 3
+		encode(0x01), getRandInt, // push "GetRandInt"
+		encode(0x01), game,       // push "Game"
+		encode(0x03, 2, 1),       // call_global 2 1
+		encode(0x01), 3,          // push 3
+		encode(0x13),             // cmp
+		encode(0x1A), 1,          // jmp_if +1
+		encode(0x7F),             // unknown, skipped
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}}, parameters);
+
+	EXPECT_NO_THROW(bytecode->run(context, "OnInit", entt::null));
+	EXPECT_EQ(bytecode->getNumExecutedInstructions(), 9);
+}
+
+namespace {
+
+class CountingFunctions : public AWE::Script::Functions {
+public:
+	CountingFunctions(entt::registry &registry) : AWE::Script::Functions(registry) {
+	}
+
+	unsigned int resolved = 0;
+	unsigned int called = 0;
+
+protected:
+	NativeFunction getFunction(const std::string &name) override {
+		resolved++;
+		if (name == "GAME.Count")
+			return &CountingFunctions::count;
+		return AWE::Script::Functions::getFunction(name);
+	}
+
+private:
+	static void count(Context &ctx) {
+		auto &functions = ctx.getFunctions<CountingFunctions>();
+		ctx.defer([&functions]() {
+			functions.called++;
+		});
+	}
+};
+
+}
+
+TEST_F(BytecodeTest, callSiteCache) {
+	DataGen::DPFileWriter parameters;
+	const uint32_t game = parameters.addString("Game");
+	const uint32_t count = parameters.addString("Count");
+
+	const auto bytecode = createBytecode({
+		encode(0x01), count,      // push "Count"
+		encode(0x01), game,       // push "Game"
+		encode(0x03),             // call_global 0 0
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}}, parameters);
+
+	CountingFunctions countingFunctions(registry);
+	AWE::Script::Context countingContext(registry, countingFunctions);
+
+	bytecode->link(countingContext);
+	EXPECT_EQ(countingFunctions.resolved, 1);
+
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NO_THROW(bytecode->run(countingContext, "OnInit", entt::null));
+	}
+	EXPECT_EQ(countingFunctions.resolved, 1);
+	EXPECT_EQ(countingFunctions.called, 3);
+
+	// Running with different functions binds the call site again
+	EXPECT_NO_THROW(bytecode->run(context, "OnInit", entt::null));
+	EXPECT_EQ(countingFunctions.called, 3);
+
+	// Alternating back finds the previous binding
+	EXPECT_NO_THROW(bytecode->run(countingContext, "OnInit", entt::null));
+	EXPECT_EQ(countingFunctions.resolved, 1);
+	EXPECT_EQ(countingFunctions.called, 4);
+}
+
+TEST_F(BytecodeTest, callSiteCacheLimit) {
+	DataGen::DPFileWriter parameters;
+	const uint32_t game = parameters.addString("Game");
+	const uint32_t count = parameters.addString("Count");
+
+	const auto bytecode = createBytecode({
+		encode(0x01), count,      // push "Count"
+		encode(0x01), game,       // push "Game"
+		encode(0x03),             // call_global 0 0
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}}, parameters);
+
+	std::vector<std::unique_ptr<CountingFunctions>> countingFunctions;
+	std::vector<std::unique_ptr<AWE::Script::Context>> contexts;
+	for (int i = 0; i < 5; ++i) {
+		countingFunctions.emplace_back(std::make_unique<CountingFunctions>(registry));
+		contexts.emplace_back(std::make_unique<AWE::Script::Context>(registry, *countingFunctions.back()));
+	}
+
+	for (int round = 0; round < 3; ++round) {
+		for (const auto &countingContext : contexts) {
+			EXPECT_NO_THROW(bytecode->run(*countingContext, "OnInit", entt::null));
+		}
+	}
+
+	// The first targets stay bound, the call site doesn't keep a binding for every further one
+	for (int i = 0; i < 4; ++i) {
+		EXPECT_EQ(countingFunctions[i]->resolved, 1);
+		EXPECT_EQ(countingFunctions[i]->called, 3);
+	}
+	EXPECT_EQ(countingFunctions[4]->resolved, 3);
+	EXPECT_EQ(countingFunctions[4]->called, 3);
+
+	// Linking drops the previous bindings
+	bytecode->link(*contexts[4]);
+	EXPECT_EQ(countingFunctions[4]->resolved, 4);
+	EXPECT_NO_THROW(bytecode->run(*contexts[4], "OnInit", entt::null));
+	EXPECT_EQ(countingFunctions[4]->resolved, 4);
+}
+
+TEST_F(BytecodeTest, programSaveLoad) {
+	DataGen::DPFileWriter parameters;
+	const uint32_t game = parameters.addString("Game");
+	const uint32_t count = parameters.addString("Count");
+
+	const auto program = createProgram({
+		encode(0x01), count,      // push "Count"
+		encode(0x01), game,       // push "Game"
+		encode(0x03),             // call_global 0 0
+		encode(0x02), 1, 2,       // push_gid
+		encode(0x15), 1,          // jmp +1
+		encode(0x0D),             // ret
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}, {"OnUpdate", 6}}, parameters);
+
+	Common::DynamicMemoryWriteStream stream(true);
+	program->save(stream);
+
+	Common::MemoryReadStream readStream(stream.getData(), stream.getLength(), false);
+	const auto loaded = std::make_shared<const AWE::Script::Program>(readStream);
+
+	EXPECT_EQ(loaded->getNumInstructions(), program->getNumInstructions());
+	EXPECT_EQ(loaded->getEntryPoints(), program->getEntryPoints());
+	EXPECT_EQ(loaded->getGIDs().size(), 1);
+	EXPECT_EQ(loaded->getCallSites().size(), 1);
+	EXPECT_EQ(loaded->disassemble(), program->disassemble());
+
+	// Scripts created from a loaded program run like scripts decoding their own bytecode
+	CountingFunctions countingFunctions(registry);
+	AWE::Script::Context countingContext(registry, countingFunctions);
+
+	AWE::Script::Bytecode first(loaded), second(loaded);
+	EXPECT_EQ(first.getProgram(), second.getProgram());
+	EXPECT_NO_THROW(first.run(countingContext, "OnInit", entt::null));
+	EXPECT_NO_THROW(second.run(countingContext, "OnInit", entt::null));
+	EXPECT_EQ(countingFunctions.called, 2);
+
+	// Corrupted programs are rejected instead of being executed
+	std::vector<byte> corrupted(stream.getData(), stream.getData() + stream.getLength());
+	corrupted.resize(corrupted.size() / 2);
+	Common::MemoryReadStream corruptedStream(corrupted.data(), corrupted.size(), false);
+	EXPECT_ANY_THROW(AWE::Script::Program program(corruptedStream));
+}
+
+TEST_F(BytecodeTest, disassemble) {
+	DataGen::DPFileWriter parameters;
+	const uint32_t game = parameters.addString("Game");
+	const uint32_t count = parameters.addString("Count");
+
+	const auto program = createProgram({
+		encode(0x01), 7,          // push 7
+		encode(0x01), count,      // push "Count"
+		encode(0x01), game,       // push "Game"
+		encode(0x03, 1, 0),       // call_global 1 0
+		encode(0x15), 1,          // jmp +1
+		encode(0x0D),             // ret
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}}, parameters);
+
+	EXPECT_EQ(program->disassemble(),
+		"OnInit:\n"
+		"  0000  push 7\n"
+		"  0001  push \"Count\"\n"
+		"  0002  push \"Game\"\n"
+		"  0003  call_global 1 0  ; Game.Count\n"
+		"  0004  jmp 0006\n"
+		"  0005  ret\n"
+		"  0006  ret\n"
+	);
+}
+
+TEST_F(BytecodeTest, reentrancy) {
+	DataGen::DPFileWriter parameters;
+	const uint32_t self = parameters.addString("this");
+	const uint32_t sendCustomEvent = parameters.addString("SendCustomEvent");
+	const uint32_t onEvent = parameters.addString("OnEvent");
+
+	const AWE::Script::BytecodePtr bytecode = createBytecode({
+		encode(0x01), 1,               // push 1
+		encode(0x01), 1,               // push 1
+		encode(0x13),                  // cmp
+		encode(0x01), onEvent,         // push "OnEvent"
+		encode(0x01), sendCustomEvent, // push "SendCustomEvent"
+		encode(0x01), self,            // push "this"
+		encode(0x03, 1, 0),            // call_global 1 0
+		encode(0x1A), 1,               // jmp_if +1, depends on the cmp before the call
+		encode(0x7F),                  // unknown, skipped
+		encode(0x0D),                  // ret
+		encode(0x01), 1,               // OnEvent: push 1
+		encode(0x01), 2,               // push 2
+		encode(0x13),                  // cmp
+		encode(0x0D),                  // ret
+	}, {{"OnInit", 0}, {"OnEvent", 16}}, parameters);
+
+	const entt::entity entity = registry.create();
+	registry.emplace<AWE::Script::BytecodePtr>(entity, bytecode);
+
+	EXPECT_NO_THROW(bytecode->run(context, "OnInit", entity));
+	EXPECT_EQ(bytecode->getNumExecutedInstructions(), 13);
+}
+
+TEST_F(BytecodeTest, profiler) {
+	DataGen::DPFileWriter parameters;
+	const uint32_t self = parameters.addString("this");
+	const uint32_t sendCustomEvent = parameters.addString("SendCustomEvent");
+	const uint32_t onEvent = parameters.addString("OnEvent");
+
+	const AWE::Script::BytecodePtr bytecode = createBytecode({
+		encode(0x01), onEvent,         // push "OnEvent"
+		encode(0x01), sendCustomEvent, // push "SendCustomEvent"
+		encode(0x01), self,            // push "this"
+		encode(0x03, 1, 0),            // call_global 1 0
+		encode(0x0D),                  // ret
+		encode(0x01), 1,               // OnEvent: push 1
+		encode(0x01), 2,               // push 2
+		encode(0x13),                  // cmp
+		encode(0x0D),                  // ret
+	}, {{"OnInit", 0}, {"OnEvent", 8}}, parameters);
+
+	const entt::entity entity = registry.create();
+	registry.emplace<AWE::Script::BytecodePtr>(entity, bytecode);
+
+	AWE::Script::Profiler profiler(registry);
+	context.setProfiler(&profiler);
+	for (int i = 0; i < 2; ++i) {
+		bytecode->run(context, "OnInit", entity);
+	}
+	context.setProfiler(nullptr);
+	bytecode->run(context, "OnInit", entity);
+
+	const auto entryPoints = profiler.getEntryPoints();
+	const auto natives = profiler.getNatives();
+	ASSERT_EQ(entryPoints.size(), 2);
+	ASSERT_EQ(natives.size(), 1);
+
+	const auto &onInitStats = entryPoints[0].name.find("OnInit") == 0 ? entryPoints[0] : entryPoints[1];
+	const auto &onEventStats = entryPoints[0].name.find("OnInit") == 0 ? entryPoints[1] : entryPoints[0];
+	EXPECT_EQ(onInitStats.calls, 2);
+	EXPECT_EQ(onInitStats.instructions, 10);
+	EXPECT_EQ(onEventStats.calls, 2);
+	EXPECT_EQ(onEventStats.instructions, 8);
+
+	// The event runs within the native function, which runs within OnInit
+	EXPECT_EQ(natives[0].name, "SendCustomEvent");
+	EXPECT_EQ(natives[0].calls, 2);
+	EXPECT_GE(natives[0].inclusive, onEventStats.inclusive);
+	EXPECT_EQ(natives[0].exclusive, natives[0].inclusive - onEventStats.inclusive);
+	EXPECT_EQ(onInitStats.exclusive, onInitStats.inclusive - natives[0].inclusive);
+	EXPECT_LE(onEventStats.exclusive, onEventStats.inclusive);
+
+	profiler.reset();
+	EXPECT_TRUE(profiler.getEntryPoints().empty());
+}
+
+TEST_F(BytecodeTest, profilerSharedProgram) {
+	const auto program = createProgram({
+		encode(0x01), 1,          // push 1
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}});
+
+	AWE::Script::Bytecode first(program), second(program);
+	const entt::entity firstEntity = registry.create();
+	const entt::entity secondEntity = registry.create();
+	registry.emplace<GID>(firstEntity) = GID{1, 0x2a};
+	registry.emplace<GID>(secondEntity) = GID{1, 0x2b};
+
+	AWE::Script::Profiler profiler(registry);
+	context.setProfiler(&profiler);
+	first.run(context, "OnInit", firstEntity);
+	second.run(context, "OnInit", secondEntity);
+
+	// Scripts of the same program share one row, named after the gid of the first caller
+	auto entryPoints = profiler.getEntryPoints();
+	ASSERT_EQ(entryPoints.size(), 1);
+	EXPECT_EQ(entryPoints[0].name, "OnInit (1:2a)");
+	EXPECT_EQ(entryPoints[0].calls, 2);
+
+	// Resetting keeps the names of the rows
+	profiler.reset();
+	second.run(context, "OnInit", secondEntity);
+	context.setProfiler(nullptr);
+
+	entryPoints = profiler.getEntryPoints();
+	ASSERT_EQ(entryPoints.size(), 1);
+	EXPECT_EQ(entryPoints[0].name, "OnInit (1:2a)");
+	EXPECT_EQ(entryPoints[0].calls, 1);
+}
+
+TEST_F(BytecodeTest, tracer) {
+	DataGen::DPFileWriter parameters;
+	const uint32_t game = parameters.addString("Game");
+	const uint32_t getRandInt = parameters.addString("GetRandInt");
+	const uint32_t missing = parameters.addString("Missing");
+
+	const auto bytecode = createBytecode({
+		encode(0x01), 4,          // push 4
+		encode(0x01), 4,          // push 4
+		encode(0x01), getRandInt, // push "GetRandInt"
+		encode(0x01), game,       // push "Game"
+		encode(0x03, 2, 1),       // call_global 2 1
+		encode(0x01), missing,    // push "Missing"
+		encode(0x01), game,       // push "Game"
+		encode(0x03),             // call_global 0 0
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}}, parameters);
+
+	const entt::entity entity = registry.create();
+	registry.emplace<GID>(entity) = GID{1, 0x20};
+
+	AWE::Script::Tracer tracer(registry);
+	context.setTracer(&tracer);
+	bytecode->run(context, "OnInit", entity);
+	context.setTracer(nullptr);
+	bytecode->run(context, "OnInit", entity);
+
+	const std::vector<std::string> calls{
+		"1:20: Game.GetRandInt(4, 4) -> 4",
+		"1:20: Game.Missing()  ; not implemented",
+	};
+	EXPECT_EQ(tracer.getCalls(), calls);
+
+	tracer.reset();
+	EXPECT_EQ(tracer.getNumCalls(), 0);
+}
+
+TEST_F(BytecodeTest, dispatcher) {
+	DataGen::DPFileWriter parameters;
+	const uint32_t game = parameters.addString("Game");
+	const uint32_t count = parameters.addString("Count");
+
+	const AWE::Script::BytecodePtr bytecode = createBytecode({
+		encode(0x01), count,      // push "Count"
+		encode(0x01), game,       // push "Game"
+		encode(0x03),             // call_global 0 0
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}}, parameters);
+
+	const AWE::Script::BytecodePtr other = createBytecode({
+		encode(0x0D),             // ret
+	}, {{"OnUpdate", 0}});
+
+	for (int i = 0; i < 200; ++i) {
+		registry.emplace<AWE::Script::BytecodePtr>(registry.create(), i % 4 == 0 ? other : bytecode);
+	}
+
+	CountingFunctions countingFunctions(registry);
+	AWE::Script::Context countingContext(registry, countingFunctions);
+
+	countingContext.linkScripts();
+
+	AWE::Script::Dispatcher dispatcher(countingContext);
+	dispatcher.run("OnInit");
+
+	EXPECT_EQ(countingFunctions.called, 150);
+	EXPECT_EQ(bytecode->getNumExecutedInstructions(), 600);
+	EXPECT_EQ(other->getNumExecutedInstructions(), 0);
+}
+
+TEST(ScriptValue, types) {
+	const AWE::Script::Variable integer(7u);
+	EXPECT_EQ(integer.getType(), AWE::Script::Variable::kInt);
+	EXPECT_EQ(integer.getInt(), 7);
+	EXPECT_THROW(integer.getEntity(), std::runtime_error);
+	EXPECT_THROW(integer.getString(), std::runtime_error);
+
+	const AWE::Script::Variable number(1.5f);
+	EXPECT_EQ(number.getType(), AWE::Script::Variable::kFloat);
+	EXPECT_FLOAT_EQ(number.getFloat(), 1.5f);
+	EXPECT_EQ(number.getInt(), 0x3FC00000u);
+
+	const AWE::Script::Variable entity(static_cast<entt::entity>(3));
+	EXPECT_EQ(entity.getEntity(), static_cast<entt::entity>(3));
+	EXPECT_THROW(entity.getInt(), std::runtime_error);
+
+	const AWE::Script::Variable string(AWE::Script::String{Atoms.intern("Game")});
+	EXPECT_EQ(string.getString().str(), "Game");
+
+	EXPECT_EQ(AWE::Script::Variable().getInt(), 0);
+}
+
+TEST_F(BytecodeTest, stackOverflow) {
+	std::vector<uint32_t> code;
+	for (int i = 0; i < 100; ++i) {
+		code.emplace_back(encode(0x01));
+		code.emplace_back(i);
+	}
+	code.emplace_back(encode(0x0D));
+
+	const auto bytecode = createBytecode(code, {{"OnInit", 0}});
+	EXPECT_THROW(bytecode->run(context, "OnInit", entt::null), std::runtime_error);
+}
@@ -0,0 +1,183 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/awe/script/context.h"
+#include "src/awe/script/eventqueue.h"
+
+#include "test/scripttest.h"
+
+using ScriptTest::encode;
+
+class EventQueueTest : public testing::Test {
+protected:
+	EventQueueTest() : functions(registry), context(registry, functions), eventQueue(context) {
+		self = parameters.addString("this");
+		record = parameters.addString("Record");
+		sleep = parameters.addString("Sleep");
+		sendCustomEvent = parameters.addString("SendCustomEvent");
+		onEvent = parameters.addString("OnEvent");
+	}
+
+	AWE::Script::BytecodePtr createBytecode(const std::vector<uint32_t> &code, const AWE::Script::EntryPoints &entryPoints) {
+		return ScriptTest::createBytecode(code, entryPoints, parameters);
+	}
+
+	entt::entity createEntity(const AWE::Script::BytecodePtr &bytecode) {
+		const entt::entity entity = registry.create();
+		registry.emplace<AWE::Script::BytecodePtr>(entity, bytecode);
+		return entity;
+	}
+
+	DataGen::DPFileWriter parameters;
+	uint32_t self, record, sleep, sendCustomEvent, onEvent;
+
+	entt::registry registry;
+	ScriptTest::RecordingFunctions functions;
+	AWE::Script::Context context;
+	AWE::Script::EventQueue eventQueue;
+};
+
+TEST_F(EventQueueTest, batches) {
+	const auto recording = createBytecode({
+		encode(0x01), record,     // push "Record"
+		encode(0x01), self,       // push "this"
+		encode(0x03),             // call_global 0 0
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}});
+	const auto other = createBytecode({
+		encode(0x01), record,     // push "Record"
+		encode(0x01), self,       // push "this"
+		encode(0x03),             // call_global 0 0
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}});
+
+	const entt::entity entity1 = createEntity(recording);
+	const entt::entity entity2 = createEntity(other);
+	const entt::entity entity3 = createEntity(recording);
+	const entt::entity entity4 = createEntity(other);
+
+	EXPECT_TRUE(eventQueue.post(entity1, "OnInit"));
+	EXPECT_TRUE(eventQueue.post(entity2, "OnInit"));
+	EXPECT_TRUE(eventQueue.post(entity3, "OnInit"));
+	EXPECT_FALSE(eventQueue.post(entity4, "OnUpdate"));
+	EXPECT_FALSE(eventQueue.post(registry.create(), "OnInit"));
+	EXPECT_EQ(eventQueue.size(), 3);
+
+	EXPECT_EQ(eventQueue.update(), 3);
+	EXPECT_TRUE(eventQueue.empty());
+
+	// The events of the same bytecode run together, in the order they were posted
+	const std::vector<entt::entity> expected{entity1, entity3, entity2};
+	EXPECT_EQ(functions.calls, expected);
+
+	const auto &metrics = eventQueue.getMetrics();
+	EXPECT_EQ(metrics.processed, 3);
+	EXPECT_EQ(metrics.totalProcessed, 3);
+	EXPECT_EQ(metrics.peakDepth, 3);
+	EXPECT_EQ(metrics.depth, 0);
+}
+
+TEST_F(EventQueueTest, sharedProgram) {
+	const auto recording = createBytecode({
+		encode(0x01), record,     // push "Record"
+		encode(0x01), self,       // push "this"
+		encode(0x03),             // call_global 0 0
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}});
+	const auto other = createBytecode({
+		encode(0x01), record,     // push "Record"
+		encode(0x01), self,       // push "this"
+		encode(0x03),             // call_global 0 0
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}});
+	const auto shared = std::make_shared<AWE::Script::Bytecode>(recording->getProgram());
+
+	const entt::entity entity1 = createEntity(recording);
+	const entt::entity entity2 = createEntity(other);
+	const entt::entity entity3 = createEntity(shared);
+
+	eventQueue.post(entity1, "OnInit");
+	eventQueue.post(entity2, "OnInit");
+	eventQueue.post(entity3, "OnInit");
+	EXPECT_EQ(eventQueue.update(), 3);
+
+	// Entities with their own bytecode of the same program share a batch
+	const std::vector<entt::entity> expected{entity1, entity3, entity2};
+	EXPECT_EQ(functions.calls, expected);
+}
+
+TEST_F(EventQueueTest, timeBudget) {
+	const auto sleeping = createBytecode({
+		encode(0x01), sleep,      // push "Sleep"
+		encode(0x01), self,       // push "this"
+		encode(0x03),             // call_global 0 0
+		encode(0x0D),             // ret
+	}, {{"OnInit", 0}});
+
+	for (int i = 0; i < 3; ++i) {
+		eventQueue.post(createEntity(sleeping), "OnInit");
+	}
+
+	// Every event takes longer than the budget, so every update runs exactly one of them
+	eventQueue.setTimeBudget(std::chrono::milliseconds(1));
+	EXPECT_EQ(eventQueue.update(), 1);
+	EXPECT_EQ(eventQueue.size(), 2);
+	EXPECT_GE(eventQueue.getMetrics().time, std::chrono::milliseconds(2));
+	EXPECT_EQ(eventQueue.update(), 1);
+	EXPECT_GE(eventQueue.getMetrics().maxLatency, std::chrono::milliseconds(2));
+
+	// Without a budget all waiting events run at once
+	eventQueue.setTimeBudget(std::chrono::microseconds(0));
+	EXPECT_EQ(eventQueue.update(), 1);
+	EXPECT_TRUE(eventQueue.empty());
+	EXPECT_EQ(eventQueue.getMetrics().totalProcessed, 3);
+}
+
+TEST_F(EventQueueTest, customEvents) {
+	functions.setEventQueue(&eventQueue);
+
+	const auto bytecode = createBytecode({
+		encode(0x01), onEvent,         // push "OnEvent"
+		encode(0x01), sendCustomEvent, // push "SendCustomEvent"
+		encode(0x01), self,            // push "this"
+		encode(0x03, 1, 0),            // call_global 1 0
+		encode(0x0D),                  // ret
+		encode(0x01), record,          // OnEvent: push "Record"
+		encode(0x01), self,            // push "this"
+		encode(0x03),                  // call_global 0 0
+		encode(0x0D),                  // ret
+	}, {{"OnInit", 0}, {"OnEvent", 8}});
+
+	const entt::entity entity = createEntity(bytecode);
+	eventQueue.post(entity, "OnInit");
+
+	// Events sent by scripts wait for the next update
+	EXPECT_EQ(eventQueue.update(), 1);
+	EXPECT_EQ(eventQueue.size(), 1);
+	EXPECT_TRUE(functions.calls.empty());
+
+	EXPECT_EQ(eventQueue.update(), 1);
+	EXPECT_EQ(functions.calls, std::vector<entt::entity>{entity});
+}
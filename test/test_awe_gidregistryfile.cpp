@@ -0,0 +1,73 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "src/common/memreadstream.h"
+
+#include "src/awe/gidregistryfile.h"
+
+static AWE::GIDRegistryFile createRegistry(std::string data) {
+	Common::MemoryReadStream stream(reinterpret_cast<byte *>(data.data()), data.size(), false);
+	return AWE::GIDRegistryFile(stream);
+}
+
+TEST(GIDRegistryFile, getString) {
+	const AWE::GIDRegistryFile registry = createRegistry(
+			"3,0A000000,scene1_reststop\n"
+			"12,ff00ab01,dynamic_object_1\r\n"
+			"12,FF00AB02,dynamic_object_2"
+	);
+
+	EXPECT_EQ(registry.getString(GID{3, 0x0000000A}), "scene1_reststop");
+	EXPECT_EQ(registry.getString(GID{12, 0x01AB00FF}), "dynamic_object_1");
+	EXPECT_EQ(registry.getString(GID{12, 0x02AB00FF}), "dynamic_object_2");
+}
+
+TEST(GIDRegistryFile, missingGIDs) {
+	const AWE::GIDRegistryFile registry = createRegistry("3,0A000000,scene1_reststop\n");
+
+	EXPECT_EQ(registry.getString(GID{0, 0}), "");
+	EXPECT_EQ(registry.getString(GID{3, 0x0000000B}), "");
+	EXPECT_EQ(registry.getString(GID{4, 0x0000000A}), "");
+}
+
+TEST(GIDRegistryFile, malformedLines) {
+	const AWE::GIDRegistryFile registry = createRegistry(
+			"\n"
+			"invalid line\n"
+			"5,0B000000,valid\n"
+			"6,,missing id\n"
+	);
+
+	EXPECT_EQ(registry.getString(GID{5, 0x0000000B}), "valid");
+	EXPECT_EQ(registry.getString(GID{6, 0}), "");
+}
+
+TEST(GIDRegistryFile, duplicateGIDs) {
+	const AWE::GIDRegistryFile registry = createRegistry(
+			"7,01000000,first\n"
+			"7,01000000,second\n"
+	);
+
+	EXPECT_EQ(registry.getString(GID{7, 1}), "second");
+}
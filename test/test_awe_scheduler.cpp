@@ -0,0 +1,131 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/awe/script/context.h"
+#include "src/awe/script/scheduler.h"
+
+#include "test/scripttest.h"
+
+using ScriptTest::encode;
+
+class SchedulerTest : public testing::Test {
+protected:
+	SchedulerTest() : functions(registry), context(registry, functions), scheduler(context) {
+		context.setScheduler(&scheduler);
+
+		const uint32_t self = parameters.addString("this");
+		const uint32_t record = parameters.addString("Record");
+		const uint32_t wait = parameters.addString("Wait");
+
+		bytecode = ScriptTest::createBytecode({
+				encode(0x01), 7u,         // push 7
+				encode(0x01), 100u,       // push 100
+				encode(0x01), wait,       // push "Wait"
+				encode(0x01), self,       // push "this"
+				encode(0x03, 1),          // call_global 1 0
+				encode(0x01), record,     // push "Record"
+				encode(0x01), self,       // push "this"
+				encode(0x03, 1),          // call_global 1 0
+				encode(0x0D),             // ret
+		}, {{"OnInit", 0}}, parameters);
+
+		entity = registry.create();
+		registry.emplace<AWE::Script::BytecodePtr>(entity, bytecode);
+	}
+
+	DataGen::DPFileWriter parameters;
+	entt::registry registry;
+	ScriptTest::RecordingFunctions functions;
+	AWE::Script::Context context;
+	AWE::Script::Scheduler scheduler;
+	AWE::Script::BytecodePtr bytecode;
+	entt::entity entity;
+};
+
+TEST_F(SchedulerTest, resume) {
+	bytecode->run(context, "OnInit", entity);
+	EXPECT_TRUE(functions.calls.empty());
+	EXPECT_EQ(scheduler.size(), 1);
+
+	EXPECT_EQ(scheduler.update(std::chrono::milliseconds(99)), 0);
+	EXPECT_TRUE(functions.calls.empty());
+
+	// The value pushed before suspending has to be restored from the saved frame
+	EXPECT_EQ(scheduler.update(std::chrono::milliseconds(1)), 1);
+	EXPECT_EQ(functions.calls, std::vector<entt::entity>{entity});
+	EXPECT_EQ(functions.values, std::vector<int>{7});
+	EXPECT_EQ(scheduler.size(), 0);
+	EXPECT_EQ(scheduler.getTime(), std::chrono::milliseconds(100));
+}
+
+TEST_F(SchedulerTest, deferred) {
+	AWE::Script::CommandBuffer commands;
+	bytecode->run(context, "OnInit", entity, &commands);
+	EXPECT_EQ(scheduler.size(), 0);
+
+	commands.execute();
+	EXPECT_EQ(scheduler.size(), 1);
+
+	scheduler.update(std::chrono::milliseconds(100));
+	EXPECT_EQ(functions.calls.size(), 1);
+}
+
+TEST_F(SchedulerTest, destroyedEntity) {
+	bytecode->run(context, "OnInit", entity);
+	registry.destroy(entity);
+
+	scheduler.update(std::chrono::milliseconds(100));
+	EXPECT_TRUE(functions.calls.empty());
+	EXPECT_EQ(scheduler.size(), 0);
+}
+
+TEST_F(SchedulerTest, changedScript) {
+	bytecode->run(context, "OnInit", entity);
+
+	// The suspended frame keeps its program alive, so a script of the same program can resume it
+	const auto program = bytecode->getProgram();
+	registry.get<AWE::Script::BytecodePtr>(entity) = std::make_shared<AWE::Script::Bytecode>(program);
+	bytecode.reset();
+
+	scheduler.update(std::chrono::milliseconds(100));
+	EXPECT_EQ(functions.values, std::vector<int>{7});
+
+	// Scripts of other programs drop the suspended frame
+	registry.get<AWE::Script::BytecodePtr>(entity)->run(context, "OnInit", entity);
+	registry.get<AWE::Script::BytecodePtr>(entity) = ScriptTest::createBytecode({encode(0x0D)}, {{"OnInit", 0}});
+
+	scheduler.update(std::chrono::milliseconds(100));
+	EXPECT_EQ(functions.values, std::vector<int>{7});
+	EXPECT_EQ(scheduler.size(), 0);
+}
+
+TEST_F(SchedulerTest, withoutScheduler) {
+	context.setScheduler(nullptr);
+
+	bytecode->run(context, "OnInit", entity);
+	EXPECT_EQ(functions.calls, std::vector<entt::entity>{entity});
+	EXPECT_EQ(functions.values, std::vector<int>{7});
+	EXPECT_EQ(scheduler.size(), 0);
+}
@@ -0,0 +1,138 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "src/common/aabbtree.h"
+
+static Common::BoundBox makeBox(const glm::vec3 &position, float size) {
+	return Common::BoundBox{
+		position.x, position.y, position.z,
+		position.x + size, position.y + size, position.z + size
+	};
+}
+
+TEST(AABBTree, insertRemove) {
+	Common::AABBTree tree(0.0f);
+	EXPECT_EQ(tree.size(), 0);
+
+	const auto first = tree.insert(makeBox(glm::vec3(0.0f), 1.0f), 1);
+	const auto second = tree.insert(makeBox(glm::vec3(10.0f), 1.0f), 2);
+	EXPECT_EQ(tree.size(), 2);
+	EXPECT_EQ(tree.getValue(first), 1);
+	EXPECT_EQ(tree.getValue(second), 2);
+
+	std::vector<uint32_t> values;
+	tree.query(Common::BoundSphere{glm::vec3(0.5f), 1.0f}, values);
+	EXPECT_EQ(values, std::vector<uint32_t>{1});
+
+	tree.remove(first);
+	EXPECT_EQ(tree.size(), 1);
+
+	values.clear();
+	tree.query(Common::BoundSphere{glm::vec3(0.5f), 1.0f}, values);
+	EXPECT_TRUE(values.empty());
+
+	values.clear();
+	tree.raycast(glm::vec3(0.0f), glm::normalize(glm::vec3(1.0f)), 20.0f, values);
+	EXPECT_EQ(values, std::vector<uint32_t>{2});
+
+	tree.clear();
+	EXPECT_EQ(tree.size(), 0);
+	EXPECT_EQ(tree.getHeight(), 0);
+}
+
+TEST(AABBTree, move) {
+	Common::AABBTree tree(0.5f);
+	const auto proxy = tree.insert(makeBox(glm::vec3(0.0f), 1.0f), 7);
+
+	// Staying inside the margin doesn't change the tree
+	EXPECT_FALSE(tree.move(proxy, makeBox(glm::vec3(0.25f), 1.0f)));
+	EXPECT_TRUE(tree.move(proxy, makeBox(glm::vec3(5.0f), 1.0f)));
+
+	const Common::BoundBox &box = tree.getBoundBox(proxy);
+	EXPECT_FLOAT_EQ(box.xmin, 4.5f);
+	EXPECT_FLOAT_EQ(box.xmax, 6.5f);
+
+	std::vector<uint32_t> values;
+	tree.query(makeBox(glm::vec3(5.5f), 0.1f), values);
+	EXPECT_EQ(values, std::vector<uint32_t>{7});
+}
+
+TEST(AABBTree, randomUpdates) {
+	// Insert, move and remove objects at random and compare the queries against testing every object
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> step(-3.0f, 3.0f);
+	std::uniform_real_distribution<float> size(0.0f, 4.0f);
+
+	Common::AABBTree tree(0.5f);
+	std::map<uint32_t, std::pair<Common::AABBTree::Proxy, glm::vec3>> objects;
+	uint32_t nextValue = 0;
+
+	for (int i = 0; i < 5000; ++i) {
+		const glm::vec3 origin(position(random), position(random), position(random));
+		objects[nextValue] = std::make_pair(tree.insert(makeBox(origin, 1.0f), nextValue), origin);
+		nextValue++;
+	}
+
+	for (int round = 0; round < 10; ++round) {
+		for (auto &[value, object] : objects) {
+			object.second += glm::vec3(step(random), step(random), step(random));
+			tree.move(object.first, makeBox(object.second, 1.0f));
+		}
+
+		for (int i = 0; i < 200; ++i) {
+			const auto iter = objects.lower_bound(random() % nextValue);
+			if (iter == objects.end())
+				continue;
+
+			tree.remove(iter->second.first);
+			objects.erase(iter);
+		}
+
+		ASSERT_EQ(tree.size(), objects.size());
+
+		// A balanced tree, well below the height of a list
+		EXPECT_LE(tree.getHeight(), 2 * std::log2(objects.size()));
+
+		const glm::vec3 center(position(random), position(random), position(random));
+		const Common::BoundSphere sphere{center, size(random) * 10.0f};
+		std::vector<uint32_t> values;
+		tree.query(sphere, values);
+		std::sort(values.begin(), values.end());
+
+		// The tree stores enlarged boxes, so it finds everything an exact test finds and nothing beyond the margin
+		for (const auto &[value, object] : objects) {
+			const bool found = std::binary_search(values.begin(), values.end(), value);
+			if (makeBox(object.second, 1.0f).intersect(sphere.position, sphere.radius)) {
+				EXPECT_TRUE(found) << "object " << value;
+			}
+			if (found) {
+				EXPECT_TRUE(tree.getBoundBox(object.first).intersect(sphere.position, sphere.radius)) << "object " << value;
+			}
+		}
+	}
+}
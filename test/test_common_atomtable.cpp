@@ -0,0 +1,64 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "src/common/atomtable.h"
+
+TEST(AtomTable, intern) {
+	const Common::Atom atom1 = Atoms.intern("skeleton");
+	const Common::Atom atom2 = Atoms.intern(std::string("skel") + "eton");
+	const Common::Atom atom3 = Atoms.intern("animation");
+
+	EXPECT_EQ(atom1, atom2);
+	EXPECT_NE(atom1, atom3);
+	EXPECT_NE(atom1, Common::kEmptyAtom);
+
+	EXPECT_EQ(Atoms.getString(atom1), "skeleton");
+	EXPECT_EQ(Atoms.getString(atom3), "animation");
+}
+
+TEST(AtomTable, emptyString) {
+	EXPECT_EQ(Atoms.intern(""), Common::kEmptyAtom);
+	EXPECT_TRUE(Atoms.getString(Common::kEmptyAtom).empty());
+}
+
+TEST(AtomTable, find) {
+	Common::Atom atom;
+
+	EXPECT_FALSE(Atoms.find("not interned string", atom));
+
+	const Common::Atom interned = Atoms.intern("interned string");
+	EXPECT_TRUE(Atoms.find("interned string", atom));
+	EXPECT_EQ(atom, interned);
+}
+
+TEST(AtomTable, stableViews) {
+	const std::string_view view = Atoms.getString(Atoms.intern("stable"));
+
+	for (unsigned int i = 0; i < 1000; ++i) {
+		Atoms.intern("string" + std::to_string(i));
+	}
+
+	EXPECT_EQ(view, "stable");
+	EXPECT_EQ(Atoms.getString(Atoms.intern("string500")), "string500");
+}
@@ -0,0 +1,136 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "src/common/bvh.h"
+
+static std::vector<Common::BVH::Object> generateObjects(unsigned int numObjects) {
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> size(0.0f, 5.0f);
+
+	std::vector<Common::BVH::Object> objects;
+	for (unsigned int i = 0; i < numObjects; ++i) {
+		const glm::vec3 min(position(random), position(random), position(random));
+		const glm::vec3 max = min + glm::vec3(size(random), size(random), size(random));
+		objects.emplace_back(Common::BoundBox{min.x, min.y, min.z, max.x, max.y, max.z}, i);
+	}
+
+	return objects;
+}
+
+template<typename Test>
+static std::vector<uint32_t> findObjects(const std::vector<Common::BVH::Object> &objects, const Test &test) {
+	std::vector<uint32_t> values;
+	for (const auto &[box, value] : objects) {
+		if (test(box))
+			values.emplace_back(value);
+	}
+	return values;
+}
+
+static std::vector<uint32_t> sorted(std::vector<uint32_t> values) {
+	std::sort(values.begin(), values.end());
+	return values;
+}
+
+TEST(BVH, empty) {
+	Common::BVH bvh;
+	EXPECT_TRUE(bvh.empty());
+
+	std::vector<uint32_t> values;
+	bvh.query(Common::BoundBox{-1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f}, values);
+	EXPECT_TRUE(values.empty());
+}
+
+TEST(BVH, queries) {
+	const auto objects = generateObjects(2000);
+	const Common::BVH bvh(objects);
+	ASSERT_EQ(bvh.size(), objects.size());
+
+	const Common::BoundBox &bounds = bvh.getBoundBox();
+	for (const auto &object : objects) {
+		EXPECT_TRUE(bounds.contains(object.first));
+	}
+
+	std::vector<uint32_t> values;
+
+	const Common::BoundBox box{-20.0f, -10.0f, 0.0f, 30.0f, 10.0f, 40.0f};
+	bvh.query(box, values);
+	EXPECT_FALSE(values.empty());
+	EXPECT_EQ(sorted(values), findObjects(objects, [&](const Common::BoundBox &b) { return b.intersect(box); }));
+
+	values.clear();
+	const Common::BoundSphere sphere{glm::vec3(10.0f, -20.0f, 5.0f), 25.0f};
+	bvh.query(sphere, values);
+	EXPECT_FALSE(values.empty());
+	EXPECT_EQ(sorted(values), findObjects(objects, [&](const Common::BoundBox &b) {
+		return b.intersect(sphere.position, sphere.radius);
+	}));
+
+	values.clear();
+	const Common::Frustum frustum(
+		glm::perspectiveFov(glm::radians(60.0f), 1.0f, 1.0f, 1.0f, 80.0f) *
+		glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f))
+	);
+	bvh.query(frustum, values);
+	EXPECT_FALSE(values.empty());
+	EXPECT_EQ(sorted(values), findObjects(objects, [&](const Common::BoundBox &b) { return frustum.intersects(b); }));
+
+	values.clear();
+	// Aimed through the center of one of the objects, so that at least one is hit
+	const glm::vec3 origin(-120.0f, 2.0f, 3.0f);
+	const glm::vec3 direction = glm::normalize(objects[42].first.getCenter() - origin);
+	bvh.raycast(origin, direction, 300.0f, values);
+	EXPECT_NE(std::find(values.begin(), values.end(), 42), values.end());
+	EXPECT_EQ(sorted(values), findObjects(objects, [&](const Common::BoundBox &b) {
+		return b.intersect(origin, 1.0f / direction, 300.0f);
+	}));
+
+	// A ray ending before the object doesn't hit it
+	values.clear();
+	const float distance = glm::distance(origin, objects[42].first.getCenter());
+	bvh.raycast(origin, direction, distance - 10.0f, values);
+	EXPECT_EQ(std::find(values.begin(), values.end(), 42), values.end());
+}
+
+TEST(BVH, identicalObjects) {
+	// Objects at the same position can't be split by their centers, but every one has to be found
+	std::vector<Common::BVH::Object> objects;
+	for (uint32_t i = 0; i < 100; ++i) {
+		objects.emplace_back(Common::BoundBox{0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f}, i);
+	}
+
+	const Common::BVH bvh(objects);
+	std::vector<uint32_t> values;
+	bvh.query(Common::BoundSphere{glm::vec3(0.5f), 0.1f}, values);
+	EXPECT_EQ(values.size(), objects.size());
+
+	values.clear();
+	bvh.query(Common::BoundSphere{glm::vec3(5.0f), 0.1f}, values);
+	EXPECT_TRUE(values.empty());
+}
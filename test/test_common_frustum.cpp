@@ -0,0 +1,101 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "src/common/frustum.h"
+
+static glm::mat4 getViewProjection() {
+	// Looking from the origin along the negative z axis
+	const glm::mat4 projection = glm::perspectiveFov(glm::radians(90.0f), 1.0f, 1.0f, 1.0f, 100.0f);
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	return projection * view;
+}
+
+TEST(Frustum, intersects) {
+	const Common::Frustum frustum(getViewProjection());
+
+	EXPECT_TRUE(frustum.intersects({glm::vec3(0.0f, 0.0f, -10.0f), 1.0f}));
+	EXPECT_TRUE(frustum.intersects({glm::vec3(9.0f, 0.0f, -10.0f), 0.5f}));
+
+	// Behind the camera, beyond the far plane and besides the frustum
+	EXPECT_FALSE(frustum.intersects({glm::vec3(0.0f, 0.0f, 10.0f), 1.0f}));
+	EXPECT_FALSE(frustum.intersects({glm::vec3(0.0f, 0.0f, -200.0f), 1.0f}));
+	EXPECT_FALSE(frustum.intersects({glm::vec3(30.0f, 0.0f, -10.0f), 1.0f}));
+
+	// Spheres reaching into the frustum
+	EXPECT_TRUE(frustum.intersects({glm::vec3(0.0f, 0.0f, 5.0f), 10.0f}));
+	EXPECT_TRUE(frustum.intersects({glm::vec3(30.0f, 0.0f, -10.0f), 20.0f}));
+
+	// Infinite spheres, as used for meshes without bounds, are never culled
+	EXPECT_TRUE(frustum.intersects({glm::vec3(0.0f), std::numeric_limits<float>::infinity()}));
+}
+
+TEST(Frustum, intersectsBox) {
+	const Common::Frustum frustum(getViewProjection());
+
+	EXPECT_TRUE(frustum.intersects(Common::BoundBox{-1.0f, -1.0f, -11.0f, 1.0f, 1.0f, -9.0f}));
+
+	// Behind the camera and besides the frustum
+	EXPECT_FALSE(frustum.intersects(Common::BoundBox{-1.0f, -1.0f, 9.0f, 1.0f, 1.0f, 11.0f}));
+	EXPECT_FALSE(frustum.intersects(Common::BoundBox{29.0f, -1.0f, -11.0f, 31.0f, 1.0f, -9.0f}));
+
+	// A box containing the whole frustum and one crossing the left plane
+	EXPECT_TRUE(frustum.intersects(Common::BoundBox{-500.0f, -500.0f, -500.0f, 500.0f, 500.0f, 500.0f}));
+	EXPECT_TRUE(frustum.intersects(Common::BoundBox{-12.0f, -1.0f, -11.0f, -9.0f, 1.0f, -9.0f}));
+}
+
+TEST(Frustum, cull) {
+	const Common::Frustum frustum(getViewProjection());
+
+	// An odd number of spheres, so that both the vectorized and the remaining spheres are tested
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+	std::uniform_real_distribution<float> radius(0.0f, 10.0f);
+
+	Common::BoundSpheres spheres;
+	for (int i = 0; i < 1003; ++i) {
+		spheres.add({glm::vec3(position(random), position(random), position(random)), radius(random)});
+	}
+
+	std::vector<byte> visible;
+	const size_t numVisible = frustum.cull(spheres, visible);
+	ASSERT_EQ(visible.size(), spheres.size());
+
+	size_t expectedVisible = 0;
+	for (size_t i = 0; i < spheres.size(); ++i) {
+		const Common::BoundSphere sphere{
+			glm::vec3(spheres.getX()[i], spheres.getY()[i], spheres.getZ()[i]),
+			spheres.getRadius()[i]
+		};
+		EXPECT_EQ(visible[i] != 0, frustum.intersects(sphere)) << "sphere " << i;
+		expectedVisible += frustum.intersects(sphere) ? 1 : 0;
+	}
+
+	EXPECT_EQ(numVisible, expectedVisible);
+	EXPECT_GT(numVisible, 0);
+	EXPECT_LT(numVisible, spheres.size());
+}
@@ -0,0 +1,46 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/common/log.h"
+
+static int evaluations = 0;
+
+static int countEvaluation() {
+	return ++evaluations;
+}
+
+TEST(Log, skipArguments) {
+	const spdlog::level::level_enum level = spdlog::get_level();
+	spdlog::set_level(spdlog::level::warn);
+
+	evaluations = 0;
+	LOG_TRACE("{}", countEvaluation());
+	LOG_DEBUG("{}", countEvaluation());
+	LOG_INFO("{}", countEvaluation());
+	EXPECT_EQ(evaluations, 0);
+
+	spdlog::set_level(spdlog::level::off);
+	LOG_WARN("{}", countEvaluation());
+	EXPECT_EQ(evaluations, 0);
+
+	spdlog::set_level(level);
+}
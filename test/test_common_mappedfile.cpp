@@ -0,0 +1,64 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "src/common/mappedfile.h"
+
+static std::string writeTestFile(const std::string &name, const std::string &contents) {
+	const std::string path = (std::filesystem::temp_directory_path() / name).string();
+	std::ofstream out(path, std::ios::binary);
+	out.write(contents.data(), contents.size());
+	return path;
+}
+
+TEST(MappedFile, data) {
+	const std::string path = writeTestFile("openawe_mappedfile_data.bin", "OpenAWE mapped file");
+	Common::MappedFile file(path);
+
+	ASSERT_EQ(file.size(), 19);
+	EXPECT_EQ(std::memcmp(file.getData(), "OpenAWE mapped file", 19), 0);
+
+	std::filesystem::remove(path);
+}
+
+TEST(MappedFile, read) {
+	const std::string path = writeTestFile("openawe_mappedfile_read.bin", std::string("\x01\x00\x00\x00\x02\x00\x00\x00", 8));
+	Common::MappedFile file(path);
+
+	EXPECT_EQ(file.readUint32LE(), 1);
+	EXPECT_EQ(file.pos(), 4);
+	EXPECT_EQ(file.readUint32LE(), 2);
+	EXPECT_TRUE(file.eos());
+
+	file.seek(-4, Common::ReadStream::END);
+	EXPECT_EQ(file.readUint32LE(), 2);
+	EXPECT_THROW(file.seek(1, Common::ReadStream::END), std::runtime_error);
+
+	std::filesystem::remove(path);
+}
+
+TEST(MappedFile, missingFile) {
+	EXPECT_THROW(Common::MappedFile("openawe_mappedfile_missing.bin"), std::runtime_error);
+}
@@ -0,0 +1,73 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/common/memorytracker.h"
+
+TEST(MemoryTracker, trackedMemory) {
+	const size_t live = MemoryTracking.getLive(Common::kMemoryMeshes);
+
+	MemoryTracking.resetPeaks();
+	{
+		Common::TrackedMemory memory(Common::kMemoryMeshes, 1024);
+		EXPECT_EQ(MemoryTracking.getLive(Common::kMemoryMeshes), live + 1024);
+
+		memory.resize(4096);
+		EXPECT_EQ(memory.size(), 4096);
+		EXPECT_EQ(MemoryTracking.getLive(Common::kMemoryMeshes), live + 4096);
+
+		memory.resize(512);
+		EXPECT_EQ(MemoryTracking.getLive(Common::kMemoryMeshes), live + 512);
+	}
+
+	EXPECT_EQ(MemoryTracking.getLive(Common::kMemoryMeshes), live);
+	EXPECT_EQ(MemoryTracking.getPeak(Common::kMemoryMeshes), live + 4096);
+
+	MemoryTracking.resetPeaks();
+	EXPECT_EQ(MemoryTracking.getPeak(Common::kMemoryMeshes), live);
+	EXPECT_GE(MemoryTracking.getTotalPeak(Common::kMemoryMeshes), live + 4096);
+}
+
+TEST(MemoryTracker, budgets) {
+	MemoryTracking.set(Common::kMemoryRegistry, 0);
+	MemoryTracking.resetPeaks();
+	MemoryTracking.setBudget(Common::kMemoryRegistry, 1000);
+
+	MemoryTracking.set(Common::kMemoryRegistry, 1000);
+	EXPECT_TRUE(MemoryTracking.checkBudgets("Test"));
+
+	MemoryTracking.set(Common::kMemoryRegistry, 1001);
+	MemoryTracking.set(Common::kMemoryRegistry, 10);
+	EXPECT_FALSE(MemoryTracking.checkBudgets("Test"));
+
+	MemoryTracking.setBudget(Common::kMemoryRegistry, 0);
+	EXPECT_TRUE(MemoryTracking.checkBudgets("Test"));
+
+	MemoryTracking.set(Common::kMemoryRegistry, 0);
+}
+
+TEST(MemoryTracker, tags) {
+	Common::MemoryTag tag;
+	EXPECT_TRUE(Common::MemoryTracker::getTag("textures", tag));
+	EXPECT_EQ(tag, Common::kMemoryTextures);
+	EXPECT_STREQ(Common::MemoryTracker::getTagName(tag), "textures");
+	EXPECT_FALSE(Common::MemoryTracker::getTag("invalid", tag));
+}
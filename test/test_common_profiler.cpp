@@ -0,0 +1,71 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "src/common/memwritestream.h"
+#include "src/common/profiler.h"
+
+static std::string saveTrace() {
+	Common::DynamicMemoryWriteStream stream(true);
+	Profile.save(stream);
+	return std::string(reinterpret_cast<const char *>(stream.getData()), stream.getLength());
+}
+
+TEST(Profiler, zones) {
+	Profile.start();
+	{
+		Common::ProfileZone zone("test_zone");
+	}
+	Profile.addCounter("test_counter", 42);
+	Profile.stop();
+
+	{
+		Common::ProfileZone zone("test_stopped_zone");
+	}
+
+	const std::string trace = saveTrace();
+	EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+	EXPECT_NE(trace.find("{\"name\":\"test_zone\",\"ph\":\"X\""), std::string::npos);
+	EXPECT_NE(trace.find("{\"name\":\"test_counter\",\"ph\":\"C\""), std::string::npos);
+	EXPECT_NE(trace.find("\"args\":{\"value\":42}"), std::string::npos);
+	EXPECT_EQ(trace.find("test_stopped_zone"), std::string::npos);
+}
+
+TEST(Profiler, threads) {
+	const size_t numEvents = Profile.getNumEvents();
+
+	Profile.start();
+	std::thread thread([](){
+		Profile.setThreadName("Test \"Thread\"");
+		Common::ProfileZone zone("test_thread_zone");
+	});
+	thread.join();
+	Profile.stop();
+
+	EXPECT_EQ(Profile.getNumEvents(), numEvents + 1);
+
+	const std::string trace = saveTrace();
+	EXPECT_NE(trace.find("\"args\":{\"name\":\"Test \\\"Thread\\\"\"}"), std::string::npos);
+	EXPECT_NE(trace.find("test_thread_zone"), std::string::npos);
+}
@@ -65,3 +65,9 @@ TEST(StringUtil, crc32) {
 	EXPECT_EQ(Common::crc32(testString1), 2513066006);
 	EXPECT_EQ(Common::crc32(testString2), 740559520);
 }
+
+TEST(StringUtil, escapeJSON) {
+	EXPECT_EQ(Common::escapeJSON("plain"), "plain");
+	EXPECT_EQ(Common::escapeJSON("a \"quoted\" \\path"), "a \\\"quoted\\\" \\\\path");
+	EXPECT_EQ(Common::escapeJSON("line\n"), "line\\u000a");
+}
@@ -0,0 +1,120 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/common/timerwheel.h"
+
+TEST(TimerWheel, expireInOrder) {
+	Common::TimerWheel wheel;
+	std::vector<int> expired;
+
+	wheel.schedule(30, [&](){ expired.emplace_back(30); });
+	wheel.schedule(10, [&](){ expired.emplace_back(10); });
+	wheel.schedule(20, [&](){ expired.emplace_back(20); });
+	EXPECT_EQ(wheel.size(), 3);
+
+	EXPECT_EQ(wheel.advance(9), 0);
+	EXPECT_TRUE(expired.empty());
+
+	EXPECT_EQ(wheel.advance(20), 2);
+	EXPECT_EQ(expired, std::vector<int>({10, 20}));
+
+	EXPECT_EQ(wheel.advance(100), 1);
+	EXPECT_EQ(expired, std::vector<int>({10, 20, 30}));
+	EXPECT_EQ(wheel.size(), 0);
+	EXPECT_EQ(wheel.getTime(), 100);
+}
+
+TEST(TimerWheel, pastDeadline) {
+	Common::TimerWheel wheel(50);
+	bool expired = false;
+
+	wheel.schedule(10, [&](){ expired = true; });
+	EXPECT_EQ(wheel.advance(50), 0);
+	EXPECT_EQ(wheel.advance(51), 1);
+	EXPECT_TRUE(expired);
+}
+
+TEST(TimerWheel, cancel) {
+	Common::TimerWheel wheel;
+	bool expired = false;
+
+	const auto id = wheel.schedule(10, [&](){ expired = true; });
+	EXPECT_NE(id, Common::TimerWheel::kInvalidTimer);
+	EXPECT_TRUE(wheel.cancel(id));
+	EXPECT_FALSE(wheel.cancel(id));
+	EXPECT_EQ(wheel.size(), 0);
+
+	// The id of the cancelled timer must not cancel a new timer reusing its storage
+	const auto other = wheel.schedule(10, [&](){ expired = true; });
+	EXPECT_NE(other, id);
+	EXPECT_FALSE(wheel.cancel(id));
+
+	wheel.advance(10);
+	EXPECT_TRUE(expired);
+	EXPECT_FALSE(wheel.cancel(other));
+}
+
+TEST(TimerWheel, cascade) {
+	Common::TimerWheel wheel(1000);
+	std::vector<uint64_t> deadlines = {1255, 1256, 1280, 66000, 16777300, 1ull << 33u};
+	std::vector<uint64_t> expired;
+
+	for (const auto deadline : deadlines) {
+		wheel.schedule(deadline, [&, deadline](){
+			expired.emplace_back(deadline);
+			EXPECT_EQ(wheel.getTime(), deadline);
+		});
+	}
+
+	for (size_t i = 0; i < deadlines.size(); ++i) {
+		wheel.advance(deadlines[i] - 1);
+		EXPECT_EQ(expired.size(), i);
+		wheel.advance(deadlines[i]);
+		EXPECT_EQ(expired.size(), i + 1);
+	}
+
+	EXPECT_EQ(expired, deadlines);
+}
+
+TEST(TimerWheel, scheduleWhileExpiring) {
+	Common::TimerWheel wheel;
+	unsigned int count = 0;
+	Common::TimerWheel::TimerId cancelled = Common::TimerWheel::kInvalidTimer;
+
+	// Every timer reschedules itself and cancels a timer expiring in the same tick
+	std::function<void()> repeat = [&](){
+		count++;
+		EXPECT_TRUE(wheel.cancel(cancelled));
+		if (count < 10) {
+			wheel.schedule(wheel.getTime() + 300, repeat);
+			cancelled = wheel.schedule(wheel.getTime() + 300, [](){ FAIL(); });
+		}
+	};
+	wheel.schedule(300, repeat);
+	cancelled = wheel.schedule(300, [](){ FAIL(); });
+
+	EXPECT_EQ(wheel.advance(3000), 10);
+	EXPECT_EQ(count, 10);
+	EXPECT_EQ(wheel.size(), 0);
+}
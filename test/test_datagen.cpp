@@ -0,0 +1,220 @@
+/* OpenAWE - A reimplementation of Remedys Alan Wake Engine
+ *
+ * OpenAWE is the legal property of its developers, whose names
+ * can be found in the AUTHORS file distributed with this source
+ * distribution.
+ *
+ * OpenAWE is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * OpenAWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenAWE. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "src/common/atomtable.h"
+#include "src/common/memreadstream.h"
+#include "src/common/memwritestream.h"
+
+#include "src/awe/binarchive.h"
+#include "src/awe/cidfile.h"
+#include "src/awe/dpfile.h"
+#include "src/awe/gidregistryfile.h"
+#include "src/awe/havokfile.h"
+#include "src/awe/rmdparchive.h"
+#include "src/awe/script/collection.h"
+#include "src/awe/script/context.h"
+
+#include "src/datagen/generator.h"
+#include "src/datagen/rmdparchivewriter.h"
+
+static const DataGen::Scale kScale = {2, 4, 4, 2, 2, 2, 4, 1, 16, 2, 4, 1, 4, 70};
+
+static Common::ReadStream *createStream(std::vector<byte> &data) {
+	return new Common::MemoryReadStream(data.data(), data.size(), false);
+}
+
+TEST(DataGen, deterministic) {
+	DataGen::Generator generator1(kScale, 42), generator2(kScale, 42), generator3(kScale, 43);
+
+	EXPECT_EQ(generator1.generateResources(DataGen::Generator::kAlanWake), generator2.generateResources(DataGen::Generator::kAlanWake));
+	EXPECT_NE(generator1.generateResources(DataGen::Generator::kAlanWake), generator3.generateResources(DataGen::Generator::kAlanWake));
+}
+
+TEST(DataGen, rmdpArchives) {
+	for (const auto game : {DataGen::Generator::kAlanWake, DataGen::Generator::kNightmare}) {
+		DataGen::Generator generator(kScale, 1);
+		DataGen::Generator::Resources resources = generator.generateResources(game);
+
+		DataGen::RMDPArchiveWriter writer(game == DataGen::Generator::kNightmare ? 7 : 2);
+		for (const auto &resource : resources) {
+			writer.addResource(resource.first, resource.second);
+		}
+
+		Common::DynamicMemoryWriteStream bin(true), rmdp(true);
+		writer.write(bin, rmdp);
+
+		AWE::RMDPArchive archive(
+				new Common::MemoryReadStream(bin.getData(), bin.getLength(), false),
+				new Common::MemoryReadStream(rmdp.getData(), rmdp.getLength(), false)
+		);
+
+		EXPECT_EQ(archive.getNumResources(), resources.size());
+		EXPECT_FALSE(archive.hasResource("objects/missing.cid"));
+
+		for (const auto &resource : resources) {
+			ASSERT_TRUE(archive.hasResource(resource.first)) << resource.first;
+
+			std::unique_ptr<Common::ReadStream> stream(archive.getResource(resource.first));
+			std::vector<byte> data(resource.second.size());
+			stream->read(data.data(), data.size());
+			EXPECT_EQ(data, resource.second) << resource.first;
+		}
+	}
+}
+
+TEST(DataGen, binArchives) {
+	DataGen::Generator generator(kScale, 1);
+	DataGen::Generator::Resources resources = generator.generateResources(DataGen::Generator::kAlanWake);
+
+	std::unique_ptr<Common::ReadStream> stream(createStream(resources["objects/cell_001.bin"]));
+	AWE::BINArchive archive(*stream);
+
+	EXPECT_EQ(archive.getNumResources(), 5);
+	for (const auto &name : {"staticobjects.cid", "dynamicobjects.cid", "characters.cid", "triggers.cid", "objects.dp"}) {
+		const std::vector<byte> &expected = resources[std::string("objects/cell_001/") + name];
+
+		std::unique_ptr<Common::ReadStream> file(archive.getResource(name));
+		ASSERT_TRUE(file) << name;
+
+		std::vector<byte> data(expected.size());
+		file->read(data.data(), data.size());
+		EXPECT_EQ(data, expected) << name;
+	}
+}
+
+TEST(DataGen, cidFiles) {
+	for (const auto game : {DataGen::Generator::kAlanWake, DataGen::Generator::kNightmare}) {
+		DataGen::Generator generator(kScale, 1);
+		DataGen::Generator::Resources resources = generator.generateResources(game);
+
+		std::shared_ptr<DPFile> dp = std::make_shared<DPFile>(createStream(resources["objects/cell_000/objects.dp"]));
+
+		std::unique_ptr<Common::ReadStream> registryStream(createStream(resources["GIDRegistry.txt"]));
+		AWE::GIDRegistryFile registry(*registryStream);
+
+		std::unique_ptr<Common::ReadStream> stream(createStream(resources["objects/cell_000/staticobjects.cid"]));
+		AWE::CIDFile staticObjects(*stream, kStaticObject, dp);
+		ASSERT_EQ(staticObjects.getContainers().size(), kScale.staticObjectsPerCell);
+		for (const auto &container : staticObjects.getContainers()) {
+			const auto staticObject = std::any_cast<AWE::Templates::StaticObject>(container);
+			EXPECT_GE(staticObject.meshResource, 1);
+			EXPECT_LE(staticObject.meshResource, kScale.numMeshes);
+			EXPECT_EQ(staticObject.physicsResource, staticObject.meshResource + 0x1000);
+			EXPECT_GE(staticObject.position.x, 0.0f);
+			EXPECT_FLOAT_EQ(staticObject.rotation[1].y, 1.0f);
+		}
+
+		stream.reset(createStream(resources["objects/cell_000/dynamicobjects.cid"]));
+		AWE::CIDFile dynamicObjects(*stream, kDynamicObject, dp);
+		ASSERT_EQ(dynamicObjects.getContainers().size(), kScale.dynamicObjectsPerCell);
+		const auto dynamicObject = std::any_cast<AWE::Templates::DynamicObject>(dynamicObjects.getContainers()[1]);
+		EXPECT_EQ(Atoms.getString(dynamicObject.identifier), "cell_000_dynamicobject_1");
+		EXPECT_EQ(registry.getString(dynamicObject.gid), "cell_000_dynamicobject_1");
+
+		stream.reset(createStream(resources["objects/cell_000/characters.cid"]));
+		AWE::CIDFile characters(*stream, kCharacter, dp);
+		ASSERT_EQ(characters.getContainers().size(), kScale.charactersPerCell);
+		const auto character = std::any_cast<AWE::Templates::Character>(characters.getContainers()[0]);
+		EXPECT_EQ(registry.getString(character.gid), "cell_000_character_0");
+		if (game == DataGen::Generator::kNightmare) {
+			EXPECT_EQ(character.identifier, "cell_000_character_0");
+			EXPECT_EQ(character.animgraphResource, character.meshResource + 0x4000);
+		}
+
+		stream.reset(createStream(resources["objects/cell_000/triggers.cid"]));
+		AWE::CIDFile triggers(*stream, kTrigger, dp);
+		ASSERT_EQ(triggers.getContainers().size(), kScale.triggersPerCell);
+		const auto trigger = std::any_cast<AWE::Templates::Trigger>(triggers.getContainers()[1]);
+		EXPECT_EQ(Atoms.getString(trigger.identifier), "cell_000_trigger_1");
+		EXPECT_EQ(Atoms.getString(trigger.localeString), "trigger_1");
+	}
+}
+
+TEST(DataGen, havokAnimations) {
+	DataGen::Generator generator(kScale, 1);
+	DataGen::Generator::Resources resources = generator.generateResources(DataGen::Generator::kNightmare);
+
+	std::unique_ptr<Common::ReadStream> stream(createStream(resources["animations/animation_000.binhkx"]));
+	AWE::HavokFile havok(*stream);
+
+	const auto &container = havok.getAnimationContainer();
+	ASSERT_EQ(container.skeletons.size(), 1);
+	ASSERT_EQ(container.animations.size(), 1);
+
+	const auto skeleton = havok.getSkeleton(container.skeletons[0]);
+	EXPECT_EQ(skeleton.name, "skeleton");
+	ASSERT_EQ(skeleton.bones.size(), kScale.animationBones);
+	EXPECT_EQ(skeleton.bones[0].parentIndex, -1);
+	EXPECT_EQ(skeleton.bones[2].parentIndex, 1);
+	EXPECT_EQ(skeleton.bones[2].name, "bone_002");
+	EXPECT_FLOAT_EQ(skeleton.bones[2].position.y, 0.25f);
+	EXPECT_FLOAT_EQ(skeleton.bones[2].rotation.w, 1.0f);
+
+	// Every block contains a track per bone
+	const auto animation = havok.getAnimation(container.animations[0]);
+	const unsigned int numBlocks = (kScale.animationFrames + 63) / 64;
+	ASSERT_EQ(animation.tracks.size(), kScale.animationBones * numBlocks);
+	EXPECT_EQ(animation.boneToTrack.at("bone_003"), 3);
+	ASSERT_TRUE(animation.tracks[0].positions);
+	EXPECT_EQ(animation.tracks[0].positions->size(), 64);
+	EXPECT_EQ(animation.tracks[0].rotations.size(), 64);
+	EXPECT_EQ(animation.tracks.back().rotations.size(), kScale.animationFrames - 64);
+	for (const auto &rotation : animation.tracks.back().rotations) {
+		EXPECT_NEAR(rotation.x * rotation.x + rotation.y * rotation.y + rotation.z * rotation.z + rotation.w * rotation.w, 1.0f, 0.01f);
+	}
+}
+
+TEST(DataGen, scripts) {
+	for (const auto game : {DataGen::Generator::kAlanWake, DataGen::Generator::kNightmare}) {
+		DataGen::Generator generator(kScale, 1);
+		DataGen::Generator::Resources resources = generator.generateResources(game);
+
+		AWE::Script::Collection collection(
+				createStream(resources["scripts/bytecode.dp"]),
+				createStream(resources["scripts/bytecodeparameters.dp"])
+		);
+
+		entt::registry registry;
+		AWE::Script::Functions functions(registry);
+		AWE::Script::Context context(registry, functions);
+
+		std::unique_ptr<Common::ReadStream> stream(createStream(resources["scripts/scripts.cid"]));
+		AWE::CIDFile scripts(*stream, kScript, std::make_shared<DPFile>(createStream(resources["objects/cell_000/objects.dp"])));
+		ASSERT_EQ(scripts.getContainers().size(), kScale.numScripts);
+
+		for (const auto &container : scripts.getContainers()) {
+			const auto script = std::any_cast<AWE::Templates::Script>(container);
+			EXPECT_EQ(script.script.numHandlers, 3);
+
+			std::unique_ptr<AWE::Script::Bytecode> bytecode(collection.createScript(script.script));
+			EXPECT_TRUE(bytecode->hasEntryPoint("OnInit"));
+			EXPECT_TRUE(bytecode->hasEntryPoint("OnTaskActivate"));
+			EXPECT_FALSE(bytecode->hasEntryPoint("OnDestroy"));
+
+			// The generated code has to be executable without any objects in the registry
+			EXPECT_NO_THROW(bytecode->run(context, "OnInit", entt::null));
+			EXPECT_NO_THROW(bytecode->run(context, "OnUpdate", entt::null));
+		}
+	}
+}